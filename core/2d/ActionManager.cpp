@@ -36,6 +36,12 @@ THE SOFTWARE.
 
 namespace ax
 {
+// eased values overshoot with the back and elastic easings, a float out of range isn't convertible to uint8_t
+static uint8_t toColorComponent(float value)
+{
+    return static_cast<uint8_t>(std::roundf(std::clamp(value, 0.0f, 255.0f)));
+}
+
 //
 // singleton stuff
 //
@@ -103,6 +109,12 @@ void ActionManager::pauseTarget(Node* target)
     {
         it->second.paused = true;
     }
+
+    auto tweenIt = _tweenTargetIndices.find(target);
+    if (tweenIt != _tweenTargetIndices.end())
+    {
+        _tweenTargets[tweenIt->second].paused = true;
+    }
 }
 
 void ActionManager::resumeTarget(Node* target)
@@ -112,6 +124,12 @@ void ActionManager::resumeTarget(Node* target)
     {
         it->second.paused = false;
     }
+
+    auto tweenIt = _tweenTargetIndices.find(target);
+    if (tweenIt != _tweenTargetIndices.end())
+    {
+        _tweenTargets[tweenIt->second].paused = false;
+    }
 }
 
 Vector<Node*> ActionManager::pauseAllRunningActions()
@@ -124,6 +142,13 @@ Vector<Node*> ActionManager::pauseAllRunningActions()
         idsWithActions.pushBack(const_cast<Node*>(target));
     }
 
+    for (auto& [target, index] : _tweenTargetIndices)
+    {
+        _tweenTargets[index].paused = true;
+        if (_targets.find(target) == _targets.end())
+            idsWithActions.pushBack(target);
+    }
+
     return idsWithActions;
 }
 
@@ -167,6 +192,10 @@ void ActionManager::removeAllActions()
 {
     for (auto actionIt = _targets.begin(); actionIt != _targets.end();)
         removeTargetActionHandle(actionIt);
+
+    for (auto& [_, index] : _tweenTargetIndices)
+        _tweenTargets[index].removed = true;
+    _tweenTargetIndices.clear();
 }
 
 void ActionManager::removeAllActionsFromTarget(Node* target)
@@ -180,6 +209,8 @@ void ActionManager::removeAllActionsFromTarget(Node* target)
     auto actionIt = _targets.find(target);
     if (actionIt != _targets.end())
         removeTargetActionHandle(actionIt);
+
+    removeTweenTarget(target);
 }
 
 void ActionManager::removeTargetActionHandle(std::unordered_map<Node*, ActionHandle>::iterator& actionIt)
@@ -452,6 +483,249 @@ void ActionManager::update(float dt)
 
     // issue #635
     _currentTarget = nullptr;
+
+    updateTweens(dt);
+}
+
+// tweens
+
+void ActionManager::addTween(Node* target,
+                             TweenProperty property,
+                             const Vec3& to,
+                             float duration,
+                             tweenfunc::TweenType easing,
+                             int tag)
+{
+    AXASSERT(target != nullptr, "target can't be nullptr!");
+    AXASSERT(easing != tweenfunc::CUSTOM_EASING, "custom easing isn't supported by tweens!");
+    if (target == nullptr)
+        return;
+
+    Vec3 from;
+    switch (property)
+    {
+    case TweenProperty::POSITION:
+        from.set(target->getPositionX(), target->getPositionY(), 0.0f);
+        break;
+    case TweenProperty::SCALE:
+        from.set(target->getScaleX(), target->getScaleY(), 0.0f);
+        break;
+    case TweenProperty::ROTATION:
+        from.set(target->getRotation(), 0.0f, 0.0f);
+        break;
+    case TweenProperty::OPACITY:
+        from.set(target->getOpacity(), 0.0f, 0.0f);
+        break;
+    case TweenProperty::COLOR:
+    {
+        auto& color = target->getColor();
+        from.set(color.r, color.g, color.b);
+        break;
+    }
+    }
+
+    auto index = getTweenTargetIndex(target);
+    ++_tweenTargets[index].tweenCount;
+
+    _tweenTargetOf.emplace_back(index);
+    _tweenProperties.emplace_back(property);
+    _tweenEasings.emplace_back(easing);
+    _tweenTags.emplace_back(tag);
+    _tweenElapsed.emplace_back(0.0f);
+    // same as ActionInterval, prevent division by 0
+    _tweenDurations.emplace_back(std::abs(duration) <= MATH_EPSILON ? MATH_EPSILON : duration);
+    _tweenFrom[0].emplace_back(from.x);
+    _tweenFrom[1].emplace_back(from.y);
+    _tweenFrom[2].emplace_back(from.z);
+    _tweenDelta[0].emplace_back(to.x - from.x);
+    _tweenDelta[1].emplace_back(to.y - from.y);
+    _tweenDelta[2].emplace_back(to.z - from.z);
+    _tweenStarted.emplace_back(0);
+    _tweenRemoved.emplace_back(0);
+}
+
+void ActionManager::removeTweensByTag(int tag, Node* target)
+{
+    AXASSERT(target != nullptr, "target can't be nullptr!");
+
+    auto tweenIt = _tweenTargetIndices.find(target);
+    if (tweenIt == _tweenTargetIndices.end())
+        return;
+
+    const auto index = tweenIt->second;
+    for (size_t i = 0, count = _tweenTargetOf.size(); i < count; ++i)
+    {
+        if (_tweenTargetOf[i] == index && _tweenTags[i] == tag)
+            _tweenRemoved[i] = 1;
+    }
+}
+
+uint32_t ActionManager::getTweenTargetIndex(Node* target)
+{
+    auto tweenIt = _tweenTargetIndices.find(target);
+    if (tweenIt != _tweenTargetIndices.end())
+        return tweenIt->second;
+
+    uint32_t index;
+    if (!_freeTweenTargets.empty())
+    {
+        index = _freeTweenTargets.back();
+        _freeTweenTargets.resize(_freeTweenTargets.size() - 1);
+    }
+    else
+    {
+        index = static_cast<uint32_t>(_tweenTargets.size());
+        _tweenTargets.emplace_back();
+    }
+
+    // same as Node::runAction, a target which isn't running starts paused
+    _tweenTargets[index] = TweenTarget{target, 0, !target->isRunning(), false};
+    _tweenTargetIndices.emplace(target, index);
+    return index;
+}
+
+void ActionManager::removeTweenTarget(Node* target)
+{
+    auto tweenIt = _tweenTargetIndices.find(target);
+    if (tweenIt != _tweenTargetIndices.end())
+    {
+        // the target may be destroyed right after, it's never accessed again
+        _tweenTargets[tweenIt->second].removed = true;
+        _tweenTargetIndices.erase(tweenIt);
+    }
+}
+
+void ActionManager::updateTweens(float dt)
+{
+    const auto count = _tweenElapsed.size();
+    if (count == 0)
+        return;
+
+    _tweenProgress.resize(count);
+    for (auto& values : _tweenValues)
+        values.resize(count);
+
+    // advance the tweens and compute their progress
+    {
+        auto targets   = _tweenTargets.data();
+        auto targetOf  = _tweenTargetOf.data();
+        auto started   = _tweenStarted.data();
+        auto elapsed   = _tweenElapsed.data();
+        auto durations = _tweenDurations.data();
+        auto progress  = _tweenProgress.data();
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto& tweenTarget = targets[targetOf[i]];
+            const bool active       = !tweenTarget.paused && !tweenTarget.removed;
+            elapsed[i] += (active && started[i]) ? dt : 0.0f;
+            started[i] |= active;
+            progress[i] = (std::max)(0.0f, (std::min)(1.0f, elapsed[i] / durations[i]));
+        }
+    }
+
+    // easing, linear tweens are left as is
+    {
+        auto easings  = _tweenEasings.data();
+        auto progress = _tweenProgress.data();
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (easings[i] != tweenfunc::Linear)
+                progress[i] = tweenfunc::tweenTo(progress[i], easings[i], nullptr);
+        }
+    }
+
+    // interpolate, one component at a time so the compiler can vectorize it
+    for (int c = 0; c < 3; ++c)
+    {
+        auto from     = _tweenFrom[c].data();
+        auto delta    = _tweenDelta[c].data();
+        auto progress = _tweenProgress.data();
+        auto values   = _tweenValues[c].data();
+        for (size_t i = 0; i < count; ++i)
+            values[i] = from[i] + delta[i] * progress[i];
+    }
+
+    // write back, the setters may add or remove tweens so the arrays are accessed by index only
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto& tweenTarget = _tweenTargets[_tweenTargetOf[i]];
+        if (tweenTarget.paused || tweenTarget.removed || _tweenRemoved[i])
+            continue;
+
+        auto node = tweenTarget.target;
+        switch (_tweenProperties[i])
+        {
+        case TweenProperty::POSITION:
+            node->setPosition(_tweenValues[0][i], _tweenValues[1][i]);
+            break;
+        case TweenProperty::SCALE:
+            node->setScale(_tweenValues[0][i], _tweenValues[1][i]);
+            break;
+        case TweenProperty::ROTATION:
+            node->setRotation(_tweenValues[0][i]);
+            break;
+        case TweenProperty::OPACITY:
+            node->setOpacity(toColorComponent(_tweenValues[0][i]));
+            break;
+        case TweenProperty::COLOR:
+            node->setColor(Color3B(toColorComponent(_tweenValues[0][i]), toColorComponent(_tweenValues[1][i]),
+                                   toColorComponent(_tweenValues[2][i])));
+            break;
+        }
+    }
+
+    // drop the finished and removed tweens, keeping the others in order,
+    // including the ones added during the write back
+    size_t last = 0;
+    for (size_t i = 0, total = _tweenElapsed.size(); i < total; ++i)
+    {
+        const auto index  = _tweenTargetOf[i];
+        auto& tweenTarget = _tweenTargets[index];
+        const bool done   = i < count && !tweenTarget.paused && _tweenElapsed[i] >= _tweenDurations[i];
+        if (done || tweenTarget.removed || _tweenRemoved[i])
+        {
+            if (--tweenTarget.tweenCount == 0)
+            {
+                if (!tweenTarget.removed)
+                    _tweenTargetIndices.erase(tweenTarget.target);
+                tweenTarget.target = nullptr;
+                _freeTweenTargets.emplace_back(index);
+            }
+            continue;
+        }
+
+        if (last != i)
+        {
+            _tweenTargetOf[last]   = index;
+            _tweenProperties[last] = _tweenProperties[i];
+            _tweenEasings[last]    = _tweenEasings[i];
+            _tweenTags[last]       = _tweenTags[i];
+            _tweenElapsed[last]    = _tweenElapsed[i];
+            _tweenDurations[last]  = _tweenDurations[i];
+            for (int c = 0; c < 3; ++c)
+            {
+                _tweenFrom[c][last]  = _tweenFrom[c][i];
+                _tweenDelta[c][last] = _tweenDelta[c][i];
+            }
+            _tweenStarted[last] = _tweenStarted[i];
+            _tweenRemoved[last] = 0;
+        }
+        ++last;
+    }
+
+    _tweenTargetOf.resize(last);
+    _tweenProperties.resize(last);
+    _tweenEasings.resize(last);
+    _tweenTags.resize(last);
+    _tweenElapsed.resize(last);
+    _tweenDurations.resize(last);
+    for (int c = 0; c < 3; ++c)
+    {
+        _tweenFrom[c].resize(last);
+        _tweenDelta[c].resize(last);
+    }
+    _tweenStarted.resize(last);
+    _tweenRemoved.resize(last);
 }
 
 }
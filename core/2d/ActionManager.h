@@ -32,8 +32,10 @@ THE SOFTWARE.
 #define __ACTION_CCACTION_MANAGER_H__
 
 #include "2d/Action.h"
+#include "2d/TweenFunction.h"
 #include "base/Vector.h"
 #include "base/Object.h"
+#include "base/axstd.h"
 
 namespace ax
 {
@@ -52,6 +54,17 @@ struct ActionHandle
  * @{
  */
 
+/** Node properties which can be animated by ActionManager::addTween, with the components of the tween values they use.
+ */
+enum class TweenProperty : uint8_t
+{
+    POSITION,  // x, y
+    SCALE,     // x, y
+    ROTATION,  // x
+    OPACITY,   // x, 0..255
+    COLOR,     // x, y, z as r, g, b, 0..255
+};
+
 /** @class ActionManager
  @brief ActionManager is a singleton that manages all the actions.
  Normally you won't need to use this singleton directly. 99% of the cases you will use the Node interface,
@@ -195,12 +208,72 @@ public:
      */
     virtual void resumeTargets(const Vector<Node*>& targetsToResume);
 
+    /** Adds a tween: a property of the target is interpolated from its current value to 'to' over 'duration'.
+     Tweens cover the simple MoveTo / ScaleTo / RotateTo / FadeTo / TintTo cases without allocating an Action,
+     they are stored in contiguous arrays and all updated in one pass, which scales to tens of thousands of them.
+     They follow the pause state of the target and are removed along with its actions by removeAllActionsFromTarget,
+     which Node calls on cleanup and destruction. The target isn't retained.
+     *
+     * @param target    The node to animate.
+     * @param property  The property to animate.
+     * @param to        The end value, see TweenProperty for the components used.
+     * @param duration  In seconds.
+     * @param easing    The easing of the interpolation, tweenfunc::CUSTOM_EASING isn't supported.
+     * @param tag       A tag for removeTweensByTag.
+     */
+    void addTween(Node* target,
+                  TweenProperty property,
+                  const Vec3& to,
+                  float duration,
+                  tweenfunc::TweenType easing = tweenfunc::Linear,
+                  int tag                      = Action::INVALID_TAG);
+    void addTween(Node* target,
+                  TweenProperty property,
+                  const Vec2& to,
+                  float duration,
+                  tweenfunc::TweenType easing = tweenfunc::Linear,
+                  int tag                      = Action::INVALID_TAG)
+    {
+        addTween(target, property, Vec3(to.x, to.y, 0.0f), duration, easing, tag);
+    }
+    void addTween(Node* target,
+                  TweenProperty property,
+                  float to,
+                  float duration,
+                  tweenfunc::TweenType easing = tweenfunc::Linear,
+                  int tag                      = Action::INVALID_TAG)
+    {
+        addTween(target, property, Vec3(to, 0.0f, 0.0f), duration, easing, tag);
+    }
+
+    /** Removes the tweens of a target with the given tag.
+     *
+     * @param tag       The tweens' tag.
+     * @param target    A certain target.
+     */
+    void removeTweensByTag(int tag, Node* target);
+
+    /** Returns the number of running tweens in all targets. */
+    size_t getNumberOfRunningTweens() const { return _tweenElapsed.size(); }
+
     /** Main loop of ActionManager.
      * @param dt    In seconds.
      */
     virtual void update(float dt);
 
 protected:
+    struct TweenTarget
+    {
+        Node* target;  // weak ref
+        uint32_t tweenCount;
+        bool paused;
+        bool removed;  // its tweens are dropped on the next update
+    };
+
+    uint32_t getTweenTargetIndex(Node* target);
+    void removeTweenTarget(Node* target);
+    void updateTweens(float dt);
+
     // declared in ActionManager.m
     void removeTargetActionHandle(std::unordered_map<Node*, ActionHandle>::iterator& actionIt);
 
@@ -216,6 +289,26 @@ protected:
     std::unordered_map<Node*, ActionHandle> _targets;
     ActionHandle* _currentTarget;
     bool _currentTargetSalvaged;
+
+    // tweens, as structure of arrays indexed by tween
+    axstd::pod_vector<TweenTarget> _tweenTargets;
+    axstd::pod_vector<uint32_t> _freeTweenTargets;
+    std::unordered_map<Node*, uint32_t> _tweenTargetIndices;
+
+    axstd::pod_vector<uint32_t> _tweenTargetOf;
+    axstd::pod_vector<TweenProperty> _tweenProperties;
+    axstd::pod_vector<tweenfunc::TweenType> _tweenEasings;
+    axstd::pod_vector<int> _tweenTags;
+    axstd::pod_vector<float> _tweenElapsed;
+    axstd::pod_vector<float> _tweenDurations;
+    axstd::pod_vector<float> _tweenFrom[3];
+    axstd::pod_vector<float> _tweenDelta[3];
+    axstd::pod_vector<uint8_t> _tweenStarted;  // like ActionInterval, the first step doesn't advance
+    axstd::pod_vector<uint8_t> _tweenRemoved;
+
+    // per update scratch
+    axstd::pod_vector<float> _tweenProgress;
+    axstd::pod_vector<float> _tweenValues[3];
 };
 
 // end of actions group
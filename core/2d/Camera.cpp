@@ -374,13 +374,18 @@ void Camera::unprojectGL(const Vec2& viewport, const Vec3* src, Vec3* dst) const
 
 #if defined(AX_ENABLE_3D)
 bool Camera::isVisibleInFrustum(const AABB* aabb) const
+{
+    return !getFrustum().isOutOfFrustum(*aabb);
+}
+
+const Frustum& Camera::getFrustum() const
 {
     if (_frustumDirty)
     {
         _frustum.initFrustum(this);
         _frustumDirty = false;
     }
-    return !_frustum.isOutOfFrustum(*aabb);
+    return _frustum;
 }
 #endif
 
@@ -199,6 +199,11 @@ public:
      * Is this aabb visible in frustum
      */
     bool isVisibleInFrustum(const AABB* aabb) const;
+
+    /**
+     * Get the frustum of the camera, updated if the camera changed.
+     */
+    const Frustum& getFrustum() const;
 #endif
 
     /**
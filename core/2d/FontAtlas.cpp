@@ -37,6 +37,8 @@
 #include "base/EventListenerCustom.h"
 #include "base/EventDispatcher.h"
 #include "base/EventType.h"
+#include "base/Scheduler.h"
+#include "base/JobSystem.h"
 
 #include "simdjson/simdjson.h"
 #include "zlib.h"
@@ -53,6 +55,9 @@ const int FontAtlas::CacheTextureHeight    = 512;
 const char* FontAtlas::CMD_PURGE_FONTATLAS = "__ax_PURGE_FONTATLAS";
 const char* FontAtlas::CMD_RESET_FONTATLAS = "__ax_RESET_FONTATLAS";
 
+bool FontAtlas::_asyncRasterizationEnabled = false;
+int FontAtlas::_glyphUploadBudget          = 32;
+
 void FontAtlas::loadFontAtlas(std::string_view fontatlasFile, hlookup::string_map<FontAtlas*>& outAtlasMap)
 {
     using namespace simdjson;
@@ -192,6 +197,9 @@ FontAtlas::~FontAtlas()
     }
 #endif
 
+    if (_fontFreeType)
+        stopAsyncRasterization();
+
     _font->release();
     releaseTextures();
 
@@ -347,122 +355,302 @@ bool FontAtlas::prepareLetterDefinitions(const std::u32string& utf32Text)
         return false;
     }
 
-    int adjustForDistanceMap = _letterPadding / 2;
-    int adjustForExtend      = _letterEdgeExtend / 2;
-    int bitmapWidth          = 0;
-    int bitmapHeight         = 0;
-    int glyphHeight;
-    Rect tempRect;
-    FontLetterDefinition tempDef;
-
-    auto pixelFormat = _pixelFormat;
+    if (_asyncRasterizationEnabled)
+    {
+        queueGlyphs(charCodeSet);
+        return false;
+    }
 
     int startY = (int)_currentPageOrigY;
 
+    GlyphBitmap glyph;
     for (auto&& charCode : charCodeSet)
     {
-        auto missingIt             = _missingGlyphFallbackFonts.find(charCode);
-        uint8_t* bitmap            = nullptr;
-        FontFreeType* charRenderer = _fontFreeType;
-        if (missingIt == _missingGlyphFallbackFonts.end())
+        glyph.charCode   = charCode;
+        glyph.renderer   = _fontFreeType;
+        glyph.glyphIndex = 0;
+        resolveGlyph(glyph);
+        addGlyph(glyph, startY);
+    }
+
+    updateTextureContent(_pixelFormat, startY);
+
+    return true;
+}
+
+void FontAtlas::prefetchCharacters(const std::u32string& utf32Text)
+{
+    prepareLetterDefinitions(utf32Text);
+}
+
+void FontAtlas::prefetchCharacters(std::string_view utf8Text)
+{
+    std::u32string utf32Text;
+    if (StringUtils::UTF8ToUTF32(utf8Text, utf32Text))
+        prepareLetterDefinitions(utf32Text);
+}
+
+bool FontAtlas::hasPendingGlyphs(const std::u32string& utf32Text) const
+{
+    if (_pendingGlyphs.empty())
+        return false;
+    for (auto&& charCode : utf32Text)
+        if (isGlyphPending(charCode))
+            return true;
+    return false;
+}
+
+void FontAtlas::resolveGlyph(GlyphBitmap& glyph)
+{
+    auto missingIt = _missingGlyphFallbackFonts.find(glyph.charCode);
+    if (missingIt != _missingGlyphFallbackFonts.end())
+    {  // found fallback font for missing charas, getGlyphBitmap without fallback
+        glyph.renderer   = missingIt->second.first;
+        glyph.glyphIndex = missingIt->second.second;
+        rasterizeGlyph(glyph, nullptr);
+        return;
+    }
+
+    FontFaceInfo* fallbackFaceInfo = nullptr;
+    if (rasterizeGlyph(glyph, &fallbackFaceInfo) || !fallbackFaceInfo)
+        return;
+
+    FontFreeType* charRenderer = nullptr;
+    auto fallbackIt            = _missingFallbackFonts.find(fallbackFaceInfo->family);
+    if (fallbackIt != _missingFallbackFonts.end())
+    {
+        charRenderer = fallbackIt->second;
+    }
+    else
+    {
+        charRenderer = FontFreeType::createWithFaceInfo(fallbackFaceInfo, _fontFreeType);
+        if (charRenderer)
+            _missingFallbackFonts.insert(fallbackFaceInfo->family, charRenderer);
+    }
+
+    if (charRenderer)
+    {
+        glyph.renderer   = charRenderer;
+        glyph.glyphIndex = fallbackFaceInfo->currentGlyphIndex;
+        rasterizeGlyph(glyph, nullptr);
+        _missingGlyphFallbackFonts.emplace(glyph.charCode, std::make_pair(charRenderer, glyph.glyphIndex));
+    }
+}
+
+bool FontAtlas::rasterizeGlyph(GlyphBitmap& glyph, FontFaceInfo** ppFallbackInfo)
+{
+    auto renderer = glyph.renderer;
+    std::lock_guard<std::recursive_mutex> lock(renderer->getFaceMutex());
+
+    uint8_t* bitmap = nullptr;
+    if (renderer == _fontFreeType)
+        bitmap = renderer->getGlyphBitmap(glyph.charCode, glyph.width, glyph.height, glyph.rect, glyph.xAdvance,
+                                          ppFallbackInfo);
+    else
+        bitmap = renderer->getGlyphBitmapByIndex(glyph.glyphIndex, glyph.width, glyph.height, glyph.rect,
+                                                 glyph.xAdvance);
+
+    glyph.pixels.clear();
+    if (bitmap && glyph.width > 0 && glyph.height > 0)
+    {
+        // copy it out of the face glyph slot, outline bitmaps are blended into a new two channels image
+        const bool outline = renderer->getOutlineSize() > 0;
+        glyph.pixels.assign(bitmap, bitmap + (glyph.width * glyph.height << (outline ? 1 : 0)));
+        if (outline)
+            delete[] bitmap;
+    }
+    return !glyph.pixels.empty();
+}
+
+void FontAtlas::addGlyph(const GlyphBitmap& glyph, int& startY)
+{
+    int adjustForDistanceMap = _letterPadding / 2;
+    int adjustForExtend      = _letterEdgeExtend / 2;
+    FontLetterDefinition tempDef;
+    tempDef.xAdvance = glyph.xAdvance;
+
+    if (!glyph.pixels.empty())
+    {
+        auto& tempRect          = glyph.rect;
+        tempDef.validDefinition = true;
+        tempDef.width           = tempRect.size.width + _letterPadding + _letterEdgeExtend;
+        tempDef.height          = tempRect.size.height + _letterPadding + _letterEdgeExtend;
+        tempDef.offsetX         = tempRect.origin.x - adjustForDistanceMap - adjustForExtend;
+        tempDef.offsetY         = _fontAscender + tempRect.origin.y - adjustForDistanceMap - adjustForExtend;
+
+        if (_currentPageOrigX + tempDef.width > _width)
         {
-            FontFaceInfo* fallbackFaceInfo = nullptr;
-            bitmap = charRenderer->getGlyphBitmap(charCode, bitmapWidth, bitmapHeight, tempRect, tempDef.xAdvance,
-                                                  &fallbackFaceInfo);
-            if (!bitmap && fallbackFaceInfo)
+            _currentPageOrigY += _currLineHeight;
+            _currLineHeight   = 0;
+            _currentPageOrigX = 0;
+            if (_currentPageOrigY + _lineHeight + _letterPadding + _letterEdgeExtend >= _height)
             {
-                auto fallbackIt = _missingFallbackFonts.find(fallbackFaceInfo->family);
-                if (fallbackIt != _missingFallbackFonts.end())
-                {
-                    charRenderer = fallbackIt->second;
-                }
-                else
-                {
-                    charRenderer = FontFreeType::createWithFaceInfo(fallbackFaceInfo, _fontFreeType);
-                    if (charRenderer)
-                        _missingFallbackFonts.insert(fallbackFaceInfo->family, charRenderer);
-                }
-
-                if (charRenderer)
-                {
-                    unsigned int glyphIndex = fallbackFaceInfo->currentGlyphIndex;
-                    bitmap =
-                        charRenderer->getGlyphBitmapByIndex(glyphIndex, bitmapWidth, bitmapHeight, tempRect, tempDef.xAdvance);
-                    _missingGlyphFallbackFonts.emplace(charCode, std::make_pair(charRenderer, glyphIndex));
-                }
+                updateTextureContent(_pixelFormat, startY);
+
+                startY = 0;
+
+                addNewPage();
             }
         }
-        else
-        {  // found fallback font for missing charas, getGlyphBitmap without fallback
-            charRenderer = missingIt->second.first;
-            unsigned int glyphIndex = missingIt->second.second;
-            bitmap = charRenderer->getGlyphBitmapByIndex(glyphIndex, bitmapWidth, bitmapHeight, tempRect, tempDef.xAdvance);
-        }
-        if (bitmap && bitmapWidth > 0 && bitmapHeight > 0)
+        int glyphHeight = glyph.height + _letterPadding + _letterEdgeExtend;
+        if (glyphHeight > _currLineHeight)
         {
-            tempDef.validDefinition = true;
-            tempDef.width           = tempRect.size.width + _letterPadding + _letterEdgeExtend;
-            tempDef.height          = tempRect.size.height + _letterPadding + _letterEdgeExtend;
-            tempDef.offsetX         = tempRect.origin.x - adjustForDistanceMap - adjustForExtend;
-            tempDef.offsetY         = _fontAscender + tempRect.origin.y - adjustForDistanceMap - adjustForExtend;
+            _currLineHeight = glyphHeight;
+        }
 
-            if (_currentPageOrigX + tempDef.width > _width)
-            {
-                _currentPageOrigY += _currLineHeight;
-                _currLineHeight   = 0;
-                _currentPageOrigX = 0;
-                if (_currentPageOrigY + _lineHeight + _letterPadding + _letterEdgeExtend >= _height)
-                {
-                    updateTextureContent(pixelFormat, startY);
+        // same as FontFreeType::renderCharAt, without taking the bitmap ownership
+        const int posX    = (int)_currentPageOrigX + adjustForExtend;
+        const int posY    = (int)_currentPageOrigY + adjustForExtend;
+        const int rowSize = glyph.width << _strideShift;
+        for (int y = 0; y < glyph.height; ++y)
+            memcpy(_currentPageData + ((posX + (posY + y) * _width) << _strideShift), glyph.pixels.data() + y * rowSize,
+                   rowSize);
+
+        tempDef.U         = _currentPageOrigX;
+        tempDef.V         = _currentPageOrigY;
+        tempDef.textureID = _currentPage;
+        _currentPageOrigX += tempDef.width + 1;
+        // take from pixels to points
+        tempDef.width   = tempDef.width / _scaleFactor;
+        tempDef.height  = tempDef.height / _scaleFactor;
+        tempDef.U       = tempDef.U / _scaleFactor;
+        tempDef.V       = tempDef.V / _scaleFactor;
+        tempDef.rotated = false;
+    }
+    else
+    {
+        tempDef.validDefinition = !!tempDef.xAdvance;
+        tempDef.width           = 0;
+        tempDef.height          = 0;
+        tempDef.U               = 0;
+        tempDef.V               = 0;
+        tempDef.offsetX         = 0;
+        tempDef.offsetY         = 0;
+        tempDef.textureID       = 0;
+        tempDef.rotated         = false;
+        _currentPageOrigX += 1;
+    }
 
-                    startY = 0;
+    _letterDefinitions[glyph.charCode] = tempDef;
+}
 
-                    addNewPage();
-                }
-            }
-            glyphHeight = static_cast<int>(bitmapHeight) + _letterPadding + _letterEdgeExtend;
-            if (glyphHeight > _currLineHeight)
-            {
-                _currLineHeight = glyphHeight;
-            }
-            charRenderer->renderCharAt(_currentPageData, (int)_currentPageOrigX + adjustForExtend,
-                                       (int)_currentPageOrigY + adjustForExtend, bitmap, bitmapWidth, bitmapHeight,
-                                        _width, _height);
-
-            tempDef.U         = _currentPageOrigX;
-            tempDef.V         = _currentPageOrigY;
-            tempDef.textureID = _currentPage;
-            _currentPageOrigX += tempDef.width + 1;
-            // take from pixels to points
-            tempDef.width   = tempDef.width / _scaleFactor;
-            tempDef.height  = tempDef.height / _scaleFactor;
-            tempDef.U       = tempDef.U / _scaleFactor;
-            tempDef.V       = tempDef.V / _scaleFactor;
-            tempDef.rotated = false;
+void FontAtlas::queueGlyphs(const std::unordered_set<char32_t>& charCodeSet)
+{
+    std::unique_lock<std::mutex> lock(_asyncMutex);
+    for (auto&& charCode : charCodeSet)
+    {
+        if (!_pendingGlyphs.emplace(charCode).second)
+            continue;
+
+        auto& glyph    = _rasterQueue.emplace_back();
+        glyph.charCode = charCode;
+        glyph.renderer = _fontFreeType;
+
+        // the fallback fonts maps are main thread only, resolve known fallbacks here
+        auto missingIt = _missingGlyphFallbackFonts.find(charCode);
+        if (missingIt != _missingGlyphFallbackFonts.end())
+        {
+            glyph.renderer   = missingIt->second.first;
+            glyph.glyphIndex = missingIt->second.second;
         }
+    }
+
+    if (!_rasterizing && !_rasterQueue.empty())
+    {
+        _rasterizing = true;
+        Director::getInstance()->getJobSystem()->enqueue([this] { rasterizeQueuedGlyphs(); });
+    }
+    lock.unlock();
+
+    if (!_uploadScheduled)
+    {
+        _uploadScheduled = true;
+        Director::getInstance()->getScheduler()->schedule(AX_CALLBACK_1(FontAtlas::uploadRasterizedGlyphs, this),
+                                                          this, 0, false, "__ax_fontatlas_upload"sv);
+    }
+}
+
+void FontAtlas::rasterizeQueuedGlyphs()
+{
+    auto fontEngine = FontFreeType::getFontEngine();
+
+    std::unique_lock<std::mutex> lock(_asyncMutex);
+    while (!_rasterQueue.empty() && !_rasterCancelled)
+    {
+        auto glyph = std::move(_rasterQueue.front());
+        _rasterQueue.pop_front();
+        lock.unlock();
+
+        // font engines aren't thread safe, glyphs missing in the face go back to the main thread
+        if (glyph.renderer == _fontFreeType && fontEngine && !_fontFreeType->getGlyphIndex(glyph.charCode))
+            glyph.needsFallback = true;
         else
+            rasterizeGlyph(glyph, nullptr);
+
+        lock.lock();
+        _rasterizedGlyphs.emplace_back(std::move(glyph));
+    }
+    _rasterizing = false;
+    _asyncCondition.notify_all();
+}
+
+void FontAtlas::uploadRasterizedGlyphs(float /*dt*/)
+{
+    std::vector<GlyphBitmap> glyphs;
+    bool idle;
+    {
+        std::lock_guard<std::mutex> lock(_asyncMutex);
+        auto count = (std::min)(_rasterizedGlyphs.size(), static_cast<size_t>((std::max)(_glyphUploadBudget, 1)));
+        glyphs.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            glyphs.emplace_back(std::move(_rasterizedGlyphs.front()));
+            _rasterizedGlyphs.pop_front();
+        }
+        idle = !_rasterizing && _rasterizedGlyphs.empty();
+    }
+
+    if (!glyphs.empty())
+    {
+        if (!_currentPageData)
+            reinit();
+
+        int startY = (int)_currentPageOrigY;
+        for (auto&& glyph : glyphs)
         {
-            if (bitmap)
-                delete[] bitmap;
-
-            tempDef.validDefinition = !!tempDef.xAdvance;
-            tempDef.width           = 0;
-            tempDef.height          = 0;
-            tempDef.U               = 0;
-            tempDef.V               = 0;
-            tempDef.offsetX         = 0;
-            tempDef.offsetY         = 0;
-            tempDef.textureID       = 0;
-            tempDef.rotated         = false;
-            _currentPageOrigX += 1;
+            if (glyph.needsFallback)
+                resolveGlyph(glyph);
+            addGlyph(glyph, startY);
+            _pendingGlyphs.erase(glyph.charCode);
         }
+        updateTextureContent(_pixelFormat, startY);
 
-        _letterDefinitions[charCode] = tempDef;
+        // let labels waiting for these glyphs refresh
+        ++_glyphGeneration;
     }
 
-    updateTextureContent(pixelFormat, startY);
+    if (idle)
+    {
+        _uploadScheduled = false;
+        Director::getInstance()->getScheduler()->unschedule("__ax_fontatlas_upload"sv, this);
+    }
+}
 
-    return true;
+void FontAtlas::stopAsyncRasterization()
+{
+    if (_uploadScheduled)
+    {
+        _uploadScheduled = false;
+        Director::getInstance()->getScheduler()->unschedule("__ax_fontatlas_upload"sv, this);
+    }
+
+    // the job only uses the fonts, wait for the glyph it's rasterizing before they are released
+    std::unique_lock<std::mutex> lock(_asyncMutex);
+    _rasterCancelled = true;
+    _asyncCondition.wait(lock, [this] { return !_rasterizing; });
+    _rasterQueue.clear();
+    _rasterizedGlyphs.clear();
+    _pendingGlyphs.clear();
 }
 
 void FontAtlas::updateTextureContent(backend::PixelFormat format, int startY)
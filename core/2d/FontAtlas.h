@@ -32,6 +32,11 @@
 
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
 
 #include "platform/PlatformMacros.h"
 #include "base/Object.h"
@@ -85,8 +90,42 @@ public:
     void addLetterDefinition(char32_t utf32Char, const FontLetterDefinition& letterDefinition);
     bool getLetterDefinitionForChar(char32_t utf32Char, FontLetterDefinition& letterDefinition);
 
+    /**
+     * Rasterizes the characters of the text which aren't in the atlas yet.
+     * When async rasterization is enabled they are queued instead, see setAsyncRasterizationEnabled.
+     * @return true if new letter definitions were added.
+     */
     bool prepareLetterDefinitions(const std::u32string& utf16String);
 
+    /**
+     * Adds a character set to the atlas ahead of time, i.e. the characters of a localization table
+     * while loading, new pages are added as needed.
+     * When async rasterization is enabled the characters are rasterized by job threads and land
+     * over the next frames, otherwise they are rasterized at once.
+     */
+    void prefetchCharacters(const std::u32string& utf32Text);
+    void prefetchCharacters(std::string_view utf8Text);
+
+    /**
+     * Rasterizes missing glyphs of dynamic ttf atlases on job threads instead of the main thread,
+     * by default: disabled.
+     * Labels lay out queued characters as missing ones until their glyphs land, then refresh.
+     */
+    static void setAsyncRasterizationEnabled(bool enabled) { _asyncRasterizationEnabled = enabled; }
+    static bool isAsyncRasterizationEnabled() { return _asyncRasterizationEnabled; }
+
+    /** The maximum count of async rasterized glyphs added to an atlas per frame, by default: 32. */
+    static void setGlyphUploadBudget(int glyphsPerFrame) { _glyphUploadBudget = glyphsPerFrame; }
+    static int getGlyphUploadBudget() { return _glyphUploadBudget; }
+
+    /** Whether some characters of the text are queued for async rasterization. */
+    bool hasPendingGlyphs(const std::u32string& utf32Text) const;
+    bool hasPendingGlyphs() const { return !_pendingGlyphs.empty(); }
+    bool isGlyphPending(char32_t utf32Char) const { return _pendingGlyphs.find(utf32Char) != _pendingGlyphs.end(); }
+
+    /** Increased each time async rasterized glyphs were added to the atlas. */
+    unsigned int getGlyphGeneration() const { return _glyphGeneration; }
+
     const auto& getLetterDefinitions() const { return _letterDefinitions; }
 
     const std::unordered_map<unsigned int, Texture2D*>& getTextures() const { return _atlasTextures; }
@@ -147,6 +186,31 @@ protected:
 
     void updateTextureContent(backend::PixelFormat format, int startY);
 
+    struct GlyphBitmap
+    {
+        char32_t charCode       = 0;
+        FontFreeType* renderer  = nullptr;
+        unsigned int glyphIndex = 0;  // used when the renderer is a fallback font
+        int width               = 0;
+        int height              = 0;
+        int xAdvance            = 0;
+        Rect rect;
+        std::vector<uint8_t> pixels;
+        bool needsFallback = false;  // missing in the font face, the fallback font is resolved on the main thread
+    };
+
+    /** Rasterizes a glyph, resolving fallback fonts for missing glyphs, main thread only. */
+    void resolveGlyph(GlyphBitmap& glyph);
+    /** Rasterizes a glyph with its renderer into glyph.pixels, safe on job threads. */
+    bool rasterizeGlyph(GlyphBitmap& glyph, FontFaceInfo** ppFallbackInfo);
+    /** Packs a rasterized glyph into the current page and adds its letter definition. */
+    void addGlyph(const GlyphBitmap& glyph, int& startY);
+
+    void queueGlyphs(const std::unordered_set<char32_t>& charCodeSet);
+    void rasterizeQueuedGlyphs();
+    void uploadRasterizedGlyphs(float dt);
+    void stopAsyncRasterization();
+
     std::unordered_map<unsigned int, Texture2D*> _atlasTextures;
     std::unordered_map<char32_t, FontLetterDefinition> _letterDefinitions;
 
@@ -179,6 +243,21 @@ protected:
     bool _antialiasEnabled                          = true;
     int _currLineHeight                             = 0;
 
+    // async rasterization, the queues are guarded by _asyncMutex
+    static bool _asyncRasterizationEnabled;
+    static int _glyphUploadBudget;
+
+    std::mutex _asyncMutex;
+    std::condition_variable _asyncCondition;
+    std::deque<GlyphBitmap> _rasterQueue;
+    std::deque<GlyphBitmap> _rasterizedGlyphs;
+    bool _rasterizing     = false;
+    bool _rasterCancelled = false;
+
+    std::unordered_set<char32_t> _pendingGlyphs;  // main thread only
+    unsigned int _glyphGeneration = 0;
+    bool _uploadScheduled         = false;
+
     friend class Label;
 };
 
@@ -64,7 +64,7 @@ constexpr std::string_view _glyphNEHE =
 
 typedef struct _DataRef
 {
-    Data data;
+    std::shared_ptr<FileMapping> data;
     unsigned int referenceCount = 0;
 } DataRef;
 
@@ -128,6 +128,11 @@ void FontFreeType::setFontEngine(IFontEngine* fe)
     s_FontEngine = fe;
 }
 
+IFontEngine* FontFreeType::getFontEngine()
+{
+    return s_FontEngine;
+}
+
 FontFreeType* FontFreeType::create(std::string_view fontName,
                                    int faceSize,
                                    GlyphCollection glyphs,
@@ -270,14 +275,15 @@ bool FontFreeType::initWithFontPath(std::string_view fontPath, int faceSize)
         }
         else
         {
+            // FreeType parses the font straight from the mapped file
             sharableData       = &s_cacheFontData[fontPath];
-            sharableData->data = FileUtils::getInstance()->getDataFromFile(fontPath);
+            sharableData->data = FileUtils::getInstance()->mapFile(fontPath);
         }
 
         ++sharableData->referenceCount;
         auto& data = sharableData->data;
-        if (data.isNull() ||
-            FT_New_Memory_Face(getFTLibrary(), data.getBytes(), static_cast<FT_Long>(data.getSize()), 0, &face))
+        if (!data || data->empty() ||
+            FT_New_Memory_Face(getFTLibrary(), data->data(), static_cast<FT_Long>(data->size()), 0, &face))
             return false;
     }
 
@@ -369,6 +375,8 @@ int* FontFreeType::getHorizontalKerningForTextUTF32(const std::u32string& text,
     if (!outNumLetters)
         return nullptr;
 
+    std::lock_guard<std::recursive_mutex> lock(_faceMutex);
+
     int* sizes = new int[outNumLetters];
     memset(sizes, 0, outNumLetters * sizeof(int));
 
@@ -406,6 +414,15 @@ int FontFreeType::getHorizontalKerningForChars(uint64_t firstChar, uint64_t seco
     return (static_cast<int>(kerning.x >> 6));
 }
 
+unsigned int FontFreeType::getGlyphIndex(char32_t charCode) const
+{
+    if (!_fontFace)
+        return 0;
+
+    std::lock_guard<std::recursive_mutex> lock(_faceMutex);
+    return FT_Get_Char_Index(_fontFace, static_cast<FT_ULong>(charCode));
+}
+
 int FontFreeType::getFontAscender() const
 {
     return _ascender >> 6;
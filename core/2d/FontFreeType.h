@@ -29,6 +29,7 @@
 #include "2d/Font.h"
 #include "2d/IFontEngine.h"
 #include <string>
+#include <mutex>
 
 namespace ax
 {
@@ -52,6 +53,7 @@ public:
      * @since axmol-2.1.3
      */
     static void setFontEngine(IFontEngine*);
+    static IFontEngine* getFontEngine();
 
     /**
      * @remark: if you want enable stream parsing, you need do one of follow steps
@@ -131,6 +133,15 @@ public:
                                          Rect& outRect,
                                          int& xAdvance);
 
+    /** The glyph index of a character in the font face, 0 if it's missing. */
+    unsigned int getGlyphIndex(char32_t charCode) const;
+
+    /**
+     * Guards the font face against the job threads of FontAtlas async rasterization.
+     * Glyph bitmaps which point into the face glyph slot are only valid while it's held.
+     */
+    std::recursive_mutex& getFaceMutex() const { return _faceMutex; }
+
     int getFontAscender() const;
     const char* getFontFamily() const;
     std::string_view getFontName() const { return _fontName; }
@@ -169,6 +180,7 @@ private:
     FT_Face _fontFace;
     FT_Stream _fontStream;
     FT_Stroker _stroker;
+    mutable std::recursive_mutex _faceMutex;
 
     std::string _fontName;
     int _faceSize;
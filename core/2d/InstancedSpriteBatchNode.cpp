@@ -0,0 +1,411 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "2d/InstancedSpriteBatchNode.h"
+#include "base/Director.h"
+#include "renderer/Renderer.h"
+#include "renderer/Texture2D.h"
+#include "renderer/TextureCache.h"
+#include "renderer/backend/DriverBase.h"
+#include "renderer/backend/ProgramStateRegistry.h"
+
+namespace ax
+{
+
+InstancedSpriteBatchNode* InstancedSpriteBatchNode::createWithTexture(Texture2D* tex, int capacity)
+{
+    InstancedSpriteBatchNode* batchNode = new InstancedSpriteBatchNode();
+    if (batchNode->initWithTexture(tex, capacity))
+    {
+        batchNode->autorelease();
+        return batchNode;
+    }
+
+    delete batchNode;
+    return nullptr;
+}
+
+InstancedSpriteBatchNode* InstancedSpriteBatchNode::create(std::string_view fileImage, int capacity)
+{
+    InstancedSpriteBatchNode* batchNode = new InstancedSpriteBatchNode();
+    if (batchNode->initWithFile(fileImage, capacity))
+    {
+        batchNode->autorelease();
+        return batchNode;
+    }
+
+    delete batchNode;
+    return nullptr;
+}
+
+InstancedSpriteBatchNode::InstancedSpriteBatchNode() {}
+
+InstancedSpriteBatchNode::~InstancedSpriteBatchNode()
+{
+    AX_SAFE_RELEASE(_instanceBuffer);
+    AX_SAFE_RELEASE(_texture);
+}
+
+bool InstancedSpriteBatchNode::initWithTexture(Texture2D* tex, int capacity)
+{
+    if (tex == nullptr)
+    {
+        return false;
+    }
+
+    AXASSERT(capacity >= 0, "Capacity must be >= 0");
+
+    if (capacity <= 0)
+    {
+        capacity = DEFAULT_CAPACITY;
+    }
+
+    _texture = tex;
+    _texture->retain();
+
+    _instances.reserve(capacity);
+    _instanceData.reserve(capacity);
+    _instanceCapacity = capacity;
+
+    initQuadBuffers();
+
+    setProgramStateWithRegistry(backend::ProgramType::POSITION_TEXTURE_COLOR_INSTANCE, tex);
+
+    updateBlendFunc();
+
+    return true;
+}
+
+bool InstancedSpriteBatchNode::initWithFile(std::string_view fileImage, int capacity)
+{
+    Texture2D* texture2D = _director->getTextureCache()->addImage(fileImage);
+    return initWithTexture(texture2D, capacity);
+}
+
+void InstancedSpriteBatchNode::initQuadBuffers()
+{
+    // unit quad corners, the vertex shader scales them by the instance axes
+    static const Vec2 corners[4] = {Vec2(0.0f, 0.0f), Vec2(1.0f, 0.0f), Vec2(0.0f, 1.0f), Vec2(1.0f, 1.0f)};
+    static const uint16_t indices[6] = {0, 1, 2, 2, 1, 3};
+
+    _customCommand.setDrawType(CustomCommand::DrawType::ELEMENT_INSTANCE);
+    _customCommand.setPrimitiveType(CustomCommand::PrimitiveType::TRIANGLE);
+
+    _customCommand.createVertexBuffer(sizeof(Vec2), 4, CustomCommand::BufferUsage::STATIC);
+    _customCommand.updateVertexBuffer(corners, sizeof(corners));
+
+    _customCommand.createIndexBuffer(CustomCommand::IndexFormat::U_SHORT, 6, CustomCommand::BufferUsage::STATIC);
+    _customCommand.updateIndexBuffer(indices, sizeof(indices));
+    _customCommand.setIndexDrawInfo(0, 6);
+}
+
+bool InstancedSpriteBatchNode::setProgramState(backend::ProgramState* programState, bool ownPS /* = false*/)
+{
+    AXASSERT(programState, "programState should not be nullptr");
+    if (Node::setProgramState(programState, ownPS))
+    {
+        auto& pipelineDescriptor        = _customCommand.getPipelineDescriptor();
+        pipelineDescriptor.programState = _programState;
+
+        _programState->validateSharedVertexLayout(backend::VertexLayoutType::Pos);
+        updateProgramStateTexture(_texture);
+        _mvpMatrixLocation = _programState->getUniformLocation("u_MVPMatrix");
+        return true;
+    }
+    return false;
+}
+
+int InstancedSpriteBatchNode::addInstance(const Rect& rect,
+                                          const Vec2& position,
+                                          float rotation,
+                                          const Vec2& scale,
+                                          const Color4B& color)
+{
+    int index = static_cast<int>(_instances.size());
+    _instances.emplace_back(Instance{rect, position, rotation, scale, color});
+    _instanceData.emplace_back();
+    packInstance(index);
+    markDirty(index);
+    return index;
+}
+
+void InstancedSpriteBatchNode::removeInstance(int index)
+{
+    AXASSERT(index >= 0 && index < getInstanceCount(), "Invalid instance index");
+
+    int last = getInstanceCount() - 1;
+    if (index != last)
+    {
+        _instances[index]    = _instances[last];
+        _instanceData[index] = _instanceData[last];
+        markDirty(index);
+    }
+    _instances.pop_back();
+    _instanceData.pop_back();
+
+    // nothing past the new end needs to be uploaded
+    _dirtyEnd = std::min(_dirtyEnd, last);
+    if (_dirtyBegin >= _dirtyEnd)
+        _dirtyBegin = _dirtyEnd = 0;
+}
+
+void InstancedSpriteBatchNode::removeAllInstances()
+{
+    _instances.clear();
+    _instanceData.clear();
+    _dirtyBegin = _dirtyEnd = 0;
+}
+
+void InstancedSpriteBatchNode::setInstanceTransform(int index, const Vec2& position, float rotation, const Vec2& scale)
+{
+    AXASSERT(index >= 0 && index < getInstanceCount(), "Invalid instance index");
+
+    auto& instance    = _instances[index];
+    instance.position = position;
+    instance.rotation = rotation;
+    instance.scale    = scale;
+    packTransform(instance, _instanceData[index]);
+    markDirty(index);
+}
+
+void InstancedSpriteBatchNode::setInstancePosition(int index, const Vec2& position)
+{
+    AXASSERT(index >= 0 && index < getInstanceCount(), "Invalid instance index");
+
+    auto& instance    = _instances[index];
+    instance.position = position;
+    packTransform(instance, _instanceData[index]);
+    markDirty(index);
+}
+
+void InstancedSpriteBatchNode::setInstanceColor(int index, const Color4B& color)
+{
+    AXASSERT(index >= 0 && index < getInstanceCount(), "Invalid instance index");
+
+    auto& instance = _instances[index];
+    instance.color = color;
+    packColor(instance, _instanceData[index]);
+    markDirty(index);
+}
+
+void InstancedSpriteBatchNode::setInstanceTextureRect(int index, const Rect& rect)
+{
+    AXASSERT(index >= 0 && index < getInstanceCount(), "Invalid instance index");
+
+    auto& instance = _instances[index];
+    instance.rect  = rect;
+    // the quad size follows the rect
+    packTransform(instance, _instanceData[index]);
+    packTextureRect(instance, _instanceData[index]);
+    markDirty(index);
+}
+
+void InstancedSpriteBatchNode::setInstanceAnchorPoint(const Vec2& anchor)
+{
+    if (_instanceAnchor.equals(anchor))
+        return;
+
+    _instanceAnchor = anchor;
+    for (int i = 0, count = getInstanceCount(); i < count; ++i)
+        packTransform(_instances[i], _instanceData[i]);
+    if (!_instances.empty())
+    {
+        _dirtyBegin = 0;
+        _dirtyEnd   = getInstanceCount();
+    }
+}
+
+void InstancedSpriteBatchNode::markDirty(int index)
+{
+    if (_dirtyBegin == _dirtyEnd)
+    {
+        _dirtyBegin = index;
+        _dirtyEnd   = index + 1;
+    }
+    else
+    {
+        _dirtyBegin = std::min(_dirtyBegin, index);
+        _dirtyEnd   = std::max(_dirtyEnd, index + 1);
+    }
+}
+
+void InstancedSpriteBatchNode::packInstance(int index)
+{
+    auto& instance = _instances[index];
+    auto& data     = _instanceData[index];
+    packTransform(instance, data);
+    packTextureRect(instance, data);
+    packColor(instance, data);
+}
+
+void InstancedSpriteBatchNode::packTransform(const Instance& instance, InstanceData& data) const
+{
+    // rotation is clockwise like Node::setRotation
+    const float radians = -AX_DEGREES_TO_RADIANS(instance.rotation);
+    const float c       = std::cos(radians);
+    const float s       = std::sin(radians);
+    const float w       = instance.rect.size.width * instance.scale.x;
+    const float h       = instance.rect.size.height * instance.scale.y;
+
+    const Vec2 axisX(c * w, s * w);
+    const Vec2 axisY(-s * h, c * h);
+
+    data.axes[0] = axisX.x;
+    data.axes[1] = axisX.y;
+    data.axes[2] = axisY.x;
+    data.axes[3] = axisY.y;
+
+    data.translation[0] = instance.position.x - axisX.x * _instanceAnchor.x - axisY.x * _instanceAnchor.y;
+    data.translation[1] = instance.position.y - axisX.y * _instanceAnchor.x - axisY.y * _instanceAnchor.y;
+    data.translation[2] = 0.0f;
+    data.translation[3] = 1.0f;
+}
+
+void InstancedSpriteBatchNode::packTextureRect(const Instance& instance, InstanceData& data) const
+{
+    const float pixelsWide = static_cast<float>(_texture->getPixelsWide());
+    const float pixelsHigh = static_cast<float>(_texture->getPixelsHigh());
+    if (pixelsWide <= 0.0f || pixelsHigh <= 0.0f)
+    {
+        std::fill(std::begin(data.uv), std::end(data.uv), 0.0f);
+        return;
+    }
+
+    const Rect rect = AX_RECT_POINTS_TO_PIXELS(instance.rect);
+    data.uv[0]      = rect.origin.x / pixelsWide;
+    data.uv[1]      = rect.origin.y / pixelsHigh;
+    data.uv[2]      = (rect.origin.x + rect.size.width) / pixelsWide;
+    data.uv[3]      = (rect.origin.y + rect.size.height) / pixelsHigh;
+}
+
+void InstancedSpriteBatchNode::packColor(const Instance& instance, InstanceData& data) const
+{
+    Color4F color(instance.color);
+    if (_texture->hasPremultipliedAlpha())
+    {
+        color.r *= color.a;
+        color.g *= color.a;
+        color.b *= color.a;
+    }
+    data.color[0] = color.r;
+    data.color[1] = color.g;
+    data.color[2] = color.b;
+    data.color[3] = color.a;
+}
+
+void InstancedSpriteBatchNode::updateInstanceBuffer()
+{
+    const int count = getInstanceCount();
+    if (!_instanceBuffer || count > _instanceCapacity)
+    {
+        // grow by 33% like SpriteBatchNode, the whole buffer is uploaded once
+        if (count > _instanceCapacity)
+            _instanceCapacity = std::max(count, (_instanceCapacity + 1) * 4 / 3);
+
+        AX_SAFE_RELEASE(_instanceBuffer);
+        _instanceBuffer = backend::DriverBase::getInstance()->newBuffer(
+            _instanceCapacity * sizeof(InstanceData), backend::BufferType::VERTEX, backend::BufferUsage::DYNAMIC);
+
+        // allocate the whole store with the live instances in front, the padding is never drawn
+        _instanceData.resize(_instanceCapacity);
+        _instanceBuffer->updateData(_instanceData.data(), _instanceCapacity * sizeof(InstanceData));
+        _instanceData.resize(count);
+
+        _dirtyBegin = _dirtyEnd = 0;
+    }
+
+    if (_dirtyBegin < _dirtyEnd)
+    {
+        _instanceBuffer->updateSubData(_instanceData.data() + _dirtyBegin, _dirtyBegin * sizeof(InstanceData),
+                                       (_dirtyEnd - _dirtyBegin) * sizeof(InstanceData));
+        _dirtyBegin = _dirtyEnd = 0;
+    }
+}
+
+void InstancedSpriteBatchNode::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
+{
+    if (_instances.empty())
+    {
+        return;
+    }
+
+    updateInstanceBuffer();
+
+    const auto& matrixProjection = _director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+    Mat4 matrixMVP               = matrixProjection * transform;
+    _programState->setUniform(_mvpMatrixLocation, matrixMVP.m, sizeof(matrixMVP.m));
+
+    _customCommand.setInstanceBuffer(_instanceBuffer, getInstanceCount());
+    _customCommand.init(_globalZOrder, _blendFunc);
+    renderer->addCommand(&_customCommand);
+}
+
+Texture2D* InstancedSpriteBatchNode::getTexture() const
+{
+    return _texture;
+}
+
+void InstancedSpriteBatchNode::setTexture(Texture2D* texture)
+{
+    if (_texture == texture)
+        return;
+
+    AX_SAFE_RETAIN(texture);
+    AX_SAFE_RELEASE(_texture);
+    _texture = texture;
+
+    if (_texture)
+    {
+        updateProgramStateTexture(_texture);
+        updateBlendFunc();
+
+        // uv rects and premultiplied colors depend on the texture
+        for (int i = 0, count = getInstanceCount(); i < count; ++i)
+            packInstance(i);
+        if (!_instances.empty())
+        {
+            _dirtyBegin = 0;
+            _dirtyEnd   = getInstanceCount();
+        }
+    }
+}
+
+void InstancedSpriteBatchNode::setBlendFunc(const BlendFunc& blendFunc)
+{
+    _blendFunc = blendFunc;
+}
+
+const BlendFunc& InstancedSpriteBatchNode::getBlendFunc() const
+{
+    return _blendFunc;
+}
+
+void InstancedSpriteBatchNode::updateBlendFunc()
+{
+    if (!_texture->hasPremultipliedAlpha())
+        _blendFunc = BlendFunc::ALPHA_NON_PREMULTIPLIED;
+    else
+        _blendFunc = BlendFunc::ALPHA_PREMULTIPLIED;
+}
+
+}  // namespace ax
@@ -0,0 +1,180 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <vector>
+
+#include "2d/Node.h"
+#include "base/Protocols.h"
+#include "renderer/CustomCommand.h"
+
+namespace ax
+{
+
+/**
+ * @addtogroup _2d
+ * @{
+ */
+
+class Texture2D;
+
+/** InstancedSpriteBatchNode draws many textured quads from one texture with a single instanced draw call.
+ *
+ * Unlike SpriteBatchNode it has no Sprite children: each quad is a lightweight instance described by its texture
+ * rect, position, rotation, scale and color in node space. Only the packed per-instance data (a 2x2 transform,
+ * translation, uv rect and color, 64 bytes) is uploaded, and only for instances modified since the last frame; the
+ * quad corners are expanded on the GPU, so no per-vertex work is done on the CPU.
+ *
+ * Limitations:
+ *  - Instance colors are used as-is, they are not cascaded from the node color/opacity.
+ *  - Requires hardware instancing (GLES2 needs GL_EXT_instanced_arrays or equivalent).
+ */
+class AX_DLL InstancedSpriteBatchNode : public Node, public TextureProtocol
+{
+    static const int DEFAULT_CAPACITY = 29;
+
+public:
+    /** Creates an InstancedSpriteBatchNode with a texture2d and an initial capacity of instances.
+     *
+     * @param tex A texture2d.
+     * @param capacity The initial capacity of instances, the instance buffer grows on demand.
+     * @return Return an autorelease object.
+     */
+    static InstancedSpriteBatchNode* createWithTexture(Texture2D* tex, int capacity = DEFAULT_CAPACITY);
+
+    /** Creates an InstancedSpriteBatchNode with a file image (.png, .jpeg, .pvr, etc) and an initial capacity.
+     *
+     * @param fileImage A file image (.png, .jpeg, .pvr, etc).
+     * @param capacity The initial capacity of instances.
+     * @return Return an autorelease object.
+     */
+    static InstancedSpriteBatchNode* create(std::string_view fileImage, int capacity = DEFAULT_CAPACITY);
+
+    /** Adds an instance.
+     *
+     * @param rect The texture rect in points, the instance is drawn with the same size.
+     * @param position The position of the instance anchor in node space.
+     * @param rotation Clockwise rotation in degrees.
+     * @param scale The scale of the instance.
+     * @param color The color of the instance.
+     * @return The index of the new instance.
+     */
+    int addInstance(const Rect& rect,
+                    const Vec2& position,
+                    float rotation       = 0.0f,
+                    const Vec2& scale    = Vec2::ONE,
+                    const Color4B& color = Color4B::WHITE);
+
+    /** Removes an instance, the last instance is moved into the freed index. */
+    void removeInstance(int index);
+
+    /** Removes all instances, the instance buffer is kept. */
+    void removeAllInstances();
+
+    int getInstanceCount() const { return static_cast<int>(_instances.size()); }
+
+    void setInstanceTransform(int index, const Vec2& position, float rotation, const Vec2& scale);
+    void setInstancePosition(int index, const Vec2& position);
+    void setInstanceColor(int index, const Color4B& color);
+    void setInstanceTextureRect(int index, const Rect& rect);
+
+    const Vec2& getInstancePosition(int index) const { return _instances[index].position; }
+    float getInstanceRotation(int index) const { return _instances[index].rotation; }
+    const Vec2& getInstanceScale(int index) const { return _instances[index].scale; }
+    const Color4B& getInstanceColor(int index) const { return _instances[index].color; }
+    const Rect& getInstanceTextureRect(int index) const { return _instances[index].rect; }
+
+    /** Sets the anchor point shared by all instances, default is (0.5, 0.5). */
+    void setInstanceAnchorPoint(const Vec2& anchor);
+    const Vec2& getInstanceAnchorPoint() const { return _instanceAnchor; }
+
+    // Overrides
+    virtual Texture2D* getTexture() const override;
+    virtual void setTexture(Texture2D* texture) override;
+    virtual void setBlendFunc(const BlendFunc& blendFunc) override;
+    virtual const BlendFunc& getBlendFunc() const override;
+    virtual void draw(Renderer* renderer, const Mat4& transform, uint32_t flags) override;
+    virtual bool setProgramState(backend::ProgramState* programState, bool ownPS = false) override;
+
+    InstancedSpriteBatchNode();
+    virtual ~InstancedSpriteBatchNode();
+
+    bool initWithTexture(Texture2D* tex, int capacity = DEFAULT_CAPACITY);
+    bool initWithFile(std::string_view fileImage, int capacity = DEFAULT_CAPACITY);
+
+protected:
+    struct Instance
+    {
+        Rect rect;
+        Vec2 position;
+        float rotation;
+        Vec2 scale;
+        Color4B color;
+    };
+
+    // Matches the mat4 a_instance attribute of spriteInstance_vert, one column per member
+    struct InstanceData
+    {
+        float axes[4];         // x axis (xy) and y axis (zw) of the quad
+        float translation[4];  // bottom-left corner, z, unused
+        float uv[4];           // left, top, right, bottom
+        float color[4];
+    };
+    static_assert(sizeof(InstanceData) == 64, "InstanceData must match the mat4 instance stride");
+
+    void updateBlendFunc();
+    void initQuadBuffers();
+    void updateInstanceBuffer();
+    void markDirty(int index);
+    void packInstance(int index);
+    void packTransform(const Instance& instance, InstanceData& data) const;
+    void packTextureRect(const Instance& instance, InstanceData& data) const;
+    void packColor(const Instance& instance, InstanceData& data) const;
+
+    Texture2D* _texture = nullptr;
+    BlendFunc _blendFunc;
+    CustomCommand _customCommand;
+
+    backend::Buffer* _instanceBuffer = nullptr;
+    int _instanceCapacity            = 0;
+
+    std::vector<Instance> _instances;
+    std::vector<InstanceData> _instanceData;
+
+    // [_dirtyBegin, _dirtyEnd) of _instanceData not uploaded yet
+    int _dirtyBegin = 0;
+    int _dirtyEnd   = 0;
+
+    Vec2 _instanceAnchor{0.5f, 0.5f};
+
+    backend::UniformLocation _mvpMatrixLocation;
+
+private:
+    AX_DISALLOW_COPY_AND_ASSIGN(InstancedSpriteBatchNode);
+};
+
+// end of _2d group
+/// @}
+
+}  // namespace ax
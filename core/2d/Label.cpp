@@ -196,6 +196,8 @@ private:
     bool _letterVisible;
 };
 
+bool Label::_batchedRenderingEnabled = false;
+
 Label::BatchCommand::BatchCommand()
 {
     textCommand.setDrawType(CustomCommand::DrawType::ELEMENT);
@@ -586,6 +588,7 @@ void Label::reset()
     _batchNodes.clear();
     _batchCommands.clear();
     _lettersInfo.clear();
+    _linesLayout.clear();
     if (_fontAtlas)
     {
         FontAtlasCache::releaseFontAtlas(_fontAtlas);
@@ -595,6 +598,7 @@ void Label::reset()
     _currentLabelType = LabelType::STRING_TEXTURE;
     _currLabelEffect  = LabelEffect::NORMAL;
     _contentDirty     = false;
+    _textDirty        = false;
     _numberOfLines    = 0;
     _lengthOfString   = 0;
     _utf32Text.clear();
@@ -938,13 +942,21 @@ void Label::setString(std::string_view text)
 {
     if (text.compare(_utf8Text))
     {
-        _utf8Text     = text;
-        _contentDirty = true;
+        _utf8Text = text;
 
         std::u32string utf32String;
         if (StringUtils::UTF8ToUTF32(_utf8Text, utf32String))
         {
-            _utf32Text = utf32String;
+            // the letters before the first changed one keep their layout, see alignTextIncremental
+            auto mismatch = std::mismatch(_utf32Text.begin(), _utf32Text.end(), utf32String.begin(), utf32String.end());
+            auto firstChanged = static_cast<int>(mismatch.first - _utf32Text.begin());
+            _textDirtyFrom = _textDirty ? (std::min)(_textDirtyFrom, firstChanged) : firstChanged;
+            _textDirty     = true;
+            _utf32Text     = std::move(utf32String);
+        }
+        else
+        {
+            _contentDirty = true;
         }
     }
 }
@@ -1082,6 +1094,7 @@ void Label::updateLabelLetters()
 
 bool Label::alignText()
 {
+    _linesLayout.clear();
     if (_fontAtlas == nullptr || _utf32Text.empty())
     {
         setContentSize(Vec2::ZERO);
@@ -1092,6 +1105,8 @@ bool Label::alignText()
     do
     {
         _fontAtlas->prepareLetterDefinitions(_utf32Text);
+        _waitingForGlyphs    = _fontAtlas->hasPendingGlyphs(_utf32Text);
+        _fontAtlasGeneration = _fontAtlas->getGlyphGeneration();
         auto& textures = _fontAtlas->getTextures();
         auto size      = textures.size();
         if (size > static_cast<size_t>(_batchNodes.size()))
@@ -1179,6 +1194,113 @@ bool Label::computeHorizontalKernings(const std::u32string& stringToRender)
         return true;
 }
 
+bool Label::alignTextIncremental()
+{
+    if (!_incrementalLayoutEnabled || _linesLayout.empty() || _utf32Text.empty() || _overflow != Overflow::NONE ||
+        !_letters.empty() || _batchNodes.empty())
+        return false;
+
+    const int firstChanged = _textDirtyFrom;
+    const int textLen      = static_cast<int>(_utf32Text.length());
+
+    // new letters which need a new atlas page go through the full layout
+    _fontAtlas->prepareLetterDefinitions(_utf32Text.substr((std::min)(firstChanged, textLen)));
+    if (_fontAtlas->getTextures().size() > static_cast<size_t>(_batchNodes.size()))
+        return false;
+    _waitingForGlyphs    = _fontAtlas->hasPendingGlyphs(_utf32Text);
+    _fontAtlasGeneration = _fontAtlas->getGlyphGeneration();
+
+    // resume from the line of the first changed letter, or the one before when wrapping since
+    // the changed word may now fit in it
+    int startLine = static_cast<int>(_linesLayout.size()) - 1;
+    while (startLine > 0 && _linesLayout[startLine].startIndex > firstChanged)
+        --startLine;
+    if (startLine > 0 && _enableWrap && _maxLineWidth > 0.f)
+        --startLine;
+    const int firstLetter = _linesLayout[startLine].startIndex;
+
+    // the quads of the letters before are kept, they are inserted in the letters order per page
+    std::vector<size_t> keptQuads(_batchNodes.size(), 0);
+    size_t pagesFound = 0;
+    for (int ctr = (std::min)(firstLetter, _lengthOfString) - 1; ctr >= 0 && pagesFound < keptQuads.size(); --ctr)
+    {
+        auto& letterInfo = _lettersInfo[ctr];
+        if (!letterInfo.valid || letterInfo.atlasIndex < 0)
+            continue;
+        auto textureID = _fontAtlas->_letterDefinitions[letterInfo.utf32Char].textureID;
+        if (!keptQuads[textureID])
+        {
+            keptQuads[textureID] = letterInfo.atlasIndex + 1;
+            ++pagesFound;
+        }
+    }
+
+    auto linesOffsetX    = std::move(_linesOffsetX);
+    auto letterOffsetY   = _letterOffsetY;
+    auto tailoredTopY    = _tailoredTopY;
+    auto tailoredBottomY = _tailoredBottomY;
+
+    updateHorizontalKernings(firstChanged);
+
+    _lengthOfString = 0;
+    if (_maxLineWidth > 0.f && !_lineBreakWithoutSpaces)
+        multilineTextWrap(AX_CALLBACK_3(Label::getFirstWordLen, this), startLine);
+    else
+        multilineTextWrap(AX_CALLBACK_3(Label::getFirstCharLen, this), startLine);
+    computeAlignmentOffset();
+
+    // the kept quads are still in place unless the alignment or the clipping of their lines moved
+    bool keepQuads = letterOffsetY == _letterOffsetY && linesOffsetX.size() >= static_cast<size_t>(startLine) &&
+                     std::equal(linesOffsetX.begin(), linesOffsetX.begin() + startLine, _linesOffsetX.begin());
+    if (keepQuads && _labelHeight > 0.f)
+        keepQuads = tailoredTopY == _tailoredTopY && tailoredBottomY == _tailoredBottomY;
+
+    if (keepQuads)
+    {
+        for (size_t i = 0; i < keptQuads.size(); ++i)
+        {
+            auto textureAtlas = _batchNodes.at(i)->getTextureAtlas();
+            auto total        = textureAtlas->getTotalQuads();
+            if (total > keptQuads[i])
+                textureAtlas->removeQuadsAtIndex(keptQuads[i], total - keptQuads[i]);
+        }
+        appendQuads(firstLetter);
+        updateQuadsColor(keptQuads);
+    }
+    else
+    {
+        updateQuads();
+        updateColor();
+    }
+
+    return true;
+}
+
+void Label::updateHorizontalKernings(int firstChanged)
+{
+    // the kerning of a letter depends on its neighbours, refresh the ones from the letter before the change
+    auto oldKernings = _horizontalKernings;
+    int kept         = firstChanged - 1;
+    if (!oldKernings || kept < 1)
+    {
+        computeHorizontalKernings(_utf32Text);
+        return;
+    }
+
+    int letterCount = 0;
+    auto kernings   = _fontAtlas->getFont()->getHorizontalKerningForTextUTF32(_utf32Text.substr(kept - 1), letterCount);
+
+    _horizontalKernings = new int[_utf32Text.length()];
+    memcpy(_horizontalKernings, oldKernings, kept * sizeof(int));
+    if (kernings)
+        memcpy(_horizontalKernings + kept, kernings + 1, (letterCount - 1) * sizeof(int));
+    else
+        memset(_horizontalKernings + kept, 0, (_utf32Text.length() - kept) * sizeof(int));
+
+    delete[] kernings;
+    delete[] oldKernings;
+}
+
 bool Label::isHorizontalClamped(float letterPositionX, int lineIndex)
 {
     auto wordWidth       = this->_linesWidth[lineIndex];
@@ -1195,13 +1317,18 @@ bool Label::isHorizontalClamped(float letterPositionX, int lineIndex)
 
 bool Label::updateQuads()
 {
-    bool ret = true;
     for (auto&& batchNode : _batchNodes)
     {
         batchNode->getTextureAtlas()->removeAllQuads();
     }
 
-    for (int ctr = 0; ctr < _lengthOfString; ++ctr)
+    return appendQuads(0);
+}
+
+bool Label::appendQuads(int firstLetter)
+{
+    bool ret = true;
+    for (int ctr = firstLetter; ctr < _lengthOfString; ++ctr)
     {
         if (_lettersInfo[ctr].valid)
         {
@@ -1439,7 +1566,7 @@ void Label::enableShadow(const Color4B& shadowColor /* = Color4B::BLACK */,
     _shadowColor3B.b = shadowColor.b;
     _shadowOpacity   = shadowColor.a;
 
-    if (!_systemFontDirty && !_contentDirty && _textSprite)
+    if (!_systemFontDirty && !_contentDirty && !_textDirty && _textSprite)
     {
         auto fontDef = _getFontDefinition();
         if (_shadowNode)
@@ -1690,14 +1817,17 @@ void Label::updateContent()
 
     if (_fontAtlas)
     {
-        std::u32string utf32String;
-        if (StringUtils::UTF8ToUTF32(_utf8Text, utf32String))
+        if (!_textDirty || _contentDirty || !alignTextIncremental())
         {
-            _utf32Text = utf32String;
-        }
+            std::u32string utf32String;
+            if (StringUtils::UTF8ToUTF32(_utf8Text, utf32String))
+            {
+                _utf32Text = utf32String;
+            }
 
-        computeHorizontalKernings(_utf32Text);
-        updateFinished = alignText();
+            computeHorizontalKernings(_utf32Text);
+            updateFinished = alignText();
+        }
     }
     else
     {
@@ -1752,6 +1882,7 @@ void Label::updateContent()
     if (updateFinished)
     {
         _contentDirty = false;
+        _textDirty    = false;
     }
 
 #if AX_LABEL_DEBUG_DRAW
@@ -1805,19 +1936,50 @@ void Label::updateBuffer(TextureAtlas* textureAtlas, CustomCommand& customComman
     customCommand.setIndexDrawInfo(0, (unsigned int)(textureAtlas->getTotalQuads() * 6));
 }
 
+void Label::submitBatchCommand(BatchCommand& batch,
+                               CustomCommand& command,
+                               TrianglesCommand& triangles,
+                               TextureAtlas* textureAtlas,
+                               Renderer* renderer,
+                               const Mat4& transform,
+                               uint32_t flags)
+{
+    if (batch.batched)
+    {
+        // the material id of the command includes the uniforms, labels with the same colors and effect merge
+        auto programState                               = command.getPipelineDescriptor().programState;
+        triangles.getPipelineDescriptor().programState = programState;
+        programState->updateBatchId();
+
+        auto quadCount = static_cast<unsigned int>(textureAtlas->getTotalQuads());
+        TrianglesCommand::Triangles trianglesData(reinterpret_cast<V3F_C4B_T2F*>(textureAtlas->getQuads()),
+                                                  textureAtlas->getIndices(), quadCount * 4, quadCount * 6);
+        triangles.init(_globalZOrder, textureAtlas->getTexture(), _blendFunc, trianglesData, transform, flags);
+        renderer->addCommand(&triangles);
+    }
+    else
+    {
+        command.init(_globalZOrder);
+        renderer->addCommand(&command);
+    }
+}
+
 void Label::updateEffectUniforms(BatchCommand& batch,
                                  TextureAtlas* textureAtlas,
                                  Renderer* renderer,
-                                 const Mat4& transform)
+                                 const Mat4& transform,
+                                 uint32_t flags)
 {
-    updateBuffer(textureAtlas, batch.textCommand);
+    if (!batch.batched)
+        updateBuffer(textureAtlas, batch.textCommand);
 
     auto& matrixProjection = _director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
 
     if (_shadowEnabled)
     {
-        updateBuffer(textureAtlas, batch.shadowCommand);
-        auto shadowMatrix = matrixProjection * _shadowTransform;
+        if (!batch.batched)
+            updateBuffer(textureAtlas, batch.shadowCommand);
+        auto shadowMatrix = batch.batched ? matrixProjection : matrixProjection * _shadowTransform;
         batch.shadowCommand.getPipelineDescriptor().programState->setUniform(_mvpMatrixLocation, shadowMatrix.m,
                                                                              sizeof(shadowMatrix.m));
     }
@@ -1838,8 +2000,8 @@ void Label::updateEffectUniforms(BatchCommand& batch,
                 auto* programStateShadow = batch.shadowCommand.getPipelineDescriptor().programState;
                 programStateShadow->setUniform(_effectColorLocation, &shadowColor, sizeof(Vec4));
                 programStateShadow->setUniform(_effectTypeLocation, &effectType, sizeof(effectType));
-                batch.shadowCommand.init(_globalZOrder);
-                renderer->addCommand(&batch.shadowCommand);
+                submitBatchCommand(batch, batch.shadowCommand, batch.shadowTriangles, textureAtlas, renderer,
+                                   _shadowTransform, flags);
             }
 
             if (_useDistanceField)
@@ -1853,12 +2015,13 @@ void Label::updateEffectUniforms(BatchCommand& batch,
                 // draw outline
                 {
                     effectType = 1;
-                    updateBuffer(textureAtlas, batch.outLineCommand);
+                    if (!batch.batched)
+                        updateBuffer(textureAtlas, batch.outLineCommand);
                     auto* programStateOutline = batch.outLineCommand.getPipelineDescriptor().programState;
                     programStateOutline->setUniform(_effectColorLocation, &effectColor, sizeof(Vec4));
                     programStateOutline->setUniform(_effectTypeLocation, &effectType, sizeof(effectType));
-                    batch.outLineCommand.init(_globalZOrder);
-                    renderer->addCommand(&batch.outLineCommand);
+                    submitBatchCommand(batch, batch.outLineCommand, batch.outLineTriangles, textureAtlas, renderer,
+                                       transform, flags);
                 }
 
                 // draw text
@@ -1879,8 +2042,8 @@ void Label::updateEffectUniforms(BatchCommand& batch,
                 Vec4 shadowColor         = Vec4(_shadowColor4F.r, _shadowColor4F.g, _shadowColor4F.b, _shadowColor4F.a);
                 auto* programStateShadow = batch.shadowCommand.getPipelineDescriptor().programState;
                 programStateShadow->setUniform(_textColorLocation, &shadowColor, sizeof(Vec4));
-                batch.shadowCommand.init(_globalZOrder);
-                renderer->addCommand(&batch.shadowCommand);
+                submitBatchCommand(batch, batch.shadowCommand, batch.shadowTriangles, textureAtlas, renderer,
+                                   _shadowTransform, flags);
             }
         }
         break;
@@ -1893,8 +2056,8 @@ void Label::updateEffectUniforms(BatchCommand& batch,
                 auto* programStateShadow = batch.shadowCommand.getPipelineDescriptor().programState;
                 programStateShadow->setUniform(_textColorLocation, &shadowColor, sizeof(Vec4));
                 programStateShadow->setUniform(_effectColorLocation, &shadowColor, sizeof(Vec4));
-                batch.shadowCommand.init(_globalZOrder);
-                renderer->addCommand(&batch.shadowCommand);
+                submitBatchCommand(batch, batch.shadowCommand, batch.shadowTriangles, textureAtlas, renderer,
+                                   _shadowTransform, flags);
             }
 
             Vec4 effectColor(_effectColorF.r, _effectColorF.g, _effectColorF.b, _effectColorF.a);
@@ -1924,8 +2087,7 @@ void Label::updateEffectUniforms(BatchCommand& batch,
         }
     }
 
-    batch.textCommand.init(_globalZOrder);
-    renderer->addCommand(&batch.textCommand);
+    submitBatchCommand(batch, batch.textCommand, batch.textTriangles, textureAtlas, renderer, transform, flags);
 }
 
 void Label::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
@@ -1999,6 +2161,11 @@ void Label::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
                     continue;
 
                 auto& batch = _batchCommands[i++];
+                // batched vertices are transformed by the renderer, the shaders only apply the projection
+                batch.batched = _batchedRenderingEnabled && _currentLabelType == LabelType::TTF &&
+                                textureAtlas->getTotalQuads() * 4 < Renderer::VBO_SIZE;
+                auto& matrixText = batch.batched ? matrixProjection : matrixMVP;
+
                 for (auto&& command : batch.getCommandArray())
                 {
                     auto* programState = command->getPipelineDescriptor().programState;
@@ -2006,11 +2173,11 @@ void Label::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
                     programState->setUniform(_textColorLocation, &textColor, sizeof(Vec4));
                     programState->setTexture(textureAtlas->getTexture()->getBackendTexture());
                 }
-                batch.textCommand.getPipelineDescriptor().programState->setUniform(_mvpMatrixLocation, matrixMVP.m,
-                                                                                   sizeof(matrixMVP.m));
-                batch.outLineCommand.getPipelineDescriptor().programState->setUniform(_mvpMatrixLocation, matrixMVP.m,
-                                                                                      sizeof(matrixMVP.m));
-                updateEffectUniforms(batch, textureAtlas, renderer, transform);
+                batch.textCommand.getPipelineDescriptor().programState->setUniform(_mvpMatrixLocation, matrixText.m,
+                                                                                   sizeof(matrixText.m));
+                batch.outLineCommand.getPipelineDescriptor().programState->setUniform(_mvpMatrixLocation, matrixText.m,
+                                                                                      sizeof(matrixText.m));
+                updateEffectUniforms(batch, textureAtlas, renderer, transform, flags);
             }
         }
     }
@@ -2037,7 +2204,12 @@ void Label::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t pare
         return;
     }
 
-    if (_systemFontDirty || _contentDirty)
+    if (_waitingForGlyphs && _fontAtlas && _fontAtlas->getGlyphGeneration() != _fontAtlasGeneration)
+    {
+        _contentDirty = true;
+    }
+
+    if (_systemFontDirty || _contentDirty || _textDirty)
     {
         // Label overflow shrink fix #566
         if (_overflow == Overflow::SHRINK && this->getRenderingFontSize() < _originalFontSize)
@@ -2158,7 +2330,7 @@ Sprite* Label::getLetter(int letterIndex)
             break;
         }
 
-        auto contentDirty = _contentDirty;
+        auto contentDirty = _contentDirty || _textDirty;
         if (contentDirty)
         {
             updateContent();
@@ -2293,7 +2465,7 @@ void Label::computeStringNumLines()
 
 int Label::getStringNumLines()
 {
-    if (_contentDirty)
+    if (_contentDirty || _textDirty)
     {
         updateContent();
     }
@@ -2392,6 +2564,11 @@ void Label::setTextColor(const Color4B& color)
 }
 
 void Label::updateColor()
+{
+    updateQuadsColor({});
+}
+
+void Label::updateQuadsColor(const std::vector<size_t>& firstQuads)
 {
     if (_batchNodes.empty())
     {
@@ -2410,13 +2587,13 @@ void Label::updateColor()
 
     ax::TextureAtlas* textureAtlas;
     V3F_C4B_T2F_Quad* quads;
-    for (auto&& batchNode : _batchNodes)
+    for (size_t i = 0; i < static_cast<size_t>(_batchNodes.size()); ++i)
     {
-        textureAtlas = batchNode->getTextureAtlas();
+        textureAtlas = _batchNodes.at(i)->getTextureAtlas();
         quads        = textureAtlas->getQuads();
         auto count   = textureAtlas->getTotalQuads();
 
-        for (int index = 0; index < count; ++index)
+        for (size_t index = i < firstQuads.size() ? firstQuads[i] : 0; index < count; ++index)
         {
             quads[index].bl.colors = color4;
             quads[index].br.colors = color4;
@@ -2439,7 +2616,7 @@ std::string Label::getDescription() const
 
 const Vec2& Label::getContentSize() const
 {
-    if (_systemFontDirty || _contentDirty)
+    if (_systemFontDirty || _contentDirty || _textDirty)
     {
         const_cast<Label*>(this)->updateContent();
     }
@@ -2771,7 +2948,7 @@ void Label::updateFontScale()
     }
 }
 
-bool Label::multilineTextWrap(const std::function<int(const std::u32string&, int, int)>& nextTokenLen)
+bool Label::multilineTextWrap(const std::function<int(const std::u32string&, int, int)>& nextTokenLen, int startLine)
 {
     int textLen               = getStringLength();
     int lineIndex             = 0;
@@ -2789,10 +2966,26 @@ bool Label::multilineTextWrap(const std::function<int(const std::u32string&, int
     FontLetterDefinition letterDef;
     Vec2 letterPosition;
     bool nextChangeSize = true;
+    int index           = 0;
+
+    if (startLine > 0)
+    {  // resume from the start of a line of the previous layout
+        auto& line          = _linesLayout[startLine];
+        lineIndex           = startLine;
+        index               = line.startIndex;
+        nextTokenY          = line.nextTokenY;
+        highestY            = line.highestY;
+        lowestY             = line.lowestY;
+        nextWhitespaceWidth = line.whitespaceWidth;
+        nextChangeSize      = line.nextChangeSize;
+    }
+    _linesWidth.resize(startLine);
+    _linesLayout.resize(startLine);
+    _linesLayout.push_back({index, nextTokenY, highestY, lowestY, nextWhitespaceWidth, nextChangeSize});
 
     this->updateFontScale();
 
-    for (int index = 0; index < textLen;)
+    while (index < textLen)
     {
         char32_t character = _utf32Text[index];
         if (character == StringUtils::UnicodeCharacters::NewLine)
@@ -2804,6 +2997,7 @@ bool Label::multilineTextWrap(const std::function<int(const std::u32string&, int
             nextTokenY -= _lineHeight * _fontScale + lineSpacing;
             recordPlaceholderInfo(index, character);
             index++;
+            _linesLayout.push_back({index, nextTokenY, highestY, lowestY, nextWhitespaceWidth, nextChangeSize});
             continue;
         }
 
@@ -2835,8 +3029,9 @@ bool Label::multilineTextWrap(const std::function<int(const std::u32string&, int
             if (!getFontLetterDef(character, letterDef))
             {
                 recordPlaceholderInfo(letterIndex, character);
-                AXLOGW("LabelTextFormatter error: can't find letter definition in font file for letter: 0x{:x}",
-                      static_cast<uint32_t>(character));
+                if (!_waitingForGlyphs || !_fontAtlas->isGlyphPending(character))
+                    AXLOGW("LabelTextFormatter error: can't find letter definition in font file for letter: 0x{:x}",
+                           static_cast<uint32_t>(character));
                 continue;
             }
 
@@ -2852,6 +3047,7 @@ bool Label::multilineTextWrap(const std::function<int(const std::u32string&, int
                 nextTokenX = 0.f;
                 nextTokenY -= (_lineHeight * _fontScale + lineSpacing);
                 newLine = true;
+                _linesLayout.push_back({index, nextTokenY, highestY, lowestY, nextWhitespaceWidth, nextChangeSize});
                 break;
             }
             else
@@ -403,6 +403,25 @@ public:
     /** Return the text the Label is currently displaying.*/
     virtual std::string_view getString() const override { return _utf8Text; }
 
+    /**
+     * Lays out only the lines from the first changed letter when just the text changed since the last
+     * layout, i.e. appending to a log or updating a counter, the quads of the lines before are kept.
+     * It applies to atlas labels with Overflow::NONE whose letters weren't got by getLetter,
+     * other labels are laid out as a whole. By default: disabled.
+     */
+    void setIncrementalLayoutEnabled(bool enabled) { _incrementalLayoutEnabled = enabled; }
+    bool isIncrementalLayoutEnabled() const { return _incrementalLayoutEnabled; }
+
+    /**
+     * Draws the pages of ttf labels with triangles commands instead of custom commands, their vertices are
+     * transformed on the cpu and the renderer merges the consecutive ones which share the atlas texture,
+     * the program and the uniforms (text and effect colors) into one draw call.
+     * Enable Renderer::setTrianglesReorderEnabled too to merge the outline and shadow passes of labels
+     * which don't overlap. By default: disabled.
+     */
+    static void setBatchedRenderingEnabled(bool enabled) { _batchedRenderingEnabled = enabled; }
+    static bool isBatchedRenderingEnabled() { return _batchedRenderingEnabled; }
+
     /**
      * Return the number of lines of text.
      */
@@ -746,6 +765,17 @@ protected:
         int lineIndex;
     };
 
+    // the wrap state at the start of a line, an incremental layout resumes from it
+    struct LineLayout
+    {
+        int startIndex;
+        float nextTokenY;
+        float highestY;
+        float lowestY;
+        float whitespaceWidth;
+        bool nextChangeSize;
+    };
+
     struct BatchCommand
     {
         BatchCommand();
@@ -763,6 +793,12 @@ protected:
         CustomCommand textCommand;
         CustomCommand outLineCommand;
         CustomCommand shadowCommand;
+
+        // used instead of the custom commands when batched, they share their program states
+        TrianglesCommand textTriangles;
+        TrianglesCommand outLineTriangles;
+        TrianglesCommand shadowTriangles;
+        bool batched = false;
     };
 
     virtual void setFontAtlas(FontAtlas* atlas, bool distanceFieldEnabled = false, bool useA8Shader = false);
@@ -774,7 +810,7 @@ protected:
 
     bool multilineTextWrapByChar();
     bool multilineTextWrapByWord();
-    bool multilineTextWrap(const std::function<int(const std::u32string&, int, int)>& lambda);
+    bool multilineTextWrap(const std::function<int(const std::u32string&, int, int)>& lambda, int startLine = 0);
     void shrinkLabelToContentSize(const std::function<bool(void)>& lambda);
     bool isHorizontalClamp();
     bool isVerticalClamp();
@@ -782,13 +818,17 @@ protected:
 
     void updateLabelLetters();
     virtual bool alignText();
+    bool alignTextIncremental();
     void computeAlignmentOffset();
     bool computeHorizontalKernings(const std::u32string& stringToRender);
+    void updateHorizontalKernings(int firstChanged);
 
     void recordLetterInfo(const ax::Vec2& point, char32_t utf32Char, int letterIndex, int lineIndex);
     void recordPlaceholderInfo(int letterIndex, char32_t utf16Char);
 
     bool updateQuads();
+    bool appendQuads(int firstLetter);
+    void updateQuadsColor(const std::vector<size_t>& firstQuads);
 
     void createSpriteForSystemFont(const FontDefinition& fontDef);
     void createShadowSpriteForSystemFont(const FontDefinition& fontDef);
@@ -821,12 +861,26 @@ protected:
     void updateEffectUniforms(BatchCommand& batch,
                               TextureAtlas* textureAtlas,
                               Renderer* renderer,
-                              const Mat4& transform);
+                              const Mat4& transform,
+                              uint32_t flags);
+    void submitBatchCommand(BatchCommand& batch,
+                            CustomCommand& command,
+                            TrianglesCommand& triangles,
+                            TextureAtlas* textureAtlas,
+                            Renderer* renderer,
+                            const Mat4& transform,
+                            uint32_t flags);
     void updateBuffer(TextureAtlas* textureAtlas, CustomCommand& customCommand);
 
     void updateBatchCommand(BatchCommand& batch);
 
     bool _contentDirty;
+    //! only the text changed since the last layout, from the letter _textDirtyFrom
+    bool _textDirty                = false;
+    int _textDirtyFrom             = 0;
+    bool _incrementalLayoutEnabled = false;
+
+    static bool _batchedRenderingEnabled;
     bool _useDistanceField;
     bool _useA8Shader;
     bool _shadowDirty;
@@ -894,6 +948,9 @@ protected:
     Sprite* _shadowNode;
     int* _horizontalKernings;
     FontAtlas* _fontAtlas;
+    //! the atlas glyph generation of the last layout, refreshed while some glyphs are rasterized async
+    unsigned int _fontAtlasGeneration = 0;
+    bool _waitingForGlyphs            = false;
     //! used for optimization
     Sprite* _reusedLetter;
     DrawNode* _underlineNode;
@@ -917,6 +974,7 @@ protected:
 
     Vector<SpriteBatchNode*> _batchNodes;
     std::vector<LetterInfo> _lettersInfo;
+    std::vector<LineLayout> _linesLayout;
 
     std::vector<float> _linesWidth;
     std::vector<float> _linesOffsetX;
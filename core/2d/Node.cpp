@@ -44,6 +44,7 @@ THE SOFTWARE.
 #include "2d/Scene.h"
 #include "2d/Component.h"
 #include "renderer/Material.h"
+#include "renderer/Renderer.h"
 #include "math/TransformUtils.h"
 #include "renderer/backend/ProgramManager.h"
 #include "renderer/backend/ProgramStateRegistry.h"
@@ -120,6 +121,7 @@ Node::Node()
     , _cascadeColorEnabled(false)
     , _cascadeOpacityEnabled(false)
     , _childFollowCameraMask(false)
+    , _parallelVisitRoot(false)
     , _cameraMask(1)
     , _onEnterCallback(nullptr)
     , _onExitCallback(nullptr)
@@ -1269,6 +1271,12 @@ bool Node::isVisitableByVisitingCamera() const
     return visibleByCamera;
 }
 
+static inline void visitChild(Node* child, Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags)
+{
+    if (!child->isParallelVisitRoot() || !renderer->deferParallelVisit(child, parentTransform, parentFlags))
+        child->visit(renderer, parentTransform, parentFlags);
+}
+
 void Node::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags)
 {
     // quick return if not visible. children won't be drawn.
@@ -1298,7 +1306,7 @@ void Node::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t paren
             auto node = _children.at(i);
 
             if (node && node->_localZOrder < 0)
-                node->visit(renderer, _modelViewTransform, flags);
+                visitChild(node, renderer, _modelViewTransform, flags);
             else
                 break;
         }
@@ -1307,7 +1315,7 @@ void Node::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t paren
             this->draw(renderer, _modelViewTransform, flags);
 
         for (auto it = _children.cbegin() + i, itCend = _children.cend(); it != itCend; ++it)
-            (*it)->visit(renderer, _modelViewTransform, flags);
+            visitChild(*it, renderer, _modelViewTransform, flags);
     }
     else if (visibleByCamera)
     {
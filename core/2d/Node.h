@@ -1829,6 +1829,16 @@ public:
      */
     void applyMaskOnEnter(bool applyChildren);
 
+    /**
+     * Marks this node as the root of a subtree which can be visited on a worker thread, see
+     * `Renderer::setParallelVisitEnabled`. Nodes of the subtree must not push render groups or touch GPU resources
+     * while visiting, e.g. ClippingNode, RenderTexture or a Label whose content is dirty.
+     * @param value true if the subtree can be visited in parallel.
+     */
+    void setParallelVisitRoot(bool value) { _parallelVisitRoot = value; }
+    /** Gets whether the subtree of this node can be visited on a worker thread. */
+    bool isParallelVisitRoot() const { return _parallelVisitRoot; }
+
     virtual void setProgramState(uint32_t programType) { setProgramStateWithRegistry(programType, nullptr); }
     void setProgramStateWithRegistry(uint32_t programType, Texture2D* texture);
 
@@ -2001,6 +2011,7 @@ protected:
     bool _normalizedPositionDirty;
 
     bool _childFollowCameraMask;
+    bool _parallelVisitRoot;  ///< whether the subtree can be visited on a worker thread
     // camera mask, it is visible only when _cameraMask & current camera' camera flag is true
     unsigned short _cameraMask;
 
@@ -0,0 +1,135 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+// Scalar particle update kernels, also used for the tails of the SIMD kernels.
+// Included by ParticleSystem.cpp, and by the unit tests to compare them with the SIMD kernels.
+
+inline void normalize_point(float x, float y, particle_point* out)
+{
+    float n = x * x + y * y;
+    // Already normalized.
+    if (n == 1.0f)
+        return;
+
+    n = sqrt(n);
+    // Too close to zero.
+    if (n < MATH_TOLERANCE)
+        return;
+
+    n      = 1.0f / n;
+    out->x = x * n;
+    out->y = y * n;
+}
+
+struct ParticleKernelsC
+{
+    // timeToLive -= dt, returns the index of the first dead particle or count if all alive
+    static int updateLife(float* timeToLive, int count, float dt)
+    {
+        int firstDead = count;
+        for (int i = 0; i < count; ++i)
+        {
+            timeToLive[i] -= dt;
+            if (timeToLive[i] <= 0.0f && firstDead == count)
+                firstDead = i;
+        }
+        return firstDead;
+    }
+
+    // value = min(value + dt, limit)
+    static void advanceClamped(float* value, const float* limit, int count, float dt)
+    {
+        for (int i = 0; i < count; ++i)
+            value[i] = MIN(value[i] + dt, limit[i]);
+    }
+
+    // value += delta * dt
+    static void integrate(float* value, const float* delta, int count, float dt)
+    {
+        for (int i = 0; i < count; ++i)
+            value[i] += delta[i] * dt;
+    }
+
+    // value = max(0, value + delta * dt)
+    static void integrateNonNegative(float* value, const float* delta, int count, float dt)
+    {
+        for (int i = 0; i < count; ++i)
+            value[i] = MAX(0.0f, value[i] + delta[i] * dt);
+    }
+
+    // index of the first dead particle in [begin, end), or end if all alive
+    static int nextDead(const float* timeToLive, int begin, int end)
+    {
+        while (begin < end && timeToLive[begin] > 0.0f)
+            ++begin;
+        return begin;
+    }
+
+    // radius mode: pos = -(cos(angle), sin(angle) * yFlip) * radius
+    static void updateRadius(ParticleData& p, int begin, int end, float yFlip)
+    {
+        for (int i = begin; i < end; ++i)
+        {
+            p.posx[i] = -cosf(p.modeB.angle[i]) * p.modeB.radius[i];
+            p.posy[i] = -sinf(p.modeB.angle[i]) * p.modeB.radius[i] * yFlip;
+        }
+    }
+
+    // gravity mode: (gravity + radial + tangential) * dt accumulated into dir, then dir * dt into pos
+    static void updateGravity(ParticleData& p, int begin, int end, const Vec2& gravity, float dt, float yFlip)
+    {
+        for (int i = begin; i < end; ++i)
+        {
+            particle_point tmp, radial = {0.0f, 0.0f}, tangential;
+
+            // radial acceleration
+            if (p.posx[i] || p.posy[i])
+            {
+                normalize_point(p.posx[i], p.posy[i], &radial);
+            }
+            tangential = radial;
+            radial.x *= p.modeA.radialAccel[i];
+            radial.y *= p.modeA.radialAccel[i];
+
+            // tangential acceleration
+            std::swap(tangential.x, tangential.y);
+            tangential.x *= -p.modeA.tangentialAccel[i];
+            tangential.y *= p.modeA.tangentialAccel[i];
+
+            // (gravity + radial + tangential) * dt
+            tmp.x = radial.x + tangential.x + gravity.x;
+            tmp.y = radial.y + tangential.y + gravity.y;
+            tmp.x *= dt;
+            tmp.y *= dt;
+
+            p.modeA.dirX[i] += tmp.x;
+            p.modeA.dirY[i] += tmp.y;
+
+            tmp.x = p.modeA.dirX[i] * dt * yFlip;
+            tmp.y = p.modeA.dirY[i] * dt * yFlip;
+            p.posx[i] += tmp.x;
+            p.posy[i] += tmp.y;
+        }
+    }
+};
@@ -0,0 +1,211 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+// NEON particle update kernels, see ParticleKernelsSSE.inl
+
+#ifdef AX_NEON_INTRINSICS
+
+struct ParticleKernelsNeon
+{
+    static int updateLife(float* timeToLive, int count, float dt)
+    {
+        int firstDead          = count;
+        int i                  = 0;
+        const float32x4_t dt4  = vdupq_n_f32(dt);
+        const float32x4_t zero = vdupq_n_f32(0.0f);
+        for (; i + 4 <= count; i += 4)
+        {
+            float32x4_t ttl = vsubq_f32(vld1q_f32(timeToLive + i), dt4);
+            vst1q_f32(timeToLive + i, ttl);
+            if (firstDead == count && anyLane(vcleq_f32(ttl, zero)))
+            {
+                firstDead = i;
+                while (timeToLive[firstDead] > 0.0f)
+                    ++firstDead;
+            }
+        }
+        int tailDead = ParticleKernelsC::updateLife(timeToLive + i, count - i, dt) + i;
+        return firstDead != count ? firstDead : tailDead;
+    }
+
+    static void advanceClamped(float* value, const float* limit, int count, float dt)
+    {
+        int i                 = 0;
+        const float32x4_t dt4 = vdupq_n_f32(dt);
+        for (; i + 4 <= count; i += 4)
+        {
+            float32x4_t v = vaddq_f32(vld1q_f32(value + i), dt4);
+            vst1q_f32(value + i, vminq_f32(v, vld1q_f32(limit + i)));
+        }
+        ParticleKernelsC::advanceClamped(value + i, limit + i, count - i, dt);
+    }
+
+    static void integrate(float* value, const float* delta, int count, float dt)
+    {
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            vst1q_f32(value + i, vmlaq_n_f32(vld1q_f32(value + i), vld1q_f32(delta + i), dt));
+        }
+        ParticleKernelsC::integrate(value + i, delta + i, count - i, dt);
+    }
+
+    static void integrateNonNegative(float* value, const float* delta, int count, float dt)
+    {
+        int i                  = 0;
+        const float32x4_t zero = vdupq_n_f32(0.0f);
+        for (; i + 4 <= count; i += 4)
+        {
+            float32x4_t v = vmlaq_n_f32(vld1q_f32(value + i), vld1q_f32(delta + i), dt);
+            vst1q_f32(value + i, vmaxq_f32(v, zero));
+        }
+        ParticleKernelsC::integrateNonNegative(value + i, delta + i, count - i, dt);
+    }
+
+    static int nextDead(const float* timeToLive, int begin, int end)
+    {
+        int i                  = begin;
+        const float32x4_t zero = vdupq_n_f32(0.0f);
+        for (; i + 4 <= end; i += 4)
+        {
+            if (anyLane(vcleq_f32(vld1q_f32(timeToLive + i), zero)))
+            {
+                while (timeToLive[i] > 0.0f)
+                    ++i;
+                return i;
+            }
+        }
+        return ParticleKernelsC::nextDead(timeToLive, i, end);
+    }
+
+    static void updateRadius(ParticleData& p, int begin, int end, float yFlip)
+    {
+        int i = begin;
+        // the polynomial range reduction loses precision past this, such lanes go through cosf/sinf
+        const float32x4_t maxAngle = vdupq_n_f32(8192.0f);
+        for (; i + 4 <= end; i += 4)
+        {
+            float32x4_t angle = vld1q_f32(p.modeB.angle + i);
+            if (anyLane(vcagtq_f32(angle, maxAngle)))
+            {
+                ParticleKernelsC::updateRadius(p, i, i + 4, yFlip);
+                continue;
+            }
+            float32x4_t s, c;
+            sincos(angle, s, c);
+            float32x4_t radius = vld1q_f32(p.modeB.radius + i);
+            vst1q_f32(p.posx + i, vnegq_f32(vmulq_f32(c, radius)));
+            vst1q_f32(p.posy + i, vmulq_n_f32(vmulq_f32(s, radius), -yFlip));
+        }
+        ParticleKernelsC::updateRadius(p, i, end, yFlip);
+    }
+
+    static void updateGravity(ParticleData& p, int begin, int end, const Vec2& gravity, float dt, float yFlip)
+    {
+        int i = begin;
+        // compare squared length, vsqrtq_f32 is not available on armv7
+        const float32x4_t tolerance = vdupq_n_f32(MATH_TOLERANCE * MATH_TOLERANCE);
+        const float32x4_t gx        = vdupq_n_f32(gravity.x);
+        const float32x4_t gy        = vdupq_n_f32(gravity.y);
+        const float posDt           = dt * yFlip;
+        for (; i + 4 <= end; i += 4)
+        {
+            float32x4_t x    = vld1q_f32(p.posx + i);
+            float32x4_t y    = vld1q_f32(p.posy + i);
+            float32x4_t len2 = vmlaq_f32(vmulq_f32(x, x), y, y);
+
+            // 1/sqrt estimate refined by two newton-raphson steps
+            float32x4_t inv = vrsqrteq_f32(len2);
+            inv             = vmulq_f32(inv, vrsqrtsq_f32(vmulq_f32(len2, inv), inv));
+            inv             = vmulq_f32(inv, vrsqrtsq_f32(vmulq_f32(len2, inv), inv));
+            inv = vreinterpretq_f32_u32(vandq_u32(vcgeq_f32(len2, tolerance), vreinterpretq_u32_f32(inv)));
+
+            float32x4_t rx = vmulq_f32(x, inv);
+            float32x4_t ry = vmulq_f32(y, inv);
+
+            float32x4_t radial     = vld1q_f32(p.modeA.radialAccel + i);
+            float32x4_t tangential = vld1q_f32(p.modeA.tangentialAccel + i);
+
+            // radial * radialAccel + (-ry, rx) * tangentialAccel + gravity
+            float32x4_t ax = vaddq_f32(vmlsq_f32(vmulq_f32(rx, radial), ry, tangential), gx);
+            float32x4_t ay = vaddq_f32(vmlaq_f32(vmulq_f32(ry, radial), rx, tangential), gy);
+
+            float32x4_t dirX = vmlaq_n_f32(vld1q_f32(p.modeA.dirX + i), ax, dt);
+            float32x4_t dirY = vmlaq_n_f32(vld1q_f32(p.modeA.dirY + i), ay, dt);
+            vst1q_f32(p.modeA.dirX + i, dirX);
+            vst1q_f32(p.modeA.dirY + i, dirY);
+
+            vst1q_f32(p.posx + i, vmlaq_n_f32(x, dirX, posDt));
+            vst1q_f32(p.posy + i, vmlaq_n_f32(y, dirY, posDt));
+        }
+        ParticleKernelsC::updateGravity(p, i, end, gravity, dt, yFlip);
+    }
+
+private:
+    static bool anyLane(uint32x4_t mask)
+    {
+        uint32x2_t r = vorr_u32(vget_low_u32(mask), vget_high_u32(mask));
+        return (vget_lane_u32(r, 0) | vget_lane_u32(r, 1)) != 0;
+    }
+
+    // Cephes single precision sin and cos, see ParticleKernelsSSE::sincos
+    static void sincos(float32x4_t x, float32x4_t& s, float32x4_t& c)
+    {
+        uint32x4_t signSin = vcltq_f32(x, vdupq_n_f32(0.0f));
+        x                  = vabsq_f32(x);
+
+        // octant j rounded up to even, y = j * pi/4
+        uint32x4_t j  = vcvtq_u32_f32(vmulq_n_f32(x, 1.27323954473516f));
+        j             = vandq_u32(vaddq_u32(j, vdupq_n_u32(1)), vdupq_n_u32(~1u));
+        float32x4_t y = vcvtq_f32_u32(j);
+
+        signSin            = veorq_u32(signSin, vtstq_u32(j, vdupq_n_u32(4)));
+        uint32x4_t posCos  = vtstq_u32(vsubq_u32(j, vdupq_n_u32(2)), vdupq_n_u32(4));
+        // j = 2 and j = 6 swap the sin and cos polynomials
+        uint32x4_t swapped = vtstq_u32(j, vdupq_n_u32(2));
+
+        x             = vmlaq_n_f32(x, y, -0.78515625f);
+        x             = vmlaq_n_f32(x, y, -2.4187564849853515625e-4f);
+        x             = vmlaq_n_f32(x, y, -3.77489497744594108e-8f);
+        float32x4_t z = vmulq_f32(x, x);
+
+        float32x4_t polyCos = vdupq_n_f32(2.443315711809948e-5f);
+        polyCos             = vmlaq_f32(vdupq_n_f32(-1.388731625493765e-3f), polyCos, z);
+        polyCos             = vmlaq_f32(vdupq_n_f32(4.166664568298827e-2f), polyCos, z);
+        polyCos             = vmulq_f32(vmulq_f32(polyCos, z), z);
+        polyCos             = vaddq_f32(vmlsq_n_f32(polyCos, z, 0.5f), vdupq_n_f32(1.0f));
+
+        float32x4_t polySin = vdupq_n_f32(-1.9515295891e-4f);
+        polySin             = vmlaq_f32(vdupq_n_f32(8.3321608736e-3f), polySin, z);
+        polySin             = vmlaq_f32(vdupq_n_f32(-1.6666654611e-1f), polySin, z);
+        polySin             = vmlaq_f32(x, vmulq_f32(polySin, z), x);
+
+        float32x4_t sinAbs = vbslq_f32(swapped, polyCos, polySin);
+        float32x4_t cosAbs = vbslq_f32(swapped, polySin, polyCos);
+        s                  = vbslq_f32(signSin, vnegq_f32(sinAbs), sinAbs);
+        c                  = vbslq_f32(posCos, cosAbs, vnegq_f32(cosAbs));
+    }
+};
+
+#endif
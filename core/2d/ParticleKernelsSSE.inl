@@ -0,0 +1,252 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+// SSE2 particle update kernels, 8 lanes with AVX2 when the compiler targets it (-mavx2, /arch:AVX2),
+// <immintrin.h> is included by ParticleSystem.cpp in that case.
+// Particle arrays are malloc'ed, so all loads and stores are unaligned.
+
+#ifdef AX_SSE_INTRINSICS
+
+struct ParticleKernelsSSE
+{
+    static int updateLife(float* timeToLive, int count, float dt)
+    {
+        int firstDead = count;
+        int i         = 0;
+#    if defined(__AVX2__)
+        const __m256 dt8   = _mm256_set1_ps(dt);
+        const __m256 zero8 = _mm256_setzero_ps();
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 ttl = _mm256_sub_ps(_mm256_loadu_ps(timeToLive + i), dt8);
+            _mm256_storeu_ps(timeToLive + i, ttl);
+            if (firstDead == count && _mm256_movemask_ps(_mm256_cmp_ps(ttl, zero8, _CMP_LE_OQ)))
+                firstDead = findDead(timeToLive, i);
+        }
+#    endif
+        const __m128 dt4   = _mm_set1_ps(dt);
+        const __m128 zero4 = _mm_setzero_ps();
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 ttl = _mm_sub_ps(_mm_loadu_ps(timeToLive + i), dt4);
+            _mm_storeu_ps(timeToLive + i, ttl);
+            if (firstDead == count && _mm_movemask_ps(_mm_cmple_ps(ttl, zero4)))
+                firstDead = findDead(timeToLive, i);
+        }
+        int tailDead = ParticleKernelsC::updateLife(timeToLive + i, count - i, dt) + i;
+        return firstDead != count ? firstDead : tailDead;
+    }
+
+    static void advanceClamped(float* value, const float* limit, int count, float dt)
+    {
+        int i = 0;
+#    if defined(__AVX2__)
+        const __m256 dt8 = _mm256_set1_ps(dt);
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 v = _mm256_add_ps(_mm256_loadu_ps(value + i), dt8);
+            _mm256_storeu_ps(value + i, _mm256_min_ps(v, _mm256_loadu_ps(limit + i)));
+        }
+#    endif
+        const __m128 dt4 = _mm_set1_ps(dt);
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 v = _mm_add_ps(_mm_loadu_ps(value + i), dt4);
+            _mm_storeu_ps(value + i, _mm_min_ps(v, _mm_loadu_ps(limit + i)));
+        }
+        ParticleKernelsC::advanceClamped(value + i, limit + i, count - i, dt);
+    }
+
+    static void integrate(float* value, const float* delta, int count, float dt)
+    {
+        int i = 0;
+#    if defined(__AVX2__)
+        const __m256 dt8 = _mm256_set1_ps(dt);
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 d = _mm256_mul_ps(_mm256_loadu_ps(delta + i), dt8);
+            _mm256_storeu_ps(value + i, _mm256_add_ps(_mm256_loadu_ps(value + i), d));
+        }
+#    endif
+        const __m128 dt4 = _mm_set1_ps(dt);
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 d = _mm_mul_ps(_mm_loadu_ps(delta + i), dt4);
+            _mm_storeu_ps(value + i, _mm_add_ps(_mm_loadu_ps(value + i), d));
+        }
+        ParticleKernelsC::integrate(value + i, delta + i, count - i, dt);
+    }
+
+    static void integrateNonNegative(float* value, const float* delta, int count, float dt)
+    {
+        int i = 0;
+#    if defined(__AVX2__)
+        const __m256 dt8   = _mm256_set1_ps(dt);
+        const __m256 zero8 = _mm256_setzero_ps();
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 v = _mm256_add_ps(_mm256_loadu_ps(value + i), _mm256_mul_ps(_mm256_loadu_ps(delta + i), dt8));
+            _mm256_storeu_ps(value + i, _mm256_max_ps(v, zero8));
+        }
+#    endif
+        const __m128 dt4   = _mm_set1_ps(dt);
+        const __m128 zero4 = _mm_setzero_ps();
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 v = _mm_add_ps(_mm_loadu_ps(value + i), _mm_mul_ps(_mm_loadu_ps(delta + i), dt4));
+            _mm_storeu_ps(value + i, _mm_max_ps(v, zero4));
+        }
+        ParticleKernelsC::integrateNonNegative(value + i, delta + i, count - i, dt);
+    }
+
+    static int nextDead(const float* timeToLive, int begin, int end)
+    {
+        int i = begin;
+#    if defined(__AVX2__)
+        const __m256 zero8 = _mm256_setzero_ps();
+        for (; i + 8 <= end; i += 8)
+        {
+            if (_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(timeToLive + i), zero8, _CMP_LE_OQ)))
+                return findDead(timeToLive, i);
+        }
+#    endif
+        const __m128 zero4 = _mm_setzero_ps();
+        for (; i + 4 <= end; i += 4)
+        {
+            if (_mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(timeToLive + i), zero4)))
+                return findDead(timeToLive, i);
+        }
+        return ParticleKernelsC::nextDead(timeToLive, i, end);
+    }
+
+    static void updateRadius(ParticleData& p, int begin, int end, float yFlip)
+    {
+        int i = begin;
+        // the polynomial range reduction loses precision past this, such lanes go through cosf/sinf
+        const __m128 maxAngle = _mm_set1_ps(8192.0f);
+        const __m128 absMask  = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+        const __m128 flip     = _mm_set1_ps(-yFlip);
+        const __m128 negOne   = _mm_set1_ps(-1.0f);
+        for (; i + 4 <= end; i += 4)
+        {
+            __m128 angle = _mm_loadu_ps(p.modeB.angle + i);
+            if (_mm_movemask_ps(_mm_cmpgt_ps(_mm_and_ps(angle, absMask), maxAngle)))
+            {
+                ParticleKernelsC::updateRadius(p, i, i + 4, yFlip);
+                continue;
+            }
+            __m128 s, c;
+            sincos(angle, s, c);
+            __m128 radius = _mm_loadu_ps(p.modeB.radius + i);
+            _mm_storeu_ps(p.posx + i, _mm_mul_ps(_mm_mul_ps(c, negOne), radius));
+            _mm_storeu_ps(p.posy + i, _mm_mul_ps(_mm_mul_ps(s, radius), flip));
+        }
+        ParticleKernelsC::updateRadius(p, i, end, yFlip);
+    }
+
+    static void updateGravity(ParticleData& p, int begin, int end, const Vec2& gravity, float dt, float yFlip)
+    {
+        int i = begin;
+        // the radial direction is left zero for particles too close to the emitter, like normalize_point
+        const __m128 tolerance = _mm_set1_ps(MATH_TOLERANCE);
+        const __m128 one       = _mm_set1_ps(1.0f);
+        const __m128 gx        = _mm_set1_ps(gravity.x);
+        const __m128 gy        = _mm_set1_ps(gravity.y);
+        const __m128 dt4       = _mm_set1_ps(dt);
+        const __m128 posDt     = _mm_set1_ps(dt * yFlip);
+        for (; i + 4 <= end; i += 4)
+        {
+            __m128 x   = _mm_loadu_ps(p.posx + i);
+            __m128 y   = _mm_loadu_ps(p.posy + i);
+            __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)));
+            __m128 inv = _mm_and_ps(_mm_cmpge_ps(len, tolerance), _mm_div_ps(one, len));
+            __m128 rx  = _mm_mul_ps(x, inv);
+            __m128 ry  = _mm_mul_ps(y, inv);
+
+            __m128 radial     = _mm_loadu_ps(p.modeA.radialAccel + i);
+            __m128 tangential = _mm_loadu_ps(p.modeA.tangentialAccel + i);
+
+            // radial * radialAccel + (-ry, rx) * tangentialAccel + gravity
+            __m128 ax = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rx, radial), _mm_mul_ps(ry, tangential)), gx);
+            __m128 ay = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ry, radial), _mm_mul_ps(rx, tangential)), gy);
+
+            __m128 dirX = _mm_add_ps(_mm_loadu_ps(p.modeA.dirX + i), _mm_mul_ps(ax, dt4));
+            __m128 dirY = _mm_add_ps(_mm_loadu_ps(p.modeA.dirY + i), _mm_mul_ps(ay, dt4));
+            _mm_storeu_ps(p.modeA.dirX + i, dirX);
+            _mm_storeu_ps(p.modeA.dirY + i, dirY);
+
+            _mm_storeu_ps(p.posx + i, _mm_add_ps(x, _mm_mul_ps(dirX, posDt)));
+            _mm_storeu_ps(p.posy + i, _mm_add_ps(y, _mm_mul_ps(dirY, posDt)));
+        }
+        ParticleKernelsC::updateGravity(p, i, end, gravity, dt, yFlip);
+    }
+
+private:
+    static int findDead(const float* timeToLive, int i)
+    {
+        while (timeToLive[i] > 0.0f)
+            ++i;
+        return i;
+    }
+
+    // Cephes single precision sin and cos, reduced to [-pi/4, pi/4] by octant with an extended precision pi/4
+    static void sincos(__m128 x, __m128& s, __m128& c)
+    {
+        const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+        __m128 signSin        = _mm_and_ps(x, signMask);
+        x                     = _mm_andnot_ps(signMask, x);
+
+        // octant j rounded up to even, y = j * pi/4
+        __m128i j = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(1.27323954473516f)));
+        j         = _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+        __m128 y  = _mm_cvtepi32_ps(j);
+
+        signSin = _mm_xor_ps(signSin, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, _mm_set1_epi32(4)), 29)));
+        __m128 signCos = _mm_castsi128_ps(
+            _mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(j, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+        // j = 2 and j = 6 swap the sin and cos polynomials
+        __m128 direct = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, _mm_set1_epi32(2)), _mm_setzero_si128()));
+
+        x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-0.78515625f)));
+        x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-2.4187564849853515625e-4f)));
+        x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-3.77489497744594108e-8f)));
+        __m128 z = _mm_mul_ps(x, x);
+
+        __m128 polyCos = _mm_set1_ps(2.443315711809948e-5f);
+        polyCos        = _mm_add_ps(_mm_mul_ps(polyCos, z), _mm_set1_ps(-1.388731625493765e-3f));
+        polyCos        = _mm_add_ps(_mm_mul_ps(polyCos, z), _mm_set1_ps(4.166664568298827e-2f));
+        polyCos        = _mm_mul_ps(_mm_mul_ps(polyCos, z), z);
+        polyCos        = _mm_add_ps(_mm_sub_ps(polyCos, _mm_mul_ps(z, _mm_set1_ps(0.5f))), _mm_set1_ps(1.0f));
+
+        __m128 polySin = _mm_set1_ps(-1.9515295891e-4f);
+        polySin        = _mm_add_ps(_mm_mul_ps(polySin, z), _mm_set1_ps(8.3321608736e-3f));
+        polySin        = _mm_add_ps(_mm_mul_ps(polySin, z), _mm_set1_ps(-1.6666654611e-1f));
+        polySin        = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(polySin, z), x), x);
+
+        s = _mm_xor_ps(_mm_or_ps(_mm_and_ps(direct, polySin), _mm_andnot_ps(direct, polyCos)), signSin);
+        c = _mm_xor_ps(_mm_or_ps(_mm_and_ps(direct, polyCos), _mm_andnot_ps(direct, polySin)), signCos);
+    }
+};
+
+#endif
@@ -47,17 +47,25 @@ THE SOFTWARE.
 #include "2d/ParticleSystem.h"
 
 #include <string>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 
 #include "2d/ParticleBatchNode.h"
 #include "renderer/TextureAtlas.h"
 #include "base/ZipUtils.h"
 #include "base/Director.h"
+#include "base/JobSystem.h"
 #include "base/Profiling.h"
 #include "base/UTF8.h"
 #include "base/Utils.h"
 #include "renderer/TextureCache.h"
 #include "platform/FileUtils.h"
 
+#if defined(AX_SSE_INTRINSICS) && defined(__AVX2__)
+#    include <immintrin.h>
+#endif
+
 using namespace std;
 
 namespace ax
@@ -80,28 +88,96 @@ namespace ax
 //  cocos2d uses a another approach, but the results are almost identical.
 //
 
-inline void normalize_point(float x, float y, particle_point* out)
-{
-    float n = x * x + y * y;
-    // Already normalized.
-    if (n == 1.0f)
-        return;
-
-    n = sqrt(n);
-    // Too close to zero.
-    if (n < MATH_TOLERANCE)
-        return;
-
-    n      = 1.0f / n;
-    out->x = x * n;
-    out->y = y * n;
-}
+#include "2d/ParticleKernels.inl"
+#if defined(AX_SSE_INTRINSICS)
+#    include "2d/ParticleKernelsSSE.inl"
+using ParticleKernels = ParticleKernelsSSE;
+#elif defined(AX_NEON_INTRINSICS) && (AX_64BITS || AX_NEON_INTRINSICS > 1)
+#    include "2d/ParticleKernelsNeon.inl"
+using ParticleKernels = ParticleKernelsNeon;
+#else
+using ParticleKernels = ParticleKernelsC;
+#endif
 
 ParticleData::ParticleData()
 {
     memset(this, 0, sizeof(ParticleData));
 }
 
+void ParticleData::moveParticles(const int* dst, const int* src, int count)
+{
+    auto move = [=](auto* values) {
+        if (values)
+        {
+            for (int i = 0; i < count; ++i)
+                values[dst[i]] = values[src[i]];
+        }
+    };
+
+    move(posx);
+    move(posy);
+    move(startPosX);
+    move(startPosY);
+
+    move(colorR);
+    move(colorG);
+    move(colorB);
+    move(colorA);
+
+    move(deltaColorR);
+    move(deltaColorG);
+    move(deltaColorB);
+    move(deltaColorA);
+
+    if (hue && sat && val)
+    {
+        move(hue);
+        move(sat);
+        move(val);
+    }
+
+    if (opacityFadeInDelta && opacityFadeInLength)
+    {
+        move(opacityFadeInDelta);
+        move(opacityFadeInLength);
+    }
+
+    if (scaleInDelta && scaleInLength)
+    {
+        move(scaleInDelta);
+        move(scaleInLength);
+    }
+
+    move(size);
+    move(deltaSize);
+    move(rotation);
+    move(staticRotation);
+    move(deltaRotation);
+
+    move(totalTimeToLive);
+    move(timeToLive);
+
+    if (animTimeDelta && animTimeLength && animIndex && animCellIndex)
+    {
+        move(animTimeDelta);
+        move(animTimeLength);
+        move(animIndex);
+        move(animCellIndex);
+    }
+
+    // atlasIndex is swapped by ParticleSystem::removeDeadParticles, each slot keeps a quad of its own
+
+    move(modeA.dirX);
+    move(modeA.dirY);
+    move(modeA.radialAccel);
+    move(modeA.tangentialAccel);
+
+    move(modeB.angle);
+    move(modeB.degreesPerSecond);
+    move(modeB.radius);
+    move(modeB.deltaRadius);
+}
+
 bool ParticleData::init(int count)
 {
     maxCount = count;
@@ -192,6 +268,9 @@ void ParticleData::release()
 
 Vector<ParticleSystem*> ParticleSystem::__allInstances;
 float ParticleSystem::__totalParticleCountFactor = 1.0f;
+bool ParticleSystem::__parallelUpdateEnabled      = false;
+std::vector<ParticleSystem*> ParticleSystem::__parallelUpdates;
+unsigned int ParticleSystem::__parallelUpdateFrame = 0;
 
 ParticleSystem::ParticleSystem()
     : _isBlendAdditive(false)
@@ -252,6 +331,7 @@ ParticleSystem::ParticleSystem()
     , _timeScale(1)
     , _fixedFPS(0)
     , _fixedFPSDelta(0)
+    , _parallelUpdateDelta(-1.0f)
     , _sourcePositionCompatible(true)  // In the furture this member's default value maybe false or be removed.
 {
     modeA.gravity.setZero();
@@ -1488,6 +1568,10 @@ void ParticleSystem::simulate(float seconds, float frameRate)
                               ? 1.0F / Director::getInstance()->getAnimationInterval()
                               : frameRate;
     auto delta          = 1.0F / frameRate;
+
+    // fast-forward synchronously, a parallel update would merge all the steps into one
+    const bool parallelUpdate = __parallelUpdateEnabled;
+    __parallelUpdateEnabled   = false;
     if (seconds > delta)
     {
         while (seconds > 0.0F)
@@ -1499,6 +1583,7 @@ void ParticleSystem::simulate(float seconds, float frameRate)
     }
     else
         this->update(seconds);
+    __parallelUpdateEnabled = parallelUpdate;
 }
 
 void ParticleSystem::resimulate(float seconds, float frameRate)
@@ -1562,6 +1647,35 @@ void ParticleSystem::update(float dt)
         _componentContainer->visit(dt);
     }
 
+    if (__parallelUpdateEnabled && !_batchNode)
+    {
+        // simulated with all the other systems at the end of this scheduler update, scheduled again when a
+        // pending batch was dropped by Scheduler::removeAllPendingActions
+        const auto frame = _director->getTotalFrames();
+        if (__parallelUpdates.empty() || __parallelUpdateFrame != frame)
+        {
+            __parallelUpdateFrame = frame;
+            _director->getScheduler()->runOnAxmolThread(&ParticleSystem::processParallelUpdates);
+        }
+        if (_parallelUpdateDelta < 0.0f)
+        {
+            this->retain();
+            __parallelUpdates.emplace_back(this);
+            _parallelUpdateDelta = dt;
+        }
+        else  // updated more than once by the same scheduler update
+            _parallelUpdateDelta += dt;
+        AX_PROFILER_STOP_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
+        return;
+    }
+
+    finishStep(step(dt));
+
+    AX_PROFILER_STOP_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
+}
+
+ParticleSystem::StepResult ParticleSystem::step(float dt)
+{
     if (_fixedFPS != 0)
     {
         _fixedFPSDelta += dt;
@@ -1569,8 +1683,7 @@ void ParticleSystem::update(float dt)
         {
             updateParticleQuads();
             _transformSystemDirty = false;
-            AX_PROFILER_STOP_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
-            return;
+            return StepResult::Skipped;
         }
         dt             = _fixedFPSDelta;
         _fixedFPSDelta = 0.0F;
@@ -1611,28 +1724,18 @@ void ParticleSystem::update(float dt)
     // for the purpose of improving cache hit rate, we should process only one property in one for-loop.
     // It was proved to be effective especially for low-end devices.
     {
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.timeToLive[i] -= dt;
-        }
+        const int firstDead = ParticleKernels::updateLife(_particleData.timeToLive, _particleCount, dt);
 
         if (_isOpacityFadeInAllocated)
         {
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.opacityFadeInDelta[i] += dt;
-                _particleData.opacityFadeInDelta[i] =
-                    MIN(_particleData.opacityFadeInDelta[i], _particleData.opacityFadeInLength[i]);
-            }
+            ParticleKernels::advanceClamped(_particleData.opacityFadeInDelta, _particleData.opacityFadeInLength,
+                                            _particleCount, dt);
         }
 
         if (_isScaleInAllocated)
         {
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.scaleInDelta[i] += dt;
-                _particleData.scaleInDelta[i] = MIN(_particleData.scaleInDelta[i], _particleData.scaleInLength[i]);
-            }
+            ParticleKernels::advanceClamped(_particleData.scaleInDelta, _particleData.scaleInLength, _particleCount,
+                                            dt);
         }
 
         if (_isLifeAnimated || _isEmitterAnimated || _isLoopAnimated)
@@ -1702,140 +1805,180 @@ void ParticleSystem::update(float dt)
                 std::fill_n(_particleData.animTimeDelta, _particleCount, 0.f);
         }
 
-        for (int i = 0; i < _particleCount; ++i)
+        if (firstDead < _particleCount)
         {
-            if (_particleData.timeToLive[i] <= 0.0f)
-            {
-                int j = _particleCount - 1;
-                while (j > 0 && _particleData.timeToLive[j] <= 0)
-                {
-                    _particleCount--;
-                    j--;
-                }
-                _particleData.copyParticle(i, _particleCount - 1);
-                if (_batchNode)
-                {
-                    // disable the switched particle
-                    int currentIndex = _particleData.atlasIndex[i];
-                    _batchNode->disableParticle(_atlasIndex + currentIndex);
-                    // switch indexes
-                    _particleData.atlasIndex[_particleCount - 1] = currentIndex;
-                }
-                --_particleCount;
-                if (_particleCount == 0 && _isAutoRemoveOnFinish)
-                {
-                    this->unscheduleUpdate();
-                    _parent->removeChild(this, true);
-                    return;
-                }
-            }
+            removeDeadParticles(firstDead);
+            if (_particleCount == 0 && _isAutoRemoveOnFinish)
+                return StepResult::Finished;
         }
 
         if (_emitterMode == Mode::GRAVITY)
         {
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                particle_point tmp, radial = {0.0f, 0.0f}, tangential;
-
-                // radial acceleration
-                if (_particleData.posx[i] || _particleData.posy[i])
-                {
-                    normalize_point(_particleData.posx[i], _particleData.posy[i], &radial);
-                }
-                tangential = radial;
-                radial.x *= _particleData.modeA.radialAccel[i];
-                radial.y *= _particleData.modeA.radialAccel[i];
-
-                // tangential acceleration
-                std::swap(tangential.x, tangential.y);
-                tangential.x *= -_particleData.modeA.tangentialAccel[i];
-                tangential.y *= _particleData.modeA.tangentialAccel[i];
-
-                // (gravity + radial + tangential) * dt
-                tmp.x = radial.x + tangential.x + modeA.gravity.x;
-                tmp.y = radial.y + tangential.y + modeA.gravity.y;
-                tmp.x *= dt;
-                tmp.y *= dt;
-
-                _particleData.modeA.dirX[i] += tmp.x;
-                _particleData.modeA.dirY[i] += tmp.y;
-
-                // this is cocos2d-x v3.0
-                // if (_configName.length()>0 && _yCoordFlipped != -1)
-
-                // this is cocos2d-x v3.0
-                tmp.x = _particleData.modeA.dirX[i] * dt * _yCoordFlipped;
-                tmp.y = _particleData.modeA.dirY[i] * dt * _yCoordFlipped;
-                _particleData.posx[i] += tmp.x;
-                _particleData.posy[i] += tmp.y;
-            }
+            ParticleKernels::updateGravity(_particleData, 0, _particleCount, modeA.gravity, dt, _yCoordFlipped);
         }
         else
         {
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.modeB.angle[i] += _particleData.modeB.degreesPerSecond[i] * dt;
-            }
-
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.modeB.radius[i] += _particleData.modeB.deltaRadius[i] * dt;
-            }
-
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.posx[i] = -cosf(_particleData.modeB.angle[i]) * _particleData.modeB.radius[i];
-            }
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.posy[i] =
-                    -sinf(_particleData.modeB.angle[i]) * _particleData.modeB.radius[i] * _yCoordFlipped;
-            }
+            ParticleKernels::integrate(_particleData.modeB.angle, _particleData.modeB.degreesPerSecond, _particleCount,
+                                       dt);
+            ParticleKernels::integrate(_particleData.modeB.radius, _particleData.modeB.deltaRadius, _particleCount, dt);
+            ParticleKernels::updateRadius(_particleData, 0, _particleCount, _yCoordFlipped);
         }
 
         // color r,g,b,a
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.colorR[i] += _particleData.deltaColorR[i] * dt;
-        }
+        ParticleKernels::integrate(_particleData.colorR, _particleData.deltaColorR, _particleCount, dt);
+        ParticleKernels::integrate(_particleData.colorG, _particleData.deltaColorG, _particleCount, dt);
+        ParticleKernels::integrate(_particleData.colorB, _particleData.deltaColorB, _particleCount, dt);
+        ParticleKernels::integrate(_particleData.colorA, _particleData.deltaColorA, _particleCount, dt);
+        // size
+        ParticleKernels::integrateNonNegative(_particleData.size, _particleData.deltaSize, _particleCount, dt);
+        // angle
+        ParticleKernels::integrate(_particleData.rotation, _particleData.deltaRotation, _particleCount, dt);
 
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.colorG[i] += _particleData.deltaColorG[i] * dt;
-        }
+        updateParticleQuads();
+        _transformSystemDirty = false;
+    }
 
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.colorB[i] += _particleData.deltaColorB[i] * dt;
-        }
+    return StepResult::Stepped;
+}
 
-        for (int i = 0; i < _particleCount; ++i)
+void ParticleSystem::finishStep(StepResult result)
+{
+    if (result == StepResult::Finished)
+    {
+        this->unscheduleUpdate();
+        if (_parent)
+            _parent->removeChild(this, true);
+    }
+    // update and send gl buffer only when this node is visible.
+    else if (result == StepResult::Stepped && _visible && !_batchNode)
+    {
+        postStep();
+    }
+}
+
+void ParticleSystem::processParallelUpdates()
+{
+    auto systems = std::move(__parallelUpdates);
+    __parallelUpdates.clear();
+    if (systems.empty())
+        return;
+
+    // Settle the state workers would otherwise create lazily: the cached transforms of shared ancestors
+    // and the emission masks.
+    auto maskCache = ParticleEmissionMaskCache::getInstance();
+    for (auto system : systems)
+    {
+        if (system->_positionType == PositionType::FREE)
+            system->getNodeToWorldTransform();
+        if (system->_isEmissionShapes)
         {
-            _particleData.colorA[i] += _particleData.deltaColorA[i] * dt;
+            for (auto&& [_, shape] : system->_emissionShapes)
+                if (shape.type == EmissionShapeType::TEXTURE_ALPHA_MASK)
+                    maskCache->getEmissionMask(shape.fourccId);
         }
-        // size
-        for (int i = 0; i < _particleCount; ++i)
+    }
+
+    // The main thread simulates too, see Renderer::processParallelVisits
+    struct ParallelUpdateState
+    {
+        std::atomic<int> next{0};
+        int count{0};
+        int remaining{0};
+        std::vector<ParticleSystem*> systems;
+        std::vector<StepResult> results;
+        std::mutex mtx;
+        std::condition_variable cv;
+    };
+    auto state       = std::make_shared<ParallelUpdateState>();
+    state->count     = static_cast<int>(systems.size());
+    state->remaining = state->count;
+    state->systems   = std::move(systems);
+    state->results.resize(state->count);
+
+    auto pick = [state]() {
+        for (int index; (index = state->next.fetch_add(1, std::memory_order_relaxed)) < state->count;)
         {
-            _particleData.size[i] += (_particleData.deltaSize[i] * dt);
-            _particleData.size[i] = MAX(0, _particleData.size[i]);
+            auto system           = state->systems[index];
+            state->results[index] = system->step(system->_parallelUpdateDelta);
+
+            std::lock_guard<std::mutex> lck(state->mtx);
+            if (--state->remaining == 0)
+                state->cv.notify_all();
         }
-        // angle
-        for (int i = 0; i < _particleCount; ++i)
+    };
+
+    auto jobSystem  = Director::getInstance()->getJobSystem();
+    const int works = (std::min)(state->count, static_cast<int>(std::thread::hardware_concurrency())) - 1;
+    for (int i = 0; i < works; ++i)
+        jobSystem->enqueue(pick);
+    pick();
+
+    {
+        std::unique_lock<std::mutex> lck(state->mtx);
+        state->cv.wait(lck, [&state] { return state->remaining == 0; });
+    }
+
+    // node graph changes and gpu uploads stay on this thread, in scheduling order
+    for (int index = 0; index < state->count; ++index)
+    {
+        auto system                  = state->systems[index];
+        system->_parallelUpdateDelta = -1.0f;
+        system->finishStep(state->results[index]);
+        system->release();
+    }
+}
+
+void ParticleSystem::setParallelUpdateEnabled(bool enabled)
+{
+    __parallelUpdateEnabled = enabled;
+}
+
+bool ParticleSystem::isParallelUpdateEnabled()
+{
+    return __parallelUpdateEnabled;
+}
+
+void ParticleSystem::removeDeadParticles(int firstDead)
+{
+    // Plan all swap-with-last moves from timeToLive alone, then apply them property by property instead of
+    // copying every property of one particle at a time. Survivors always come from slots >= the new count and
+    // land in slots below it, so the moves never chain.
+    _deadParticleSlots.clear();
+    _survivorSlots.clear();
+
+    auto timeToLive = _particleData.timeToLive;
+    int last        = _particleCount;
+    // the dead slot scan skips whole vectors of live particles
+    for (int i = ParticleKernels::nextDead(timeToLive, firstDead, last); i < last;)
+    {
+        do
+            --last;
+        while (last > i && timeToLive[last] <= 0.0f);
+
+        if (last > i)
         {
-            _particleData.rotation[i] += _particleData.deltaRotation[i] * dt;
+            _deadParticleSlots.emplace_back(i);
+            _survivorSlots.emplace_back(last);
         }
-
-        updateParticleQuads();
-        _transformSystemDirty = false;
+        i = ParticleKernels::nextDead(timeToLive, i + 1, last);
     }
+    _particleCount = last;
 
-    // update and send gl buffer only when this node is visible.
-    if (_visible && !_batchNode)
+    const int moveCount = static_cast<int>(_survivorSlots.size());
+    if (_batchNode)
     {
-        postStep();
+        // disable the quads of the dead particles and switch indexes, the survivors keep drawing to their quads
+        auto atlasIndex = _particleData.atlasIndex;
+        for (int i = 0; i < moveCount; ++i)
+        {
+            const auto deadIndex = atlasIndex[_deadParticleSlots[i]];
+            _batchNode->disableParticle(_atlasIndex + deadIndex);
+            atlasIndex[_deadParticleSlots[i]] = atlasIndex[_survivorSlots[i]];
+            atlasIndex[_survivorSlots[i]]     = deadIndex;
+        }
     }
 
-    AX_PROFILER_STOP_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
+    _particleData.moveParticles(_deadParticleSlots.data(), _survivorSlots.data(), moveCount);
 }
 
 void ParticleSystem::updateWithNoTime()
@@ -169,6 +169,12 @@ public:
     void release();
     unsigned int getMaxCount() { return maxCount; }
 
+    /**
+     * Copy particles in bulk, p[dst[i]] = p[src[i]] for i in [0, count), one property array at a time.
+     * No src slot may also appear in dst. atlasIndex is left as is, the batched quads are swapped by the caller.
+     */
+    void moveParticles(const int* dst, const int* src, int count);
+
     void copyParticle(int p1, int p2)
     {
         posx[p1]      = posx[p2];
@@ -434,6 +440,15 @@ public:
      */
     static Vector<ParticleSystem*>& getAllParticleSystems();
 
+    /** Simulate particle systems in parallel on JobSystem workers, disabled by default.
+     * While enabled, update() of a system not rendered by a ParticleBatchNode only records its delta time. All
+     * recorded systems are then simulated concurrently, quads included, at the end of the scheduler update.
+     * Each system emits with its own FastRNG, so results don't depend on which worker runs it.
+     * Subclasses overriding addParticles/updateParticleQuads must not touch other nodes from them.
+     */
+    static void setParallelUpdateEnabled(bool enabled);
+    static bool isParallelUpdateEnabled();
+
 protected:
     bool allocAnimationMem();
     void deallocAnimationMem();
@@ -1459,6 +1474,23 @@ public:
 protected:
     virtual void updateBlendFunc();
 
+    /** Swap-with-last removal of every dead particle from firstDead on, applied one property array at a time. */
+    void removeDeadParticles(int firstDead);
+
+    enum class StepResult
+    {
+        Skipped,   ///< waiting for the next fixed fps step, quads refreshed only
+        Stepped,   ///< particles emitted and integrated
+        Finished,  ///< all particles died and the system is removed on finish
+    };
+
+    /** Emit, integrate and fill the quads, doesn't touch other nodes so it's safe to run on a worker. */
+    StepResult step(float dt);
+    /** Main thread part of a step: removal on finish and postStep. */
+    void finishStep(StepResult result);
+
+    static void processParallelUpdates();
+
 private:
     friend class EngineDataManager;
     /** Internal use only, it's used by EngineDataManager class for Android platform */
@@ -1526,6 +1558,10 @@ protected:
     // particle data
     ParticleData _particleData;
 
+    // scratch for removeDeadParticles: _particleData slots receiving a survivor, and where it comes from
+    std::vector<int> _deadParticleSlots;
+    std::vector<int> _survivorSlots;
+
     // Emitter name
     std::string _configName;
 
@@ -1677,11 +1713,18 @@ protected:
     /** Fixed frame rate delta (internal) */
     float _fixedFPSDelta;
 
+    /** Delta time recorded for the pending parallel update, negative when not pending (internal) */
+    float _parallelUpdateDelta;
+
     /** is sourcePosition compatible */
     bool _sourcePositionCompatible;
 
     static Vector<ParticleSystem*> __allInstances;
 
+    static bool __parallelUpdateEnabled;
+    static std::vector<ParticleSystem*> __parallelUpdates;
+    static unsigned int __parallelUpdateFrame;
+
     FastRNG _rng;
 
 private:
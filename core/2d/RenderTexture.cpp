@@ -487,39 +487,26 @@ bool RenderTexture::saveToFile(std::string_view fileName,
 
 void RenderTexture::onSaveToFile(std::string filename, bool isRGBA, bool forceNonPMA)
 {
-    auto callbackFunc = [this, _filename = std::move(filename), isRGBA, forceNonPMA](RefPtr<Image> image) {
-        if (image)
+    // the pixels arrive a few frames later, keep this alive until the file is written
+    auto callbackFunc = [self = RefPtr(this), _filename = std::move(filename), isRGBA,
+                         forceNonPMA](RefPtr<Image> image) {
+        auto done = [self, _filename] {
+            if (self->_saveFileCallback)
+                self->_saveFileCallback(self, _filename);
+        };
+        if (!image)
         {
-            if (forceNonPMA && image->hasPremultipliedAlpha())
-            {
-                _director->getJobSystem()->enqueue([self = RefPtr(this), image, _filename, isRGBA, forceNonPMA]() {
-                    image->reversePremultipliedAlpha();
-
-                    Director::getInstance()->getScheduler()->runOnAxmolThread([self, image, _filename, isRGBA] {
-                        image->saveToFile(_filename, !isRGBA);
-                        if (self->_saveFileCallback)
-                        {
-                            self->_saveFileCallback(self, _filename);
-                        }
-                    });
-                });
-            }
-            else
-            {
-                image->saveToFile(_filename, !isRGBA);
-                if (_saveFileCallback)
-                {
-                    _saveFileCallback(this, _filename);
-                }
-            }
-        }
-        else
-        {
-            if (_saveFileCallback)
-            {
-                _saveFileCallback(this, _filename);
-            }
+            done();
+            return;
         }
+
+        // encoding is the costly part, don't stall the frame with it
+        auto encode = [image, _filename, isRGBA, forceNonPMA] {
+            if (forceNonPMA && image->hasPremultipliedAlpha())
+                image->reversePremultipliedAlpha();
+            image->saveToFile(_filename, !isRGBA);
+        };
+        Director::getInstance()->getJobSystem()->enqueue(std::move(encode), std::move(done));
     };
     newImage(callbackFunc);
 }
@@ -166,6 +166,7 @@ public:
 
     /* Creates a new Image from with the texture's data.
      * Caller is responsible for releasing it by calling delete.
+     * The callback is invoked once the GPU copy completed, usually one or two frames later.
      *
      * @param eglCacheHint Whether for egl cache, internal use
      * @return An image.
@@ -35,6 +35,14 @@ THE SOFTWARE.
 #include "base/UTF8.h"
 #include "renderer/Renderer.h"
 
+#if defined(AX_ENABLE_3D)
+#    include "3d/AABBTree.h"
+#    include "3d/MeshRenderer.h"
+#    include "base/JobSystem.h"
+#    include <atomic>
+#    include <condition_variable>
+#endif
+
 #if defined(AX_ENABLE_PHYSICS)
 #    include "physics/PhysicsWorld.h"
 #endif
@@ -186,6 +194,10 @@ void Scene::render(Renderer* renderer, const Mat4& eyeTransform, const Mat4* eye
     Camera* defaultCamera = nullptr;
     const auto& transform = getNodeToParentTransform();
 
+#if defined(AX_ENABLE_3D)
+    updateSkeletons();
+#endif
+
     for (const auto& camera : getCameras())
     {
         if (!camera->isVisible())
@@ -211,12 +223,20 @@ void Scene::render(Renderer* renderer, const Mat4& eyeTransform, const Mat4* eye
         _director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
         _director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION,
                               Camera::_visitingCamera->getViewProjectionMatrix());
+#if defined(AX_ENABLE_3D)
+        // the frustum is computed lazily, build it here so the nodes visited in parallel only read it
+        camera->getFrustum();
+#    if AX_USE_CULLING
+        cullMeshRenderers(camera);
+#    endif
+#endif
 
         camera->apply();
         // clear background with max depth
         camera->clearBackground();
         // visit the scene
         visit(renderer, transform, 0);
+        renderer->processParallelVisits();
 #if defined(AX_ENABLE_NAVMESH)
         if (_navMesh && _navMeshDebugCamera == camera)
         {
@@ -260,6 +280,78 @@ void Scene::render(Renderer* renderer, const Mat4& eyeTransform, const Mat4* eye
     Camera::_visitingCamera = nullptr;
 }
 
+#if defined(AX_ENABLE_3D)
+AABBTree* Scene::getMeshCullingTree()
+{
+    if (!_meshCullingTree)
+        _meshCullingTree = std::make_unique<AABBTree>();
+    return _meshCullingTree.get();
+}
+
+void Scene::cullMeshRenderers(const Camera* camera)
+{
+    ++_cullingStamp;
+    if (!_meshCullingTree || _meshCullingTree->empty())
+        return;
+
+    // subtrees fully inside or outside the frustum are accepted or rejected at once
+    const auto stamp = _cullingStamp;
+    _meshCullingTree->query(camera->getFrustum(), [stamp](void* userData) {
+        static_cast<MeshRenderer*>(userData)->_cullingStamp = stamp;
+    });
+}
+
+void Scene::updateSkeletons()
+{
+    if (!MeshRenderer::isParallelSkinningEnabled() || _skinnedMeshRenderers.size() < 2)
+        return;
+
+    // The renderers drawn last frame are most likely visible again, the others are evaluated by their draw
+    const auto frame = _director->getTotalFrames();
+
+    // The main thread evaluates too, see Renderer::processParallelVisits
+    struct ParallelSkinningState
+    {
+        std::atomic<int> next{0};
+        int count{0};
+        int remaining{0};
+        std::vector<MeshRenderer*> renderers;
+        std::mutex mtx;
+        std::condition_variable cv;
+    };
+    auto state = std::make_shared<ParallelSkinningState>();
+    for (auto renderer : _skinnedMeshRenderers)
+    {
+        if (renderer->_skeletonFrame + 1 == frame && renderer->isVisible())
+            state->renderers.emplace_back(renderer);
+    }
+    state->count     = static_cast<int>(state->renderers.size());
+    state->remaining = state->count;
+    if (state->count < 2)
+        return;
+
+    auto pick = [state, frame]() {
+        for (int index; (index = state->next.fetch_add(1, std::memory_order_relaxed)) < state->count;)
+        {
+            state->renderers[index]->updateSkeleton(frame);
+
+            std::lock_guard<std::mutex> lck(state->mtx);
+            if (--state->remaining == 0)
+                state->cv.notify_all();
+        }
+    };
+
+    auto jobSystem  = _director->getJobSystem();
+    const int works = (std::min)(state->count, static_cast<int>(std::thread::hardware_concurrency())) - 1;
+    for (int i = 0; i < works; ++i)
+        jobSystem->enqueue(pick);
+    pick();
+
+    std::unique_lock<std::mutex> lck(state->mtx);
+    state->cv.wait(lck, [&state] { return state->remaining == 0; });
+}
+#endif
+
 void Scene::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags)
 {
     Node::visit(renderer, parentTransform, parentFlags);
@@ -269,6 +361,10 @@ void Scene::visit()
 {
     const auto eyeTransform = Mat4::IDENTITY;
 
+#if defined(AX_ENABLE_3D)
+    updateSkeletons();
+#endif
+
     for (const auto& camera : getCameras())
     {
         if (!camera->isVisible())
@@ -280,6 +376,13 @@ void Scene::visit()
         _director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
         _director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION,
                               Camera::_visitingCamera->getViewProjectionMatrix());
+#if defined(AX_ENABLE_3D)
+        // the frustum is computed lazily, build it here so the nodes visited in parallel only read it
+        camera->getFrustum();
+#    if AX_USE_CULLING
+        cullMeshRenderers(camera);
+#    endif
+#endif
 
         camera->apply();
         // clear background with max depth
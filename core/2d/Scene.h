@@ -31,6 +31,8 @@ THE SOFTWARE.
 #define __CCSCENE_H__
 
 #include <string>
+#include <memory>
+#include <mutex>
 #include "2d/Node.h"
 
 namespace ax
@@ -41,6 +43,10 @@ class BaseLight;
 class Renderer;
 class EventListenerCustom;
 class EventCustom;
+#if defined(AX_ENABLE_3D)
+class AABBTree;
+class MeshRenderer;
+#endif
 #if defined(AX_ENABLE_PHYSICS)
 class PhysicsWorld;
 #endif
@@ -142,6 +148,23 @@ protected:
     friend class Camera;
     friend class BaseLight;
     friend class Renderer;
+    friend class MeshRenderer;
+
+#if defined(AX_ENABLE_3D)
+    /** Queries the culling tree with the camera frustum, marking the MeshRenderers which may be visible. */
+    void cullMeshRenderers(const Camera* camera);
+    AABBTree* getMeshCullingTree();
+
+    // bounding volume hierarchy of the MeshRenderers of the scene, updated by the MeshRenderers on visit
+    std::unique_ptr<AABBTree> _meshCullingTree;
+    std::mutex _meshCullingMutex;  // MeshRenderers may be visited in parallel
+    uint32_t _cullingStamp = 0;     // incremented for each camera pass
+
+    /** Evaluates the skeletons of the skinned MeshRenderers drawn last frame on JobSystem workers. */
+    void updateSkeletons();
+
+    std::vector<MeshRenderer*> _skinnedMeshRenderers;  // weak refs, the running MeshRenderers with a skeleton
+#endif
 
     std::vector<Camera*> _cameras;     // weak ref to Camera
 
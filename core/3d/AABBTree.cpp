@@ -0,0 +1,363 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "3d/AABBTree.h"
+
+namespace ax
+{
+
+static AABB combineAABB(const AABB& a, const AABB& b)
+{
+    AABB aabb(a);
+    aabb.merge(b);
+    return aabb;
+}
+
+static float surfaceArea(const AABB& aabb)
+{
+    const Vec3 size = aabb._max - aabb._min;
+    return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+static bool containsAABB(const AABB& outer, const AABB& inner)
+{
+    return outer._min.x <= inner._min.x && outer._min.y <= inner._min.y && outer._min.z <= inner._min.z &&
+           inner._max.x <= outer._max.x && inner._max.y <= outer._max.y && inner._max.z <= outer._max.z;
+}
+
+AABBTree::AABBTree(float fatRatio) : _fatRatio(fatRatio) {}
+
+int AABBTree::allocateNode()
+{
+    int nodeId;
+    if (_freeList != NULL_NODE)
+    {
+        nodeId    = _freeList;
+        _freeList = _nodes[nodeId].parent;
+    }
+    else
+    {
+        nodeId = static_cast<int>(_nodes.size());
+        _nodes.emplace_back();
+    }
+
+    auto& node    = _nodes[nodeId];
+    node.userData = nullptr;
+    node.parent   = NULL_NODE;
+    node.child1   = NULL_NODE;
+    node.child2   = NULL_NODE;
+    node.height   = 0;
+    return nodeId;
+}
+
+void AABBTree::freeNode(int nodeId)
+{
+    auto& node    = _nodes[nodeId];
+    node.userData = nullptr;
+    node.parent   = _freeList;
+    node.height   = -1;
+    _freeList     = nodeId;
+}
+
+void AABBTree::fatten(AABB& aabb) const
+{
+    const Vec3 margin = (aabb._max - aabb._min) * _fatRatio;
+    aabb._min -= margin;
+    aabb._max += margin;
+}
+
+int AABBTree::createProxy(const AABB& aabb, void* userData)
+{
+    const int proxyId = allocateNode();
+    auto& node        = _nodes[proxyId];
+    node.aabb         = aabb;
+    node.userData     = userData;
+    fatten(node.aabb);
+
+    insertLeaf(proxyId);
+    return proxyId;
+}
+
+void AABBTree::destroyProxy(int proxyId)
+{
+    AXASSERT(proxyId >= 0 && proxyId < static_cast<int>(_nodes.size()) && _nodes[proxyId].isLeaf(),
+             "invalid proxy id");
+    removeLeaf(proxyId);
+    freeNode(proxyId);
+}
+
+bool AABBTree::moveProxy(int proxyId, const AABB& aabb)
+{
+    AXASSERT(proxyId >= 0 && proxyId < static_cast<int>(_nodes.size()) && _nodes[proxyId].isLeaf(),
+             "invalid proxy id");
+    if (containsAABB(_nodes[proxyId].aabb, aabb))
+        return false;
+
+    removeLeaf(proxyId);
+    _nodes[proxyId].aabb = aabb;
+    fatten(_nodes[proxyId].aabb);
+    insertLeaf(proxyId);
+    return true;
+}
+
+void AABBTree::insertLeaf(int leaf)
+{
+    if (_root == NULL_NODE)
+    {
+        _root               = leaf;
+        _nodes[leaf].parent = NULL_NODE;
+        return;
+    }
+
+    // find the best sibling, the one which grows the total surface area the least
+    const AABB leafAABB = _nodes[leaf].aabb;
+    int index           = _root;
+    while (!_nodes[index].isLeaf())
+    {
+        const auto& node = _nodes[index];
+
+        const float area         = surfaceArea(node.aabb);
+        const float combinedArea = surfaceArea(combineAABB(node.aabb, leafAABB));
+
+        // cost of creating a new parent for this node and the new leaf
+        const float cost = 2.0f * combinedArea;
+        // minimum cost of pushing the leaf further down the tree
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](int child) {
+            const auto& childNode = _nodes[child];
+            const float newArea   = surfaceArea(combineAABB(childNode.aabb, leafAABB));
+            return childNode.isLeaf() ? newArea + inheritanceCost
+                                      : (newArea - surfaceArea(childNode.aabb)) + inheritanceCost;
+        };
+        const float cost1 = descendCost(node.child1);
+        const float cost2 = descendCost(node.child2);
+
+        if (cost < cost1 && cost < cost2)
+            break;
+
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    const int sibling   = index;
+    const int oldParent = _nodes[sibling].parent;
+    const int newParent = allocateNode();
+
+    auto& parentNode  = _nodes[newParent];
+    parentNode.parent = oldParent;
+    parentNode.aabb   = combineAABB(leafAABB, _nodes[sibling].aabb);
+    parentNode.height = _nodes[sibling].height + 1;
+    parentNode.child1 = sibling;
+    parentNode.child2 = leaf;
+
+    if (oldParent != NULL_NODE)
+    {
+        if (_nodes[oldParent].child1 == sibling)
+            _nodes[oldParent].child1 = newParent;
+        else
+            _nodes[oldParent].child2 = newParent;
+    }
+    else
+    {
+        _root = newParent;
+    }
+    _nodes[sibling].parent = newParent;
+    _nodes[leaf].parent    = newParent;
+
+    // refit and rebalance the ancestors
+    index = _nodes[leaf].parent;
+    while (index != NULL_NODE)
+    {
+        index = balance(index);
+
+        auto& node  = _nodes[index];
+        node.height = 1 + (std::max)(_nodes[node.child1].height, _nodes[node.child2].height);
+        node.aabb   = combineAABB(_nodes[node.child1].aabb, _nodes[node.child2].aabb);
+
+        index = node.parent;
+    }
+}
+
+void AABBTree::removeLeaf(int leaf)
+{
+    if (leaf == _root)
+    {
+        _root = NULL_NODE;
+        return;
+    }
+
+    const int parent      = _nodes[leaf].parent;
+    const int grandParent = _nodes[parent].parent;
+    const int sibling     = _nodes[parent].child1 == leaf ? _nodes[parent].child2 : _nodes[parent].child1;
+
+    if (grandParent != NULL_NODE)
+    {
+        // the sibling takes the place of the parent
+        if (_nodes[grandParent].child1 == parent)
+            _nodes[grandParent].child1 = sibling;
+        else
+            _nodes[grandParent].child2 = sibling;
+        _nodes[sibling].parent = grandParent;
+        freeNode(parent);
+
+        int index = grandParent;
+        while (index != NULL_NODE)
+        {
+            index = balance(index);
+
+            auto& node  = _nodes[index];
+            node.aabb   = combineAABB(_nodes[node.child1].aabb, _nodes[node.child2].aabb);
+            node.height = 1 + (std::max)(_nodes[node.child1].height, _nodes[node.child2].height);
+
+            index = node.parent;
+        }
+    }
+    else
+    {
+        _root                  = sibling;
+        _nodes[sibling].parent = NULL_NODE;
+        freeNode(parent);
+    }
+}
+
+// Rotates the child subtree of iA which is higher by more than one level up, returns the new root of the subtree.
+int AABBTree::balance(int iA)
+{
+    TreeNode* A = &_nodes[iA];
+    if (A->isLeaf() || A->height < 2)
+        return iA;
+
+    const int iB = A->child1;
+    const int iC = A->child2;
+    TreeNode* B  = &_nodes[iB];
+    TreeNode* C  = &_nodes[iC];
+
+    const int heightDiff = C->height - B->height;
+
+    // rotate C up
+    if (heightDiff > 1)
+    {
+        const int iF = C->child1;
+        const int iG = C->child2;
+        TreeNode* F  = &_nodes[iF];
+        TreeNode* G  = &_nodes[iG];
+
+        // swap A and C
+        C->child1 = iA;
+        C->parent = A->parent;
+        A->parent = iC;
+
+        // A's old parent points to C
+        if (C->parent != NULL_NODE)
+        {
+            if (_nodes[C->parent].child1 == iA)
+                _nodes[C->parent].child1 = iC;
+            else
+                _nodes[C->parent].child2 = iC;
+        }
+        else
+        {
+            _root = iC;
+        }
+
+        // keep the higher of F and G under C
+        if (F->height > G->height)
+        {
+            C->child2 = iF;
+            A->child2 = iG;
+            G->parent = iA;
+            A->aabb   = combineAABB(B->aabb, G->aabb);
+            C->aabb   = combineAABB(A->aabb, F->aabb);
+            A->height = 1 + (std::max)(B->height, G->height);
+            C->height = 1 + (std::max)(A->height, F->height);
+        }
+        else
+        {
+            C->child2 = iG;
+            A->child2 = iF;
+            F->parent = iA;
+            A->aabb   = combineAABB(B->aabb, F->aabb);
+            C->aabb   = combineAABB(A->aabb, G->aabb);
+            A->height = 1 + (std::max)(B->height, F->height);
+            C->height = 1 + (std::max)(A->height, G->height);
+        }
+
+        return iC;
+    }
+
+    // rotate B up
+    if (heightDiff < -1)
+    {
+        const int iD = B->child1;
+        const int iE = B->child2;
+        TreeNode* D  = &_nodes[iD];
+        TreeNode* E  = &_nodes[iE];
+
+        // swap A and B
+        B->child1 = iA;
+        B->parent = A->parent;
+        A->parent = iB;
+
+        // A's old parent points to B
+        if (B->parent != NULL_NODE)
+        {
+            if (_nodes[B->parent].child1 == iA)
+                _nodes[B->parent].child1 = iB;
+            else
+                _nodes[B->parent].child2 = iB;
+        }
+        else
+        {
+            _root = iB;
+        }
+
+        // keep the higher of D and E under B
+        if (D->height > E->height)
+        {
+            B->child2 = iD;
+            A->child1 = iE;
+            E->parent = iA;
+            A->aabb   = combineAABB(C->aabb, E->aabb);
+            B->aabb   = combineAABB(A->aabb, D->aabb);
+            A->height = 1 + (std::max)(C->height, E->height);
+            B->height = 1 + (std::max)(A->height, D->height);
+        }
+        else
+        {
+            B->child2 = iE;
+            A->child1 = iD;
+            D->parent = iA;
+            A->aabb   = combineAABB(C->aabb, D->aabb);
+            B->aabb   = combineAABB(A->aabb, E->aabb);
+            A->height = 1 + (std::max)(C->height, D->height);
+            B->height = 1 + (std::max)(A->height, E->height);
+        }
+
+        return iB;
+    }
+
+    return iA;
+}
+
+}  // namespace ax
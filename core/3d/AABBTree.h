@@ -0,0 +1,147 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <vector>
+
+#include "3d/AABB.h"
+#include "3d/Frustum.h"
+
+namespace ax
+{
+
+/**
+ * @addtogroup _3d
+ * @{
+ */
+
+/**
+ * Dynamic bounding volume hierarchy of AABBs, used to cull whole groups of objects against a frustum at once.
+ * Leaves store a fat AABB, enlarged by a fraction of its size, so objects moving a little don't restructure the
+ * tree. Insertion picks the sibling by surface area and the tree is kept balanced by rotations.
+ * @js NA
+ * @lua NA
+ */
+class AX_DLL AABBTree
+{
+public:
+    static constexpr int NULL_NODE = -1;
+
+    /**
+     * @param fatRatio The leaves AABBs are enlarged by this fraction of their extents on each side.
+     */
+    explicit AABBTree(float fatRatio = 0.1f);
+
+    /** Adds a leaf, returns its proxy id. */
+    int createProxy(const AABB& aabb, void* userData);
+
+    void destroyProxy(int proxyId);
+
+    /**
+     * Updates the AABB of a leaf.
+     * @return true if the leaf had to be reinserted, false if the new AABB was still inside its fat AABB.
+     */
+    bool moveProxy(int proxyId, const AABB& aabb);
+
+    void* getUserData(int proxyId) const { return _nodes[proxyId].userData; }
+    const AABB& getFatAABB(int proxyId) const { return _nodes[proxyId].aabb; }
+
+    bool empty() const { return _root == NULL_NODE; }
+
+    /** The height of the tree, 0 for a single leaf. */
+    int getHeight() const { return _root != NULL_NODE ? _nodes[_root].height : 0; }
+
+    /**
+     * Calls visitor(userData) for each leaf whose fat AABB intersects the frustum.
+     * Subtrees fully inside the frustum aren't tested any further.
+     */
+    template <typename _Visitor>
+    void query(const Frustum& frustum, _Visitor&& visitor) const;
+
+protected:
+    struct TreeNode
+    {
+        AABB aabb;
+        void* userData;
+        int parent;  // next free node when the node is free
+        int child1;
+        int child2;
+        int height;  // 0 for leaves, -1 for free nodes
+
+        bool isLeaf() const { return child1 == NULL_NODE; }
+    };
+
+    int allocateNode();
+    void freeNode(int nodeId);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    int balance(int nodeId);
+    void fatten(AABB& aabb) const;
+
+    std::vector<TreeNode> _nodes;
+    int _root     = NULL_NODE;
+    int _freeList = NULL_NODE;
+    float _fatRatio;
+
+    struct QueryItem
+    {
+        int nodeId;
+        uint32_t planeMask;
+    };
+    mutable std::vector<QueryItem> _queryStack;
+};
+
+template <typename _Visitor>
+void AABBTree::query(const Frustum& frustum, _Visitor&& visitor) const
+{
+    if (_root == NULL_NODE)
+        return;
+
+    _queryStack.clear();
+    _queryStack.push_back(QueryItem{_root, frustum.getPlaneMask()});
+    while (!_queryStack.empty())
+    {
+        auto item = _queryStack.back();
+        _queryStack.pop_back();
+
+        auto& node = _nodes[item.nodeId];
+        if (item.planeMask && !frustum.intersectAABB(node.aabb, item.planeMask))
+            continue;
+
+        if (node.isLeaf())
+        {
+            visitor(node.userData);
+        }
+        else
+        {
+            _queryStack.push_back(QueryItem{node.child2, item.planeMask});
+            _queryStack.push_back(QueryItem{node.child1, item.planeMask});
+        }
+    }
+}
+
+// end of 3d group
+/** @} */
+
+}  // namespace ax
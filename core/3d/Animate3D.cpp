@@ -174,9 +174,8 @@ void Animate3D::startWithTarget(Node* target)
                         auto bone = skin->getBoneByName(boneName);
                         if (bone)
                         {
-                            auto curve        = _animation->getBoneCurveByName(boneName);
-                            _boneCurves[bone] = curve;
-                            hasCurve          = true;
+                            _boneCurves.push_back({bone, iter.second, -1, -1, -1});
+                            hasCurve = true;
                         }
                         else
                         {
@@ -186,14 +185,10 @@ void Animate3D::startWithTarget(Node* target)
                             else
                                 node = findChildByNameRecursively(target, boneName);
 
-                            if (node)
+                            if (node && iter.second)
                             {
-                                auto curve = _animation->getBoneCurveByName(boneName);
-                                if (curve)
-                                {
-                                    _nodeCurves[node] = curve;
-                                    hasCurve          = true;
-                                }
+                                _nodeCurves.push_back({node, iter.second, -1, -1, -1});
+                                hasCurve = true;
                             }
                         }
                     }
@@ -212,14 +207,10 @@ void Animate3D::startWithTarget(Node* target)
                 else
                     node = findChildByNameRecursively(target, boneName);
 
-                if (node)
+                if (node && iter.second)
                 {
-                    auto curve = _animation->getBoneCurveByName(boneName);
-                    if (curve)
-                    {
-                        _nodeCurves[node] = curve;
-                        hasCurve          = true;
-                    }
+                    _nodeCurves.push_back({node, iter.second, -1, -1, -1});
+                    hasCurve = true;
                 }
             }
         }
@@ -336,7 +327,6 @@ void Animate3D::update(float t)
             if (_weight > 0.0f)
             {
                 float transDst[3], rotDst[4], scaleDst[3];
-                float *trans = nullptr, *rot = nullptr, *scale = nullptr;
                 if (_playReverse)
                 {
                     t        = 1 - t;
@@ -346,50 +336,49 @@ void Animate3D::update(float t)
                 t        = _start + t * _last;
                 lastTime = _start + lastTime * _last;
 
-                for (const auto& it : _boneCurves)
+                for (auto& binding : _boneCurves)
                 {
-                    auto bone  = it.first;
-                    auto curve = it.second;
+                    auto curve   = binding.curve;
+                    float *trans = nullptr, *rot = nullptr, *scale = nullptr;
                     if (curve->translateCurve)
                     {
-                        curve->translateCurve->evaluate(t, transDst, _translateEvaluate);
+                        curve->translateCurve->evaluate(t, transDst, _translateEvaluate, binding.translateCursor);
                         trans = &transDst[0];
                     }
                     if (curve->rotCurve)
                     {
-                        curve->rotCurve->evaluate(t, rotDst, _roteEvaluate);
+                        curve->rotCurve->evaluate(t, rotDst, _roteEvaluate, binding.rotCursor);
                         rot = &rotDst[0];
                     }
                     if (curve->scaleCurve)
                     {
-                        curve->scaleCurve->evaluate(t, scaleDst, _scaleEvaluate);
+                        curve->scaleCurve->evaluate(t, scaleDst, _scaleEvaluate, binding.scaleCursor);
                         scale = &scaleDst[0];
                     }
-                    bone->setAnimationValue(trans, rot, scale, this, _weight);
+                    binding.target->setAnimationValue(trans, rot, scale, this, _weight);
                 }
 
-                for (const auto& it : _nodeCurves)
+                for (auto& binding : _nodeCurves)
                 {
-                    auto node  = it.first;
-                    auto curve = it.second;
+                    auto curve = binding.curve;
                     Mat4 transform;
                     if (curve->translateCurve)
                     {
-                        curve->translateCurve->evaluate(t, transDst, _translateEvaluate);
+                        curve->translateCurve->evaluate(t, transDst, _translateEvaluate, binding.translateCursor);
                         transform.translate(transDst[0], transDst[1], transDst[2]);
                     }
                     if (curve->rotCurve)
                     {
-                        curve->rotCurve->evaluate(t, rotDst, _roteEvaluate);
+                        curve->rotCurve->evaluate(t, rotDst, _roteEvaluate, binding.rotCursor);
                         Quaternion qua(rotDst[0], rotDst[1], rotDst[2], rotDst[3]);
                         transform.rotate(qua);
                     }
                     if (curve->scaleCurve)
                     {
-                        curve->scaleCurve->evaluate(t, scaleDst, _scaleEvaluate);
+                        curve->scaleCurve->evaluate(t, scaleDst, _scaleEvaluate, binding.scaleCursor);
                         transform.scale(scaleDst[0], scaleDst[1], scaleDst[2]);
                     }
-                    node->setAdditionalTransform(&transform);
+                    binding.target->setAdditionalTransform(&transform);
                 }
                 if (!_keyFrameUserInfos.empty())
                 {
@@ -169,8 +169,18 @@ protected:
     EvaluateType _scaleEvaluate;
     Animate3DQuality _quality;
 
-    std::unordered_map<Bone3D*, Animation3D::Curve*> _boneCurves;  // weak ref
-    std::unordered_map<Node*, Animation3D::Curve*> _nodeCurves;
+    /** a curve bound to its target once by startWithTarget, with the key cursors of its channels */
+    template <typename T>
+    struct CurveBinding
+    {
+        T* target;  // weak ref
+        Animation3D::Curve* curve;
+        int translateCursor;
+        int rotCursor;
+        int scaleCursor;
+    };
+    std::vector<CurveBinding<Bone3D>> _boneCurves;
+    std::vector<CurveBinding<Node>> _nodeCurves;
 
     std::unordered_map<int, ValueMap> _keyFrameUserInfos;
     std::unordered_map<int, EventCustom*> _keyFrameEvent;
@@ -32,6 +32,35 @@
 namespace ax
 {
 
+namespace
+{
+// a channel whose keys all hold the same value is stored as a single key
+template <typename T>
+int getDistinctKeyCount(const axstd::pod_vector<T>& values)
+{
+    for (size_t i = 1; i < values.size(); ++i)
+    {
+        if (memcmp(&values[i], &values[0], sizeof(T)) != 0)
+            return static_cast<int>(values.size());
+    }
+    return 1;
+}
+
+template <typename CurveType, typename T>
+CurveType* createCurve(axstd::pod_vector<float>& keys, axstd::pod_vector<T>& values)
+{
+    const int count = getDistinctKeyCount(values);
+    auto curve      = Animation3D::isKeyQuantizationEnabled() && count > 1
+                          ? CurveType::createQuantized(&keys[0], &values[0].x, count)
+                          : CurveType::create(&keys[0], &values[0].x, count);
+    if (curve)
+        curve->retain();
+    return curve;
+}
+}  // namespace
+
+bool Animation3D::_keyQuantizationEnabled = false;
+
 Animation3D* Animation3D::create(std::string_view fileName, std::string_view animationName)
 {
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(fileName);
@@ -128,9 +157,7 @@ bool Animation3D::init(const Animation3DData& data)
             axstd::resize_and_transform(iter.second.begin(), iter.second.end(), values,
                                         [](const auto& keyIter) { return keyIter._key; });
 
-            curve->translateCurve = Curve::AnimationCurveVec3::create(&keys[0], &values[0].x, (int)keys.size());
-            if (curve->translateCurve)
-                curve->translateCurve->retain();
+            curve->translateCurve = createCurve<Curve::AnimationCurveVec3>(keys, values);
         }
     }
 
@@ -154,9 +181,7 @@ bool Animation3D::init(const Animation3DData& data)
             axstd::resize_and_transform(iter.second.begin(), iter.second.end(), values,
                                         [](const auto& keyIter) { return keyIter._key; });
 
-            curve->rotCurve = Curve::AnimationCurveQuat::create(&keys[0], &values[0].x, (int)keys.size());
-            if (curve->rotCurve)
-                curve->rotCurve->retain();
+            curve->rotCurve = createCurve<Curve::AnimationCurveQuat>(keys, values);
         }
     }
 
@@ -180,9 +205,7 @@ bool Animation3D::init(const Animation3DData& data)
             axstd::resize_and_transform(iter.second.begin(), iter.second.end(), values,
                                         [](const auto& keyIter) { return keyIter._key; });
 
-            curve->scaleCurve = Curve::AnimationCurveVec3::create(&keys[0], &values[0].x, (int)keys.size());
-            if (curve->scaleCurve)
-                curve->scaleCurve->retain();
+            curve->scaleCurve = createCurve<Curve::AnimationCurveVec3>(keys, values);
         }
     }
 
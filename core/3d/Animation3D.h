@@ -93,10 +93,22 @@ public:
     /**init Animation3D with file name and animation name*/
     bool initWithFile(std::string_view filename, std::string_view animationName);
 
+    /** Store the keys of the animations loaded afterwards as 16 bit quantized values, disabled by default.
+     * Halves the memory of the curves, see AnimationCurve::createQuantized. Cached animations aren't affected.
+     * It is opt-in because the error grows with the range of a channel: a translation curve spanning 1000 units
+     * is off by up to 0.008 units, which shows on root motion and large scenes, and quantized rotations are no
+     * longer exactly unit quaternions. Enable it where animation memory matters more than that, e.g. on mobile
+     * with many skinned characters.
+     */
+    static void setKeyQuantizationEnabled(bool enabled) { _keyQuantizationEnabled = enabled; }
+    static bool isKeyQuantizationEnabled() { return _keyQuantizationEnabled; }
+
 protected:
     hlookup::string_map<Curve*> _boneCurves;  // bone curves map, key bone name, value AnimationCurve
 
     float _duration;  // animation duration
+
+    static bool _keyQuantizationEnabled;
 };
 
 /**
@@ -63,6 +63,12 @@ public:
     /**create animation curve*/
     static AnimationCurve* create(float* keytime, float* value, int count);
 
+    /**
+     * create animation curve storing each component as 16 bits, quantized over the range of its keys.
+     * Takes half the memory of create, the error is at most 1/131070 of the range of a component.
+     */
+    static AnimationCurve* createQuantized(float* keytime, float* value, int count);
+
     /**
      * evaluate value of time
      * @param time Time to be estimated
@@ -71,6 +77,16 @@ public:
      */
     void evaluate(float time, float* dst, EvaluateType type) const;
 
+    /**
+     * evaluate value of time, starting the key search from a cursor
+     * @param time Time to be estimated
+     * @param dst Estimated value of that time
+     * @param type EvaluateType
+     * @param cursor The key index found by the previous evaluation, -1 if none, updated with the new one.
+     * Sequential playback then finds its key in constant time.
+     */
+    void evaluate(float time, float* dst, EvaluateType type, int& cursor) const;
+
     /**set evaluate function, allow the user use own function*/
     void setEvaluateFun(std::function<void(float time, float* dst)> fun);
 
@@ -88,13 +104,29 @@ public:
      */
     int determineIndex(float time) const;
 
+    /**
+     * Determine index by time, checking the key at hint and the next one before searching.
+     */
+    int determineIndex(float time, int hint) const;
+
+    /**get key count*/
+    int getKeyCount() const { return _count; }
+
 protected:
+    /** the value of a key, decoded into buffer when quantized */
+    float* getKey(int index, float* buffer) const;
+
     float* _value;    //
     float* _keytime;  // key time(0 - 1), start time _keytime[0], end time _keytime[_count - 1]
     int _count;
     int _componentSizeByte;  // component size in byte, position and scale 3 * sizeof(float), rotation 4 * sizeof(float)
 
     std::function<void(float time, float* dst)> _evaluateFun;  // user defined function
+
+    // quantized keys, replace _value, each component is _quantizeMin + key * _quantizeStep
+    uint16_t* _quantizedValue;
+    float _quantizeMin[componentSize]{};
+    float _quantizeStep[componentSize]{};
 };
 
 // end of 3d group
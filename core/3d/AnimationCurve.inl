@@ -4,25 +4,38 @@ namespace ax
 
 template <int componentSize>
 void AnimationCurve<componentSize>::evaluate(float time, float* dst, EvaluateType type) const
+{
+    int cursor = -1;
+    evaluate(time, dst, type, cursor);
+}
+
+template <int componentSize>
+void AnimationCurve<componentSize>::evaluate(float time, float* dst, EvaluateType type, int& cursor) const
 {
     if (_count == 1 || time <= _keytime[0])
     {
-        memcpy(dst, _value, _componentSizeByte);
+        auto key = getKey(0, dst);
+        if (key != dst)
+            memcpy(dst, key, _componentSizeByte);
         return;
     }
     else if (time >= _keytime[_count - 1])
     {
-        memcpy(dst, &_value[(_count - 1) * componentSize], _componentSizeByte);
+        auto key = getKey(_count - 1, dst);
+        if (key != dst)
+            memcpy(dst, key, _componentSizeByte);
         return;
     }
 
-    unsigned int index = determineIndex(time);
+    unsigned int index = determineIndex(time, cursor);
+    cursor             = index;
 
     float scale = (_keytime[index + 1] - _keytime[index]);
     float t = (time - _keytime[index]) / scale;
 
-    float* fromValue = &_value[index * componentSize];
-    float* toValue = fromValue + componentSize;
+    float fromBuffer[componentSize], toBuffer[componentSize];
+    float* fromValue = getKey(index, fromBuffer);
+    float* toValue = getKey(index + 1, toBuffer);
 
     switch (type) {
         case EvaluateType::INT_LINEAR:
@@ -65,6 +78,18 @@ void AnimationCurve<componentSize>::evaluate(float time, float* dst, EvaluateTyp
     }
 }
 
+template <int componentSize>
+float* AnimationCurve<componentSize>::getKey(int index, float* buffer) const
+{
+    if (!_quantizedValue)
+        return &_value[index * componentSize];
+
+    auto quantized = &_quantizedValue[index * componentSize];
+    for (auto i = 0; i < componentSize; i++)
+        buffer[i] = _quantizeMin[i] + quantized[i] * _quantizeStep[i];
+    return buffer;
+}
+
 template <int componentSize>
 void AnimationCurve<componentSize>::setEvaluateFun(std::function<void(float time, float* dst)> fun)
 {
@@ -92,6 +117,44 @@ AnimationCurve<componentSize>* AnimationCurve<componentSize>::create(float* keyt
     return curve;
 }
 
+template <int componentSize>
+AnimationCurve<componentSize>* AnimationCurve<componentSize>::createQuantized(float* keytime, float* value, int count)
+{
+    AnimationCurve* curve = new AnimationCurve();
+    curve->_keytime = new float[count];
+    memcpy(curve->_keytime, keytime, count * sizeof(float));
+
+    for (auto i = 0; i < componentSize; i++)
+    {
+        float minValue = value[i], maxValue = value[i];
+        for (auto key = 1; key < count; key++)
+        {
+            minValue = std::min(minValue, value[key * componentSize + i]);
+            maxValue = std::max(maxValue, value[key * componentSize + i]);
+        }
+        curve->_quantizeMin[i]  = minValue;
+        curve->_quantizeStep[i] = (maxValue - minValue) / 65535.0f;
+    }
+
+    curve->_quantizedValue = new uint16_t[count * componentSize];
+    for (auto key = 0; key < count; key++)
+    {
+        for (auto i = 0; i < componentSize; i++)
+        {
+            const auto step = curve->_quantizeStep[i];
+            const auto offset = value[key * componentSize + i] - curve->_quantizeMin[i];
+            curve->_quantizedValue[key * componentSize + i] =
+                step > 0.0f ? static_cast<uint16_t>(std::min(std::lround(offset / step), 65535L)) : 0;
+        }
+    }
+
+    curve->_count = count;
+    curve->_componentSizeByte = componentSize * sizeof(float);
+
+    curve->autorelease();
+    return curve;
+}
+
 template <int componentSize>
 float AnimationCurve<componentSize>::getStartTime() const
 {
@@ -112,6 +175,7 @@ AnimationCurve<componentSize>::AnimationCurve()
 , _count(0)
 , _componentSizeByte(0)
 , _evaluateFun(nullptr)
+, _quantizedValue(nullptr)
 {
 
 }
@@ -120,6 +184,7 @@ AnimationCurve<componentSize>::~AnimationCurve()
 {
     AX_SAFE_DELETE_ARRAY(_keytime);
     AX_SAFE_DELETE_ARRAY(_value);
+    AX_SAFE_DELETE_ARRAY(_quantizedValue);
 }
 
 template <int componentSize>
@@ -145,4 +210,23 @@ int AnimationCurve<componentSize>::determineIndex(float time) const
     return -1;
 }
 
+template <int componentSize>
+int AnimationCurve<componentSize>::determineIndex(float time, int hint) const
+{
+    // sequential playback stays on the same key or moves to an adjacent one
+    if (hint >= 0 && hint < _count - 1)
+    {
+        if (time >= _keytime[hint])
+        {
+            if (time <= _keytime[hint + 1])
+                return hint;
+            if (hint + 2 < _count && time <= _keytime[hint + 2])
+                return hint + 1;
+        }
+        else if (hint > 0 && time >= _keytime[hint - 1])
+            return hint - 1;
+    }
+    return determineIndex(time);
+}
+
 }
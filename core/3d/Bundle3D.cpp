@@ -28,10 +28,18 @@ THE SOFTWARE.
 #include "3d/ObjLoader.h"
 
 #include "base/Macros.h"
+#include "base/Director.h"
+#include "base/JobSystem.h"
 #include "platform/FileUtils.h"
 #include "3d/BundleReader.h"
 #include "base/Data.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
 #define BUNDLE_TYPE_SCENE 1
 #define BUNDLE_TYPE_NODE 2
 #define BUNDLE_TYPE_ANIMATIONS 3
@@ -161,7 +169,7 @@ void Bundle3D::clear()
 {
     if (_isBinary)
     {
-        _binaryBuffer.clear();
+        _binaryBuffer.reset();
         AX_SAFE_DELETE_ARRAY(_references);
     }
     else
@@ -921,6 +929,84 @@ bool Bundle3D::loadMaterials(MaterialDatas& materialdatas)
     }
     return true;
 }
+bool Bundle3D::loadModelDatas(MeshDatas& meshdatas,
+                              MaterialDatas& materialdatas,
+                              NodeDatas& nodedatas,
+                              const TextureCallback& textureCallback)
+{
+    auto loadMaterialsAndTextures = [&materialdatas, &textureCallback](Bundle3D* bundle) {
+        if (!bundle->loadMaterials(materialdatas))
+            return false;
+        if (textureCallback)
+        {
+            // the materials often share textures, report each one once
+            std::unordered_set<std::string_view> reported;
+            for (const auto& material : materialdatas.materials)
+            {
+                for (const auto& texture : material.textures)
+                {
+                    if (!texture.filename.empty() && reported.emplace(texture.filename).second)
+                        textureCallback(texture.filename);
+                }
+            }
+        }
+        return true;
+    };
+
+    // the materials are small, parse them first so the textures load while the meshes decode
+    if (!_isBinary || !_parallelDecodeEnabled)
+        return loadMaterialsAndTextures(this) && loadMeshDatas(meshdatas) && loadNodes(nodedatas);
+
+    // Each section is decoded by a bundle of its own over the shared mapping, the calling thread decodes too
+    constexpr int count = 3;  // meshes, materials, nodes
+    struct ParallelDecodeState
+    {
+        std::atomic<int> next{0};
+        int remaining{count};
+        Bundle3D bundles[count];
+        bool results[count]{};
+        std::mutex mtx;
+        std::condition_variable cv;
+    };
+    auto state = std::make_shared<ParallelDecodeState>();
+    for (auto& bundle : state->bundles)
+        bundle.shareBinary(*this);
+
+    // only invoked while the calling thread waits, the late workers find nothing left to pick
+    auto decode = [&, state](int index) {
+        auto bundle = &state->bundles[index];
+        switch (index)
+        {
+        case 0:
+            return bundle->loadMeshDatas(meshdatas);
+        case 1:
+            return loadMaterialsAndTextures(bundle);
+        default:
+            return bundle->loadNodes(nodedatas);
+        }
+    };
+    auto pick = [state, decode]() {
+        for (int index; (index = state->next.fetch_add(1, std::memory_order_relaxed)) < count;)
+        {
+            state->results[index] = decode(index);
+
+            std::lock_guard<std::mutex> lck(state->mtx);
+            if (--state->remaining == 0)
+                state->cv.notify_all();
+        }
+    };
+
+    auto jobSystem  = Director::getInstance()->getJobSystem();
+    const int works = (std::min)(count, static_cast<int>(std::thread::hardware_concurrency())) - 1;
+    for (int i = 0; i < works; ++i)
+        jobSystem->enqueue(pick);
+    pick();
+
+    std::unique_lock<std::mutex> lck(state->mtx);
+    state->cv.wait(lck, [&state] { return state->remaining == 0; });
+    return state->results[0] && state->results[1] && state->results[2];
+}
+
 bool Bundle3D::loadMaterialsBinary(MaterialDatas& materialdatas)
 {
     if (!seekToFirstType(BUNDLE_TYPE_MATERIAL))
@@ -1088,10 +1174,9 @@ bool Bundle3D::loadBinary(std::string_view path)
 {
     clear();
 
-    // get file data
-    _binaryBuffer.clear();
-    _binaryBuffer = FileUtils::getInstance()->getDataFromFile(path);
-    if (_binaryBuffer.isNull())
+    // get file data, the reader parses the mapped file in place
+    _binaryBuffer = FileUtils::getInstance()->mapFile(path);
+    if (!_binaryBuffer)
     {
         clear();
         AXLOGW("warning: Failed to read file: {}", path);
@@ -1099,7 +1184,7 @@ bool Bundle3D::loadBinary(std::string_view path)
     }
 
     // Initialise bundle reader
-    _binaryReader.init((char*)_binaryBuffer.getBytes(), _binaryBuffer.getSize());
+    _binaryReader.init((char*)_binaryBuffer->data(), static_cast<ssize_t>(_binaryBuffer->size()));
 
     // Read identifier info
     char identifier[] = {'C', '3', 'B', '\0'};
@@ -1150,6 +1235,21 @@ bool Bundle3D::loadBinary(std::string_view path)
     return true;
 }
 
+void Bundle3D::shareBinary(const Bundle3D& other)
+{
+    clear();
+
+    _isBinary       = true;
+    _path           = other._path;
+    _modelPath      = other._modelPath;
+    _version        = other._version;
+    _binaryBuffer   = other._binaryBuffer;
+    _referenceCount = other._referenceCount;
+    _references     = new Reference[_referenceCount];
+    std::copy_n(other._references, _referenceCount, _references);
+    _binaryReader.init((char*)_binaryBuffer->data(), static_cast<ssize_t>(_binaryBuffer->size()));
+}
+
 bool Bundle3D::loadMeshDataJson_0_1(MeshDatas& meshdatas)
 {
     const rapidjson::Value& mesh_data_array = _jsonReader[MESH];
@@ -2313,6 +2413,8 @@ std::vector<Vec3> Bundle3D::getTrianglesList(std::string_view path)
     return trianglesList;
 }
 
+bool Bundle3D::_parallelDecodeEnabled = true;
+
 Bundle3D::Bundle3D()
     : _modelPath(""), _path(""), _version(""), _referenceCount(0), _references(nullptr), _isBinary(false)
 {}
@@ -27,6 +27,8 @@
 #ifndef __CCBUNDLE3D_H__
 #define __CCBUNDLE3D_H__
 
+#include <functional>
+
 #include "base/Data.h"
 #include "3d/Bundle3DData.h"
 #include "3d/BundleReader.h"
@@ -43,6 +45,7 @@ namespace ax
  */
 
 class Animation3D;
+class FileMapping;
 
 /**
  * @brief Defines a bundle file that contains a collection of assets. Mesh, Material, MeshSkin, Animation
@@ -102,6 +105,23 @@ public:
     // since 3.3, to support reskin
     virtual bool loadMaterials(MaterialDatas& materialdatas);
 
+    /** Invoked with the path of each texture referenced by the materials, see loadModelDatas */
+    using TextureCallback = std::function<void(std::string_view)>;
+
+    /**
+     * load the meshes, materials and nodes of the bundle, the sections of a c3b file are decoded concurrently
+     * @param textureCallback Invoked from the decoding thread once the materials are parsed, so that the textures
+     * can be prefetched while the meshes are still decoding
+     */
+    virtual bool loadModelDatas(MeshDatas& meshdatas,
+                                MaterialDatas& materialdatas,
+                                NodeDatas& nodedatas,
+                                const TextureCallback& textureCallback = nullptr);
+
+    /** Enables or disables decoding the sections of c3b files on the JobSystem, enabled by default */
+    static void setParallelDecodeEnabled(bool enabled) { _parallelDecodeEnabled = enabled; }
+    static bool isParallelDecodeEnabled() { return _parallelDecodeEnabled; }
+
     /**
      * load triangle list
      * @param path the file path to load
@@ -184,6 +204,12 @@ protected:
      */
     Reference* seekToFirstType(unsigned int type, std::string_view id = "");
 
+    /*
+     * read the same c3b file as another bundle, with a reader of its own over the shared mapping
+     * @param other The loaded binary bundle
+     */
+    void shareBinary(const Bundle3D& other);
+
 protected:
     std::string _modelPath;
     std::string _path;
@@ -194,11 +220,13 @@ protected:
     rapidjson::Document _jsonReader;
 
     // for binary reading
-    Data _binaryBuffer;
+    std::shared_ptr<FileMapping> _binaryBuffer;
     BundleReader _binaryReader;
     unsigned int _referenceCount;
     Reference* _references;
     bool _isBinary;
+
+    static bool _parallelDecodeEnabled;
 };
 
 // end of 3d group
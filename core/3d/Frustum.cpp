@@ -81,6 +81,41 @@ bool Frustum::isOutOfFrustum(const OBB& obb) const
     return false;
 }
 
+bool Frustum::intersectAABB(const AABB& aabb, uint32_t& planeMask) const
+{
+    const float centerX = (aabb._min.x + aabb._max.x) * 0.5f;
+    const float centerY = (aabb._min.y + aabb._max.y) * 0.5f;
+    const float centerZ = (aabb._min.z + aabb._max.z) * 0.5f;
+    const float extentX = (aabb._max.x - aabb._min.x) * 0.5f;
+    const float extentY = (aabb._max.y - aabb._min.y) * 0.5f;
+    const float extentZ = (aabb._max.z - aabb._min.z) * 0.5f;
+
+    // signed distances of the nearest and farthest corners to every plane, branchless so it vectorizes
+    alignas(32) float nearDist[8];
+    alignas(32) float farDist[8];
+    for (int i = 0; i < 8; ++i)
+    {
+        const float dist = _planeNormalX[i] * centerX + _planeNormalY[i] * centerY + _planeNormalZ[i] * centerZ -
+                           _planeDist[i];
+        const float radius =
+            _planeAbsNormalX[i] * extentX + _planeAbsNormalY[i] * extentY + _planeAbsNormalZ[i] * extentZ;
+        nearDist[i] = dist - radius;
+        farDist[i]  = dist + radius;
+    }
+
+    for (int i = 0; i < 6; ++i)
+    {
+        const uint32_t bit = 1u << i;
+        if (!(planeMask & bit))
+            continue;
+        if (nearDist[i] > 0)
+            return false;
+        if (farDist[i] <= 0)
+            planeMask &= ~bit;
+    }
+    return true;
+}
+
 void Frustum::createPlane(const Camera* camera)
 {
     const Mat4& mat = camera->getViewProjectionMatrix();
@@ -98,6 +133,18 @@ void Frustum::createPlane(const Camera* camera)
                         (mat.m[15] + mat.m[14]));  // near
     _plane[5].initPlane(-Vec3(mat.m[3] - mat.m[2], mat.m[7] - mat.m[6], mat.m[11] - mat.m[10]),
                         (mat.m[15] - mat.m[14]));  // far
+
+    for (int i = 0; i < 6; ++i)
+    {
+        const Vec3& normal  = _plane[i].getNormal();
+        _planeNormalX[i]    = normal.x;
+        _planeNormalY[i]    = normal.y;
+        _planeNormalZ[i]    = normal.z;
+        _planeAbsNormalX[i] = std::abs(normal.x);
+        _planeAbsNormalY[i] = std::abs(normal.y);
+        _planeAbsNormalZ[i] = std::abs(normal.z);
+        _planeDist[i]       = _plane[i].getDist();
+    }
 }
 
 }
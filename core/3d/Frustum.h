@@ -68,6 +68,19 @@ public:
      */
     bool isOutOfFrustum(const OBB& obb) const;
 
+    /**
+     * The mask of the planes to test with intersectAABB, one bit per plane, 0 if the frustum isn't initialized.
+     */
+    uint32_t getPlaneMask() const { return _initialized ? (_clipZ ? 0x3Fu : 0x0Fu) : 0u; }
+
+    /**
+     * Tests an aabb against the planes in planeMask, all of them at once.
+     * The bits of the planes the aabb is fully inside of are cleared from planeMask, so the children of a
+     * bounding volume hierarchy node only need to be tested against the remaining ones, none once it's 0.
+     * @return false if the aabb is out of frustum.
+     */
+    bool intersectAABB(const AABB& aabb, uint32_t& planeMask) const;
+
     /**
      * get & set z clip. if bclipZ == true use near and far plane
      */
@@ -81,6 +94,15 @@ protected:
     void createPlane(const Camera* camera);
 
     Plane _plane[6];  // clip plane, left, right, top, bottom, near, far
+
+    // the planes as structure of arrays, padded to 8 lanes for intersectAABB
+    alignas(32) float _planeNormalX[8]{};
+    alignas(32) float _planeNormalY[8]{};
+    alignas(32) float _planeNormalZ[8]{};
+    alignas(32) float _planeAbsNormalX[8]{};
+    alignas(32) float _planeAbsNormalY[8]{};
+    alignas(32) float _planeAbsNormalZ[8]{};
+    alignas(32) float _planeDist[8]{};
     bool _clipZ;      // use near and far clip plane
     bool _initialized;
 };
@@ -519,7 +519,12 @@ void Mesh::draw(Renderer* renderer,
         pass->setUniformColor(&color, sizeof(color));
 
         if (_skin)
-            pass->setUniformMatrixPalette(_skin->getMatrixPalette(), _skin->getMatrixPaletteSizeInBytes());
+        {
+            if (_instancing)
+                pass->setUniformMatrixPaletteTexture(2, _skin->getMatrixPaletteTexture());
+            else
+                pass->setUniformMatrixPalette(_skin->getMatrixPalette(), _skin->getMatrixPaletteSizeInBytes());
+        }
 
         if (scene && !scene->getLights().empty())
         {
@@ -50,6 +50,7 @@ MeshMaterial* MeshMaterial::_diffuseNoTexMaterial  = nullptr;
 MeshMaterial* MeshMaterial::_bumpedDiffuseMaterial = nullptr;
 
 MeshMaterial* MeshMaterial::_unLitMaterialSkin         = nullptr;
+MeshMaterial* MeshMaterial::_unLitInstanceMaterialSkin = nullptr;
 MeshMaterial* MeshMaterial::_vertexLitMaterialSkin     = nullptr;
 MeshMaterial* MeshMaterial::_diffuseMaterialSkin       = nullptr;
 MeshMaterial* MeshMaterial::_bumpedDiffuseMaterialSkin = nullptr;
@@ -66,6 +67,7 @@ backend::ProgramState* MeshMaterial::_diffuseNoTexMaterialProgState  = nullptr;
 backend::ProgramState* MeshMaterial::_bumpedDiffuseMaterialProgState = nullptr;
 
 backend::ProgramState* MeshMaterial::_unLitMaterialSkinProgState         = nullptr;
+backend::ProgramState* MeshMaterial::_unLitInstanceMaterialSkinProgState = nullptr;
 backend::ProgramState* MeshMaterial::_vertexLitMaterialSkinProgState     = nullptr;
 backend::ProgramState* MeshMaterial::_diffuseMaterialSkinProgState       = nullptr;
 backend::ProgramState* MeshMaterial::_bumpedDiffuseMaterialSkinProgState = nullptr;
@@ -115,6 +117,15 @@ void MeshMaterial::createBuiltInMaterial()
         _unLitInstanceMaterial->_type = MeshMaterial::MaterialType::UNLIT_INSTANCE;
     }
 
+    program = backend::Program::getBuiltinProgram(backend::ProgramType::SKINPOSITION_TEXTURE_3D_INSTANCE);
+    _unLitInstanceMaterialSkinProgState = new backend::ProgramState(program);
+    _unLitInstanceMaterialSkin          = new MeshMaterial();
+    if (_unLitInstanceMaterialSkin &&
+        _unLitInstanceMaterialSkin->initWithProgramState(_unLitInstanceMaterialSkinProgState))
+    {
+        _unLitInstanceMaterialSkin->_type = MeshMaterial::MaterialType::UNLIT_INSTANCE;
+    }
+
     program                      = backend::Program::getBuiltinProgram(backend::ProgramType::POSITION_3D);
     _unLitNoTexMaterialProgState = new backend::ProgramState(program);
     _unLitNoTexMaterial          = new MeshMaterial();
@@ -169,6 +180,8 @@ void MeshMaterial::releaseBuiltInMaterial()
 {
     AX_SAFE_RELEASE_NULL(_unLitMaterial);
     AX_SAFE_RELEASE_NULL(_unLitMaterialSkin);
+    AX_SAFE_RELEASE_NULL(_unLitInstanceMaterial);
+    AX_SAFE_RELEASE_NULL(_unLitInstanceMaterialSkin);
 
     AX_SAFE_RELEASE_NULL(_unLitNoTexMaterial);
     AX_SAFE_RELEASE_NULL(_vertexLitMaterial);
@@ -188,6 +201,8 @@ void MeshMaterial::releaseBuiltInMaterial()
     AX_SAFE_RELEASE_NULL(_bumpedDiffuseMaterialProgState);
 
     AX_SAFE_RELEASE_NULL(_unLitMaterialSkinProgState);
+    AX_SAFE_RELEASE_NULL(_unLitInstanceMaterialProgState);
+    AX_SAFE_RELEASE_NULL(_unLitInstanceMaterialSkinProgState);
     AX_SAFE_RELEASE_NULL(_vertexLitMaterialSkinProgState);
     AX_SAFE_RELEASE_NULL(_diffuseMaterialSkinProgState);
     AX_SAFE_RELEASE_NULL(_bumpedDiffuseMaterialSkinProgState);
@@ -243,7 +258,7 @@ MeshMaterial* MeshMaterial::createBuiltInMaterial(MaterialType type, bool skinne
         break;
 
     case MeshMaterial::MaterialType::UNLIT_INSTANCE:
-        material = skinned ? /* TODO: implement instanced hardware skinning */ nullptr : _unLitInstanceMaterial;
+        material = skinned ? _unLitInstanceMaterialSkin : _unLitInstanceMaterial;
         break;
 
     case MeshMaterial::MaterialType::UNLIT_NOTEX:
@@ -147,6 +147,7 @@ protected:
     static MeshMaterial* _bumpedDiffuseMaterial;
 
     static MeshMaterial* _unLitMaterialSkin;
+    static MeshMaterial* _unLitInstanceMaterialSkin;
     static MeshMaterial* _vertexLitMaterialSkin;
     static MeshMaterial* _diffuseMaterialSkin;
     static MeshMaterial* _bumpedDiffuseMaterialSkin;
@@ -163,6 +164,7 @@ protected:
     static backend::ProgramState* _bumpedDiffuseMaterialProgState;
 
     static backend::ProgramState* _unLitMaterialSkinProgState;
+    static backend::ProgramState* _unLitInstanceMaterialSkinProgState;
     static backend::ProgramState* _vertexLitMaterialSkinProgState;
     static backend::ProgramState* _diffuseMaterialSkinProgState;
     static backend::ProgramState* _bumpedDiffuseMaterialSkinProgState;
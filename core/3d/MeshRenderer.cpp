@@ -31,6 +31,7 @@
 #include "3d/MeshMaterial.h"
 #include "3d/AttachNode.h"
 #include "3d/Mesh.h"
+#include "3d/AABBTree.h"
 
 #include "base/Director.h"
 #include "base/UTF8.h"
@@ -51,6 +52,8 @@ namespace ax
 
 static MeshMaterial* getMeshRendererMaterialForAttribs(MeshVertexData* meshVertexData, bool usesLight);
 
+bool MeshRenderer::__parallelSkinningEnabled = false;
+
 MeshRenderer* MeshRenderer::create()
 {
     auto mesh = new MeshRenderer();
@@ -114,12 +117,22 @@ void MeshRenderer::createAsync(std::string_view modelPath,
     meshRenderer->_asyncLoadParam.meshdatas         = new MeshDatas();
     meshRenderer->_asyncLoadParam.nodeDatas         = new NodeDatas();
 
+    // The textures are requested from the main thread as soon as the materials are parsed, and decoded by the
+    // TextureCache while the meshes are still decoding. The load doesn't wait for them: their callbacks can be
+    // unbound by anyone through TextureCache::unbindAllImageAsync, a texture still decoding when initFrom runs is
+    // then loaded synchronously like before.
     auto director = Director::getInstance();
     director->getJobSystem()->enqueue(
         [director, meshRenderer] {
+        auto prefetchTexture = [director](std::string_view path) {
+            director->getScheduler()->runOnAxmolThread([director, path = std::string{path}] {
+                director->getTextureCache()->addImageAsync(path, nullptr);
+            });
+        };
+
         auto& loadParam  = meshRenderer->_asyncLoadParam;
         loadParam.result = meshRenderer->loadFromFile(loadParam.modelFullPath, loadParam.nodeDatas, loadParam.meshdatas,
-                                                      loadParam.materialdatas);
+                                                      loadParam.materialdatas, prefetchTexture);
     },
         [meshRenderer] { meshRenderer->afterAsyncLoad(&meshRenderer->_asyncLoadParam); });
 }
@@ -236,7 +249,8 @@ bool MeshRenderer::loadFromCache(std::string_view path)
 bool MeshRenderer::loadFromFile(std::string_view path,
                                 NodeDatas* nodedatas,
                                 MeshDatas* meshdatas,
-                                MaterialDatas* materialdatas)
+                                MaterialDatas* materialdatas,
+                                const std::function<void(std::string_view)>& textureCallback)
 {
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(path);
 
@@ -255,8 +269,7 @@ bool MeshRenderer::loadFromFile(std::string_view path,
             return false;
         }
 
-        auto ret =
-            bundle->loadMeshDatas(*meshdatas) && bundle->loadMaterials(*materialdatas) && bundle->loadNodes(*nodedatas);
+        auto ret = bundle->loadModelDatas(*meshdatas, *materialdatas, *nodedatas, textureCallback);
         Bundle3D::destroyBundle(bundle);
 
         return ret;
@@ -705,14 +718,22 @@ void MeshRenderer::enableInstancing(MeshMaterial::InstanceMaterialType instanceM
     {
     case MeshMaterial::InstanceMaterialType::UNLIT_INSTANCE:
     {
-        auto mat = MeshMaterial::createBuiltInMaterial(MeshMaterial::MaterialType::UNLIT_INSTANCE, false);
-        enableInstancing(mat, count);
+        _instancingEnabled = true;
+        for (auto&& mesh : _meshes)
+        {
+            // skinned meshes read their joints from MeshSkin::getMatrixPaletteTexture
+            auto mat = MeshMaterial::createBuiltInMaterial(MeshMaterial::MaterialType::UNLIT_INSTANCE,
+                                                           mesh->getSkin() != nullptr);
+            mesh->enableInstancing(true, MAX(1, count));
+            mesh->setMaterial(mat);
+        }
     }
     }
 }
 
 void MeshRenderer::enableInstancing(MeshMaterial* instanceMat, int count)
 {
+    _instancingEnabled = true;
     for (auto&& mesh : _meshes)
     {
         mesh->enableInstancing(true, MAX(1, count));
@@ -722,6 +743,7 @@ void MeshRenderer::enableInstancing(MeshMaterial* instanceMat, int count)
 
 void MeshRenderer::disableInstancing()
 {
+    _instancingEnabled = false;
     for (auto&& mesh : _meshes)
         mesh->enableInstancing(false, 0);
 }
@@ -820,6 +842,10 @@ void MeshRenderer::visit(ax::Renderer* renderer, const ax::Mat4& parentTransform
     uint32_t flags = processParentFlags(parentTransform, parentFlags);
     flags |= FLAGS_RENDER_AS_3D;
 
+#if AX_USE_CULLING
+    updateCullingProxy(flags);
+#endif
+
     //
     _director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
     _director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
@@ -859,15 +885,13 @@ void MeshRenderer::visit(ax::Renderer* renderer, const ax::Mat4& parentTransform
 void MeshRenderer::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 {
 #if AX_USE_CULLING
-    // TODO new-renderer: interface isVisibleInFrustum removal
-    //  camera clipping
-//    if(_children.empty() && Camera::getVisitingCamera() &&
-//    !Camera::getVisitingCamera()->isVisibleInFrustum(&getAABB()))
-//        return;
+    // camera clipping
+    if (isCulledByVisitingCamera())
+        return;
 #endif
 
     if (_skeleton)
-        _skeleton->updateBoneMatrix();
+        updateSkeleton(_director->getTotalFrames());
 
     Color4F color(getDisplayedColor());
     color.a = getDisplayedOpacity() / 255.0f;
@@ -899,6 +923,132 @@ void MeshRenderer::draw(Renderer* renderer, const Mat4& transform, uint32_t flag
     }
 }
 
+void MeshRenderer::onEnter()
+{
+    Node::onEnter();
+    if (_skeleton)
+        addToSkinnedMeshRenderers();
+#if AX_USE_CULLING
+    // the leaf is created on the next visit
+    _cullingScene = getScene();
+    _cullingFrame = 0;
+#endif
+}
+
+void MeshRenderer::onExit()
+{
+#if AX_USE_CULLING
+    removeCullingProxy();
+#endif
+    removeFromSkinnedMeshRenderers();
+    Node::onExit();
+}
+
+void MeshRenderer::setParallelSkinningEnabled(bool enabled)
+{
+    __parallelSkinningEnabled = enabled;
+}
+
+bool MeshRenderer::isParallelSkinningEnabled()
+{
+    return __parallelSkinningEnabled;
+}
+
+void MeshRenderer::updateSkeleton(unsigned int frame)
+{
+    // several cameras draw the same pose
+    if (_skeletonFrame == frame)
+        return;
+    _skeletonFrame = frame;
+
+    _skeleton->updateBoneMatrix();
+    for (auto&& mesh : _meshes)
+    {
+        if (auto skin = mesh->getSkin())
+            skin->getMatrixPalette();
+    }
+}
+
+void MeshRenderer::addToSkinnedMeshRenderers()
+{
+    auto scene = getScene();
+    if (_skinningScene == scene)
+        return;
+    removeFromSkinnedMeshRenderers();
+    if (!scene)
+        return;
+
+    _skinningScene = scene;
+    _skinningIndex = static_cast<int>(scene->_skinnedMeshRenderers.size());
+    scene->_skinnedMeshRenderers.emplace_back(this);
+}
+
+void MeshRenderer::removeFromSkinnedMeshRenderers()
+{
+    if (!_skinningScene)
+        return;
+
+    // swap with the last one
+    auto& renderers = _skinningScene->_skinnedMeshRenderers;
+    renderers.back()->_skinningIndex = _skinningIndex;
+    renderers[_skinningIndex]        = renderers.back();
+    renderers.pop_back();
+
+    _skinningScene = nullptr;
+    _skinningIndex = -1;
+}
+
+void MeshRenderer::updateCullingProxy(uint32_t flags)
+{
+    // The visit may have been skipped by an invisible ancestor, which moved meanwhile
+    const auto frame = _director->getTotalFrames();
+    _cullingMoved    = (flags & FLAGS_DIRTY_MASK) || _aabbDirty || _cullingFrame + 1 < frame ||
+                       _cullingProxy == AABBTree::NULL_NODE;
+    _cullingFrame    = frame;
+    if (!_cullingMoved || !_cullingScene)
+        return;
+
+    const auto& aabb = getAABB();
+
+    std::lock_guard<std::mutex> lock(_cullingScene->_meshCullingMutex);
+    auto tree = _cullingScene->getMeshCullingTree();
+    if (aabb.isEmpty())
+    {
+        if (_cullingProxy != AABBTree::NULL_NODE)
+            tree->destroyProxy(_cullingProxy);
+        _cullingProxy = AABBTree::NULL_NODE;
+    }
+    else if (_cullingProxy == AABBTree::NULL_NODE)
+        _cullingProxy = tree->createProxy(aabb, this);
+    else
+        tree->moveProxy(_cullingProxy, aabb);
+}
+
+void MeshRenderer::removeCullingProxy()
+{
+    if (_cullingScene && _cullingProxy != AABBTree::NULL_NODE)
+    {
+        std::lock_guard<std::mutex> lock(_cullingScene->_meshCullingMutex);
+        _cullingScene->getMeshCullingTree()->destroyProxy(_cullingProxy);
+    }
+    _cullingProxy = AABBTree::NULL_NODE;
+    _cullingScene = nullptr;
+}
+
+bool MeshRenderer::isCulledByVisitingCamera() const
+{
+    auto camera = Camera::getVisitingCamera();
+    if (!camera || _instancingEnabled)
+        return false;
+
+    // The culling tree of the scene was queried with the camera frustum before the visit,
+    // the renderers which moved since then are tested on their own
+    if (_cullingProxy != AABBTree::NULL_NODE && !_cullingMoved)
+        return _cullingStamp != _cullingScene->_cullingStamp;
+
+    return !camera->isVisibleInFrustum(&getAABB());
+}
+
 bool MeshRenderer::setProgramState(backend::ProgramState* programState, bool ownPS /* = false*/)
 {
     if (Node::setProgramState(programState, ownPS))
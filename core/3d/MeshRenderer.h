@@ -77,7 +77,8 @@ public:
      * If the 3d model was previously loaded, it will create a new 3d mesh and the callback will be called once.
      * Otherwise it will load the model file in a new thread, and when the 3d mesh is loaded, the callback will be
      * called with the created MeshRenderer and a user-defined parameter. The callback will be called from the main thread,
-     * so it is safe to create any object from the callback.
+     * so it is safe to create any object from the callback. The textures referenced by the materials are requested
+     * from the TextureCache as soon as they are parsed, so they decode while the meshes are still loading.
      * @param modelPath model to be loaded
      * @param callback callback when loading is finished
      * @param callbackparam user-defined parameter for the callback
@@ -116,6 +117,14 @@ public:
 
     Skeleton3D* getSkeleton() const { return _skeleton; }
 
+    /** Evaluate the skeletons of the skinned MeshRenderers drawn last frame on JobSystem workers, disabled by
+     * default. While enabled, each running scene evaluates them concurrently before it's visited, matrix palettes
+     * included, draw then only evaluates the skeletons which just became visible. Animations must only drive the
+     * bones of their own skeleton.
+     */
+    static void setParallelSkinningEnabled(bool enabled);
+    static bool isParallelSkinningEnabled();
+
     /** return an AttachNode by bone name. Otherwise, return nullptr if it doesn't exist */
     AttachNode* getAttachNode(std::string_view boneName);
 
@@ -224,8 +233,13 @@ public:
     bool loadFromCache(std::string_view path);
 
     /** load a file and feed it's content into meshedatas, nodedatas and materialdatas, obj file and .mtl file
-     should be in the same directory. */
-    bool loadFromFile(std::string_view path, NodeDatas* nodedatas, MeshDatas* meshdatas, MaterialDatas* materialdatas);
+     should be in the same directory. textureCallback is invoked with the texture paths of c3b and c3t files,
+     see Bundle3D::loadModelDatas */
+    bool loadFromFile(std::string_view path,
+                      NodeDatas* nodedatas,
+                      MeshDatas* meshdatas,
+                      MaterialDatas* materialdatas,
+                      const std::function<void(std::string_view)>& textureCallback = nullptr);
 
     /**
      * Visits this MeshRenderer's children and draws them recursively.
@@ -234,6 +248,9 @@ public:
      */
     virtual void visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags) override;
 
+    virtual void onEnter() override;
+    virtual void onExit() override;
+
     /** generate default material. */
     void genMaterial(bool useLight = false);
 
@@ -250,8 +267,19 @@ public:
 
     void afterAsyncLoad(void* param);
 
+    /** Updates the leaf of this MeshRenderer in the culling tree of its scene if it moved since the last visit. */
+    void updateCullingProxy(uint32_t flags);
+    void removeCullingProxy();
+    /** Whether the visiting camera can't see this MeshRenderer. */
+    bool isCulledByVisitingCamera() const;
+
     static AABB getAABBRecursivelyImp(Node* node);
 
+    /** Evaluates the skeleton and the matrix palettes of the meshes, once per frame. Safe to run on a worker. */
+    void updateSkeleton(unsigned int frame);
+    void addToSkinnedMeshRenderers();
+    void removeFromSkinnedMeshRenderers();
+
     /** Enables instancing for this Mesh Renderer, keep in mind that
      a special vertex shader has to be used, make sure that your shader
      has a mat4 attribute set on the location of total vertex attributes +1
@@ -327,6 +355,21 @@ protected:
     bool _usingAutogeneratedGLProgram;
     bool _transparentMaterialHint; // Generate transparent materials when building from files
     unsigned short _meshTextureHint; // Whether model file has texture config
+    bool _instancingEnabled = false;  // the instances aren't covered by the aabb, never culled
+
+    // frustum culling, see Scene::cullMeshRenderers
+    friend class Scene;
+    Scene* _cullingScene       = nullptr;  // weak ref, the scene whose culling tree holds this
+    int _cullingProxy          = -1;
+    uint32_t _cullingStamp     = 0;      // the stamp of the last camera pass which found this visible
+    unsigned int _cullingFrame = 0;      // the frame of the last visit
+    bool _cullingMoved         = false;  // the leaf was updated after the query of the current camera
+
+    // parallel skinning, see Scene::updateSkeletons
+    Scene* _skinningScene       = nullptr;  // weak ref, the scene which lists this in its skinned renderers
+    int _skinningIndex          = -1;
+    unsigned int _skeletonFrame = ~0u;  // the frame the skeleton was last evaluated
+    static bool __parallelSkinningEnabled;
 
     struct AsyncLoadParam
     {
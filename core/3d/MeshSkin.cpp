@@ -26,6 +26,7 @@
 #include "3d/MeshSkin.h"
 #include "3d/Bundle3D.h"
 #include "3d/Skeleton3D.h"
+#include "renderer/Texture2D.h"
 
 namespace ax
 {
@@ -38,6 +39,7 @@ MeshSkin::~MeshSkin()
 {
     removeAllBones();
     AX_SAFE_RELEASE(_skeleton);
+    AX_SAFE_RELEASE(_matrixPaletteTexture);
 }
 
 MeshSkin* MeshSkin::create(Skeleton3D* skeleton,
@@ -101,9 +103,15 @@ int MeshSkin::getBoneIndex(Bone3D* bone) const
 // compute matrix palette used by gpu skin
 Vec4* MeshSkin::getMatrixPalette()
 {
-    _matrixPalette.resize(_skinBones.size() * PALETTE_ROWS);
+    const auto paletteSize = static_cast<size_t>(_skinBones.size() * PALETTE_ROWS);
+    if (_skeleton && _paletteVersion == _skeleton->_matrixVersion && _matrixPalette.size() == paletteSize)
+        return _matrixPalette.data();
+    if (_skeleton)
+        _paletteVersion = _skeleton->_matrixVersion;
+
+    _matrixPalette.resize(paletteSize);
     int i = 0, paletteIndex = 0;
-    static Mat4 t;
+    Mat4 t;
     for (auto&& it : _skinBones)
     {
         Mat4::multiply(it->getWorldMat(), _invBindPoses[i++], &t);
@@ -115,6 +123,29 @@ Vec4* MeshSkin::getMatrixPalette()
     return _matrixPalette.data();
 }
 
+Texture2D* MeshSkin::getMatrixPaletteTexture()
+{
+    auto palette = getMatrixPalette();
+    auto width   = static_cast<int>(getMatrixPaletteSize());
+    if (width == 0)
+        return nullptr;
+
+    if (!_matrixPaletteTexture || _matrixPaletteTexture->getPixelsWide() != width)
+    {
+        AX_SAFE_RELEASE(_matrixPaletteTexture);
+        _matrixPaletteTexture = new Texture2D();
+        _matrixPaletteTexture->initWithData(palette, getMatrixPaletteSizeInBytes(), backend::PixelFormat::RGBA32F,
+                                            width, 1);
+        // the shader addresses single texels, never filter between two palette rows
+        _matrixPaletteTexture->setAliasTexParameters();
+    }
+    else if (!_skeleton || _paletteTextureVersion != _paletteVersion)
+        _matrixPaletteTexture->updateWithSubData(palette, 0, 0, width, 1);
+    _paletteTextureVersion = _paletteVersion;
+
+    return _matrixPaletteTexture;
+}
+
 ssize_t MeshSkin::getMatrixPaletteSize() const
 {
     return _skinBones.size() * PALETTE_ROWS;
@@ -134,6 +165,8 @@ void MeshSkin::removeAllBones()
 void MeshSkin::addSkinBone(Bone3D* bone)
 {
     _skinBones.pushBack(bone);
+    _paletteVersion        = ~0u;
+    _paletteTextureVersion = ~0u;
 }
 
 Bone3D* MeshSkin::getRootBone() const
@@ -42,6 +42,7 @@ namespace ax
 
 class Bone3D;
 class Skeleton3D;
+class Texture2D;
 
 /**
  * @brief MeshSkin, A class maintain a collection of bones that affect Mesh vertex.
@@ -71,9 +72,15 @@ public:
     /**get bone index*/
     int getBoneIndex(Bone3D* bone) const;
 
-    /**compute matrix palette used by gpu skin*/
+    /**compute matrix palette used by gpu skin, only rebuilt when the skeleton was updated since the last call*/
     Vec4* getMatrixPalette();
 
+    /**
+     * get the matrix palette as a getMatrixPaletteSize() x 1 RGBA32F texture, for instanced skinning which
+     * is not limited by the joint count of the u_matrixPalette uniform. Only uploaded when the palette changed.
+     */
+    Texture2D* getMatrixPaletteTexture();
+
     /**getSkinBoneCount() * 3*/
     ssize_t getMatrixPaletteSize() const;
 
@@ -108,6 +115,10 @@ protected:
     // Each 4x3 row-wise matrix is represented as 3 Vec4's.
     // The number of Vec4's is (_skinBones.size() * 3).
     std::vector<Vec4> _matrixPalette;
+    unsigned int _paletteVersion = ~0u;  // the skeleton matrix version the palette was built from
+
+    Texture2D* _matrixPaletteTexture    = nullptr;
+    unsigned int _paletteTextureVersion = ~0u;  // the palette version uploaded to _matrixPaletteTexture
 };
 
 // end of 3d group
@@ -147,7 +147,7 @@ Bone3D* Bone3D::create(std::string_view id)
 void Bone3D::updateJointMatrix(Vec4* matrixPalette)
 {
     {
-        static Mat4 t;
+        Mat4 t;
         Mat4::multiply(_world, getInverseBindPose(), &t);
 
         matrixPalette[0].set(t.m[0], t.m[4], t.m[8], t.m[12]);
@@ -171,21 +171,57 @@ Bone3D* Bone3D::getChildBoneByIndex(int index) const
 void Bone3D::addChildBone(Bone3D* bone)
 {
     if (_children.find(bone) == _children.end())
+    {
         _children.pushBack(bone);
+        bone->_parent = this;
+        bone->setSkeleton(_skeleton);
+        setSkeletonBonesDirty();
+    }
 }
 void Bone3D::removeChildBoneByIndex(int index)
 {
-    _children.erase(index);
+    removeChildBone(_children.at(index));
 }
 void Bone3D::removeChildBone(Bone3D* bone)
 {
-    _children.eraseObject(bone);
+    if (_children.find(bone) != _children.end())
+    {
+        setSkeletonBonesDirty();
+        bone->_parent = nullptr;
+        bone->setSkeleton(nullptr);
+        _children.eraseObject(bone);
+    }
 }
 void Bone3D::removeAllChildBone()
 {
+    if (_children.empty())
+        return;
+
+    setSkeletonBonesDirty();
+    for (auto&& it : _children)
+    {
+        it->_parent = nullptr;
+        it->setSkeleton(nullptr);
+    }
     _children.clear();
 }
 
+void Bone3D::setSkeleton(Skeleton3D* skeleton)
+{
+    _skeleton = skeleton;
+    for (auto&& it : _children)
+    {
+        it->setSkeleton(skeleton);
+    }
+}
+
+void Bone3D::setSkeletonBonesDirty()
+{
+    // the sorted bones hold raw pointers, they must not be walked again before sorting
+    if (_skeleton)
+        _skeleton->_sortedBonesDirty = true;
+}
+
 Bone3D::Bone3D(std::string_view id) : _name(id), _parent(nullptr), _worldDirty(true) {}
 
 Bone3D::~Bone3D()
@@ -263,6 +299,7 @@ Skeleton3D* Skeleton3D::create(const std::vector<NodeData*>& skeletondata)
         bone->resetPose();
         skeleton->_rootBones.pushBack(bone);
     }
+    skeleton->_sortedBonesDirty = true;
     skeleton->autorelease();
     return skeleton;
 }
@@ -316,35 +353,69 @@ int Skeleton3D::getBoneIndex(Bone3D* bone) const
 // refresh bone world matrix
 void Skeleton3D::updateBoneMatrix()
 {
+    if (_sortedBonesDirty)
+        sortBones();
+
+    for (auto bone : _sortedBones)
+    {
+        bone->updateLocalMat();
+        if (bone->_parent)
+            Mat4::multiply(bone->_parent->_world, bone->_local, &bone->_world);
+        else
+            bone->_world = bone->_local;
+        bone->_worldDirty = false;
+    }
+    ++_matrixVersion;
+}
+
+void Skeleton3D::sortBones()
+{
+    _sortedBones.clear();
     for (const auto& it : _rootBones)
     {
-        it->setWorldMatDirty(true);
-        it->updateWorldMat();
+        // breadth first, a bone is always visited after its parent
+        auto first = _sortedBones.size();
+        _sortedBones.emplace_back(it);
+        for (; first < _sortedBones.size(); ++first)
+        {
+            for (auto&& child : _sortedBones[first]->_children)
+                _sortedBones.emplace_back(child);
+        }
     }
+    _sortedBonesDirty = false;
 }
 
 void Skeleton3D::removeAllBones()
 {
+    for (auto&& it : _rootBones)
+        it->setSkeleton(nullptr);
+    for (auto&& it : _bones)
+        it->setSkeleton(nullptr);
     _bones.clear();
     _rootBones.clear();
+    _sortedBones.clear();
+    _sortedBonesDirty = true;
 }
 
 void Skeleton3D::addBone(Bone3D* bone)
 {
+    bone->_skeleton = this;
     _bones.pushBack(bone);
+    _sortedBonesDirty = true;
 }
 
 Bone3D* Skeleton3D::createBone3D(const NodeData& nodedata)
 {
-    auto bone = Bone3D::create(nodedata.id);
+    auto bone       = Bone3D::create(nodedata.id);
+    bone->_skeleton = this;
     for (const auto& it : nodedata.children)
     {
         auto child = createBone3D(*it);
         bone->addChildBone(child);
-        child->_parent = bone;
     }
     _bones.pushBack(bone);
-    bone->_oriPose = nodedata.transform;
+    _sortedBonesDirty = true;
+    bone->_oriPose    = nodedata.transform;
     return bone;
 }
 
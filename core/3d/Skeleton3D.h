@@ -33,6 +33,8 @@
 namespace ax
 {
 
+class Skeleton3D;
+
 /**
  * @addtogroup _3d
  * @{
@@ -155,6 +157,12 @@ protected:
     /**set world matrix dirty flag*/
     void setWorldMatDirty(bool dirty = true);
 
+    /**set the skeleton of this bone and its children*/
+    void setSkeleton(Skeleton3D* skeleton);
+
+    /**the bone tree changed, the skeleton has to sort its bones again*/
+    void setSkeletonBonesDirty();
+
     std::string _name;  // bone name
     /**
      * The Mat4 representation of the Joint's bind pose.
@@ -164,6 +172,7 @@ protected:
     Mat4 _oriPose;  // original bone pose
 
     Bone3D* _parent;  // parent bone
+    Skeleton3D* _skeleton = nullptr;  // weak ref, the skeleton evaluating this bone
 
     Vector<Bone3D*> _children;
 
@@ -180,6 +189,9 @@ protected:
  */
 class AX_DLL Skeleton3D : public Object
 {
+    friend class Bone3D;
+    friend class MeshSkin;
+
 public:
     /**
      * @lua NA
@@ -200,7 +212,7 @@ public:
     /**get bone index*/
     int getBoneIndex(Bone3D* bone) const;
 
-    /**refresh bone world matrix*/
+    /**refresh bone world matrix, parents first in one pass over the bones*/
     void updateBoneMatrix();
 
     Skeleton3D();
@@ -217,9 +229,16 @@ public:
     Bone3D* createBone3D(const NodeData& nodedata);
 
 protected:
+    /** sorts the bones reachable from the roots, each parent before its children */
+    void sortBones();
+
     Vector<Bone3D*> _bones;  // bones
 
     Vector<Bone3D*> _rootBones;
+
+    std::vector<Bone3D*> _sortedBones;  // evaluation order, rebuilt when bones are added or removed
+    bool _sortedBonesDirty       = true;
+    unsigned int _matrixVersion = 0;  // incremented by each updateBoneMatrix, see MeshSkin::getMatrixPalette
 };
 
 // end of 3d group
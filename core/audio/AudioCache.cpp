@@ -42,7 +42,6 @@ unsigned int __idIndex = 0;
 }
 
 #define INVALID_AL_BUFFER_ID 0xFFFFFFFF
-#define PCMDATA_CACHEMAXSIZE 1048576
 
 namespace ax
 {
@@ -54,6 +53,9 @@ AudioCache::AudioCache()
     , _duration(0.0f)
     , _alBufferId(INVALID_AL_BUFFER_ID)
     , _queBufferFrames(0)
+    , _streamingThreshold(AUDIO_STREAMING_THRESHOLD)
+    , _pcmBytes(0)
+    , _lastUsed(0)
     , _state(State::INITIAL)
     , _isDestroyed(std::make_shared<bool>(false))
     , _id(++__idIndex)
@@ -96,7 +98,7 @@ AudioCache::~AudioCache()
     }
     else
     {
-        AXLOGW("AudioCache ({}), id={}, buffer isn't ready, state={}", fmt::ptr(this), _id, (int)_state);
+        AXLOGW("AudioCache ({}), id={}, buffer isn't ready, state={}", fmt::ptr(this), _id, (int)_state.load());
     }
 
     if (_queBufferFrames > 0)
@@ -169,7 +171,7 @@ void AudioCache::readDataTask(unsigned int selfId)
         _duration    = 1.0f * totalFrames / sampleRate;
         _totalFrames = totalFrames;
 
-        if (dataSize <= PCMDATA_CACHEMAXSIZE)
+        if (dataSize <= _streamingThreshold)
         {
             uint32_t framesRead = 0;
             const uint32_t framesToReadOnce =
@@ -285,7 +287,8 @@ void AudioCache::readDataTask(unsigned int selfId)
                 break;
             }
 
-            _state = State::READY;
+            _pcmBytes = dataSize;
+            _state    = State::READY;
         }
         else
         {
@@ -302,7 +305,8 @@ void AudioCache::readDataTask(unsigned int selfId)
                 decoder->readFixedFrames(_queBufferFrames, _queBuffers[index]);
             }
 
-            _state = State::READY;
+            _pcmBytes = static_cast<size_t>(queBufferBytes) * QUEUEBUFFER_NUM;
+            _state    = State::READY;
         }
 
     } while (false);
@@ -349,7 +353,7 @@ void AudioCache::addPlayCallback(const std::function<void()>& callback)
         break;
 
     default:
-        AXLOGE("Invalid state: {}", (int)_state);
+        AXLOGE("Invalid state: {}", (int)_state.load());
         break;
     }
 }
@@ -383,7 +387,7 @@ void AudioCache::addLoadCallback(const std::function<void(bool)>& callback)
         break;
 
     default:
-        AXLOGE("Invalid state: {}", (int)_state);
+        AXLOGE("Invalid state: {}", (int)_state.load());
         break;
     }
 }
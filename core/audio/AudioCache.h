@@ -32,6 +32,7 @@
 #include <mutex>
 #include <vector>
 #include <memory>
+#include <atomic>
 
 #include "platform/PlatformMacros.h"
 #include "audio/AudioMacros.h"
@@ -77,17 +78,22 @@ protected:
     uint32_t _framesRead;
 
     /*Cache related stuff;
-     * Cache pcm data when sizeInBytes less than PCMDATA_CACHEMAXSIZE
+     * Cache pcm data when sizeInBytes less than _streamingThreshold
      */
     ALuint _alBufferId;
 
     /*Queue buffer related stuff
-     *  Streaming in OpenAL when sizeInBytes greater then PCMDATA_CACHEMAXSIZE
+     *  Streaming in OpenAL when sizeInBytes greater then _streamingThreshold
      */
     char* _queBuffers[QUEUEBUFFER_NUM];
     ALsizei _queBufferSize[QUEUEBUFFER_NUM];
     uint32_t _queBufferFrames;
 
+    // memory budget related stuff, maintained by AudioEngineImpl
+    size_t _streamingThreshold;
+    std::atomic<size_t> _pcmBytes;  // written by the decode task before _state becomes READY
+    uint64_t _lastUsed;
+
     std::mutex _playCallbackMutex;
     std::vector<std::function<void()>> _playCallbacks;
 
@@ -96,12 +102,13 @@ protected:
 
     std::mutex _readDataTaskMutex;
 
-    State _state;
+    // written by the decode task, read by AudioEngineImpl and AudioPlayer on other threads
+    std::atomic<State> _state;
 
     std::shared_ptr<bool> _isDestroyed;
     std::string _fileFullPath;
     unsigned int _id;
-    bool _isLoadingFinished;
+    std::atomic<bool> _isLoadingFinished;
     bool _isSkipReadDataTask;
 
     friend class AudioEngineImpl;
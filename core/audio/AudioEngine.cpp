@@ -51,6 +51,8 @@ hlookup::string_map<std::list<AUDIO_ID>> AudioEngine::_audioPathIDMap;
 // profileName,ProfileHelper
 hlookup::string_map<AudioEngine::ProfileHelper> AudioEngine::_audioPathProfileHelperMap;
 unsigned int AudioEngine::_maxInstances                        = MAX_AUDIOINSTANCES;
+size_t AudioEngine::_cacheBudget                               = AUDIO_CACHE_BUDGET;
+size_t AudioEngine::_streamingThreshold                        = AUDIO_STREAMING_THRESHOLD;
 AudioEngine::ProfileHelper* AudioEngine::_defaultProfileHelper = nullptr;
 std::unordered_map<AUDIO_ID, AudioEngine::AudioInfo> AudioEngine::_audioIDInfoMap;
 AudioEngineImpl* AudioEngine::_audioEngineImpl = nullptr;
@@ -409,6 +411,23 @@ bool AudioEngine::setMaxAudioInstance(int maxInstances)
     return false;
 }
 
+void AudioEngine::setCacheBudget(size_t bytes)
+{
+    _cacheBudget = bytes;
+    if (_audioEngineImpl)
+        _audioEngineImpl->trimCaches(nullptr);
+}
+
+AudioCacheStats AudioEngine::getCacheStats()
+{
+    if (_audioEngineImpl)
+        return _audioEngineImpl->getCacheStats();
+
+    AudioCacheStats stats;
+    stats.budget = _cacheBudget;
+    return stats;
+}
+
 bool AudioEngine::isLoop(AUDIO_ID audioID)
 {
     auto tmpIterator = _audioIDInfoMap.find(audioID);
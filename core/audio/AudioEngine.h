@@ -84,6 +84,21 @@ public:
     AudioProfile() : maxInstances(0), minDelay(0.0) {}
 };
 
+/**
+ * @struct AudioCacheStats
+ *
+ * @brief Counters of the decoded audio cache, see AudioEngine::getCacheStats.
+ * @js NA
+ */
+struct AX_DLL AudioCacheStats
+{
+    unsigned int hits      = 0;  // play2d/preload requests served by an existing cache
+    unsigned int misses    = 0;  // play2d/preload requests which had to decode the file
+    unsigned int evictions = 0;  // unused caches dropped to stay within the budget
+    size_t bytes           = 0;  // bytes held by all loaded caches, decoded PCM and stream queue buffers
+    size_t budget          = 0;  // 0 means unlimited
+};
+
 class AudioEngineImpl;
 
 /**
@@ -288,6 +303,31 @@ public:
      */
     static void uncacheAll();
 
+    /**
+     * Sets the memory budget of the decoded audio cache, in bytes.
+     * When loaded caches exceed it, the least recently used ones which aren't playing are uncached.
+     *
+     * @param bytes The budget, 0 means unlimited. Defaults to 32 MB on Android and iOS, unlimited elsewhere.
+     */
+    static void setCacheBudget(size_t bytes);
+
+    /** Gets the memory budget of the decoded audio cache, in bytes. */
+    static size_t getCacheBudget() { return _cacheBudget; }
+
+    /**
+     * Sets the decoded size above which an audio file is streamed instead of being fully decoded.
+     * Only affects files which aren't cached yet.
+     *
+     * @param bytes The decoded PCM size threshold.
+     */
+    static void setStreamingThreshold(size_t bytes) { _streamingThreshold = bytes; }
+
+    /** Gets the decoded size above which an audio file is streamed, in bytes. */
+    static size_t getStreamingThreshold() { return _streamingThreshold; }
+
+    /** Gets the hit/miss/eviction counters and memory usage of the decoded audio cache. */
+    static AudioCacheStats getCacheStats();
+
     /**
      * Gets the audio profile by id of audio instance.
      *
@@ -379,6 +419,9 @@ protected:
 
     static unsigned int _maxInstances;
 
+    static size_t _cacheBudget;
+    static size_t _streamingThreshold;
+
     static ProfileHelper* _defaultProfileHelper;
 
     static AudioEngineImpl* _audioEngineImpl;
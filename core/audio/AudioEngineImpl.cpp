@@ -40,6 +40,8 @@
 #include "base/Scheduler.h"
 #include "base/Utils.h"
 
+#include "yasio/thread_name.hpp"
+
 #if AX_USE_ALSOFT
 #    include "alc/inprogext.h"
 #endif
@@ -308,24 +310,24 @@ ALvoid ax::AudioEngineImpl::myAlSourceNotificationCallback(ALuint sid, ALuint no
     if (notificationID != AL_BUFFERS_PROCESSED)
         return;
 
-    AudioPlayer* player = nullptr;
-    s_instance->_threadMutex.lock();
-    for (const auto& e : s_instance->_audioPlayers)
-    {
-        player = e.second;
-        if (player->_alSource == sid && player->_streamingSource)
-        {
-            player->wakeupRotateThread();
-        }
-    }
-    s_instance->_threadMutex.unlock();
+    // Don't take any lock here, the streaming thread may be inside OpenAL with its lock held
+    s_instance->_wakeupStreamingThread();
 }
 #endif
 
 namespace ax
 {
 
-AudioEngineImpl::AudioEngineImpl() : _scheduled(false), _currentAudioID(0), _scheduler(nullptr)
+AudioEngineImpl::AudioEngineImpl()
+    : _scheduled(false)
+    , _currentAudioID(0)
+    , _scheduler(nullptr)
+    , _cacheClock(0)
+    , _cacheHits(0)
+    , _cacheMisses(0)
+    , _cacheEvictions(0)
+    , _streamingThreadExit(false)
+    , _streamingWakeup(false)
 {
     s_instance = this;
 }
@@ -337,6 +339,8 @@ AudioEngineImpl::~AudioEngineImpl()
         _scheduler->unschedule(AX_SCHEDULE_SELECTOR(AudioEngineImpl::update), this);
     }
 
+    _stopStreamingThread();
+
     if (s_ALContext)
     {
         alDeleteSources(MAX_AUDIOINSTANCES, _alSources);
@@ -502,11 +506,13 @@ AudioCache* AudioEngineImpl::preload(std::string_view filePath, std::function<vo
     auto it = _audioCaches.find(filePath);
     if (it == _audioCaches.end())
     {
+        ++_cacheMisses;
         audioCache = new AudioCache();  // hlookup_second(it);
         _audioCaches.emplace(filePath, std::unique_ptr<AudioCache>(audioCache));
-        audioCache->_fileFullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
-        unsigned int cacheId      = audioCache->_id;
-        auto isCacheDestroyed     = audioCache->_isDestroyed;
+        audioCache->_fileFullPath       = FileUtils::getInstance()->fullPathForFilename(filePath);
+        audioCache->_streamingThreshold = AudioEngine::_streamingThreshold;
+        unsigned int cacheId            = audioCache->_id;
+        auto isCacheDestroyed           = audioCache->_isDestroyed;
         AudioEngine::addTask([audioCache, cacheId, isCacheDestroyed]() {
             if (*isCacheDestroyed)
             {
@@ -516,11 +522,15 @@ AudioCache* AudioEngineImpl::preload(std::string_view filePath, std::function<vo
             }
             audioCache->readDataTask(cacheId);
         });
+        // Invoked in axmol thread once loaded, and never after the cache was destroyed
+        audioCache->addLoadCallback([this, audioCache](bool) { trimCaches(audioCache); });
     }
     else
     {
+        ++_cacheHits;
         audioCache = it->second.get();
     }
+    audioCache->_lastUsed = ++_cacheClock;
 
     if (audioCache && callback)
     {
@@ -593,6 +603,9 @@ void AudioEngineImpl::_play2d(AudioCache* cache, AUDIO_ID audioID)
     {
         if (player->play2d())
         {
+            if (player->_streamingSource)
+                _addStreamingPlayer(player);
+
             _scheduler->runOnAxmolThread([audioID]() {
                 if (AudioEngine::_audioIDInfoMap.find(audioID) != AudioEngine::_audioIDInfoMap.end())
                 {
@@ -740,6 +753,8 @@ void AudioEngineImpl::stop(AUDIO_ID audioID)
         return;
 
     auto player = iter->second;
+    if (player->_streamingSource)
+        _removeStreamingPlayer(player);
     player->destroy();
 
     // Call '_updatePlayersState' method to cleanup immediately since the schedule may be cancelled without any
@@ -752,6 +767,8 @@ void AudioEngineImpl::stopAll()
     std::lock_guard<std::recursive_mutex> lck(_threadMutex);
     for (auto&& player : _audioPlayers)
     {
+        if (player.second->_streamingSource)
+            _removeStreamingPlayer(player.second);
         player.second->destroy();
     }
     // Note: Don't set the flag to false here, it should be set in 'update' function.
@@ -890,6 +907,8 @@ void AudioEngineImpl::_updatePlayers(bool forStop)
 
         if (player->_removeByAudioEngine)
         {
+            if (player->_streamingSource)
+                _removeStreamingPlayer(player);
             AudioEngine::remove(audioID);
 
             it = _audioPlayers.erase(it);
@@ -956,6 +975,177 @@ void AudioEngineImpl::_unscheduleUpdate()
     }
 }
 
+void AudioEngineImpl::_addStreamingPlayer(AudioPlayer* player)
+{
+    std::lock_guard<std::mutex> lck(_streamingMutex);
+    _streamingPlayers.emplace_back(player);
+
+    if (!_streamingThread.joinable())
+    {
+        _streamingThreadExit = false;
+        _streamingThread     = std::thread(&AudioEngineImpl::_streamingThreadLoop, this);
+    }
+    _streamingCondition.notify_one();
+}
+
+void AudioEngineImpl::_removeStreamingPlayer(AudioPlayer* player)
+{
+    // Waits for the current streaming pass, after that the streaming thread never touches the player again
+    std::lock_guard<std::mutex> lck(_streamingMutex);
+    auto it = std::find(_streamingPlayers.begin(), _streamingPlayers.end(), player);
+    if (it != _streamingPlayers.end())
+    {
+        _streamingPlayers.erase(it);
+        player->closeStream();
+    }
+}
+
+void AudioEngineImpl::_wakeupStreamingThread()
+{
+    _streamingWakeup = true;
+    _streamingCondition.notify_one();
+}
+
+void AudioEngineImpl::_stopStreamingThread()
+{
+    if (!_streamingThread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lck(_streamingMutex);
+        _streamingThreadExit = true;
+        _streamingCondition.notify_one();
+    }
+    _streamingThread.join();
+
+    for (auto player : _streamingPlayers)
+        player->closeStream();
+    _streamingPlayers.clear();
+}
+
+void AudioEngineImpl::_streamingThreadLoop()
+{
+    yasio::set_thread_name("axmol-audio");
+
+    const auto sleepTime = std::chrono::milliseconds(static_cast<long long>(QUEUEBUFFER_TIME_STEP * 1000) / 2);
+
+    std::unique_lock<std::mutex> lck(_streamingMutex);
+    while (!_streamingThreadExit)
+    {
+        int budget = QUEUEBUFFER_DECODE_BUDGET;
+
+        // Refill pass: looping streams (usually background music) first, so a burst of one-shot streams
+        // can't starve them out of the decode budget
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            for (auto it = _streamingPlayers.begin(); it != _streamingPlayers.end();)
+            {
+                auto player = *it;
+                if (player->_loop != (pass == 0))
+                {
+                    ++it;
+                }
+                else if (!player->updateStream(budget))
+                {
+                    AXLOGV("Stream of player id={} finished", player->_id);
+                    player->closeStream();
+                    it = _streamingPlayers.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+
+        // Decode-ahead pass with what is left of the budget, in the same order
+        const bool starved = budget <= 0;
+        for (int pass = 0; pass < 2 && budget > 0; ++pass)
+        {
+            for (auto player : _streamingPlayers)
+            {
+                if (player->_loop == (pass == 0))
+                    player->decodeAhead(budget);
+            }
+        }
+
+        if (_streamingPlayers.empty())
+        {
+            _streamingCondition.wait(lck, [this] { return _streamingThreadExit || !_streamingPlayers.empty(); });
+        }
+        else if (starved)
+        {
+            // some queues weren't refilled, give the other threads a chance to take the lock and go again
+            lck.unlock();
+            std::this_thread::yield();
+            lck.lock();
+        }
+        else
+        {
+            _streamingCondition.wait_for(lck, sleepTime,
+                                         [this] { return _streamingThreadExit || _streamingWakeup.load(); });
+        }
+        _streamingWakeup = false;
+    }
+}
+
+void AudioEngineImpl::trimCaches(AudioCache* keep)
+{
+    const size_t budget = AudioEngine::_cacheBudget;
+    if (budget == 0)
+        return;
+
+    std::lock_guard<std::recursive_mutex> lck(_threadMutex);
+
+    auto isEvictable = [this, keep](AudioCache* cache) {
+        if (cache == keep || !cache->_isLoadingFinished || cache->_state != AudioCache::State::READY)
+            return false;
+        for (auto&& player : _audioPlayers)
+        {
+            if (player.second->_audioCache == cache)
+                return false;
+        }
+        return true;
+    };
+
+    size_t bytes = getCacheStats().bytes;
+    while (bytes > budget)
+    {
+        auto lru = _audioCaches.end();
+        for (auto it = _audioCaches.begin(); it != _audioCaches.end(); ++it)
+        {
+            auto cache = it->second.get();
+            if ((lru == _audioCaches.end() || cache->_lastUsed < lru->second->_lastUsed) && isEvictable(cache))
+                lru = it;
+        }
+        if (lru == _audioCaches.end())
+            break;
+
+        AXLOGV("Evict audio cache: {}, {} bytes", lru->second->_fileFullPath, lru->second->_pcmBytes.load());
+        bytes -= lru->second->_pcmBytes;
+        _audioCaches.erase(lru);
+        ++_cacheEvictions;
+    }
+}
+
+AudioCacheStats AudioEngineImpl::getCacheStats()
+{
+    std::lock_guard<std::recursive_mutex> lck(_threadMutex);
+
+    AudioCacheStats stats;
+    stats.hits      = _cacheHits;
+    stats.misses    = _cacheMisses;
+    stats.evictions = _cacheEvictions;
+    stats.budget    = AudioEngine::_cacheBudget;
+    for (auto&& item : _audioCaches)
+    {
+        auto cache = item.second.get();
+        if (cache->_isLoadingFinished && cache->_state == AudioCache::State::READY)
+            stats.bytes += cache->_pcmBytes;
+    }
+    return stats;
+}
+
 void AudioEngineImpl::uncache(std::string_view filePath)
 {
     _audioCaches.erase(filePath);
@@ -31,9 +31,12 @@
 
 #    include <unordered_map>
 #    include <queue>
+#    include <thread>
+#    include <condition_variable>
 
 #    include "base/Object.h"
 #    include "audio/AudioMacros.h"
+#    include "audio/AudioEngine.h"
 #    include "audio/AudioCache.h"
 #    include "audio/AudioPlayer.h"
 
@@ -66,12 +69,23 @@ public:
     AudioCache* preload(std::string_view filePath, std::function<void(bool)> callback);
     void update(float dt);
 
+    // uncache the least recently used caches which aren't playing until AudioEngine's cache budget is met
+    void trimCaches(AudioCache* keep);
+    AudioCacheStats getCacheStats();
+
 private:
     // query players state per frame and dispatch finish callback if possible
     void _updatePlayers(bool forStop);
     void _play2d(AudioCache* cache, AUDIO_ID audioID);
     void _unscheduleUpdate();
     ALuint findValidSource();
+
+    // shared streaming thread, refills the queue buffers of all streamed players
+    void _addStreamingPlayer(AudioPlayer* player);
+    void _removeStreamingPlayer(AudioPlayer* player);
+    void _wakeupStreamingThread();
+    void _stopStreamingThread();
+    void _streamingThreadLoop();
 #if defined(__APPLE__) && !AX_USE_ALSOFT
     static ALvoid myAlSourceNotificationCallback(ALuint sid, ALuint notificationID, ALvoid* userData);
 #endif
@@ -94,6 +108,19 @@ private:
 
     AUDIO_ID _currentAudioID;
     Scheduler* _scheduler;
+
+    // decoded cache usage
+    uint64_t _cacheClock;
+    unsigned int _cacheHits;
+    unsigned int _cacheMisses;
+    unsigned int _cacheEvictions;
+
+    std::thread _streamingThread;
+    std::mutex _streamingMutex;
+    std::condition_variable _streamingCondition;
+    std::vector<AudioPlayer*> _streamingPlayers;
+    bool _streamingThreadExit;
+    std::atomic_bool _streamingWakeup;
 };
 
 }
@@ -26,12 +26,25 @@
 
 #pragma once
 
+#include "platform/PlatformConfig.h"
 #include "base/Logging.h"
 
 #include <functional>
 
 #define QUEUEBUFFER_NUM (3)
 #define QUEUEBUFFER_TIME_STEP (0.05f)
+// max queue buffers decoded by the shared streaming thread per pass, looping (music) streams are served first
+#define QUEUEBUFFER_DECODE_BUDGET (8)
+
+// default decoded size above which a file is streamed instead of fully decoded, see AudioEngine::setStreamingThreshold
+#define AUDIO_STREAMING_THRESHOLD (1024 * 1024)
+// default memory budget of the decoded audio cache, see AudioEngine::setCacheBudget
+// bounded on mobile, where the OS kills apps under memory pressure, unlimited (0) elsewhere
+#if AX_TARGET_PLATFORM == AX_PLATFORM_ANDROID || AX_TARGET_PLATFORM == AX_PLATFORM_IOS
+#    define AUDIO_CACHE_BUDGET (32 * 1024 * 1024)
+#else
+#    define AUDIO_CACHE_BUDGET (0)
+#endif
 
 #define QUOTEME_(x) #x
 #define QUOTEME(x) QUOTEME_(x)
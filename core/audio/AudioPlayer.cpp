@@ -33,8 +33,6 @@
 #include "audio/AudioDecoder.h"
 #include "audio/AudioDecoderManager.h"
 
-#include "yasio/thread_name.hpp"
-
 namespace ax
 {
 
@@ -51,12 +49,13 @@ AudioPlayer::AudioPlayer()
     , _ready(false)
     , _currTime(0.0f)
     , _streamingSource(false)
-    , _rotateBufferThread(nullptr)
+    , _streamDecoder(nullptr)
+    , _streamBuffer(nullptr)
+    , _streamFramesToRead(0)
+    , _streamPendingFrames(0)
+    , _streamPending(false)
     , _timeDirty(false)
-    , _isRotateThreadExited(false)
-#if defined(__APPLE__)
-    , _needWakeupRotateThread(false)
-#endif
+    , _isStreamFinished(false)
     , _id(++__playerIdIndex)
 {
     memset(_bufferIds, 0, sizeof(_bufferIds));
@@ -67,6 +66,10 @@ AudioPlayer::~AudioPlayer()
     AXLOGV("~AudioPlayer() ({}), id={}", fmt::ptr(this), _id);
     destroy();
 
+    // a stream which was opened but never handed to the streaming thread
+    if (_streamDecoder)
+        closeStream();
+
     if (_streamingSource)
     {
         alDeleteBuffers(QUEUEBUFFER_NUM, _bufferIds);
@@ -101,43 +104,28 @@ void AudioPlayer::destroy()
 
         if (_streamingSource)
         {
-            if (_rotateBufferThread != nullptr)
-            {
-                while (!_isRotateThreadExited)
-                {
-                    _sleepCondition.notify_one();
-                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
-                }
-
-                if (_rotateBufferThread->joinable())
-                {
-                    _rotateBufferThread->join();
-                }
-
-                delete _rotateBufferThread;
-                _rotateBufferThread = nullptr;
-                AXLOGV("{}", "rotateBufferThread exited!");
+            // The stream is closed by AudioEngineImpl when it detaches this player from the streaming thread,
+            // under its streaming mutex
 
 #if AX_TARGET_PLATFORM == AX_PLATFORM_IOS
-                // some specific OpenAL implement defects existed on iOS platform
-                // refer to: https://github.com/cocos2d/cocos2d-x/issues/18597
-                ALint sourceState;
-                ALint bufferProcessed = 0;
-                alGetSourcei(_alSource, AL_SOURCE_STATE, &sourceState);
-                if (sourceState == AL_PLAYING)
+            // some specific OpenAL implement defects existed on iOS platform
+            // refer to: https://github.com/cocos2d/cocos2d-x/issues/18597
+            ALint sourceState;
+            ALint bufferProcessed = 0;
+            alGetSourcei(_alSource, AL_SOURCE_STATE, &sourceState);
+            if (sourceState == AL_PLAYING)
+            {
+                alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
+                while (bufferProcessed < QUEUEBUFFER_NUM)
                 {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
                     alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
-                    while (bufferProcessed < QUEUEBUFFER_NUM)
-                    {
-                        std::this_thread::sleep_for(std::chrono::milliseconds(2));
-                        alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
-                    }
-                    alSourceUnqueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
-                    CHECK_AL_ERROR_DEBUG();
                 }
-                AXLOGV("{}", "UnqueueBuffers Before alSourceStop");
-#endif
+                alSourceUnqueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
+                CHECK_AL_ERROR_DEBUG();
             }
+            AXLOGV("{}", "UnqueueBuffers Before alSourceStop");
+#endif
         }
     } while (false);
 
@@ -218,28 +206,21 @@ bool AudioPlayer::play2d()
             _streamingSource = true;
         }
 
+        if (_streamingSource)
         {
-            std::unique_lock<std::mutex> lk(_sleepMutex);
-            if (_isDestroyed)
-                break;
-
-            if (_streamingSource)
-            {
-                // To continuously stream audio from a source without interruption, buffer queuing is required.
-                alSourceQueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
-                CHECK_AL_ERROR_DEBUG();
-                _rotateBufferThread = new std::thread(&AudioPlayer::rotateBufferThread, this,
-                                                      _audioCache->_queBufferFrames * QUEUEBUFFER_NUM + 1);
-            }
-            else
-            {
-                alSourcei(_alSource, AL_BUFFER, _audioCache->_alBufferId);
-                CHECK_AL_ERROR_DEBUG();
-            }
-
-            alSourcePlay(_alSource);
+            // To continuously stream audio from a source without interruption, buffer queuing is required.
+            // The queue is refilled by the shared streaming thread of AudioEngineImpl.
+            alSourceQueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
+            CHECK_AL_ERROR_DEBUG();
+        }
+        else
+        {
+            alSourcei(_alSource, AL_BUFFER, _audioCache->_alBufferId);
+            CHECK_AL_ERROR_DEBUG();
         }
 
+        alSourcePlay(_alSource);
+
         auto alError = alGetError();
         if (alError != AL_NO_ERROR)
         {
@@ -275,159 +256,151 @@ bool AudioPlayer::play2d()
     return ret;
 }
 
-// rotateBufferThread is used to rotate alBufferData for _alSource when playing big audio file
-void AudioPlayer::rotateBufferThread(int offsetFrame)
+bool AudioPlayer::openStream()
 {
-    yasio::set_thread_name("axmol-audio");
+    auto& fullPath = _audioCache->_fileFullPath;
+    _streamDecoder = AudioDecoderManager::createDecoder(fullPath);
+    if (_streamDecoder == nullptr || !_streamDecoder->open(fullPath))
+    {
+        AXLOGE("AudioPlayer::openStream, open decoder failed: {}", fullPath);
+        return false;
+    }
 
-    char* tmpBuffer           = nullptr;
-    auto& fullPath            = _audioCache->_fileFullPath;
-    AudioDecoder* decoder     = AudioDecoderManager::createDecoder(fullPath);
-    long long rotateSleepTime = static_cast<long long>(QUEUEBUFFER_TIME_STEP * 1000) / 2;
-    do
+    _streamFramesToRead = _audioCache->_queBufferFrames;
+    _streamBuffer       = (char*)calloc(1, _streamDecoder->framesToBytes(_streamFramesToRead));
+    _streamPending      = false;
+
+    // the first QUEUEBUFFER_NUM buffers were decoded by AudioCache
+    _streamDecoder->seek(_streamFramesToRead * QUEUEBUFFER_NUM + 1);
+    return true;
+}
+
+void AudioPlayer::closeStream()
+{
+    AudioDecoderManager::destroyDecoder(_streamDecoder);
+    _streamDecoder = nullptr;
+    free(_streamBuffer);
+    _streamBuffer  = nullptr;
+    _streamPending = false;
+
+    _isStreamFinished = true;
+}
+
+uint32_t AudioPlayer::readStreamFrames(int& budget)
+{
+    --budget;
+    uint32_t framesRead = _streamDecoder->readFixedFrames(_streamFramesToRead, _streamBuffer);
+    if (framesRead == 0 && _loop)
     {
-        BREAK_IF(decoder == nullptr || !decoder->open(fullPath));
+        _streamDecoder->seek(0);
+        framesRead = _streamDecoder->readFixedFrames(_streamFramesToRead, _streamBuffer);
+    }
+    return framesRead;
+}
 
-        uint32_t framesRead         = 0;
-        const uint32_t framesToRead = _audioCache->_queBufferFrames;
-        const uint32_t bufferSize   = decoder->framesToBytes(framesToRead);
-#if AX_USE_ALSOFT
-        const auto sourceFormat = decoder->getSourceFormat();
-#endif
-        tmpBuffer = (char*)malloc(bufferSize);
-        memset(tmpBuffer, 0, bufferSize);
+bool AudioPlayer::updateStream(int& budget)
+{
+    if (_isDestroyed)
+        return false;
 
-        if (offsetFrame != 0)
-        {
-            decoder->seek(offsetFrame);
-        }
+    if (_streamDecoder == nullptr)
+    {
+        --budget;
+        if (!openStream())
+            return false;
+    }
 
-        ALint sourceState;
+    ALint sourceState;
+    alGetSourcei(_alSource, AL_SOURCE_STATE, &sourceState);
+    if (sourceState == AL_PLAYING)
+    {
         ALint bufferProcessed = 0;
-        bool needToExitThread = false;
+        alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
 
-        while (!_isDestroyed)
+        // the budget is soft, a buffer decoded ahead can always be uploaded
+        while (bufferProcessed > 0 && (budget > 0 || (_streamPending && !_timeDirty)))
         {
-            alGetSourcei(_alSource, AL_SOURCE_STATE, &sourceState);
-            if (sourceState == AL_PLAYING)
+            bufferProcessed--;
+            if (_timeDirty)
             {
-                alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
-                while (bufferProcessed > 0)
+                _timeDirty       = false;
+                _streamPending   = false;
+                auto offsetFrame = _currTime * _streamDecoder->getSampleRate() * _streamDecoder->getChannelCount();
+                _streamDecoder->seek(offsetFrame);
+            }
+            else
+            {
+                _currTime += QUEUEBUFFER_TIME_STEP;
+                if (_currTime > _audioCache->_duration)
                 {
-                    bufferProcessed--;
-                    if (_timeDirty)
+                    if (_loop)
                     {
-                        _timeDirty  = false;
-                        offsetFrame = _currTime * decoder->getSampleRate() * decoder->getChannelCount();
-                        decoder->seek(offsetFrame);
+                        _currTime = 0.0f;
                     }
                     else
                     {
-                        _currTime += QUEUEBUFFER_TIME_STEP;
-                        if (_currTime > _audioCache->_duration)
-                        {
-                            if (_loop)
-                            {
-                                _currTime = 0.0f;
-                            }
-                            else
-                            {
-                                _currTime = _audioCache->_duration;
-                            }
-                        }
-                    }
-
-                    framesRead = decoder->readFixedFrames(framesToRead, tmpBuffer);
-
-                    if (framesRead == 0)
-                    {
-                        if (_loop)
-                        {
-                            decoder->seek(0);
-                            framesRead = decoder->readFixedFrames(framesToRead, tmpBuffer);
-                        }
-                        else
-                        {
-                            needToExitThread = true;
-                            break;
-                        }
+                        _currTime = _audioCache->_duration;
                     }
-                    /*
-                     While the source is playing, alSourceUnqueueBuffers can be called to remove buffers which have
-                     already played. Those buffers can then be filled with new data or discarded. New or refilled
-                     buffers can then be attached to the playing source using alSourceQueueBuffers. As long as there is
-                     always a new buffer to play in the queue, the source will continue to play.
-                     */
-                    ALuint bid;
-                    alSourceUnqueueBuffers(_alSource, 1, &bid);
-#if AX_USE_ALSOFT
-                    if (sourceFormat == AUDIO_SOURCE_FORMAT::ADPCM || sourceFormat == AUDIO_SOURCE_FORMAT::IMA_ADPCM)
-                        alBufferi(bid, AL_UNPACK_BLOCK_ALIGNMENT_SOFT, decoder->getSamplesPerBlock());
-#endif
-                    alBufferData(bid, _audioCache->_format, tmpBuffer, decoder->framesToBytes(framesRead),
-                                 decoder->getSampleRate());
-                    alSourceQueueBuffers(_alSource, 1, &bid);
                 }
             }
-            /* Make sure the source hasn't underrun */
-            else if (sourceState != AL_PAUSED)
-            {
-                ALint queued;
 
-                /* If no buffers are queued, playback is finished */
-                alGetSourcei(_alSource, AL_BUFFERS_QUEUED, &queued);
-                if (queued == 0)
-                {
-                    needToExitThread = true;
-                }
-                else
-                {
-                    alSourcePlay(_alSource);
-                    if (alGetError() != AL_NO_ERROR)
-                    {
-                        AXLOGE("{}", "Error restarting playback!");
-                        needToExitThread = true;
-                    }
-                }
-            }
-
-            std::unique_lock<std::mutex> lk(_sleepMutex);
-            if (_isDestroyed || needToExitThread)
-            {
-                break;
-            }
-#if defined(__APPLE__)
-            if (!_needWakeupRotateThread)
-            {
-                _sleepCondition.wait_for(lk, std::chrono::milliseconds(rotateSleepTime));
-            }
-
-            _needWakeupRotateThread = false;
-#else
-            _sleepCondition.wait_for(lk, std::chrono::milliseconds(rotateSleepTime));
+            uint32_t framesRead = _streamPending ? _streamPendingFrames : readStreamFrames(budget);
+            _streamPending      = false;
+            if (framesRead == 0)
+                return false;
+
+            /*
+             While the source is playing, alSourceUnqueueBuffers can be called to remove buffers which have
+             already played. Those buffers can then be filled with new data or discarded. New or refilled
+             buffers can then be attached to the playing source using alSourceQueueBuffers. As long as there is
+             always a new buffer to play in the queue, the source will continue to play.
+             */
+            ALuint bid;
+            alSourceUnqueueBuffers(_alSource, 1, &bid);
+#if AX_USE_ALSOFT
+            const auto sourceFormat = _streamDecoder->getSourceFormat();
+            if (sourceFormat == AUDIO_SOURCE_FORMAT::ADPCM || sourceFormat == AUDIO_SOURCE_FORMAT::IMA_ADPCM)
+                alBufferi(bid, AL_UNPACK_BLOCK_ALIGNMENT_SOFT, _streamDecoder->getSamplesPerBlock());
 #endif
+            alBufferData(bid, _audioCache->_format, _streamBuffer, _streamDecoder->framesToBytes(framesRead),
+                         _streamDecoder->getSampleRate());
+            alSourceQueueBuffers(_alSource, 1, &bid);
         }
+    }
+    /* Make sure the source hasn't underrun */
+    else if (sourceState != AL_PAUSED)
+    {
+        ALint queued;
 
-    } while (false);
+        /* If no buffers are queued, playback is finished */
+        alGetSourcei(_alSource, AL_BUFFERS_QUEUED, &queued);
+        if (queued == 0)
+            return false;
+
+        alSourcePlay(_alSource);
+        if (alGetError() != AL_NO_ERROR)
+        {
+            AXLOGE("{}", "Error restarting playback!");
+            return false;
+        }
+    }
 
-    AXLOGV("{}", "Exit rotate buffer thread ...");
-    AudioDecoderManager::destroyDecoder(decoder);
-    free(tmpBuffer);
-    _isRotateThreadExited = true;
+    return true;
 }
 
-#if defined(__APPLE__)
-void AudioPlayer::wakeupRotateThread()
+void AudioPlayer::decodeAhead(int& budget)
 {
-    _needWakeupRotateThread = true;
-    _sleepCondition.notify_all();
+    if (budget > 0 && _streamDecoder != nullptr && !_streamPending && !_timeDirty && !_isDestroyed)
+    {
+        _streamPendingFrames = readStreamFrames(budget);
+        _streamPending       = true;
+    }
 }
-#endif
 
 bool AudioPlayer::isFinished() const
 {
     if (_streamingSource)
-        return _isRotateThreadExited;
+        return _isStreamFinished;
     else
     {
         ALint sourceState;
@@ -29,9 +29,8 @@
 #include "platform/PlatformConfig.h"
 
 #include <string>
-#include <condition_variable>
+#include <atomic>
 #include <mutex>
-#include <thread>
 
 #include "audio/AudioMacros.h"
 #include "platform/PlatformMacros.h"
@@ -41,6 +40,7 @@ namespace ax
 {
 
 class AudioCache;
+class AudioDecoder;
 class AudioEngineImpl;
 
 class AX_DLL AudioPlayer
@@ -62,11 +62,16 @@ public:
 
 protected:
     void setCache(AudioCache* cache);
-    void rotateBufferThread(int offsetFrame);
     bool play2d();
-#if defined(__APPLE__)
-    void wakeupRotateThread();
-#endif
+
+    // streaming, always invoked by the shared streaming thread of AudioEngineImpl with its lock held
+    bool openStream();
+    void closeStream();
+    /** Refills the processed queue buffers, returns false once the stream has finished. */
+    bool updateStream(int& budget);
+    /** Decodes the next queue buffer in advance so the next refill only has to upload it. */
+    void decodeAhead(int& budget);
+    uint32_t readStreamFrames(int& budget);
 
     AudioCache* _audioCache;
 
@@ -83,14 +88,13 @@ protected:
     float _currTime;
     bool _streamingSource;
     ALuint _bufferIds[QUEUEBUFFER_NUM];
-    std::thread* _rotateBufferThread;
-    std::condition_variable _sleepCondition;
-    std::mutex _sleepMutex;
-    bool _timeDirty;
-    bool _isRotateThreadExited;
-#if defined(__APPLE__)
-    std::atomic_bool _needWakeupRotateThread;
-#endif
+    AudioDecoder* _streamDecoder;
+    char* _streamBuffer;
+    uint32_t _streamFramesToRead;
+    uint32_t _streamPendingFrames;
+    bool _streamPending;
+    std::atomic_bool _timeDirty;
+    std::atomic_bool _isStreamFinished;
 
     std::mutex _play2dMutex;
 
@@ -179,6 +179,7 @@ THE SOFTWARE.
 #include "platform/Device.h"
 #include "platform/FileUtils.h"
 #include "platform/FileStream.h"
+#include "platform/PackFile.h"
 #include "platform/Image.h"
 #include "platform/PlatformConfig.h"
 #include "platform/PlatformMacros.h"
@@ -241,6 +242,7 @@ THE SOFTWARE.
 #include "2d/AnchoredSprite.h"
 #include "2d/AutoPolygon.h"
 #include "2d/SpriteBatchNode.h"
+#include "2d/InstancedSpriteBatchNode.h"
 #include "2d/SpriteFrame.h"
 #include "2d/SpriteFrameCache.h"
 
@@ -264,6 +266,7 @@ THE SOFTWARE.
 
 // 3d
 #include "3d/AABB.h"
+#include "3d/AABBTree.h"
 #include "3d/Animate3D.h"
 #include "3d/Animation3D.h"
 #include "3d/AttachNode.h"
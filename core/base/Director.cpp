@@ -79,6 +79,8 @@ namespace ax
 // singleton stuff
 static Director* s_SharedDirector = nullptr;
 
+static thread_local std::stack<Mat4>* s_threadMatrixStacks = nullptr;
+
 #define kDefaultFPS 60  // 60 frames per second
 
 const char* Director::EVENT_BEFORE_SET_NEXT_SCENE = "director_before_set_next_scene";
@@ -495,123 +497,61 @@ void Director::resetMatrixStack()
     initMatrixStack();
 }
 
-void Director::popMatrix(MATRIX_STACK_TYPE type)
+std::stack<Mat4>& Director::getMatrixStack(MATRIX_STACK_TYPE type)
 {
-    if (MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW == type)
-    {
-        _modelViewMatrixStack.pop();
-    }
-    else if (MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION == type)
+    // the renderer redirects the matrix stacks of worker threads visiting parallel subtrees
+    auto stacks = s_threadMatrixStacks;
+    if (type == MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW)
     {
-        _projectionMatrixStack.pop();
+        return stacks ? stacks[0] : _modelViewMatrixStack;
     }
-    else if (MATRIX_STACK_TYPE::MATRIX_STACK_TEXTURE == type)
+    else if (type == MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION)
     {
-        _textureMatrixStack.pop();
+        return stacks ? stacks[1] : _projectionMatrixStack;
     }
-    else
+    else if (type == MATRIX_STACK_TYPE::MATRIX_STACK_TEXTURE)
     {
-        AXASSERT(false, "unknown matrix stack type");
+        return stacks ? stacks[2] : _textureMatrixStack;
     }
+
+    AXASSERT(false, "unknown matrix stack type, will return modelview matrix stack instead");
+    return stacks ? stacks[0] : _modelViewMatrixStack;
+}
+
+void Director::setThreadMatrixStacks(std::stack<Mat4>* stacks)
+{
+    s_threadMatrixStacks = stacks;
+}
+
+void Director::popMatrix(MATRIX_STACK_TYPE type)
+{
+    getMatrixStack(type).pop();
 }
 
 void Director::loadIdentityMatrix(MATRIX_STACK_TYPE type)
 {
-    if (MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW == type)
-    {
-        _modelViewMatrixStack.top() = Mat4::IDENTITY;
-    }
-    else if (MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION == type)
-    {
-        _projectionMatrixStack.top() = Mat4::IDENTITY;
-    }
-    else if (MATRIX_STACK_TYPE::MATRIX_STACK_TEXTURE == type)
-    {
-        _textureMatrixStack.top() = Mat4::IDENTITY;
-    }
-    else
-    {
-        AXASSERT(false, "unknown matrix stack type");
-    }
+    getMatrixStack(type).top() = Mat4::IDENTITY;
 }
 
 void Director::loadMatrix(MATRIX_STACK_TYPE type, const Mat4& mat)
 {
-    if (MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW == type)
-    {
-        _modelViewMatrixStack.top() = mat;
-    }
-    else if (MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION == type)
-    {
-        _projectionMatrixStack.top() = mat;
-    }
-    else if (MATRIX_STACK_TYPE::MATRIX_STACK_TEXTURE == type)
-    {
-        _textureMatrixStack.top() = mat;
-    }
-    else
-    {
-        AXASSERT(false, "unknown matrix stack type");
-    }
+    getMatrixStack(type).top() = mat;
 }
 
 void Director::multiplyMatrix(MATRIX_STACK_TYPE type, const Mat4& mat)
 {
-    if (MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW == type)
-    {
-        _modelViewMatrixStack.top() *= mat;
-    }
-    else if (MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION == type)
-    {
-        _projectionMatrixStack.top() *= mat;
-    }
-    else if (MATRIX_STACK_TYPE::MATRIX_STACK_TEXTURE == type)
-    {
-        _textureMatrixStack.top() *= mat;
-    }
-    else
-    {
-        AXASSERT(false, "unknown matrix stack type");
-    }
+    getMatrixStack(type).top() *= mat;
 }
 
 void Director::pushMatrix(MATRIX_STACK_TYPE type)
 {
-    if (type == MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW)
-    {
-        _modelViewMatrixStack.push(_modelViewMatrixStack.top());
-    }
-    else if (type == MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION)
-    {
-        _projectionMatrixStack.push(_projectionMatrixStack.top());
-    }
-    else if (type == MATRIX_STACK_TYPE::MATRIX_STACK_TEXTURE)
-    {
-        _textureMatrixStack.push(_textureMatrixStack.top());
-    }
-    else
-    {
-        AXASSERT(false, "unknown matrix stack type");
-    }
+    auto& stack = getMatrixStack(type);
+    stack.push(stack.top());
 }
 
 const Mat4& Director::getMatrix(MATRIX_STACK_TYPE type) const
 {
-    if (type == MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW)
-    {
-        return _modelViewMatrixStack.top();
-    }
-    else if (type == MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION)
-    {
-        return _projectionMatrixStack.top();
-    }
-    else if (type == MATRIX_STACK_TYPE::MATRIX_STACK_TEXTURE)
-    {
-        return _textureMatrixStack.top();
-    }
-
-    AXASSERT(false, "unknown matrix stack type, will return modelview matrix instead");
-    return _modelViewMatrixStack.top();
+    return const_cast<Director*>(this)->getMatrixStack(type).top();
 }
 
 void Director::setProjection(Projection projection)
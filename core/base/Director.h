@@ -505,6 +505,15 @@ public:
      */
     void resetMatrixStack();
 
+    /**
+     * Redirects the matrix stacks used by the calling thread, nullptr restores the director's own stacks.
+     * The renderer uses it to visit parallel subtrees on worker threads.
+     *
+     * @param stacks An array of 3 matrix stacks indexed by MATRIX_STACK_TYPE.
+     * @js NA
+     */
+    static void setThreadMatrixStacks(std::stack<Mat4>* stacks);
+
     /**
      * returns the axmol thread id.
      Useful to know if certain code is already running on the axmol thread
@@ -567,6 +576,7 @@ protected:
     void destroyTextureCache();
 
     void initMatrixStack();
+    std::stack<Mat4>& getMatrixStack(MATRIX_STACK_TYPE type);
 
     std::stack<Mat4> _modelViewMatrixStack;
     std::stack<Mat4> _textureMatrixStack;
@@ -47,6 +47,9 @@ Timer::Timer()
     , _delay(0.0f)
     , _interval(0.0f)
     , _aborted(false)
+    , _syncClock(0.0)
+    , _queueGeneration(0)
+    , _queued(false)
 {}
 
 void Timer::setupTimerWithInterval(float seconds, unsigned int repeat, float delay)
@@ -117,6 +120,16 @@ bool Timer::isExhausted() const
     return !_runForever && _timesExecuted > _repeat;
 }
 
+float Timer::getTimeToTrigger() const
+{
+    // not started yet, or triggered every frame
+    if (_elapsed == -1)
+        return 0.0f;
+    if (_useDelay)
+        return _delay - _elapsed;
+    return (_interval > 0) ? _interval - _elapsed : 0.0f;
+}
+
 // TimerTargetSelector
 
 TimerTargetSelector::TimerTargetSelector() : _target(nullptr), _selector(nullptr) {}
@@ -218,8 +231,9 @@ const int Scheduler::PRIORITY_NON_SYSTEM_MIN = PRIORITY_SYSTEM + 1;
 
 Scheduler::Scheduler()
     : _timeScale(1.0f)
-    , _currentTarget(nullptr)
-    , _currentTargetSalvaged(false)
+    , _timerClock(0.0)
+    , _timerOrder(0)
+    , _staleTimerEntries(0)
     , _indexMapLocked(false)
 #if AX_ENABLE_SCRIPT_BINDING
     , _scriptHandlerEntries(20)
@@ -234,6 +248,105 @@ Scheduler::~Scheduler()
     unscheduleAll();
 }
 
+bool Scheduler::TimerQueueEntry::isValid() const
+{
+    return generation == timer->_queueGeneration && !timer->isAborted();
+}
+
+TimerHandle& Scheduler::addTimerTarget(void* target, bool paused)
+{
+    auto timerIt = _timersMap.find(target);
+    if (timerIt == _timersMap.end())
+    {
+        timerIt = _timersMap.emplace(target, TimerHandle{}).first;
+
+        // Is this the 1st element ? Then set the pause level to all the selectors of this target
+        timerIt->second.paused      = paused;
+        timerIt->second.pausedClock = _timerClock;
+        timerIt->second.timers.reserve(10);
+    }
+    else
+    {
+        AXASSERT(timerIt->second.paused == paused, "element's paused should be paused!");
+    }
+    return timerIt->second;
+}
+
+void Scheduler::requeueTimer(TimerHandle& timerHandle, Timer* timer, void* target)
+{
+    // the timer starts counting from the next update, or from the resume when the target is paused since
+    // resumeTimers shifts it by the whole paused time
+    if (timerHandle.paused)
+    {
+        timer->_syncClock = timerHandle.pausedClock;
+    }
+    else
+    {
+        timer->_syncClock = _timerClock;
+        enqueueTimer(timer, target);
+    }
+}
+
+void Scheduler::enqueueTimer(Timer* timer, void* target)
+{
+    if (timer->_queued)
+        ++_staleTimerEntries;
+    timer->_queued = true;
+    timer->retain();
+    _timerQueue.emplace_back(TimerQueueEntry{timer->_syncClock + timer->getTimeToTrigger(), _timerOrder++, timer,
+                                             target, ++timer->_queueGeneration});
+    std::push_heap(_timerQueue.begin(), _timerQueue.end(), TimerQueueEntry::later);
+}
+
+void Scheduler::retireTimer(Timer* timer)
+{
+    // the queue entry, if any, is released on its turn or by compactTimerQueue
+    timer->setAborted();
+    if (timer->_queued)
+    {
+        timer->_queued = false;
+        ++_staleTimerEntries;
+    }
+}
+
+void Scheduler::pauseTimers(TimerHandle& timerHandle)
+{
+    if (!timerHandle.paused)
+    {
+        timerHandle.paused      = true;
+        timerHandle.pausedClock = _timerClock;
+    }
+}
+
+void Scheduler::resumeTimers(TimerHandle& timerHandle, void* target)
+{
+    if (!timerHandle.paused)
+        return;
+
+    timerHandle.paused = false;
+
+    // the time spent paused doesn't count
+    const double pausedTime = _timerClock - timerHandle.pausedClock;
+    for (auto timer : timerHandle.timers)
+    {
+        timer->_syncClock += pausedTime;
+        enqueueTimer(timer, target);
+    }
+}
+
+void Scheduler::compactTimerQueue()
+{
+    auto last = std::remove_if(_timerQueue.begin(), _timerQueue.end(), [](const TimerQueueEntry& entry) {
+        if (entry.isValid())
+            return false;
+        entry.timer->release();
+        return true;
+    });
+    _staleTimerEntries -= std::distance(last, _timerQueue.end());
+    _timerQueue.erase(last, _timerQueue.end());
+    std::make_heap(_timerQueue.begin(), _timerQueue.end(), TimerQueueEntry::later);
+}
+
 void Scheduler::schedule(const ccSchedulerFunc& callback,
                          void* target,
                          float interval,
@@ -254,25 +367,9 @@ void Scheduler::schedule(const ccSchedulerFunc& callback,
     AXASSERT(target, "Argument target must be non-nullptr");
     AXASSERT(!key.empty(), "key should not be empty!");
 
-    auto timerIt = _timersMap.find(target);
-    if (timerIt == _timersMap.end())
-    {
-        timerIt = _timersMap.emplace(target, TimerHandle{}).first;
-
-        // Is this the 1st element ? Then set the pause level to all the selectors of this target
-        timerIt->second.paused = paused;
-    }
-    else
-    {
-        AXASSERT(timerIt->second.paused == paused, "element's paused should be paused!");
-    }
-
-    auto& timers = timerIt->second.timers;
-    if (timers.empty())
-    {
-        timers.reserve(10);
-    }
-    else
+    auto& timerHandle = addTimerTarget(target, paused);
+    auto& timers      = timerHandle.timers;
+    if (!timers.empty())
     {
         auto timerIt = std::find_if(timers.begin(), timers.end(), [&key](Timer* const itimer) {
             TimerTargetCallback* timer = dynamic_cast<TimerTargetCallback*>(itimer);
@@ -283,6 +380,7 @@ void Scheduler::schedule(const ccSchedulerFunc& callback,
             AXLOGD("Scheduler#schedule. Reiniting timer with interval {:.4f}, repeat {}, delay {:.4f}", interval, repeat,
                   delay);
             (*timerIt)->setupTimerWithInterval(interval, repeat, delay);
+            requeueTimer(timerHandle, *timerIt, target);
             return;
         }
     }
@@ -291,6 +389,7 @@ void Scheduler::schedule(const ccSchedulerFunc& callback,
     timer->initWithCallback(this, callback, target, key, interval, repeat, delay);
     timers.pushBack(timer);
     timer->release();
+    requeueTimer(timerHandle, timer, target);
 }
 
 void Scheduler::unschedule(std::string_view key, void* target)
@@ -311,30 +410,12 @@ void Scheduler::unschedule(std::string_view key, void* target)
 
             if (timer && key == timer->getKey())
             {
-                if (timer == timerHandle.currentTimer && (!timer->isAborted()))
-                {
-                    timer->retain();
-                    timer->setAborted();
-                }
-
+                retireTimer(timer);
                 timerHandle.timers.erase(i);
 
-                // update timerIndex in case we are in tick:, looping over the actions
-                if (timerHandle.timerIndex >= i)
-                {
-                    timerHandle.timerIndex--;
-                }
-
                 if (timerHandle.timers.empty())
                 {
-                    if (_currentTarget == &timerHandle)
-                    {
-                        _currentTargetSalvaged = true;
-                    }
-                    else
-                    {
-                        _timersMap.erase(timerIt);
-                    }
+                    _timersMap.erase(timerIt);
                 }
 
                 return;
@@ -499,6 +580,7 @@ void Scheduler::unscheduleAllWithMinPriority(int minPriority)
     {
         unscheduleAllForTarget(timerIt);
     }
+    compactTimerQueue();
 
     axstd::pod_vector<void*> targets;
 
@@ -562,23 +644,9 @@ void Scheduler::unscheduleAllForTarget(void* target)
 void Scheduler::unscheduleAllForTarget(std::unordered_map<void*, TimerHandle>::iterator& timerIt)
 {
     auto const target = timerIt->first;
-    auto& timerHandle = timerIt->second;
-    if (timerHandle.timers.contains(timerHandle.currentTimer) && (!timerHandle.currentTimer->isAborted()))
-    {
-        timerHandle.currentTimer->retain();
-        timerHandle.currentTimer->setAborted();
-    }
-    timerHandle.timers.clear();
-
-    if (_currentTarget == &timerHandle)
-    {
-        _currentTargetSalvaged = true;
-        ++timerIt;
-    }
-    else
-    {
-        timerIt = _timersMap.erase(timerIt);
-    }
+    for (auto timer : timerIt->second.timers)
+        retireTimer(timer);
+    timerIt = _timersMap.erase(timerIt);
 
     unscheduleUpdate(target);
 }
@@ -614,7 +682,7 @@ void Scheduler::resumeTarget(void* target)
     auto timerIt = _timersMap.find(target);
     if (timerIt != _timersMap.end())
     {
-        timerIt->second.paused = false;
+        resumeTimers(timerIt->second, target);
     }
 
     // update selector
@@ -633,7 +701,7 @@ void Scheduler::pauseTarget(void* target)
     auto timerIt = _timersMap.find(target);
     if (timerIt != _timersMap.end())
     {
-        timerIt->second.paused = true;
+        pauseTimers(timerIt->second);
     }
 
     // update selector
@@ -677,7 +745,7 @@ std::set<void*> Scheduler::pauseAllTargetsWithMinPriority(int minPriority)
     // Custom Selectors
     for (auto& [target, timerHandle] : _timersMap)
     {
-        timerHandle.paused = true;
+        pauseTimers(timerHandle);
         idsWithSelectors.insert(target);
     }
 
@@ -781,43 +849,46 @@ void Scheduler::update(float dt)
         }
     }
 
-    // Iterate over all the custom selectors
-    for (auto it = _timersMap.begin(); it != _timersMap.end();)
+    // Update the custom selectors which are due, timers (re)queued by the callbacks
+    // are picked on the next frame
+    _timerClock += dt;
+    while (!_timerQueue.empty() && _timerQueue.front().due <= _timerClock)
     {
-        auto elt               = &it->second;
-        _currentTarget         = elt;
-        _currentTargetSalvaged = false;
+        std::pop_heap(_timerQueue.begin(), _timerQueue.end(), TimerQueueEntry::later);
+        _dueTimers.emplace_back(_timerQueue.back());
+        _timerQueue.pop_back();
+    }
 
-        if (!_currentTarget->paused)
+    for (auto&& entry : _dueTimers)
+    {
+        // The entries retain their timer, it's safe to update a timer which unschedules itself
+        auto timer = entry.timer;
+        if (entry.isValid())
         {
-            // The 'timers' array may change while inside this loop
-            for (elt->timerIndex = 0; elt->timerIndex < elt->timers.size(); ++(elt->timerIndex))
-            {
-                elt->currentTimer = elt->timers[elt->timerIndex];
-                AXASSERT(!elt->currentTimer->isAborted(), "An aborted timer should not be updated");
-
-                elt->currentTimer->update(dt);
+            timer->_queued = false;
 
-                if (elt->currentTimer->isAborted())
-                {
-                    // The currentTimer told the remove itself. To prevent the timer from
-                    // accidentally deallocating itself before finishing its step, we retained
-                    // it. Now that step is done, it's safe to release it.
-                    elt->currentTimer->release();
-                }
+            // paused targets requeue their timers on resume
+            auto timerIt = _timersMap.find(entry.target);
+            if (timerIt != _timersMap.end() && !timerIt->second.paused)
+            {
+                timer->update(static_cast<float>(_timerClock - timer->_syncClock));
+                timer->_syncClock = _timerClock;
 
-                elt->currentTimer = nullptr;
+                if (!timer->isAborted() && !timer->_queued)
+                    enqueueTimer(timer, entry.target);
             }
         }
-
-        // only delete currentTarget if no actions were scheduled during the cycle (issue #481)
-        if (_currentTargetSalvaged && _currentTarget->timers.empty())
+        else
         {
-            it = _timersMap.erase(it);
+            --_staleTimerEntries;
         }
-        else
-            ++it;
+        timer->release();
     }
+    _dueTimers.clear();
+
+    // drop the entries of unscheduled timers once they dominate the queue
+    if (_staleTimerEntries > 64 && _staleTimerEntries * 2 > _timerQueue.size())
+        compactTimerQueue();
 
     // delete all updates that are removed in update
     for (auto&& sched : _updateDeleteVector)
@@ -829,7 +900,6 @@ void Scheduler::update(float dt)
     _updateDeleteVector.clear();
 
     _indexMapLocked = false;
-    _currentTarget  = nullptr;
 
 #if AX_ENABLE_SCRIPT_BINDING
     //
@@ -883,26 +953,9 @@ void Scheduler::schedule(SEL_SCHEDULE selector,
 {
     AXASSERT(target, "Argument target must be non-nullptr");
 
-    auto timerIt = _timersMap.find(target);
-
-    if (timerIt == _timersMap.end())
-    {
-        timerIt = _timersMap.emplace(target, TimerHandle{}).first;
-
-        // Is this the 1st element ? Then set the pause level to all the selectors of this target
-        timerIt->second.paused = paused;
-    }
-    else
-    {
-        AXASSERT(timerIt->second.paused == paused, "element's paused should be paused.");
-    }
-
-    auto&& timers = timerIt->second.timers;
-    if (timers.empty())
-    {
-        timers.reserve(10);
-    }
-    else
+    auto& timerHandle = addTimerTarget(target, paused);
+    auto&& timers     = timerHandle.timers;
+    if (!timers.empty())
     {
         auto timerIt = std::find_if(timers.begin(), timers.end(), [selector](Timer* const itimer) {
             TimerTargetSelector* timer = dynamic_cast<TimerTargetSelector*>(itimer);
@@ -913,6 +966,7 @@ void Scheduler::schedule(SEL_SCHEDULE selector,
             AXLOGD("Scheduler#schedule. Reiniting timer with interval {:.4}, repeat {}, delay {:.4f}", interval, repeat,
                   delay);
             (*timerIt)->setupTimerWithInterval(interval, repeat, delay);
+            requeueTimer(timerHandle, *timerIt, target);
             return;
         }
     }
@@ -921,6 +975,7 @@ void Scheduler::schedule(SEL_SCHEDULE selector,
     timer->initWithSelector(this, selector, target, interval, repeat, delay);
     timers.pushBack(timer);
     timer->release();
+    requeueTimer(timerHandle, timer, target);
 }
 
 void Scheduler::schedule(SEL_SCHEDULE selector, Object* target, float interval, bool paused)
@@ -968,30 +1023,12 @@ void Scheduler::unschedule(SEL_SCHEDULE selector, Object* target)
 
             if (timer && selector == timer->getSelector())
             {
-                if (timer == timerHandle.currentTimer && !timer->isAborted())
-                {
-                    timer->retain();
-                    timer->setAborted();
-                }
-
+                retireTimer(timer);
                 timers.erase(i);
 
-                // update timerIndex in case we are in tick:, looping over the actions
-                if (timerHandle.timerIndex >= i)
-                {
-                    timerHandle.timerIndex--;
-                }
-
                 if (timers.empty())
                 {
-                    if (_currentTarget == &timerHandle)
-                    {
-                        _currentTargetSalvaged = true;
-                    }
-                    else
-                    {
-                        _timersMap.erase(timerIt);
-                    }
+                    _timersMap.erase(timerIt);
                 }
 
                 return;
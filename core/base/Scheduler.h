@@ -48,6 +48,8 @@ typedef std::function<void(float)> ccSchedulerFunc;
  */
 class AX_DLL Timer : public Object
 {
+    friend class Scheduler;
+
 protected:
     Timer();
 
@@ -56,6 +58,8 @@ public:
     void setAborted() { _aborted = true; }
     bool isAborted() const { return _aborted; }
     bool isExhausted() const;
+    /** time left before the next update of the timer can trigger it */
+    float getTimeToTrigger() const;
 
     virtual void trigger(float dt) = 0;
     virtual void cancel()          = 0;
@@ -73,6 +77,11 @@ protected:
     float _delay;
     float _interval;
     bool _aborted;
+
+    // Scheduler timer queue bookkeeping
+    double _syncClock;  // scheduler clock up to which _elapsed is accumulated
+    unsigned int _queueGeneration;
+    bool _queued;
 };
 
 class AX_DLL TimerTargetSelector : public Timer
@@ -172,8 +181,7 @@ struct SchedHandle
 struct TimerHandle
 {
     Vector<Timer*> timers;
-    int timerIndex;
-    Timer* currentTimer;
+    double pausedClock;  // scheduler clock when the target was paused
     bool paused;
 };
 
@@ -513,6 +521,30 @@ protected:
 
     void unscheduleAllForTarget(std::unordered_map<void*, TimerHandle>::iterator& timerIt);
 
+    // interval timers
+    struct TimerQueueEntry
+    {
+        double due;      // scheduler clock of the next update
+        uint64_t order;  // keeps timers due at the same time in scheduling order
+        Timer* timer;    // retained while queued
+        void* target;
+        unsigned int generation;  // the entry is stale when it doesn't match the timer's
+
+        bool isValid() const;
+        static bool later(const TimerQueueEntry& lhs, const TimerQueueEntry& rhs)
+        {
+            return lhs.due > rhs.due || (lhs.due == rhs.due && lhs.order > rhs.order);
+        }
+    };
+
+    TimerHandle& addTimerTarget(void* target, bool paused);
+    void requeueTimer(TimerHandle& timerHandle, Timer* timer, void* target);
+    void enqueueTimer(Timer* timer, void* target);
+    void retireTimer(Timer* timer);
+    void pauseTimers(TimerHandle& timerHandle);
+    void resumeTimers(TimerHandle& timerHandle, void* target);
+    void compactTimerQueue();
+
     float _timeScale;
 
     axstd::pod_vector<SchedHandle*> _waitList; // list wait active
@@ -531,8 +563,13 @@ protected:
 
     // Used for "selectors with interval"
     std::unordered_map<void*, TimerHandle> _timersMap;
-    struct TimerHandle* _currentTarget;
-    bool _currentTargetSalvaged;
+    // min-heap of the interval timers by due time, only the timers due are updated each frame.
+    // Paused targets drop their entries and requeue them on resume.
+    std::vector<TimerQueueEntry> _timerQueue;
+    std::vector<TimerQueueEntry> _dueTimers;
+    double _timerClock;  // sum of the scaled frame deltas
+    uint64_t _timerOrder;
+    size_t _staleTimerEntries;
     // If true unschedule will not remove anything from a hash. Elements will only be marked for deletion.
     bool _indexMapLocked;
 
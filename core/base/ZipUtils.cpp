@@ -46,6 +46,8 @@
 #include "platform/FileUtils.h"
 #include <map>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
 
 #include "yasio/string_view.hpp"
 
@@ -541,6 +543,9 @@ struct ZipEntryInfo
     unz_file_pos pos;
     uint64_t uncompressed_size;
     uint64_t offset;
+    // stored (uncompressed) entries of single disk archives are read directly, bypassing unzip
+    uint64_t local_header_offset;
+    bool stored;
 };
 
 struct ZipFilePrivate
@@ -556,6 +561,144 @@ struct ZipFilePrivate
         functionOverrides.zclose_file    = ZipFile_close_file_func;
         functionOverrides.zerror_file    = ZipFile_error_file_func;
         functionOverrides.opaque         = this;
+        readerCount                      = 0;
+        maxReaders                       = (std::max)(2u, std::thread::hardware_concurrency());
+    }
+
+    ~ZipFilePrivate()
+    {
+        for (auto reader : idleReaders)
+        {
+            unzClose(reader->zipFile);
+            delete reader;
+        }
+    }
+
+    // Each reader owns its unzFile handle (and inflate stream), so reads on different threads never share one
+    struct Reader
+    {
+        unzFile zipFile = nullptr;
+        std::unique_ptr<IFileStream> stream;
+    };
+
+    Reader* acquireReader()
+    {
+        std::unique_lock<std::mutex> lck(readerMtx);
+        for (;;)
+        {
+            if (!idleReaders.empty())
+            {
+                auto reader = idleReaders.back();
+                idleReaders.pop_back();
+                return reader;
+            }
+
+            if (readerCount < maxReaders)
+            {
+                ++readerCount;
+                lck.unlock();
+
+                auto reader     = new Reader();
+                reader->zipFile = unzOpen2_64(zipFileName.c_str(), &functionOverrides);
+                if (reader->zipFile)
+                    return reader;
+
+                delete reader;
+                lck.lock();
+                --readerCount;
+                readerCond.notify_one();
+                return nullptr;
+            }
+
+            readerCond.wait(lck);
+        }
+    }
+
+    void releaseReader(Reader* reader)
+    {
+        std::lock_guard<std::mutex> lck(readerMtx);
+        idleReaders.push_back(reader);
+        readerCond.notify_one();
+    }
+
+    // Reads a stored entry straight from the archive into buf, without going through unzip's intermediate buffer
+    static int readStoredEntry(Reader* reader,
+                               std::string_view zipFileName,
+                               const ZipEntryInfo& entry,
+                               uint64_t offset,
+                               void* buf,
+                               unsigned int size)
+    {
+        if (!reader->stream)
+            reader->stream = FileUtils::getInstance()->openFileStream(zipFileName, IFileStream::Mode::READ);
+        if (!reader->stream)
+            return -1;
+
+        // local file header: signature(4), ..., file name length(2) at 26, extra field length(2) at 28
+        uint8_t header[30];
+        if (reader->stream->seek(static_cast<int64_t>(entry.local_header_offset), SEEK_SET) < 0 ||
+            reader->stream->read(header, sizeof(header)) != static_cast<int>(sizeof(header)))
+            return -1;
+        if (header[0] != 0x50 || header[1] != 0x4b || header[2] != 0x03 || header[3] != 0x04)
+            return -1;
+
+        const uint64_t dataOffset = entry.local_header_offset + sizeof(header) + (header[26] | (header[27] << 8)) +
+                                    (header[28] | (header[29] << 8));
+        if (reader->stream->seek(static_cast<int64_t>(dataOffset + offset), SEEK_SET) < 0)
+            return -1;
+        return reader->stream->read(buf, size);
+    }
+
+    // The size of the data prepended to the archive (self extracting stub, signing block...), which minizip adds to
+    // every offset of the central directory, see byte_before_the_zipfile in unzOpenInternal
+    static uint64_t getArchivePrefixSize(std::string_view zipFileName)
+    {
+        auto fs = FileUtils::getInstance()->openFileStream(zipFileName, IFileStream::Mode::READ);
+        if (!fs)
+            return 0;
+
+        const auto fileSize = fs->size();
+        // end of central directory record(22) and its comment(up to 65535)
+        const auto tailSize = static_cast<unsigned int>((std::min)(fileSize, static_cast<int64_t>(22 + 0xffff)));
+        std::vector<uint8_t> tail(tailSize);
+        if (tailSize < 22 || fs->seek(fileSize - tailSize, SEEK_SET) < 0 ||
+            fs->read(tail.data(), tailSize) != static_cast<int>(tailSize))
+            return 0;
+
+        auto le = [](const uint8_t* p, int n) {
+            uint64_t v = 0;
+            for (int i = n - 1; i >= 0; --i)
+                v = (v << 8) | p[i];
+            return v;
+        };
+
+        for (auto i = static_cast<int64_t>(tailSize) - 22; i >= 0; --i)
+        {
+            const uint8_t* eocd = tail.data() + i;
+            if (le(eocd, 4) != 0x06054b50)
+                continue;
+
+            uint64_t centralPos    = static_cast<uint64_t>(fileSize - tailSize + i);
+            uint64_t centralSize   = le(eocd + 12, 4);
+            uint64_t centralOffset = le(eocd + 16, 4);
+
+            // zip64 end of central directory locator, then record
+            uint8_t locator[20];
+            uint8_t eocd64[56];
+            if (centralPos >= sizeof(locator) &&
+                fs->seek(static_cast<int64_t>(centralPos - sizeof(locator)), SEEK_SET) >= 0 &&
+                fs->read(locator, sizeof(locator)) == static_cast<int>(sizeof(locator)) &&
+                le(locator, 4) == 0x07064b50 && fs->seek(static_cast<int64_t>(le(locator + 8, 8)), SEEK_SET) >= 0 &&
+                fs->read(eocd64, sizeof(eocd64)) == static_cast<int>(sizeof(eocd64)) && le(eocd64, 4) == 0x06064b50)
+            {
+                centralPos    = le(locator + 8, 8);
+                centralSize   = le(eocd64 + 40, 8);
+                centralOffset = le(eocd64 + 48, 8);
+            }
+
+            return centralPos >= centralOffset + centralSize ? centralPos - (centralOffset + centralSize) : 0;
+        }
+        return 0;
     }
 
     // unzip overrides to support IFileStream
@@ -663,8 +806,14 @@ struct ZipFilePrivate
     // End of Overrides
 
     std::string zipFileName;
+    // used for enumeration only, reads go through the reader pool
     unzFile zipFile;
-    std::mutex zipFileMtx;
+
+    std::mutex readerMtx;
+    std::condition_variable readerCond;
+    std::vector<Reader*> idleReaders;
+    unsigned int readerCount;
+    unsigned int maxReaders;
 
     // std::unordered_map is faster if available on the platform
     typedef hlookup::string_map<struct ZipEntryInfo> FileListContainer;
@@ -715,6 +864,8 @@ bool ZipFile::setFilter(std::string_view filter)
         // clear existing file list
         _data->fileList.clear();
 
+        const uint64_t prefixSize = ZipFilePrivate::getArchivePrefixSize(_data->zipFileName);
+
         // UNZ_MAXFILENAMEINZIP + 1 - it is done so in unzLocateFile
         char szCurrentFileName[UNZ_MAXFILENAMEINZIP + 1];
         unz_file_info64 fileInfo;
@@ -731,7 +882,10 @@ bool ZipFile::setFilter(std::string_view filter)
                 // cache info about filtered files only (like 'assets/')
                 if (filter.empty() || currentFileName.substr(0, filter.length()) == filter)
                 {
-                    _data->fileList[currentFileName] = ZipEntryInfo{posInfo, (uint64_t)fileInfo.uncompressed_size, 0};
+                    const bool stored = fileInfo.compression_method == 0 && (fileInfo.flag & 1) == 0 &&
+                                        fileInfo.disk_num_start == 0;
+                    _data->fileList[currentFileName] = ZipEntryInfo{
+                        posInfo, (uint64_t)fileInfo.uncompressed_size, 0, prefixSize + fileInfo.disk_offset, stored};
                 }
             }
             // next file - also get the information about it
@@ -804,20 +958,34 @@ bool ZipFile::getFileData(std::string_view fileName, ResizableBuffer* buffer)
 
         ZipEntryInfo& fileInfo = it->second;
 
-        std::unique_lock<std::mutex> lck(_data->zipFileMtx);
+        auto reader = _data->acquireReader();
+        AX_BREAK_IF(!reader);
 
-        int nRet = unzGoToFilePos(_data->zipFile, &fileInfo.pos);
-        AX_BREAK_IF(UNZ_OK != nRet);
+        buffer->resize(fileInfo.uncompressed_size);
+        if (fileInfo.stored)
+        {
+            int nSize = ZipFilePrivate::readStoredEntry(reader, _data->zipFileName, fileInfo, 0, buffer->buffer(),
+                                                        static_cast<unsigned int>(fileInfo.uncompressed_size));
+            res       = nSize == (int)fileInfo.uncompressed_size;
+        }
 
-        nRet = unzOpenCurrentFile(_data->zipFile);
-        AX_BREAK_IF(UNZ_OK != nRet);
+        // through unzip, or when the stored entry couldn't be read directly
+        if (!res)
+        {
+            int nRet = unzGoToFilePos(reader->zipFile, &fileInfo.pos);
+            if (UNZ_OK == nRet)
+                nRet = unzOpenCurrentFile(reader->zipFile);
+            if (UNZ_OK == nRet)
+            {
+                int AX_UNUSED nSize = unzReadCurrentFile(reader->zipFile, buffer->buffer(),
+                                                         static_cast<unsigned int>(fileInfo.uncompressed_size));
+                AXASSERT(nSize == 0 || nSize == (int)fileInfo.uncompressed_size, "the file size is wrong");
+                unzCloseCurrentFile(reader->zipFile);
+                res = true;
+            }
+        }
 
-        buffer->resize(fileInfo.uncompressed_size);
-        int AX_UNUSED nSize =
-            unzReadCurrentFile(_data->zipFile, buffer->buffer(), static_cast<unsigned int>(fileInfo.uncompressed_size));
-        AXASSERT(nSize == 0 || nSize == (int)fileInfo.uncompressed_size, "the file size is wrong");
-        unzCloseCurrentFile(_data->zipFile);
-        res = true;
+        _data->releaseReader(reader);
     } while (0);
 
     return res;
@@ -874,19 +1042,34 @@ int ZipFile::vread(ZipEntryInfo* entry, void* buf, unsigned int size)
     {
         AX_BREAK_IF(entry == nullptr || entry->offset >= entry->uncompressed_size);
 
-        std::unique_lock<std::mutex> lck(_data->zipFileMtx);
+        auto reader = _data->acquireReader();
+        AX_BREAK_IF(!reader);
 
-        int nRet = unzGoToFilePos(_data->zipFile, &entry->pos);
-        AX_BREAK_IF(UNZ_OK != nRet);
+        n = -1;
+        if (entry->stored)
+        {
+            size = static_cast<unsigned int>((std::min)(static_cast<uint64_t>(size),
+                                                        entry->uncompressed_size - entry->offset));
+            n    = ZipFilePrivate::readStoredEntry(reader, _data->zipFileName, *entry, entry->offset, buf, size);
+        }
+
+        // through unzip, or when the stored entry couldn't be read directly
+        if (n < 0)
+        {
+            n = 0;
+            if (UNZ_OK == unzGoToFilePos(reader->zipFile, &entry->pos))
+            {
+                unzOpenCurrentFile(reader->zipFile);
+                unzSeek64(reader->zipFile, entry->offset, SEEK_SET);
+                n = unzReadCurrentFile(reader->zipFile, buf, size);
+                unzCloseCurrentFile(reader->zipFile);
+            }
+        }
 
-        nRet = unzOpenCurrentFile(_data->zipFile);
-        unzSeek64(_data->zipFile, entry->offset, SEEK_SET);
-        n = unzReadCurrentFile(_data->zipFile, buf, size);
         if (n > 0)
             entry->offset += n;
 
-        unzCloseCurrentFile(_data->zipFile);
-
+        _data->releaseReader(reader);
     } while (false);
 
     return n;
@@ -97,9 +97,13 @@ public:
         auto jobSystem = ax::Director::getInstance()->getJobSystem();
 
         const int PARALLELS = std::clamp(std::thread::hardware_concurrency(), 2u, ASTCDEC_MAX_PARALLELS);
-        for (int i = 0; i < PARALLELS; ++i)
+        for (int i = 1; i < PARALLELS; ++i)
             jobSystem->enqueue([task] { execute(task); });
 
+        // decode on the calling thread too, it may be a JobSystem worker itself, e.g. TextureCache decode workers,
+        // so waiting only could starve the pool
+        execute(task);
+
         task->wait_done();
 
         return ASTCENC_SUCCESS;
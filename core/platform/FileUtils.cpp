@@ -37,6 +37,8 @@ THE SOFTWARE.
 #include "platform/SAXParser.h"
 #include "platform/FileStream.h"
 
+#include "mio/mio.hpp"
+
 #ifdef MINIZIP_FROM_SYSTEM
 #    include <minizip/unzip.h>
 #else  // from our embedded sources
@@ -584,6 +586,10 @@ FileUtils::Status FileUtils::getContents(std::string_view filename, ResizableBuf
 
     const auto fullPath = fileUtils->fullPathForFilename(filename);
 
+    std::shared_ptr<PackFile> pack;
+    if (auto entry = findPackEntry(fullPath, pack))
+        return pack->read(entry, buffer) ? Status::OK : Status::ReadFailed;
+
     FileStream fileStream;
     fileStream.open(fullPath, IFileStream::Mode::READ);
     if (!fileStream)
@@ -610,6 +616,65 @@ FileUtils::Status FileUtils::getContents(std::string_view filename, ResizableBuf
 
     return Status::OK;
 }
+
+FileMapping::~FileMapping()
+{
+    delete static_cast<mio::mmap_source*>(_mmap);
+}
+
+uint8_t* FileMapping::takeBuffer(ssize_t* size)
+{
+    if (isMapped())
+        return nullptr;
+
+    _data = nullptr;
+    _size = 0;
+    return _buffer.takeBuffer(size);
+}
+
+std::shared_ptr<FileMapping> FileUtils::mapFile(std::string_view filename) const
+{
+    if (filename.empty())
+        return nullptr;
+
+    const auto fullPath = fullPathForFilename(filename);
+
+    auto mapping = std::make_shared<FileMapping>();
+
+    // a delegate may transform the contents in getContents, i.e. decryption
+    if (canMapFile(fullPath))
+    {
+        std::shared_ptr<PackFile> pack;
+        if (auto entry = findPackEntry(fullPath, pack))
+            return pack->map(entry);
+
+        FileStream fileStream;
+        if (fileStream.open(fullPath, IFileStream::Mode::READ) && fileStream.nativeHandle() != (osfhnd_t)-1 &&
+            fileStream.size() > 0)
+        {
+            // the mapping keeps the file contents alive after the handle is closed
+            std::error_code error;
+            auto mmap = std::make_unique<mio::mmap_source>();
+            mmap->map(fileStream.nativeHandle(), 0, mio::map_entire_file, error);
+            if (!error)
+            {
+                mapping->_data = reinterpret_cast<const uint8_t*>(mmap->data());
+                mapping->_size = mmap->size();
+                mapping->_mmap = mmap.release();
+                return mapping;
+            }
+            AXLOGW("FileUtils::mapFile: mapping {} failed, {}", fullPath, error.message());
+        }
+    }
+
+    if (getContents(fullPath, &mapping->_buffer) != Status::OK)
+        return nullptr;
+
+    mapping->_data = mapping->_buffer.getBytes();
+    mapping->_size = static_cast<size_t>(mapping->_buffer.getSize());
+    return mapping;
+}
+
 #ifndef AX_CORE_PROFILE
 void FileUtils::writeValueMapToFile(ValueMap dict, std::string_view fullPath, std::function<void(bool)> callback) const
 {
@@ -670,7 +735,7 @@ std::string FileUtils::fullPathForFilename(std::string_view filename) const
      * getStringFromFile/getDataFromFile at sub-thread c. then this function will call again with really fullPath d.
      * then isAbsolutePath avoid to access _fullPathCache _fullPathCache concurrent
      */
-    if (isAbsolutePath(filename))
+    if (isAbsolutePath(filename) || packEntryExists(filename))
     {
         return std::string{filename};
     }
@@ -684,6 +749,20 @@ std::string FileUtils::fullPathForFilename(std::string_view filename) const
 
     std::string fullpath;
 
+    // Mounted archives first, a hash lookup each instead of a stat call per search path
+    {
+        std::shared_lock<std::shared_mutex> lck(_mountedPacksMutex);
+        for (const auto& pack : _mountedPacks)
+        {
+            if (pack->find(filename))
+            {
+                fullpath.assign(pack->getPath()).append(1, '/').append(filename);
+                _fullPathCache.emplace(filename, fullpath);
+                return fullpath;
+            }
+        }
+    }
+
     for (const auto& searchIt : _searchPathArray)
     {
         fullpath = this->getPathForFilename(filename, searchIt);
@@ -878,6 +957,86 @@ void FileUtils::addSearchPath(std::string_view searchpath, const bool front)
     }
 }
 
+bool FileUtils::mountPack(std::string_view packFile)
+{
+    auto fullPath = fullPathForFilename(packFile);
+    if (fullPath.empty())
+        return false;
+
+    auto pack = PackFile::open(fullPath);
+    if (!pack)
+    {
+        AXLOGW("FileUtils::mountPack: {} isn't a valid pack", fullPath);
+        return false;
+    }
+
+    {
+        // mounting the same archive again moves it to the front
+        std::unique_lock<std::shared_mutex> lck(_mountedPacksMutex);
+        std::erase_if(_mountedPacks, [&](const std::shared_ptr<PackFile>& mounted) {
+            return mounted->getPath() == fullPath;
+        });
+        _mountedPacks.insert(_mountedPacks.begin(), std::move(pack));
+    }
+
+    // files cached from the search paths may be shadowed by the archive now
+    _fullPathCache.clear();
+    return true;
+}
+
+void FileUtils::unmountPack(std::string_view packFile)
+{
+    auto fullPath = fullPathForFilename(packFile);
+
+    std::unique_lock<std::shared_mutex> lck(_mountedPacksMutex);
+    auto it = std::find_if(_mountedPacks.begin(), _mountedPacks.end(),
+                           [&](const std::shared_ptr<PackFile>& pack) { return pack->getPath() == fullPath; });
+    if (it != _mountedPacks.end())
+    {
+        _mountedPacks.erase(it);
+        lck.unlock();
+        _fullPathCache.clear();
+    }
+}
+
+const PackFile::Entry* FileUtils::findPackEntryUnlocked(std::string_view fullPath,
+                                                       std::shared_ptr<PackFile>& pack) const
+{
+    for (const auto& mounted : _mountedPacks)
+    {
+        auto packPath = mounted->getPath();
+        if (fullPath.size() > packPath.size() + 1 && fullPath[packPath.size()] == '/' &&
+            cxx20::starts_with(fullPath, packPath))
+        {
+            if (auto entry = mounted->find(fullPath.substr(packPath.size() + 1)))
+            {
+                pack = mounted;
+                return entry;
+            }
+        }
+    }
+    return nullptr;
+}
+
+const PackFile::Entry* FileUtils::findPackEntry(std::string_view fullPath, std::shared_ptr<PackFile>& pack) const
+{
+    std::shared_lock<std::shared_mutex> lck(_mountedPacksMutex);
+    return findPackEntryUnlocked(fullPath, pack);
+}
+
+bool FileUtils::packEntryExists(std::string_view fullPath) const
+{
+    return getPackEntrySize(fullPath) >= 0;
+}
+
+int64_t FileUtils::getPackEntrySize(std::string_view fullPath) const
+{
+    std::shared_lock<std::shared_mutex> lck(_mountedPacksMutex);
+    std::shared_ptr<PackFile> pack;
+    auto entry = findPackEntryUnlocked(fullPath, pack);
+    return entry ? static_cast<int64_t>(entry->originalSize) : -1;
+}
+
 std::string FileUtils::getFullPathForFilenameWithinDirectory(std::string_view directory,
                                                              std::string_view filename) const
 {
@@ -897,6 +1056,9 @@ std::string FileUtils::getFullPathForFilenameWithinDirectory(std::string_view di
 
 bool FileUtils::isFileExist(std::string_view filename) const
 {
+    if (packEntryExists(filename))
+        return true;
+
     if (isAbsolutePath(filename))
     {
         return isFileExistInternal(filename);
@@ -1037,6 +1199,10 @@ void FileUtils::listFilesRecursivelyAsync(std::string_view dirPath,
 
 std::unique_ptr<IFileStream> FileUtils::openFileStream(std::string_view filePath, IFileStream::Mode mode) const
 {
+    std::shared_ptr<PackFile> pack;
+    if (auto entry = findPackEntry(filePath, pack))
+        return mode == IFileStream::Mode::READ ? pack->openStream(entry) : nullptr;
+
     FileStream fs;
     return fs.open(filePath, mode) ? std::make_unique<FileStream>(std::move(fs)) : nullptr;
 }
@@ -1295,6 +1461,9 @@ int64_t FileUtils::getFileSize(std::string_view filepath) const
     else
         path = filepath;
 
+    if (auto size = getPackEntrySize(path); size >= 0)
+        return size;
+
     struct stat info;
     // Get data associated with "crt_stat.c":
     int result = ::stat(path.data(), &info);
@@ -32,9 +32,11 @@ THE SOFTWARE.
 #include <unordered_map>
 #include <type_traits>
 #include <mutex>
+#include <shared_mutex>
 #include <memory>
 
 #include "platform/IFileStream.h"
+#include "platform/PackFile.h"
 #include "platform/PlatformMacros.h"
 #include "base/Types.h"
 #include "base/Value.h"
@@ -98,6 +100,43 @@ public:
     virtual size_t size() const override { return _buffer->size() * sizeof(typename T::value_type); }
 };
 
+/**
+ * Read-only view of a whole file, obtained by FileUtils::mapFile.
+ * The contents are memory mapped when possible, otherwise they are read into an owned buffer.
+ */
+class AX_DLL FileMapping
+{
+public:
+    FileMapping() = default;
+    ~FileMapping();
+
+    const uint8_t* data() const { return _data; }
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    /** Whether the contents are memory mapped rather than read into a buffer. */
+    bool isMapped() const { return _mmap != nullptr || _parent != nullptr; }
+
+    /**
+     * Takes the buffer of a not mapped view, which must be released with free().
+     * @return nullptr when the view is memory mapped.
+     */
+    uint8_t* takeBuffer(ssize_t* size);
+
+private:
+    friend class FileUtils;
+    friend class PackFile;
+
+    FileMapping(const FileMapping&)            = delete;
+    FileMapping& operator=(const FileMapping&) = delete;
+
+    const uint8_t* _data = nullptr;
+    size_t _size         = 0;
+    void* _mmap          = nullptr;  // mio::mmap_source
+    std::shared_ptr<FileMapping> _parent;  // the mapped archive a view of a packed entry points into
+    Data _buffer;
+};
+
 /** Helper class to handle file operations. */
 class AX_DLL FileUtils
 {
@@ -226,6 +265,28 @@ public:
     }
     virtual Status getContents(std::string_view filename, ResizableBuffer* buffer) const;
 
+    /**
+     *  Gets a read-only view of whole file contents, memory mapped when the file lives on a regular file system,
+     *  falls back to getContents otherwise (i.e. android apk assets, zip archives, empty files).
+     *
+     *  The view stays valid as long as it's referenced, parsers can consume it without copying.
+     *  Files are only mapped when canMapFile allows it, they are read through getContents otherwise.
+     *
+     *  @param filename The resource file name which contains the path.
+     *  @return The view, nullptr when the file can't be opened or read.
+     */
+    virtual std::shared_ptr<FileMapping> mapFile(std::string_view filename) const;
+
+    /**
+     *  Whether mapFile may map a file instead of reading it through getContents.
+     *  Only the platform instance created by getInstance maps files by default. A delegate set by setDelegate
+     *  reads them through its getContents, which may transform them (i.e. decryption), it can override this
+     *  to return true when it reads them as-is.
+     *
+     *  @param fullPath The full path of the file.
+     */
+    virtual bool canMapFile(std::string_view fullPath) const { return _canMapFiles; }
+
     /** Returns the fullpath for a given filename.
 
      First it will try to get a new filename from the "filenameLookup" dictionary.
@@ -330,6 +391,20 @@ public:
      */
     void addSearchPath(std::string_view path, const bool front = false);
 
+    /**
+     * Mounts a packed archive (.axpk, see PackFile) into the file search chain.
+     * Mounted archives are searched before the search paths, the most recently mounted first, with a single
+     * hash lookup per archive instead of file system stat calls. Files found in an archive are exposed under the
+     * archive path as if it were a directory, i.e. "res.axpk/images/a.png".
+     *
+     * @param packFile The archive file, resolved with fullPathForFilename.
+     * @return false if the archive can't be opened.
+     */
+    bool mountPack(std::string_view packFile);
+
+    /** Unmounts a packed archive mounted by mountPack. */
+    void unmountPack(std::string_view packFile);
+
     /**
      *  Gets the array of search paths.
      *
@@ -847,6 +922,31 @@ protected:
      */
     std::vector<std::string> _originalSearchPaths;
 
+    /**
+     * The packed archives mounted by 'mountPack', the lower index the higher priority.
+     * Read by JobSystem workers loading files, locked by _mountedPacksMutex.
+     */
+    std::vector<std::shared_ptr<PackFile>> _mountedPacks;
+    mutable std::shared_mutex _mountedPacksMutex;
+
+    /** Set by getInstance for the platform instance, see canMapFile. */
+    bool _canMapFiles = false;
+
+    /**
+     * Finds the archive entry of a path inside a mounted archive, nullptr if the path isn't in any.
+     * The archive is returned in pack, which keeps the entry alive if the archive is unmounted meanwhile.
+     */
+    const PackFile::Entry* findPackEntry(std::string_view fullPath, std::shared_ptr<PackFile>& pack) const;
+
+    /** Whether the path is inside a mounted archive. */
+    bool packEntryExists(std::string_view fullPath) const;
+
+    /** The uncompressed size of a file inside a mounted archive, -1 if the path isn't in any. */
+    int64_t getPackEntrySize(std::string_view fullPath) const;
+
+    /** findPackEntry for callers already holding _mountedPacksMutex. */
+    const PackFile::Entry* findPackEntryUnlocked(std::string_view fullPath, std::shared_ptr<PackFile>& pack) const;
+
     /**
      *  The default root path of resources.
      *  If the default root path of resources needs to be changed, do it in the `init` method of FileUtils's subclass.
@@ -590,14 +590,9 @@ bool Image::initWithImageFile(std::string_view path)
     bool ret  = false;
     _filePath = FileUtils::getInstance()->fullPathForFilename(path);
 
-    Data data = FileUtils::getInstance()->getDataFromFile(_filePath);
-
-    if (!data.isNull())
-    {
-        ssize_t n = 0;
-        auto buf  = data.takeBuffer(&n);
-        ret       = initWithImageData(buf, n, true);
-    }
+    auto mapping = FileUtils::getInstance()->mapFile(_filePath);
+    if (mapping)
+        ret = initWithImageMapping(mapping.get());
 
     return ret;
 }
@@ -607,18 +602,24 @@ bool Image::initWithImageFileThreadSafe(std::string_view fullpath)
     bool ret  = false;
     _filePath = fullpath;
 
-    Data data = FileUtils::getInstance()->getDataFromFile(_filePath);
-
-    if (!data.isNull())
-    {
-        ssize_t n = 0;
-        auto buf  = data.takeBuffer(&n);
-        ret       = initWithImageData(buf, n, true);
-    }
+    auto mapping = FileUtils::getInstance()->mapFile(_filePath);
+    if (mapping)
+        ret = initWithImageMapping(mapping.get());
 
     return ret;
 }
 
+bool Image::initWithImageMapping(FileMapping* mapping)
+{
+    // decode straight from the mapped file, the buffered fallback is handed over as before
+    if (mapping->isMapped())
+        return initWithImageData(mapping->data(), static_cast<ssize_t>(mapping->size()));
+
+    ssize_t n = 0;
+    auto buf  = mapping->takeBuffer(&n);
+    return initWithImageData(buf, n, true);
+}
+
 bool Image::initWithImageData(const uint8_t* data, ssize_t dataLen)
 {
     return initWithImageData(const_cast<uint8_t*>(data), dataLen, false);
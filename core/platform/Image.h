@@ -48,6 +48,8 @@ THE SOFTWARE.
 namespace ax
 {
 
+class FileMapping;
+
 /**
  * @addtogroup platform
  * @{
@@ -260,6 +262,7 @@ protected:
      @return  true if loaded correctly.
      */
     bool initWithImageFileThreadSafe(std::string_view fullpath);
+    bool initWithImageMapping(FileMapping* mapping);
 
     Format detectFormat(const uint8_t* data, ssize_t dataLen);
     bool isPng(const uint8_t* data, ssize_t dataLen);
@@ -0,0 +1,236 @@
+// Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md)
+#include "platform/PackFile.h"
+#include "platform/FileUtils.h"
+
+#include <zlib.h>
+#include "xxhash/xxhash.h"
+
+namespace ax
+{
+
+static_assert(sizeof(PackFile::Header) == 40, "PackFile::Header layout mismatch with tools/axpack");
+static_assert(sizeof(PackFile::Entry) == 32, "PackFile::Entry layout mismatch with tools/axpack");
+
+namespace
+{
+// read-only stream over a view of an entry
+class PackEntryStream : public IFileStream
+{
+public:
+    explicit PackEntryStream(std::shared_ptr<FileMapping> view) : _view(std::move(view)) {}
+
+    bool open(std::string_view, IFileStream::Mode) override { return false; }
+    int close() override
+    {
+        _view.reset();
+        return 0;
+    }
+
+    int64_t seek(int64_t offset, int origin) const override
+    {
+        int64_t pos;
+        switch (origin)
+        {
+        case SEEK_SET:
+            pos = offset;
+            break;
+        case SEEK_CUR:
+            pos = _pos + offset;
+            break;
+        case SEEK_END:
+            pos = size() + offset;
+            break;
+        default:
+            return -1;
+        }
+        if (pos < 0 || pos > size())
+            return -1;
+        _pos = pos;
+        return _pos;
+    }
+
+    int read(void* buf, unsigned int size) const override
+    {
+        if (!_view)
+            return -1;
+        const auto n = static_cast<unsigned int>((std::min)(static_cast<int64_t>(size), this->size() - _pos));
+        memcpy(buf, _view->data() + _pos, n);
+        _pos += n;
+        return static_cast<int>(n);
+    }
+
+    int write(const void*, unsigned int) const override { return -1; }
+    int64_t tell() const override { return _pos; }
+    int64_t size() const override { return _view ? static_cast<int64_t>(_view->size()) : 0; }
+    bool isOpen() const override { return !!_view; }
+
+private:
+    std::shared_ptr<FileMapping> _view;
+    mutable int64_t _pos = 0;
+};
+}  // namespace
+
+std::shared_ptr<PackFile> PackFile::open(std::string_view path)
+{
+    auto pack = std::make_shared<PackFile>();
+    if (pack->init(path))
+        return pack;
+    return nullptr;
+}
+
+bool PackFile::init(std::string_view path)
+{
+    _path = path;
+
+    auto fileUtils = FileUtils::getInstance();
+    auto mapping   = fileUtils->mapFile(path);
+    if (mapping && mapping->isMapped())
+    {
+        // read everything from the mapping
+        if (mapping->size() < sizeof(Header))
+            return false;
+        memcpy(&_header, mapping->data(), sizeof(Header));
+        if (memcmp(_header.magic, "AXPK", 4) != 0 || _header.version != VERSION ||
+            _header.tocOffset + uint64_t{_header.slotCount} * sizeof(Entry) > mapping->size() ||
+            _header.namesOffset + _header.namesSize > mapping->size())
+            return false;
+
+        _slots.resize(_header.slotCount);
+        memcpy(_slots.data(), mapping->data() + _header.tocOffset, _slots.size() * sizeof(Entry));
+        _names.assign(reinterpret_cast<const char*>(mapping->data()) + _header.namesOffset, _header.namesSize);
+        _mapping = std::move(mapping);
+    }
+    else
+    {
+        // can't be mapped (i.e. android apk assets), only keep the table of contents in memory
+        mapping.reset();
+        auto fs = fileUtils->openFileStream(path, IFileStream::Mode::READ);
+        if (!fs || fs->read(&_header, sizeof(Header)) != static_cast<int>(sizeof(Header)))
+            return false;
+        if (memcmp(_header.magic, "AXPK", 4) != 0 || _header.version != VERSION)
+            return false;
+
+        _slots.resize(_header.slotCount);
+        _names.resize(_header.namesSize);
+        const auto tocSize = static_cast<unsigned int>(_slots.size() * sizeof(Entry));
+        if (fs->seek(static_cast<int64_t>(_header.tocOffset), SEEK_SET) < 0 ||
+            fs->read(_slots.data(), tocSize) != static_cast<int>(tocSize))
+            return false;
+        if (fs->seek(static_cast<int64_t>(_header.namesOffset), SEEK_SET) < 0 ||
+            fs->read(_names.data(), _header.namesSize) != static_cast<int>(_header.namesSize))
+            return false;
+    }
+
+    // the slot count must be a power of two, see find
+    return _header.slotCount != 0 && (_header.slotCount & (_header.slotCount - 1)) == 0;
+}
+
+const PackFile::Entry* PackFile::find(std::string_view name) const
+{
+    if (name.empty() || _slots.empty())
+        return nullptr;
+
+    const uint64_t hash = XXH64(name.data(), name.size(), 0);
+    const uint32_t mask = _header.slotCount - 1;
+    for (uint32_t i = static_cast<uint32_t>(hash) & mask, probes = 0; probes < _header.slotCount;
+         i = (i + 1) & mask, ++probes)
+    {
+        auto& entry = _slots[i];
+        if (entry.nameLength == 0)
+            break;
+        if (entry.hash == hash && getName(&entry) == name)
+            return &entry;
+    }
+    return nullptr;
+}
+
+std::string_view PackFile::getName(const Entry* entry) const
+{
+    if (entry->nameOffset + entry->nameLength > _names.size())
+        return {};
+    return std::string_view{_names}.substr(entry->nameOffset, entry->nameLength);
+}
+
+bool PackFile::readPayload(const Entry* entry, void* dst) const
+{
+    // stored entries are copied as is, a size mismatch means a malformed archive
+    if (!(entry->flags & ENTRY_DEFLATE) && entry->size != entry->originalSize)
+        return false;
+    if (entry->originalSize == 0)
+        return true;
+
+    const uint8_t* payload = nullptr;
+    std::vector<uint8_t> payloadBuffer;
+    if (_mapping)
+    {
+        if (entry->offset + entry->size > _mapping->size())
+            return false;
+        payload = _mapping->data() + entry->offset;
+    }
+    else
+    {
+        auto fs = FileUtils::getInstance()->openFileStream(_path, IFileStream::Mode::READ);
+        if (!fs || fs->seek(static_cast<int64_t>(entry->offset), SEEK_SET) < 0)
+            return false;
+
+        // stored entries are read straight into the destination
+        auto target = dst;
+        if (entry->flags & ENTRY_DEFLATE)
+        {
+            payloadBuffer.resize(entry->size);
+            target = payloadBuffer.data();
+        }
+        if (fs->read(target, entry->size) != static_cast<int>(entry->size))
+            return false;
+        if (target == dst)
+            return true;
+        payload = payloadBuffer.data();
+    }
+
+    if (entry->flags & ENTRY_DEFLATE)
+    {
+        uLongf destLen = entry->originalSize;
+        return uncompress(static_cast<Bytef*>(dst), &destLen, payload, entry->size) == Z_OK &&
+               destLen == entry->originalSize;
+    }
+
+    memcpy(dst, payload, entry->size);
+    return true;
+}
+
+bool PackFile::read(const Entry* entry, ResizableBuffer* buffer) const
+{
+    buffer->resize(entry->originalSize);
+    return readPayload(entry, buffer->buffer());
+}
+
+std::shared_ptr<FileMapping> PackFile::map(const Entry* entry) const
+{
+    auto view = std::make_shared<FileMapping>();
+    if (_mapping && !(entry->flags & ENTRY_DEFLATE))
+    {
+        if (entry->size != entry->originalSize || entry->offset + entry->size > _mapping->size())
+            return nullptr;
+        view->_data   = _mapping->data() + entry->offset;
+        view->_size   = entry->size;
+        view->_parent = _mapping;
+        return view;
+    }
+
+    ResizableBufferAdapter<Data> buffer(&view->_buffer);
+    if (!read(entry, &buffer))
+        return nullptr;
+    view->_data = view->_buffer.getBytes();
+    view->_size = static_cast<size_t>(view->_buffer.getSize());
+    return view;
+}
+
+std::unique_ptr<IFileStream> PackFile::openStream(const Entry* entry) const
+{
+    auto view = map(entry);
+    if (!view)
+        return nullptr;
+    return std::make_unique<PackEntryStream>(std::move(view));
+}
+
+}  // namespace ax
@@ -0,0 +1,110 @@
+// Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md)
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "platform/IFileStream.h"
+#include "platform/PlatformMacros.h"
+
+namespace ax
+{
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+
+class FileMapping;
+class ResizableBuffer;
+
+/**
+ * Read-only packed archive (.axpk), built by tools/axpack.
+ *
+ * Layout, little endian:
+ *   - Header
+ *   - payloads, each one aligned to Header::alignment, stored as is or deflated
+ *   - table of contents: open addressing hash table of Header::slotCount (power of two) Entry slots,
+ *     keyed by the xxh64 of the entry name, linear probing, a slot with nameLength 0 is empty
+ *   - names: the entry names, relative to the packed resource root, '/' separated, not null terminated
+ *
+ * The whole archive is memory mapped when possible, stored entries are then served without any copy.
+ * Mount it into the FileUtils search chain with FileUtils::mountPack.
+ */
+class AX_DLL PackFile
+{
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    struct Header
+    {
+        char magic[4];  // "AXPK"
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t slotCount;
+        uint64_t tocOffset;
+        uint64_t namesOffset;
+        uint32_t namesSize;
+        uint32_t alignment;
+    };
+
+    enum EntryFlags : uint16_t
+    {
+        ENTRY_DEFLATE = 1,
+    };
+
+    struct Entry
+    {
+        uint64_t hash;
+        uint64_t offset;
+        uint32_t size;          // payload size in the archive
+        uint32_t originalSize;  // size once inflated
+        uint32_t nameOffset;
+        uint16_t nameLength;
+        uint16_t flags;
+    };
+
+    /**
+     * Opens an archive, reading its table of contents.
+     * @param path The full path of the archive.
+     * @return nullptr if the file isn't a valid archive.
+     */
+    static std::shared_ptr<PackFile> open(std::string_view path);
+
+    /** The full path of the archive, entries are exposed under it as if it were a directory. */
+    std::string_view getPath() const { return _path; }
+
+    uint32_t getEntryCount() const { return _header.entryCount; }
+
+    /** Looks up an entry by its name relative to the archive root, nullptr if not found. */
+    const Entry* find(std::string_view name) const;
+
+    std::string_view getName(const Entry* entry) const;
+
+    /** Reads (and inflates if needed) the contents of an entry. */
+    bool read(const Entry* entry, ResizableBuffer* buffer) const;
+
+    /** Gets a view of an entry, which references the mapped archive for stored entries. */
+    std::shared_ptr<FileMapping> map(const Entry* entry) const;
+
+    /** Opens a read-only stream over an entry. */
+    std::unique_ptr<IFileStream> openStream(const Entry* entry) const;
+
+private:
+    bool init(std::string_view path);
+    bool readPayload(const Entry* entry, void* dst) const;
+
+    std::string _path;
+    Header _header{};
+    std::vector<Entry> _slots;
+    std::string _names;
+
+    // the whole archive when it could be memory mapped
+    std::shared_ptr<FileMapping> _mapping;
+};
+
+// end of platform group
+/** @} */
+
+}  // namespace ax
@@ -86,6 +86,7 @@ FileUtils* FileUtils::getInstance()
     if (s_sharedFileUtils == nullptr)
     {
         s_sharedFileUtils = new FileUtilsApple();
+        s_sharedFileUtils->_canMapFiles = true;
         if (!s_sharedFileUtils->init())
         {
             delete s_sharedFileUtils;
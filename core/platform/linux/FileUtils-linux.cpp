@@ -57,6 +57,7 @@ FileUtils* FileUtils::getInstance()
     if (s_sharedFileUtils == nullptr)
     {
         s_sharedFileUtils = new FileUtilsLinux();
+        s_sharedFileUtils->_canMapFiles = true;
         if (!s_sharedFileUtils->init())
         {
             delete s_sharedFileUtils;
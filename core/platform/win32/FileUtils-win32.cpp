@@ -82,6 +82,7 @@ FileUtils* FileUtils::getInstance()
     if (s_sharedFileUtils == nullptr)
     {
         s_sharedFileUtils = new FileUtilsWin32();
+        s_sharedFileUtils->_canMapFiles = true;
         if (!s_sharedFileUtils->init())
         {
             delete s_sharedFileUtils;
@@ -153,6 +154,8 @@ int64_t FileUtilsWin32::getFileSize(std::string_view filepath) const
 {
     if (filepath.empty())
         return -1;
+    if (auto size = getPackEntrySize(filepath); size >= 0)
+        return size;
     WIN32_FILE_ATTRIBUTE_DATA attrs = {0};
     if (GetFileAttributesExW(ntcvt::from_chars(filepath).c_str(), GetFileExInfoStandard, &attrs) &&
         !(attrs.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
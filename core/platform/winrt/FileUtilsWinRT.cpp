@@ -71,6 +71,7 @@ FileUtils* FileUtils::getInstance()
     if (s_sharedFileUtils == nullptr)
     {
         s_sharedFileUtils = new FileUtilsWinRT();
+        s_sharedFileUtils->_canMapFiles = true;
         if(!s_sharedFileUtils->init())
         {
           delete s_sharedFileUtils;
@@ -123,6 +124,9 @@ std::string FileUtilsWinRT::getFullPathForFilenameWithinDirectory(std::string_vi
 
 int64_t FileUtilsWinRT::getFileSize(std::string_view filepath) const
 {
+    if (auto size = getPackEntrySize(filepath); size >= 0)
+        return size;
+
     WIN32_FILE_ATTRIBUTE_DATA fad;
     if (!GetFileAttributesEx(ntcvt::from_chars(filepath).c_str(), GetFileExInfoStandard, &fad))
     {
@@ -157,6 +157,9 @@ void Pass::initUniformLocations()
     _locColor         = ps->getUniformLocation("u_color");
     _locMatrixPalette = ps->getUniformLocation("u_matrixPalette");
 
+    _locMatrixPaletteTexture = ps->getUniformLocation("u_matrixPaletteTex");
+    _locMatrixPaletteWidth   = ps->getUniformLocation("u_matrixPaletteWidth");
+
     _locDirLightColor = ps->getUniformLocation(s_dirLightUniformColorName);
     _locDirLightDir   = ps->getUniformLocation(s_dirLightUniformDirName);
 
@@ -304,6 +307,16 @@ void Pass::setUniformMatrixPalette(const void* data, size_t dataLen)
     TRY_SET_UNIFORM(_locMatrixPalette);
 }
 
+void Pass::setUniformMatrixPaletteTexture(uint32_t slot, Texture2D* tex)
+{
+    if (_locMatrixPaletteTexture && tex)
+    {
+        float width = static_cast<float>(tex->getPixelsWide());
+        _programState->setTexture(_locMatrixPaletteTexture, slot, tex->getBackendTexture());
+        _programState->setUniform(_locMatrixPaletteWidth, &width, sizeof(width));
+    }
+}
+
 void Pass::setUniformDirLightColor(const void* data, size_t dataLen)
 {
     TRY_SET_UNIFORM(_locDirLightColor);
@@ -45,6 +45,7 @@ class Node;
 class VertexAttribBinding;
 class MeshIndexData;
 class RenderState;
+class Texture2D;
 
 namespace backend
 {
@@ -113,6 +114,7 @@ public:
 
     void setUniformColor(const void*, size_t);          // ucolor
     void setUniformMatrixPalette(const void*, size_t);  // u_matrixPalette
+    void setUniformMatrixPaletteTexture(uint32_t slot, Texture2D*);  // u_matrixPaletteTex, u_matrixPaletteWidth
 
     void setUniformDirLightColor(const void*, size_t);
     void setUniformDirLightDir(const void*, size_t);
@@ -161,6 +163,8 @@ private:
 
     backend::UniformLocation _locColor;          // ucolor
     backend::UniformLocation _locMatrixPalette;  // u_matrixPalette
+    backend::UniformLocation _locMatrixPaletteTexture;  // u_matrixPaletteTex
+    backend::UniformLocation _locMatrixPaletteWidth;    // u_matrixPaletteWidth
 
     backend::UniformLocation _locDirLightColor;
     backend::UniformLocation _locDirLightDir;
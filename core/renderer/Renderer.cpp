@@ -26,6 +26,10 @@
 #include "renderer/Renderer.h"
 
 #include <algorithm>
+#include <limits>
+#include <atomic>
+#include <condition_variable>
+#include <thread>
 
 #include "renderer/TrianglesCommand.h"
 #include "renderer/CustomCommand.h"
@@ -63,6 +67,15 @@ static bool compare3DCommand(RenderCommand* a, RenderCommand* b)
     return a->getDepth() > b->getDepth();
 }
 
+template <typename _BoundsA, typename _BoundsB>
+static bool isTriReorderOverlapped(const _BoundsA& a, const _BoundsB& b)
+{
+    // bounds not lying on the same plane may overlap on screen with a perspective projection
+    if (!a.flat || !b.flat || a.z != b.z)
+        return true;
+    return a.minX < b.maxX && b.minX < a.maxX && a.minY < b.maxY && b.minY < a.maxY;
+}
+
 // queue
 RenderQueue::RenderQueue() {}
 
@@ -157,6 +170,9 @@ void RenderQueue::realloc(size_t reserveSize)
 //
 static const int DEFAULT_RENDER_QUEUE = 0;
 
+// the render queue of the parallel subtree visited by the calling thread
+static thread_local RenderQueue* s_parallelVisitQueue = nullptr;
+
 //
 // constructors, destructor, init
 //
@@ -231,12 +247,22 @@ void Renderer::addCallbackCommand(std::function<void()> func, float globalZOrder
 
 void Renderer::addCommand(RenderCommand* command)
 {
+    if (auto queue = s_parallelVisitQueue)
+    {
+        AXASSERT(command->getType() != RenderCommand::Type::UNKNOWN_COMMAND, "Invalid Command Type");
+        AXASSERT(command->getType() != RenderCommand::Type::GROUP_COMMAND,
+                 "Cannot add group command while visiting in parallel");
+        queue->emplace_back(command);
+        return;
+    }
+
     int renderQueueID = _commandGroupStack.top();
     addCommand(command, renderQueueID);
 }
 
 void Renderer::addCommand(RenderCommand* command, int renderQueueID)
 {
+    AXASSERT(!s_parallelVisitQueue, "Cannot add command to a render queue while visiting in parallel");
     AXASSERT(!_isRendering, "Cannot add command while rendering");
     AXASSERT(renderQueueID >= 0, "Invalid render queue");
     AXASSERT(command->getType() != RenderCommand::Type::UNKNOWN_COMMAND, "Invalid Command Type");
@@ -260,18 +286,21 @@ GroupCommand* Renderer::getNextGroupCommand()
 
 void Renderer::pushGroup(int renderQueueID)
 {
+    AXASSERT(!s_parallelVisitQueue, "Cannot change render queue while visiting in parallel");
     AXASSERT(!_isRendering, "Cannot change render queue while rendering");
     _commandGroupStack.push(renderQueueID);
 }
 
 void Renderer::popGroup()
 {
+    AXASSERT(!s_parallelVisitQueue, "Cannot change render queue while visiting in parallel");
     AXASSERT(!_isRendering, "Cannot change render queue while rendering");
     _commandGroupStack.pop();
 }
 
 int Renderer::createRenderQueue()
 {
+    AXASSERT(!s_parallelVisitQueue, "Cannot create render queue while visiting in parallel");
     RenderQueue newRenderQueue;
     _renderGroups.emplace_back(newRenderQueue);
     return (int)_renderGroups.size() - 1;
@@ -309,20 +338,16 @@ void Renderer::processRenderCommand(RenderCommand* command)
             drawBatchedTriangles();
 
             _queuedTotalIndexCount = _queuedTotalVertexCount = 0;
-#ifdef AX_USE_METAL
             _queuedIndexCount = _queuedVertexCount = 0;
             _triangleCommandBufferManager.prepareNextBuffer();
             _vertexBuffer = _triangleCommandBufferManager.getVertexBuffer();
             _indexBuffer  = _triangleCommandBufferManager.getIndexBuffer();
-#endif
         }
 
         // queue it
         _queuedTriangleCommands.emplace_back(cmd);
-#ifdef AX_USE_METAL
         _queuedIndexCount += cmd->getIndexCount();
         _queuedVertexCount += cmd->getVertexCount();
-#endif
         _queuedTotalVertexCount += cmd->getVertexCount();
         _queuedTotalIndexCount += cmd->getIndexCount();
     }
@@ -402,8 +427,114 @@ void Renderer::doVisitRenderQueue(const std::vector<RenderCommand*>& renderComma
     flush();
 }
 
+bool Renderer::deferParallelVisit(Node* node, const Mat4& parentTransform, uint32_t parentFlags)
+{
+    // nested roots are visited in place, and the subtree must be visited with the same camera it was deferred with
+    if (!_parallelVisitEnabled || s_parallelVisitQueue || _isRendering || !node->isVisible() ||
+        !Camera::getVisitingCamera())
+        return false;
+
+    auto director = Director::getInstance();
+    auto& visit   = _parallelVisits.emplace_back();
+    visit.node            = node;
+    visit.parentTransform = parentTransform;
+    visit.parentFlags     = parentFlags;
+    visit.renderQueueID   = _commandGroupStack.top();
+    auto& renderQueue     = _renderGroups[visit.renderQueueID];
+    for (int i = 0; i < RenderQueue::QUEUE_COUNT; ++i)
+        visit.queueOffsets[i] = renderQueue.getSubQueueSize(static_cast<RenderQueue::QUEUE_GROUP>(i));
+    visit.matrices[0] = director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+    visit.matrices[1] = director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+    visit.matrices[2] = director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_TEXTURE);
+
+    node->retain();
+    return true;
+}
+
+void Renderer::runParallelVisit(const ParallelVisit& visit, RenderQueue& queue)
+{
+    std::stack<Mat4> matrixStacks[3];
+    for (int i = 0; i < 3; ++i)
+        matrixStacks[i].push(visit.matrices[i]);
+
+    Director::setThreadMatrixStacks(matrixStacks);
+    s_parallelVisitQueue = &queue;
+
+    visit.node->visit(this, visit.parentTransform, visit.parentFlags);
+
+    s_parallelVisitQueue = nullptr;
+    Director::setThreadMatrixStacks(nullptr);
+}
+
+void Renderer::processParallelVisits()
+{
+    if (_parallelVisits.empty())
+        return;
+
+    const int visitCount = static_cast<int>(_parallelVisits.size());
+    if (static_cast<int>(_parallelVisitQueues.size()) < visitCount)
+        _parallelVisitQueues.resize(visitCount);
+
+    // The main thread picks visits too, so it's never blocked by busy workers. The state is shared with the
+    // jobs since they may start after all visits are done.
+    struct ParallelVisitState
+    {
+        std::atomic<int> next{0};
+        int count{0};
+        int remaining{0};
+        std::mutex mtx;
+        std::condition_variable cv;
+    };
+    auto state       = std::make_shared<ParallelVisitState>();
+    state->count     = visitCount;
+    state->remaining = visitCount;
+
+    auto pick = [this, state]() {
+        for (int index; (index = state->next.fetch_add(1, std::memory_order_relaxed)) < state->count;)
+        {
+            runParallelVisit(_parallelVisits[index], _parallelVisitQueues[index]);
+
+            std::lock_guard<std::mutex> lck(state->mtx);
+            if (--state->remaining == 0)
+                state->cv.notify_all();
+        }
+    };
+
+    auto jobSystem  = Director::getInstance()->getJobSystem();
+    const int works = (std::min)(visitCount, static_cast<int>(std::thread::hardware_concurrency())) - 1;
+    for (int i = 0; i < works; ++i)
+        jobSystem->enqueue(pick);
+    pick();
+
+    {
+        std::unique_lock<std::mutex> lck(state->mtx);
+        state->cv.wait(lck, [&state] { return state->remaining == 0; });
+    }
+
+    // Merge backwards, so the offsets of the previous visits are still valid
+    for (int index = visitCount - 1; index >= 0; --index)
+    {
+        auto& visit       = _parallelVisits[index];
+        auto& queue       = _parallelVisitQueues[index];
+        auto& renderQueue = _renderGroups[visit.renderQueueID];
+        for (int i = 0; i < RenderQueue::QUEUE_COUNT; ++i)
+        {
+            auto group    = static_cast<RenderQueue::QUEUE_GROUP>(i);
+            auto& source  = queue.getSubQueue(group);
+            auto& target  = renderQueue.getSubQueue(group);
+            target.insert(target.begin() + visit.queueOffsets[i], source.begin(), source.end());
+        }
+        queue.clear();
+        visit.node->release();
+    }
+    _parallelVisits.clear();
+}
+
 void Renderer::render()
 {
+    // the deferred subtrees are usually processed by the scene right after visiting
+    processParallelVisits();
+
     // TODO: setup camera or MVP
     _isRendering = true;
     //    if (_glViewAssigned)
@@ -429,11 +560,9 @@ void Renderer::endFrame()
 {
     _commandBuffer->endFrame();
 
-#ifdef AX_USE_METAL
     _triangleCommandBufferManager.putbackAllBuffers();
     _vertexBuffer = _triangleCommandBufferManager.getVertexBuffer();
     _indexBuffer  = _triangleCommandBufferManager.getIndexBuffer();
-#endif
     _queuedTotalIndexCount  = 0;
     _queuedTotalVertexCount = 0;
 }
@@ -590,35 +719,120 @@ void Renderer::setViewPort(int x, int y, unsigned int w, unsigned int h)
 
 void Renderer::fillVerticesAndIndices(const TrianglesCommand* cmd, unsigned int vertexBufferOffset)
 {
-    auto destVertices = &_verts[_filledVertex];
+    auto destVertices = &_fillVerts[_filledVertex];
     auto srcVertices = cmd->getVertices();
     auto vertexCount = cmd->getVertexCount();
     auto&& modelView = cmd->getModelView();
     MathUtil::transformVertices(destVertices, srcVertices, vertexCount, modelView);
 
-    auto destIndices = &_indices[_filledIndex];
-    auto srcIndices = cmd->getIndices();
-    auto indexCount = cmd->getIndexCount();
-    auto offset = vertexBufferOffset + _filledVertex;
-    MathUtil::transformIndices(destIndices, srcIndices, indexCount, int(offset));
+    fillIndices(cmd, vertexBufferOffset + _filledVertex);
 
     _filledVertex += vertexCount;
+}
+
+void Renderer::fillIndices(const TrianglesCommand* cmd, unsigned int vertexOffset)
+{
+    auto destIndices = &_fillIndices[_filledIndex];
+    auto srcIndices  = cmd->getIndices();
+    auto indexCount  = cmd->getIndexCount();
+    MathUtil::transformIndices(destIndices, srcIndices, indexCount, int(vertexOffset));
+
     _filledIndex += indexCount;
 }
 
+void Renderer::fillVerticesAndReorderTriangles()
+{
+    const auto commandCount = _queuedTriangleCommands.size();
+    _triReorderInfos.resize(commandCount);
+    _triReorderBatches.clear();
+
+    for (size_t i = 0; i < commandCount; ++i)
+    {
+        auto cmd          = _queuedTriangleCommands[i];
+        auto& info        = _triReorderInfos[i];
+        auto destVertices = &_verts[_filledVertex];
+        auto vertexCount  = cmd->getVertexCount();
+        MathUtil::transformVertices(destVertices, cmd->getVertices(), vertexCount, cmd->getModelView());
+
+        info.vertexStart = _filledVertex;
+        info.next        = -1;
+        info.minX = info.minY = std::numeric_limits<float>::max();
+        info.maxX = info.maxY = std::numeric_limits<float>::lowest();
+        info.z                = vertexCount > 0 ? destVertices[0].vertices.z : 0.0f;
+        info.flat             = true;
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            auto& pos = destVertices[v].vertices;
+            info.minX = std::min(info.minX, pos.x);
+            info.minY = std::min(info.minY, pos.y);
+            info.maxX = std::max(info.maxX, pos.x);
+            info.maxY = std::max(info.maxY, pos.y);
+            info.flat = info.flat && pos.z == info.z;
+        }
+        _filledVertex += vertexCount;
+
+        // Look back for a batch with the same material, stop at the first one that overlaps this command,
+        // since drawing this command before it would change the visual result.
+        const auto materialID = cmd->getMaterialID();
+        const bool batchable  = !cmd->isSkipBatching();
+        int target            = -1;
+        if (batchable)
+        {
+            int lookback = 0;
+            for (int b = (int)_triReorderBatches.size() - 1; b >= 0 && lookback < TRIANGLES_REORDER_MAX_LOOKBACK;
+                 --b, ++lookback)
+            {
+                auto& batch = _triReorderBatches[b];
+                if (batch.batchable && batch.materialID == materialID)
+                {
+                    target = b;
+                    break;
+                }
+                if (!batch.batchable || isTriReorderOverlapped(batch, info))
+                    break;
+            }
+        }
+
+        if (target >= 0)
+        {
+            auto& batch = _triReorderBatches[target];
+            batch.minX  = std::min(batch.minX, info.minX);
+            batch.minY  = std::min(batch.minY, info.minY);
+            batch.maxX  = std::max(batch.maxX, info.maxX);
+            batch.maxY  = std::max(batch.maxY, info.maxY);
+            batch.flat  = batch.flat && info.flat && batch.z == info.z;
+            _triReorderInfos[batch.last].next = (int)i;
+            batch.last                        = (int)i;
+        }
+        else
+        {
+            _triReorderBatches.emplace_back(TriReorderBatch{materialID, batchable, info.minX, info.minY, info.maxX,
+                                                            info.maxY, info.z, info.flat, (int)i, (int)i});
+        }
+    }
+
+    _triReorderedCommands.clear();
+    _triReorderedVertexStarts.clear();
+    for (auto&& batch : _triReorderBatches)
+    {
+        for (int index = batch.first; index != -1; index = _triReorderInfos[index].next)
+        {
+            _triReorderedCommands.emplace_back(_queuedTriangleCommands[index]);
+            _triReorderedVertexStarts.emplace_back(_triReorderInfos[index].vertexStart);
+        }
+    }
+    _queuedTriangleCommands.swap(_triReorderedCommands);
+}
+
 void Renderer::drawBatchedTriangles()
 {
     if (_queuedTriangleCommands.empty())
         return;
 
-        /************** 1: Setup up vertices/indices *************/
-#ifdef AX_USE_METAL
+    /************** 1: Setup up vertices/indices *************/
+    // every flush of a frame appends to the buffers, so the regions drawn before are never overwritten
     unsigned int vertexBufferFillOffset = _queuedTotalVertexCount - _queuedVertexCount;
     unsigned int indexBufferFillOffset  = _queuedTotalIndexCount - _queuedIndexCount;
-#else
-    unsigned int vertexBufferFillOffset = 0;
-    unsigned int indexBufferFillOffset  = 0;
-#endif
 
     _triBatchesToDraw[0].offset        = indexBufferFillOffset;
     _triBatchesToDraw[0].indicesToDraw = 0;
@@ -631,12 +845,32 @@ void Renderer::drawBatchedTriangles()
     _filledVertex = 0;
     _filledIndex  = 0;
 
-    for (const auto& cmd : _queuedTriangleCommands)
+    // vertices are filled in queued order, so only the order of indices changes
+    const bool reordered = _trianglesReorderEnabled && _queuedTriangleCommands.size() > 2;
+
+    // Write straight into the mapped buffers when the backend supports it. Reordering reads the transformed
+    // vertices back, which is slow on write-combined memory, so they are still staged in _verts then.
+    void* mappedVertices = reordered ? nullptr
+                                     : _vertexBuffer->map(vertexBufferFillOffset * sizeof(_verts[0]),
+                                                          _queuedVertexCount * sizeof(_verts[0]));
+    void* mappedIndices  = _indexBuffer->map(indexBufferFillOffset * sizeof(_indices[0]),
+                                             _queuedIndexCount * sizeof(_indices[0]));
+    _fillVerts   = mappedVertices ? static_cast<V3F_C4B_T2F*>(mappedVertices) : _verts;
+    _fillIndices = mappedIndices ? static_cast<unsigned short*>(mappedIndices) : _indices;
+
+    if (reordered)
+        fillVerticesAndReorderTriangles();
+
+    for (size_t cmdIndex = 0, cmdCount = _queuedTriangleCommands.size(); cmdIndex < cmdCount; ++cmdIndex)
     {
+        auto cmd               = _queuedTriangleCommands[cmdIndex];
         auto currentMaterialID = cmd->getMaterialID();
         const bool batchable   = !cmd->isSkipBatching();
 
-        fillVerticesAndIndices(cmd, vertexBufferFillOffset);
+        if (reordered)
+            fillIndices(cmd, vertexBufferFillOffset + _triReorderedVertexStarts[cmdIndex]);
+        else
+            fillVerticesAndIndices(cmd, vertexBufferFillOffset);
 
         // in the same batch ?
         if (batchable && (prevMaterialID == currentMaterialID || firstCommand))
@@ -676,14 +910,24 @@ void Renderer::drawBatchedTriangles()
         firstCommand   = false;
     }
     batchesTotal++;
-#ifdef AX_USE_METAL
-    _vertexBuffer->updateSubData(_verts, vertexBufferFillOffset * sizeof(_verts[0]), _filledVertex * sizeof(_verts[0]));
-    _indexBuffer->updateSubData(_indices, indexBufferFillOffset * sizeof(_indices[0]),
-                                _filledIndex * sizeof(_indices[0]));
-#else
-    _vertexBuffer->updateData(_verts, _filledVertex * sizeof(_verts[0]));
-    _indexBuffer->updateData(_indices, _filledIndex * sizeof(_indices[0]));
-#endif
+
+    const auto vertexBufferOffset = vertexBufferFillOffset * sizeof(_verts[0]);
+    const auto vertexBufferLength = _filledVertex * sizeof(_verts[0]);
+    if (mappedVertices)
+        _vertexBuffer->unmap();
+    else if (auto dest = _vertexBuffer->map(vertexBufferOffset, vertexBufferLength))
+    {
+        memcpy(dest, _verts, vertexBufferLength);
+        _vertexBuffer->unmap();
+    }
+    else
+        _vertexBuffer->updateSubData(_verts, vertexBufferOffset, vertexBufferLength);
+
+    if (mappedIndices)
+        _indexBuffer->unmap();
+    else
+        _indexBuffer->updateSubData(_indices, indexBufferFillOffset * sizeof(_indices[0]),
+                                    _filledIndex * sizeof(_indices[0]));
 
     /************** 2: Draw *************/
     beginRenderPass();
@@ -709,10 +953,8 @@ void Renderer::drawBatchedTriangles()
     /************** 3: Cleanup *************/
     _queuedTriangleCommands.clear();
 
-#ifdef AX_USE_METAL
     _queuedIndexCount  = 0;
     _queuedVertexCount = 0;
-#endif
 }
 
 void Renderer::drawCustomCommand(RenderCommand* command)
@@ -893,6 +1135,10 @@ void Renderer::clear(ClearFlag flags, const Color4F& color, float depth, unsigne
 
 CallbackCommand* Renderer::nextCallbackCommand()
 {
+    std::unique_lock<std::mutex> lck(_parallelVisitMutex, std::defer_lock);
+    if (s_parallelVisitQueue)
+        lck.lock();
+
     CallbackCommand* cmd = nullptr;
     if (!_callbackCommandsPool.empty())
     {
@@ -994,17 +1240,15 @@ void Renderer::TriangleCommandBufferManager::createBuffer()
 {
     auto driver = backend::DriverBase::getInstance();
 
-    // Not initializing the buffer before passing it to updateData for Android/OpenGL ES.
-    // This change does fix the Android/OpenGL ES performance problem
-    // If for some reason we get reports of performance issues on OpenGL implementations,
-    // then we can just add pre-processor checks for OpenGL and have the updateData() allocate the full size after buffer creation.
+    // Streaming buffers: the backend keeps an in-flight copy per frame, on OpenGL they are persistent mapped
+    // (or mapped unsynchronized) so batches are written without driver synchronization or orphaning.
     auto vertexBuffer = driver->newBuffer(Renderer::VBO_SIZE * sizeof(_verts[0]), backend::BufferType::VERTEX,
-                                          backend::BufferUsage::DYNAMIC);
+                                          backend::BufferUsage::STREAM);
     if (!vertexBuffer)
         return;
 
     auto indexBuffer = driver->newBuffer(Renderer::INDEX_VBO_SIZE * sizeof(_indices[0]), backend::BufferType::INDEX,
-                                         backend::BufferUsage::DYNAMIC);
+                                         backend::BufferUsage::STREAM);
     if (!indexBuffer)
     {
         vertexBuffer->release();
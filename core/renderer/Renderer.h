@@ -30,6 +30,7 @@
 #include <array>
 #include <deque>
 #include <optional>
+#include <mutex>
 
 #include "platform/PlatformMacros.h"
 #include "renderer/RenderCommand.h"
@@ -59,6 +60,7 @@ struct PixelBufferDescriptor;
 }  // namespace backend
 
 class EventListenerCustom;
+class Node;
 class TrianglesCommand;
 class MeshCommand;
 class GroupCommand;
@@ -141,6 +143,8 @@ public:
     static const int BATCH_TRIAGCOMMAND_RESERVED_SIZE = 64;
     /**Reserved for material id, which means that the command could not be batched.*/
     static const int MATERIAL_ID_DO_NOT_BATCH = 0;
+    /**The max number of batches a triangles command can be moved back over when reordering by material id.*/
+    static const int TRIANGLES_REORDER_MAX_LOOKBACK = 32;
     /**Constructor.*/
     Renderer();
     /**Destructor.*/
@@ -172,6 +176,25 @@ public:
     /** Renders into the GLView all the queued `RenderCommand` objects */
     void render();
 
+    /**
+     * Enable/disable visiting the subtrees of nodes flagged by `Node::setParallelVisitRoot` on JobSystem workers.
+     * Each subtree is visited into its own render queue, which is merged back at the position where the subtree
+     * would have been visited, so the queued commands are identical to a serial visit.
+     * @param enabled true to enable parallel visit, false otherwise (default).
+     */
+    void setParallelVisitEnabled(bool enabled) { _parallelVisitEnabled = enabled; }
+    /** Get whether parallel visit is enabled or not. */
+    bool isParallelVisitEnabled() const { return _parallelVisitEnabled; }
+
+    /**
+     * Defers the visit of a parallel root node until `processParallelVisits` is called.
+     * @return false if the node must be visited in place.
+     */
+    bool deferParallelVisit(Node* node, const Mat4& parentTransform, uint32_t parentFlags);
+
+    /** Visits all deferred subtrees in parallel and merges their commands into the render queues. */
+    void processParallelVisits();
+
     /** Cleans all `RenderCommand`s in the queue */
     void clean();
 
@@ -186,6 +209,17 @@ public:
     /* clear draw stats */
     void clearDrawStats() { _drawnBatches = _drawnVertices = 0; }
 
+    /**
+     * Enable/disable reordering of queued triangles commands by material id.
+     * When enabled, a command may be moved back to join an earlier batch with the same material
+     * if its bounds don't overlap any command it skips over, so the visual result is unchanged.
+     * The batches saved this way show up as a lower `getDrawnBatches`.
+     * @param enabled true to enable reordering, false otherwise (default).
+     */
+    void setTrianglesReorderEnabled(bool enabled) { _trianglesReorderEnabled = enabled; }
+    /** Get whether reordering of queued triangles commands is enabled or not. */
+    bool isTrianglesReorderEnabled() const { return _trianglesReorderEnabled; }
+
     /**
      Set render targets. If not set, will use default render targets. It will effect all commands.
      @flags Flags to indicate which attachment to be replaced.
@@ -412,7 +446,7 @@ public:
     /** returns whether or not a rectangle is visible or not */
     bool checkVisibility(const Mat4& transform, const Vec2& size);
 
-    /** read pixels from RenderTarget or screen framebuffer */
+    /** read pixels from RenderTarget or screen framebuffer, the callback may be invoked in a later frame */
     void readPixels(backend::RenderTarget* rt, std::function<void(const backend::PixelBufferDescriptor&)> callback);
 
     void beginRenderPass();  /// Begin a render pass.
@@ -487,10 +521,28 @@ protected:
 
     void fillVerticesAndIndices(const TrianglesCommand* cmd, unsigned int vertexBufferOffset);
 
+    void fillIndices(const TrianglesCommand* cmd, unsigned int vertexOffset);
+
+    /// Fill the vertices of all queued triangles commands, then reorder them by material id.
+    void fillVerticesAndReorderTriangles();
+
     void pushStateBlock();
 
     void popStateBlock();
 
+    struct ParallelVisit
+    {
+        Node* node;
+        Mat4 parentTransform;
+        uint32_t parentFlags;
+        int renderQueueID;
+        // the sizes of the render queue groups at the time of the deferral, where the commands are merged back
+        size_t queueOffsets[RenderQueue::QUEUE_COUNT];
+        // the modelview, projection and texture matrices at the time of the deferral
+        Mat4 matrices[3];
+    };
+    void runParallelVisit(const ParallelVisit& visit, RenderQueue& queue);
+
     backend::RenderPipeline* _renderPipeline = nullptr;
 
     Viewport _viewport;
@@ -503,6 +555,13 @@ protected:
 
     std::vector<TrianglesCommand*> _queuedTriangleCommands;
 
+    // the deferred parallel visits and their own render queues
+    std::vector<ParallelVisit> _parallelVisits;
+    std::vector<RenderQueue> _parallelVisitQueues;
+    // guards the pools used while visiting in parallel
+    std::mutex _parallelVisitMutex;
+    bool _parallelVisitEnabled = false;
+
     // the pool for callback commands
     std::vector<CallbackCommand*> _callbackCommandsPool;
 
@@ -511,6 +570,9 @@ protected:
     // for TrianglesCommand
     V3F_C4B_T2F _verts[VBO_SIZE];
     unsigned short _indices[INDEX_VBO_SIZE];
+    // destination of the batch being filled, the mapped buffer region or _verts/_indices when it can't be mapped
+    V3F_C4B_T2F* _fillVerts      = nullptr;
+    unsigned short* _fillIndices = nullptr;
     backend::Buffer* _vertexBuffer = nullptr;
     backend::Buffer* _indexBuffer  = nullptr;
     TriangleCommandBufferManager _triangleCommandBufferManager;
@@ -528,6 +590,31 @@ protected:
         unsigned int indicesToDraw = 0;
         unsigned int offset        = 0;
     };
+    // Internal structures used to reorder the queued triangles commands
+    struct TriReorderInfo
+    {
+        unsigned int vertexStart = 0;  // first vertex of the command in _verts
+        float minX, minY, maxX, maxY;  // bounds of the transformed vertices
+        float z;                       // only valid when flat is true
+        bool flat;                     // all transformed vertices share the same z
+        int next = -1;                 // next command in the same reorder batch
+    };
+    struct TriReorderBatch
+    {
+        uint32_t materialID;
+        bool batchable;
+        float minX, minY, maxX, maxY;
+        float z;
+        bool flat;
+        int first;
+        int last;
+    };
+    std::vector<TriReorderInfo> _triReorderInfos;
+    std::vector<TriReorderBatch> _triReorderBatches;
+    std::vector<TrianglesCommand*> _triReorderedCommands;
+    std::vector<unsigned int> _triReorderedVertexStarts;
+    bool _trianglesReorderEnabled = false;
+
     // capacity of the array of TriBatches
     int _triBatchesToDrawCapacity = 500;
     // the TriBatches
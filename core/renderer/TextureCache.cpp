@@ -33,6 +33,8 @@ THE SOFTWARE.
 #include <stack>
 #include <cctype>
 #include <list>
+#include <algorithm>
+#include <chrono>
 
 #include "renderer/Texture2D.h"
 #include "base/Macros.h"
@@ -63,7 +65,9 @@ std::string TextureCache::getETC1AlphaFileSuffix()
     return s_etc1AlphaFileSuffix;
 }
 
-TextureCache::TextureCache() : _loadingThread(nullptr), _needQuit(false), _asyncRefCount(0) {}
+TextureCache::TextureCache()
+    : _needQuit(false), _asyncRefCount(0), _asyncDecodeWorkers(0), _activeDecodeWorkers(0), _asyncUploadBudget(0)
+{}
 
 TextureCache::~TextureCache()
 {
@@ -72,7 +76,8 @@ TextureCache::~TextureCache()
     for (auto&& texture : _textures)
         texture.second->release();
 
-    AX_SAFE_DELETE(_loadingThread);
+    for (auto&& asyncStruct : _asyncStructQueue)
+        delete asyncStruct;
 }
 
 std::string TextureCache::getDescription() const
@@ -83,11 +88,12 @@ std::string TextureCache::getDescription() const
 struct TextureCache::AsyncStruct
 {
 public:
-    AsyncStruct(std::string_view fn, const std::function<void(Texture2D*)>& f, std::string_view key)
+    AsyncStruct(std::string_view fn, const std::function<void(Texture2D*)>& f, std::string_view key, int prio)
         : filename(fn)
         , callback(f)
         , callbackKey(key)
         , pixelFormat(Texture2D::getDefaultAlphaPixelFormat())
+        , priority(prio)
         , loadSuccess(false)
     {}
 
@@ -97,14 +103,15 @@ public:
     Image image;
     Image imageAlpha;
     backend::PixelFormat pixelFormat;
+    int priority;
     bool loadSuccess;
 };
 
 /**
  The addImageAsync logic follow the steps:
  - find the image has been add or not, if not add an AsyncStruct to _requestQueue  (GL thread)
- - get AsyncStruct from _requestQueue, load res and fill image data to AsyncStruct.image, then add AsyncStruct to
- _responseQueue (Load thread)
+ - get the highest priority AsyncStruct from _requestQueue, load res and fill image data to AsyncStruct.image, then
+ add AsyncStruct to _responseQueue (JobSystem decode workers, at most getAsyncDecodeWorkers() at the same time)
  - on schedule callback, get AsyncStruct from _responseQueue, convert image to texture, then delete AsyncStruct (GL
  thread)
 
@@ -114,7 +121,7 @@ public:
 
  the object's life time:
  - AsyncStruct: construct and destruct in GL thread
- - image data: new in Load thread, delete in GL thread(by Image instance)
+ - image data: new in decode worker, delete in GL thread(by Image instance)
 
  Note:
  - all AsyncStruct referenced in _asyncStructQueue, for unbind function use.
@@ -126,8 +133,8 @@ public:
  - In addImageAsyncCallback, will deduplicate the request to ensure only create one texture.
 
  Does process all response in addImageAsyncCallback consume more time?
- - Convert image to texture faster than load image from disk, so this isn't a
- problem.
+ - Convert image to texture faster than load image from disk, but a burst of decoded
+ images may still exceed a frame, use setAsyncUploadBudget to spread them over frames.
 
  Call unbindImageAsync(path) to prevent the call to the callback when the
  texture is loaded.
@@ -140,8 +147,8 @@ void TextureCache::addImageAsync(std::string_view path, const std::function<void
 /**
  The addImageAsync logic follow the steps:
  - find the image has been add or not, if not add an AsyncStruct to _requestQueue  (GL thread)
- - get AsyncStruct from _requestQueue, load res and fill image data to AsyncStruct.image, then add AsyncStruct to
- _responseQueue (Load thread)
+ - get the highest priority AsyncStruct from _requestQueue, load res and fill image data to AsyncStruct.image, then
+ add AsyncStruct to _responseQueue (JobSystem decode workers, at most getAsyncDecodeWorkers() at the same time)
  - on schedule callback, get AsyncStruct from _responseQueue, convert image to texture, then delete AsyncStruct (GL
  thread)
 
@@ -151,7 +158,7 @@ void TextureCache::addImageAsync(std::string_view path, const std::function<void
 
  the object's life time:
  - AsyncStruct: construct and destruct in GL thread
- - image data: new in Load thread, delete in GL thread(by Image instance)
+ - image data: new in decode worker, delete in GL thread(by Image instance)
 
  Note:
  - all AsyncStruct referenced in _asyncStructQueue, for unbind function use.
@@ -163,8 +170,8 @@ void TextureCache::addImageAsync(std::string_view path, const std::function<void
  - In addImageAsyncCallback, will deduplicate the request to ensure only create one texture.
 
  Does process all response in addImageAsyncCallback consume more time?
- - Convert image to texture faster than load image from disk, so this isn't a
- problem.
+ - Convert image to texture faster than load image from disk, but a burst of decoded
+ images may still exceed a frame, use setAsyncUploadBudget to spread them over frames.
 
  The callbackKey allows to unbind the callback in cases where the loading of
  path is requested by several sources simultaneously. Each source can then
@@ -174,6 +181,14 @@ void TextureCache::addImageAsync(std::string_view path, const std::function<void
 void TextureCache::addImageAsync(std::string_view path,
                                  const std::function<void(Texture2D*)>& callback,
                                  std::string_view callbackKey)
+{
+    addImageAsync(path, callback, callbackKey, 0);
+}
+
+void TextureCache::addImageAsync(std::string_view path,
+                                 const std::function<void(Texture2D*)>& callback,
+                                 std::string_view callbackKey,
+                                 int priority)
 {
     Texture2D* texture = nullptr;
 
@@ -198,14 +213,6 @@ void TextureCache::addImageAsync(std::string_view path,
         return;
     }
 
-    // lazy init
-    if (_loadingThread == nullptr)
-    {
-        // create a new thread to load images
-        _needQuit      = false;
-        _loadingThread = new std::thread(&TextureCache::loadImage, this);
-    }
-
     if (0 == _asyncRefCount)
     {
         Director::getInstance()->getScheduler()->schedule(AX_SCHEDULE_SELECTOR(TextureCache::addImageAsyncCallBack),
@@ -215,16 +222,34 @@ void TextureCache::addImageAsync(std::string_view path,
     ++_asyncRefCount;
 
     // generate async struct
-    AsyncStruct* data = new AsyncStruct(fullpath, callback, callbackKey);
+    AsyncStruct* data = new AsyncStruct(fullpath, callback, callbackKey, priority);
 
     // add async struct into queue
     _asyncStructQueue.emplace_back(data);
     std::unique_lock<std::mutex> ul(_requestMutex);
-    _requestQueue.emplace_back(data);
-    _sleepCondition.notify_one();
+
+    // insert after the requests with the same or higher priority
+    auto where = std::find_if(_requestQueue.rbegin(), _requestQueue.rend(),
+                              [priority](AsyncStruct* request) { return request->priority >= priority; });
+    _requestQueue.insert(where.base(), data);
+
+    // start a new decode worker if the pool isn't full, workers exit when the request queue is empty
+    if (_activeDecodeWorkers < getAsyncDecodeWorkers())
+    {
+        ++_activeDecodeWorkers;
+        ul.unlock();
+        Director::getInstance()->getJobSystem()->enqueue([this] { loadImages(); });
+    }
 }
 
-void TextureCache::unbindImageAsync(std::string_view callbackKey)
+int TextureCache::getAsyncDecodeWorkers() const
+{
+    if (_asyncDecodeWorkers > 0)
+        return _asyncDecodeWorkers;
+    return (std::max)(static_cast<int>(std::thread::hardware_concurrency()) - 1, 1);
+}
+
+void TextureCache::cancelImageAsync(const std::string_view* callbackKey)
 {
     if (_asyncStructQueue.empty())
     {
@@ -233,51 +258,64 @@ void TextureCache::unbindImageAsync(std::string_view callbackKey)
 
     for (auto&& asyncStruct : _asyncStructQueue)
     {
-        if (asyncStruct->callbackKey == callbackKey)
+        if (!callbackKey || asyncStruct->callbackKey == *callbackKey)
         {
             asyncStruct->callback = nullptr;
         }
     }
-}
 
-void TextureCache::unbindAllImageAsync()
-{
-    if (_asyncStructQueue.empty())
+    // the requests not picked by decode workers yet don't need to be loaded anymore
+    std::vector<AsyncStruct*> canceled;
     {
-        return;
+        std::lock_guard<std::mutex> lck(_requestMutex);
+        auto it = std::remove_if(_requestQueue.begin(), _requestQueue.end(), [callbackKey](AsyncStruct* request) {
+            return !callbackKey || request->callbackKey == *callbackKey;
+        });
+        canceled.assign(it, _requestQueue.end());
+        _requestQueue.erase(it, _requestQueue.end());
     }
-    for (auto&& asyncStruct : _asyncStructQueue)
+
+    for (auto asyncStruct : canceled)
+    {
+        _asyncStructQueue.erase(std::find(_asyncStructQueue.begin(), _asyncStructQueue.end(), asyncStruct));
+        delete asyncStruct;
+        --_asyncRefCount;
+    }
+
+    if (!canceled.empty() && 0 == _asyncRefCount)
     {
-        asyncStruct->callback = nullptr;
+        Director::getInstance()->getScheduler()->unschedule(AX_SCHEDULE_SELECTOR(TextureCache::addImageAsyncCallBack),
+                                                            this);
     }
 }
 
-void TextureCache::loadImage()
+void TextureCache::unbindImageAsync(std::string_view callbackKey)
+{
+    cancelImageAsync(&callbackKey);
+}
+
+void TextureCache::unbindAllImageAsync()
+{
+    cancelImageAsync(nullptr);
+}
+
+void TextureCache::loadImages()
 {
     AsyncStruct* asyncStruct = nullptr;
-    while (!_needQuit)
+    for (;;)
     {
         std::unique_lock<std::mutex> ul(_requestMutex);
-        // pop an AsyncStruct from request queue
-        if (_requestQueue.empty())
+        // exit when there is nothing to load, new requests start a new worker
+        if (_needQuit || _requestQueue.empty())
         {
-            asyncStruct = nullptr;
-        }
-        else
-        {
-            asyncStruct = _requestQueue.front();
-            _requestQueue.pop_front();
+            --_activeDecodeWorkers;
+            _workerCondition.notify_all();
+            break;
         }
 
-        if (nullptr == asyncStruct)
-        {
-            if (_needQuit)
-            {
-                break;
-            }
-            _sleepCondition.wait(ul);
-            continue;
-        }
+        // pop the highest priority AsyncStruct from request queue
+        asyncStruct = _requestQueue.front();
+        _requestQueue.pop_front();
         ul.unlock();
 
         // load image
@@ -302,8 +340,18 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
 {
     Texture2D* texture       = nullptr;
     AsyncStruct* asyncStruct = nullptr;
+    const auto startTime     = std::chrono::steady_clock::now();
+    bool firstResponse       = true;
     while (true)
     {
+        // leave the remaining responses to the next frames once the budget is exceeded
+        if (!firstResponse && _asyncUploadBudget > 0 &&
+            std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count() >= _asyncUploadBudget)
+        {
+            break;
+        }
+        firstResponse = false;
+
         // pop an AsyncStruct from response queue
         _responseMutex.lock();
         if (_responseQueue.empty())
@@ -314,10 +362,6 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
         {
             asyncStruct = _responseQueue.front();
             _responseQueue.pop_front();
-
-            // the asyncStruct's sequence order in _asyncStructQueue must equal to the order in _responseQueue
-            AX_ASSERT(asyncStruct == _asyncStructQueue.front());
-            _asyncStructQueue.pop_front();
         }
         _responseMutex.unlock();
 
@@ -326,6 +370,9 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
             break;
         }
 
+        // decode workers respond out of request order
+        _asyncStructQueue.erase(std::find(_asyncStructQueue.begin(), _asyncStructQueue.end(), asyncStruct));
+
         // check the image has been convert to texture or not
         auto it = _textures.find(asyncStruct->filename);
         if (it != _textures.end())
@@ -743,13 +790,10 @@ std::string TextureCache::getTextureFilePath(ax::Texture2D* texture) const
 
 void TextureCache::waitForQuit()
 {
-    // notify sub thread to quick
+    // notify decode workers to quit, and wait for the ones still loading
     std::unique_lock<std::mutex> ul(_requestMutex);
     _needQuit = true;
-    _sleepCondition.notify_one();
-    ul.unlock();
-    if (_loadingThread)
-        _loadingThread->join();
+    _workerCondition.wait(ul, [this] { return _activeDecodeWorkers == 0; });
 }
 
 std::string TextureCache::getCachedTextureInfo() const
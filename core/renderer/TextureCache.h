@@ -124,19 +124,49 @@ public:
                        const std::function<void(Texture2D*)>& callback,
                        std::string_view callbackKey);
 
+    /** Loads a texture asynchronously with a priority.
+     * Pending requests are decoded by a pool of JobSystem workers, higher priority first and in request order
+     * for the same priority. Callbacks are invoked on the main thread in the order the images finish decoding.
+     * @param path The file path.
+     * @param callback A callback function would be invoked after the image is loaded.
+     * @param callbackKey The key used to unbind the callback, see `unbindImageAsync`.
+     * @param priority The priority of the request, 0 by default.
+     */
+    void addImageAsync(std::string_view path,
+                       const std::function<void(Texture2D*)>& callback,
+                       std::string_view callbackKey,
+                       int priority);
+
     /** Unbind a specified bound image asynchronous callback.
      * In the case an object who was bound to an image asynchronous callback was destroyed before the callback is
      * invoked, the object always need to unbind this callback manually.
+     * Requests with this key which aren't decoding yet are canceled.
      * @param filename It's the related/absolute path of the file image.
      * @since v3.1
      */
     virtual void unbindImageAsync(std::string_view filename);
 
     /** Unbind all bound image asynchronous load callbacks.
+     * Requests which aren't decoding yet are canceled.
      * @since v3.1
      */
     virtual void unbindAllImageAsync();
 
+    /** Sets the max number of JobSystem workers decoding images for addImageAsync at the same time.
+     * @param workers The number of workers, 0 (default) uses the number of hardware threads minus one.
+     */
+    void setAsyncDecodeWorkers(int workers) { _asyncDecodeWorkers = workers; }
+    /** Gets the max number of JobSystem workers decoding images for addImageAsync at the same time. */
+    int getAsyncDecodeWorkers() const;
+
+    /** Sets the time budget per frame for creating textures of the decoded images on the main thread.
+     * The remaining decoded images are created in the next frames, at least one image is created per frame.
+     * @param budget The budget in seconds, 0 (default) means no limit.
+     */
+    void setAsyncUploadBudget(float budget) { _asyncUploadBudget = budget; }
+    /** Gets the time budget per frame for creating textures of the decoded images. */
+    float getAsyncUploadBudget() const { return _asyncUploadBudget; }
+
     /** Returns a Texture2D object given an Image.
      * If the image was not previously loaded, it will create a new Texture2D object and it will return it.
      * Otherwise it will return a reference of a previously loaded image.
@@ -226,28 +256,32 @@ public:
 
 private:
     void addImageAsyncCallBack(float dt);
-    void loadImage();
+    void loadImages();
+    void cancelImageAsync(const std::string_view* callbackKey);
     void parseNinePatchImage(Image* image, Texture2D* texture, std::string_view path);
 
 public:
 protected:
     struct AsyncStruct;
 
-    std::thread* _loadingThread;
-
     std::deque<AsyncStruct*> _asyncStructQueue;
-    std::deque<AsyncStruct*> _requestQueue;
+    std::deque<AsyncStruct*> _requestQueue;  // sorted by priority
     std::deque<AsyncStruct*> _responseQueue;
 
     std::mutex _requestMutex;
     std::mutex _responseMutex;
 
-    std::condition_variable _sleepCondition;
+    // notified when a decode worker exits
+    std::condition_variable _workerCondition;
 
     bool _needQuit;
 
     int _asyncRefCount;
 
+    int _asyncDecodeWorkers;
+    int _activeDecodeWorkers;  // locked by _requestMutex
+    float _asyncUploadBudget;
+
     hlookup::string_map<Texture2D*> _textures;
 
     static std::string s_etc1AlphaFileSuffix;
@@ -74,6 +74,21 @@ public:
      */
     virtual void usingDefaultStoredData(bool needDefaultStoredData) = 0;
 
+    /**
+     * Map a region of a BufferUsage::STREAM buffer for writing, the region must not be used by draws of the current
+     * frame yet.
+     * @param offset Specifies the offset in bytes of the region.
+     * @param size Specifies the size in bytes of the region.
+     * @return Pointer to the mapped region, or nullptr if the backend can't map the buffer, use updateSubData then.
+     * @see `unmap()`
+     */
+    virtual void* map(std::size_t offset, std::size_t size) { return nullptr; }
+
+    /**
+     * Finish writing the region returned by map, must be invoked before the buffer is used for drawing.
+     */
+    virtual void unmap() {}
+
     /**
      * Get buffer size in bytes.
      * @return The buffer size in bytes.
@@ -37,7 +37,8 @@ NS_AX_BACKEND_BEGIN
 enum class BufferUsage : uint32_t
 {
     STATIC,
-    DYNAMIC
+    DYNAMIC,
+    STREAM,  // rewritten every frame, backends keep several in-flight copies and may map them directly
 };
 
 enum class BufferType : uint32_t
@@ -384,6 +385,9 @@ struct ProgramType
         VIDEO_TEXTURE_I420, // For some android 11 and older devices
         VIDEO_TEXTURE_BGR32,
 
+        POSITION_TEXTURE_COLOR_INSTANCE,      // spriteInstance_vert,             positionTextureColor_frag
+        SKINPOSITION_TEXTURE_3D_INSTANCE,     // skinPositionTextureInstance_vert, colorTexture_frag
+
         BUILTIN_COUNT,
 
         VIDEO_TEXTURE_RGB32 = POSITION_TEXTURE_COLOR,
@@ -154,6 +154,10 @@ bool ProgramManager::init()
                     VertexLayoutType::Sprite);
     registerProgram(ProgramType::VIDEO_TEXTURE_I420, positionTextureColor_vert, videoTextureI420_frag,
                     VertexLayoutType::Sprite);
+    registerProgram(ProgramType::POSITION_TEXTURE_COLOR_INSTANCE, spriteInstance_vert, positionTextureColor_frag,
+                    VertexLayoutType::Pos);
+    registerProgram(ProgramType::SKINPOSITION_TEXTURE_3D_INSTANCE, skinPositionTextureInstance_vert,
+                    colorTexture_frag, VertexLayoutType::Unspec);
 
     // The builtin dual sampler shader registry
     ProgramStateRegistry::getInstance()->registerProgram(ProgramType::POSITION_TEXTURE_COLOR,
@@ -222,6 +226,29 @@ Program* ProgramManager::loadProgram(std::string_view vsName,
     return program;
 }
 
+size_t ProgramManager::preloadPrograms(size_t maxCount)
+{
+    size_t remaining = 0;
+    auto preload     = [&](const BuiltinRegInfo& info, uint32_t progType, uint64_t progId) {
+        if (info.vsName.empty() || _cachedPrograms.find(progId) != _cachedPrograms.end())
+            return;
+        if (maxCount > 0)
+        {
+            loadProgram(info.vsName, info.fsName, progType, progId, info.vlt);
+            --maxCount;
+        }
+        else
+            ++remaining;
+    };
+
+    for (uint32_t progType = 0; progType < ProgramType::BUILTIN_COUNT; ++progType)
+        preload(_builtinRegistry[progType], progType, progType);
+    for (auto&& [progId, info] : _customRegistry)
+        preload(info, ProgramType::CUSTOM_PROGRAM, progId);
+
+    return remaining;
+}
+
 uint64_t ProgramManager::registerCustomProgram(std::string_view vsName,
                                                std::string_view fsName,
                                                VertexLayoutType vlt,
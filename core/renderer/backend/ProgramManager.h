@@ -88,6 +88,17 @@ public:
                                std::string_view fsName,
                                VertexLayoutType vlt = VertexLayoutType::Unspec);
 
+    /**
+     * Load every builtin and registered custom program that is not cached yet.
+     * Call it during a loading screen to move shader compilation off the first frames that use them,
+     * on the GL backend this also fills the persistent program binary cache so later launches skip
+     * compilation entirely.
+     * @param maxCount the maximum number of programs to load by this call, allows spreading the work
+     *        over several frames
+     * @return the number of registered programs still not loaded
+     */
+    size_t preloadPrograms(size_t maxCount = SIZE_MAX);
+
      /**
      * Unload a program object from cache.
      * @param program Specifies the program object to move.
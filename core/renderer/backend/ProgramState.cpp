@@ -31,6 +31,7 @@
 #include "base/EventType.h"
 #include "base/Director.h"
 #include <algorithm>
+#include <atomic>
 #include "xxhash/xxhash.h"
 
 #include "axslcc/sgs-spec.h"
@@ -167,6 +168,11 @@ bool ProgramState::init(Program* program)
 
     _uniformBuffers.resize((std::max)(_vertexUniformBufferSize + _fragmentUniformBufferSize, (size_t)1), 0);
 
+    static std::atomic<uint64_t> s_nextUniformStateId{1};
+    _uniformStateId    = s_nextUniformStateId++;
+    _uniformDirtyBegin = 0;
+    _uniformDirtyEnd   = _vertexUniformBufferSize;
+
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     _backToForegroundListener =
         EventListenerCustom::create(EVENT_RENDERER_RECREATED, [this](EventCustom*) { this->resetUniforms(); });
@@ -228,6 +234,8 @@ ProgramState* ProgramState::clone() const
     cp->_vertexTextureInfos   = _vertexTextureInfos;
     cp->_fragmentTextureInfos = _fragmentTextureInfos;
     cp->_uniformBuffers       = _uniformBuffers;
+    cp->_uniformDirtyBegin    = 0;
+    cp->_uniformDirtyEnd      = _vertexUniformBufferSize;
 
     cp->_ownVertexLayout = _ownVertexLayout;
     cp->_vertexLayout    = !_ownVertexLayout ? _vertexLayout : new VertexLayout(*_vertexLayout);
@@ -267,12 +275,25 @@ void ProgramState::setVertexUniform(int location, const void* data, std::size_t
     if (location < 0)
         return;
 #if AX_GLES_PROFILE != 200
-    assert(location + offset + size <= _vertexUniformBufferSize);
-    memcpy(_uniformBuffers.data() + location + offset, data, size);
-#else
-    assert(offset + size <= _vertexUniformBufferSize);
-    memcpy(_uniformBuffers.data() + offset, data, size);
+    offset += location;
 #endif
+    assert(offset + size <= _vertexUniformBufferSize);
+
+    auto dest = _uniformBuffers.data() + offset;
+    if (memcmp(dest, data, size) == 0)
+        return;
+
+    memcpy(dest, data, size);
+    if (_uniformDirtyBegin < _uniformDirtyEnd)
+    {
+        _uniformDirtyBegin = (std::min)(_uniformDirtyBegin, offset);
+        _uniformDirtyEnd   = (std::max)(_uniformDirtyEnd, offset + size);
+    }
+    else
+    {
+        _uniformDirtyBegin = offset;
+        _uniformDirtyEnd   = offset + size;
+    }
 }
 
 #ifdef AX_USE_METAL
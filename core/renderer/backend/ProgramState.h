@@ -227,6 +227,28 @@ public:
      */
     const char* getFragmentUniformBuffer(std::size_t& size) const;
 
+    /**
+     * Get the byte range of the vertex uniform buffer whose content changed since the last
+     * clearUniformDirtyRange, setting a uniform to its current value doesn't dirty it.
+     * @return false if no uniform changed.
+     */
+    bool getUniformDirtyRange(std::size_t& begin, std::size_t& end) const
+    {
+        begin = _uniformDirtyBegin;
+        end   = _uniformDirtyEnd;
+        return _uniformDirtyBegin < _uniformDirtyEnd;
+    }
+
+    /**
+     * Indicate the uniforms were uploaded, used by backends.
+     */
+    void clearUniformDirtyRange() { _uniformDirtyBegin = _uniformDirtyEnd = 0; }
+
+    /**
+     * Get an id unique to this program state, lets backends detect consecutive uploads of the same uniforms.
+     */
+    uint64_t getUniformStateId() const { return _uniformStateId; }
+
     /**
      * An abstract base class that can be extended to support custom material auto bindings.
      *
@@ -407,6 +429,10 @@ protected:
     uint64_t _batchId    = -1;
     bool _isBatchable = false;
 
+    uint64_t _uniformStateId       = 0;
+    std::size_t _uniformDirtyBegin = 0;
+    std::size_t _uniformDirtyEnd   = 0;
+
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     EventListenerCustom* _backToForegroundListener = nullptr;
 #endif
@@ -46,11 +46,38 @@ void VertexLayout::setAttrib(std::string_view name,
         _attributes, name,
         Attribute{name, index, format, offset,
                   needToBeNormallized});  // _attributes[name] = {name, index, format, offset, needToBeNormallized};
+    _hash = 0;
 }
 
 void VertexLayout::setStride(std::size_t stride)
 {
     _stride = stride;
+    _hash   = 0;
+}
+
+uint64_t VertexLayout::getHash() const
+{
+    if (_hash == 0)
+    {
+        // attributes are unordered, so combine the attribute hashes with a commutative sum
+        uint64_t hash = static_cast<uint64_t>(_stride) * 0x9e3779b97f4a7c15ull;
+        for (auto&& item : _attributes)
+        {
+            auto& attribute = item.second;
+            uint64_t value  = static_cast<uint64_t>(attribute.index) | (static_cast<uint64_t>(attribute.format) << 8) |
+                             (static_cast<uint64_t>(attribute.needToBeNormallized) << 16) |
+                             (static_cast<uint64_t>(attribute.offset) << 32);
+            // splitmix64 finalizer
+            value ^= value >> 30;
+            value *= 0xbf58476d1ce4e5b9ull;
+            value ^= value >> 27;
+            value *= 0x94d049bb133111ebull;
+            value ^= value >> 31;
+            hash += value;
+        }
+        _hash = hash ? hash : 1;
+    }
+    return _hash;
 }
 
 NS_AX_BACKEND_END
@@ -121,10 +121,17 @@ public:
      */
     inline bool isValid() const { return _stride != 0; }
 
+    /**
+     * Get a hash of the attributes and stride, layouts with the same hash bind vertices identically.
+     * @note Used by the opengl vertex array cache.
+     */
+    uint64_t getHash() const;
+
 private:
     hlookup::string_map<Attribute> _attributes;
     std::size_t _stride      = 0;
     VertexStepMode _stepMode = VertexStepMode::VERTEX;
+    mutable uint64_t _hash   = 0;  // 0: not computed yet
 };
 
 // end of _backend group
@@ -31,7 +31,7 @@ NS_AX_BACKEND_BEGIN
 BufferMTL::BufferMTL(id<MTLDevice> mtlDevice, std::size_t size, BufferType type, BufferUsage usage)
     : Buffer(size, type, usage)
 {
-    if (BufferUsage::DYNAMIC == usage)
+    if (BufferUsage::STATIC != usage)
     {
         NSMutableArray* mutableDynamicDataBuffers = [NSMutableArray arrayWithCapacity:MAX_INFLIGHT_BUFFER];
         for (int i = 0; i < MAX_INFLIGHT_BUFFER; ++i)
@@ -53,7 +53,7 @@ BufferMTL::BufferMTL(id<MTLDevice> mtlDevice, std::size_t size, BufferType type,
 
 BufferMTL::~BufferMTL()
 {
-    if (BufferUsage::DYNAMIC == _usage)
+    if (BufferUsage::STATIC != _usage)
     {
         for (id<MTLBuffer> buffer in _dynamicDataBuffers)
             [buffer release];
@@ -94,7 +94,7 @@ void BufferMTL::beginFrame()
 
 void BufferMTL::updateIndex()
 {
-    if (BufferUsage::DYNAMIC == _usage && !_indexUpdated)
+    if (BufferUsage::STATIC != _usage && !_indexUpdated)
     {
         _currentFrameIndex = (_currentFrameIndex + 1) % MAX_INFLIGHT_BUFFER;
         _mtlBuffer         = _dynamicDataBuffers[_currentFrameIndex];
@@ -42,15 +42,63 @@ GLenum toGLUsage(const BufferUsage& usage)
         return GL_STATIC_DRAW;
     case BufferUsage::DYNAMIC:
         return GL_DYNAMIC_DRAW;
+    case BufferUsage::STREAM:
+        return GL_STREAM_DRAW;
     default:
         return GL_DYNAMIC_DRAW;
     }
 }
+
+unsigned int s_frameCounter = 0;
+
+#if AX_GL_STREAM_BUFFER
+enum class StreamSupport
+{
+    Unknown,
+    No,
+    MapRange,
+    BufferStorage,
+};
+StreamSupport s_streamSupport = StreamSupport::Unknown;
+
+StreamSupport getStreamSupport()
+{
+    if (s_streamSupport == StreamSupport::Unknown)
+    {
+        s_streamSupport = StreamSupport::MapRange;
+#    if defined(GLAD_GL_H_)
+        // GL 3.0/GLES 3.0 for mapping and GL 3.2/GLES 3.0 for fences, GL 4.4, ARB or EXT buffer_storage for persistent
+        if (!glMapBufferRange || !glUnmapBuffer || !glFenceSync || !glClientWaitSync || !glDeleteSync)
+            s_streamSupport = StreamSupport::No;
+        else if (glBufferStorage || glBufferStorageEXT)
+            s_streamSupport = StreamSupport::BufferStorage;
+#    endif
+    }
+    return s_streamSupport;
+}
+#endif
 }  // namespace
 
+void BufferGL::beginFrame()
+{
+    ++s_frameCounter;
+}
+
 BufferGL::BufferGL(std::size_t size, BufferType type, BufferUsage usage) : Buffer(size, type, usage)
 {
-    glGenBuffers(1, &_buffer);
+#if AX_GL_STREAM_BUFFER
+    if (BufferUsage::STREAM == usage)
+        createStreamBuffers();
+    if (_streamMode == StreamMode::None)
+#endif
+        glGenBuffers(1, &_buffer);
+
+    if (BufferUsage::STREAM == usage && _buffer && !_bufferAllocated)
+    {
+        // written at increasing offsets during a frame, allocate the whole store, see updateSubData
+        glBufferData(__gl->bindBuffer(_type, _buffer), _size, nullptr, GL_STREAM_DRAW);
+        _bufferAllocated = _size;
+    }
 
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     _backToForegroundListener =
@@ -61,6 +109,9 @@ BufferGL::BufferGL(std::size_t size, BufferType type, BufferUsage usage) : Buffe
 
 BufferGL::~BufferGL()
 {
+#if AX_GL_STREAM_BUFFER
+    deleteStreamBuffers();
+#endif
     if (_buffer)
         __gl->deleteBuffer(_type, _buffer);
 #if AX_ENABLE_CACHE_TEXTURE_DATA
@@ -79,6 +130,20 @@ void BufferGL::usingDefaultStoredData(bool needDefaultStoredData)
 #if AX_ENABLE_CACHE_TEXTURE_DATA
 void BufferGL::reloadBuffer()
 {
+#    if AX_GL_STREAM_BUFFER
+    if (_streamMode != StreamMode::None)
+    {
+        // the objects died with the context, only forget them
+        std::fill(std::begin(_streamBuffers), std::end(_streamBuffers), 0);
+        std::fill(std::begin(_streamFences), std::end(_streamFences), nullptr);
+        _streamMode = StreamMode::None;
+        _buffer     = 0;
+        _mapped     = false;
+        createStreamBuffers();
+        if (_streamMode != StreamMode::None)
+            return;
+    }
+#    endif
     glGenBuffers(1, &_buffer);
 
     if (!_needDefaultStoredData)
@@ -102,10 +167,136 @@ void BufferGL::fillBuffer(const void* data, std::size_t offset, std::size_t size
 }
 #endif
 
+#if AX_GL_STREAM_BUFFER
+void BufferGL::createStreamBuffers()
+{
+    auto support = getStreamSupport();
+    if (support == StreamSupport::No)
+        return;
+
+    glGenBuffers(MAX_INFLIGHT_BUFFER, _streamBuffers);
+    for (int i = 0; i < MAX_INFLIGHT_BUFFER; ++i)
+    {
+        auto target = __gl->bindBuffer(_type, _streamBuffers[i]);
+#    if defined(GLAD_GL_H_)
+        if (support == StreamSupport::BufferStorage)
+        {
+            constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            if (glBufferStorage)
+                glBufferStorage(target, _size, nullptr, flags);
+            else
+                glBufferStorageEXT(target, _size, nullptr, flags);
+            _streamMappedData[i] = static_cast<uint8_t*>(glMapBufferRange(target, 0, _size, flags));
+            if (!_streamMappedData[i])
+            {
+                AXLOGW("BufferGL: persistent mapping failed, streaming buffers fall back to glBufferSubData");
+                s_streamSupport = StreamSupport::No;
+                deleteStreamBuffers();
+                return;
+            }
+            continue;
+        }
+#    endif
+        glBufferData(target, _size, nullptr, GL_STREAM_DRAW);
+    }
+    CHECK_GL_ERROR_DEBUG();
+
+    _streamMode        = support == StreamSupport::BufferStorage ? StreamMode::Persistent : StreamMode::Unsynchronized;
+    _currentFrameIndex = 0;
+    _streamFrame       = s_frameCounter;
+    _buffer            = _streamBuffers[0];
+    _bufferAllocated   = _size;
+}
+
+void BufferGL::deleteStreamBuffers()
+{
+    for (int i = 0; i < MAX_INFLIGHT_BUFFER; ++i)
+    {
+        if (_streamFences[i])
+            glDeleteSync(_streamFences[i]);
+        // deleting a buffer unmaps it
+        if (_streamBuffers[i])
+            __gl->deleteBuffer(_type, _streamBuffers[i]);
+        _streamFences[i]     = nullptr;
+        _streamBuffers[i]    = 0;
+        _streamMappedData[i] = nullptr;
+    }
+    if (_streamMode != StreamMode::None)
+        _buffer = 0;
+    _streamMode      = StreamMode::None;
+    _bufferAllocated = 0;
+}
+
+void BufferGL::updateStreamIndex()
+{
+    if (_streamFrame == s_frameCounter)
+        return;
+    _streamFrame = s_frameCounter;
+
+    // all draws reading the current copy were submitted last frame
+    _streamFences[_currentFrameIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    _currentFrameIndex = (_currentFrameIndex + 1) % MAX_INFLIGHT_BUFFER;
+    _buffer            = _streamBuffers[_currentFrameIndex];
+
+    // only blocks when the GPU is more than MAX_INFLIGHT_BUFFER - 1 frames behind
+    if (auto fence = _streamFences[_currentFrameIndex])
+    {
+        if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+            glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+        glDeleteSync(fence);
+        _streamFences[_currentFrameIndex] = nullptr;
+    }
+}
+#endif
+
+void* BufferGL::map(std::size_t offset, std::size_t size)
+{
+#if AX_GL_STREAM_BUFFER
+    if (_streamMode == StreamMode::None)
+        return nullptr;
+
+    AXASSERT(!_mapped, "buffer is already mapped");
+    AXASSERT(offset + size <= _size, "buffer size overflow");
+
+    updateStreamIndex();
+    if (_streamMode == StreamMode::Persistent)
+        return _streamMappedData[_currentFrameIndex] + offset;
+
+    // the copy was released by its fence and the region isn't drawn yet this frame, so the driver needn't sync
+    auto data = glMapBufferRange(__gl->bindBuffer(_type, _buffer), offset, size,
+                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    _mapped   = data != nullptr;
+    return data;
+#else
+    return nullptr;
+#endif
+}
+
+void BufferGL::unmap()
+{
+#if AX_GL_STREAM_BUFFER
+    // persistent storage is coherent, nothing to flush
+    if (_mapped)
+    {
+        glUnmapBuffer(__gl->bindBuffer(_type, _buffer));
+        _mapped = false;
+    }
+#endif
+}
+
 void BufferGL::updateData(const void* data, std::size_t size)
 {
     assert(size && size <= _size);
 
+#if AX_GL_STREAM_BUFFER
+    if (_streamMode != StreamMode::None)
+    {
+        updateSubData(data, 0, size);
+        return;
+    }
+#endif
+
     if (_buffer)
     {
         glBufferData(__gl->bindBuffer(_type, _buffer), size, data, toGLUsage(_usage));
@@ -125,11 +316,36 @@ void BufferGL::updateSubData(const void* data, std::size_t offset, std::size_t s
     AXASSERT(_bufferAllocated != 0, "updateData should be invoke before updateSubData");
     AXASSERT(offset + size <= _bufferAllocated, "buffer size overflow");
 
+#if AX_GL_STREAM_BUFFER
+    if (_streamMode != StreamMode::None)
+    {
+        updateStreamIndex();
+        if (_streamMode == StreamMode::Persistent)
+        {
+            memcpy(_streamMappedData[_currentFrameIndex] + offset, data, size);
+            return;
+        }
+    }
+#endif
+
     if (_buffer)
     {
         CHECK_GL_ERROR_DEBUG();
 
-        glBufferSubData(__gl->bindBuffer(_type, _buffer), offset, size, data);
+#if AX_GL_STREAM_BUFFER
+        const bool plainStream = BufferUsage::STREAM == _usage && _streamMode == StreamMode::None;
+#else
+        const bool plainStream = BufferUsage::STREAM == _usage;
+#endif
+        auto target = __gl->bindBuffer(_type, _buffer);
+        if (plainStream && _orphanFrame != s_frameCounter)
+        {
+            // Not mappable (GLES2, WebGL), orphan the store on the first write of a frame so the draws of the
+            // previous frames keep theirs and glBufferSubData doesn't wait for them
+            _orphanFrame = s_frameCounter;
+            glBufferData(target, _bufferAllocated, nullptr, GL_STREAM_DRAW);
+        }
+        glBufferSubData(target, offset, size, data);
 
 #if AX_ENABLE_CACHE_TEXTURE_DATA
         fillBuffer(data, offset, size);
@@ -30,6 +30,13 @@
 
 #include <vector>
 
+// Streaming buffers need glMapBufferRange and fence syncs, GLES2 and WebGL fall back to glBufferSubData
+#if AX_GLES_PROFILE != 200 && AX_TARGET_PLATFORM != AX_PLATFORM_WASM
+#    define AX_GL_STREAM_BUFFER 1
+#else
+#    define AX_GL_STREAM_BUFFER 0
+#endif
+
 NS_AX_BACKEND_BEGIN
 /**
  * @addtogroup _opengl
@@ -79,12 +86,44 @@ public:
     virtual void usingDefaultStoredData(bool needDefaultStoredData) override;
 
     /**
-     * Get buffer object.
+     * Map a region of a BufferUsage::STREAM buffer, persistent mapped memory is returned when glBufferStorage is
+     * available, otherwise the region is mapped unsynchronized.
+     */
+    virtual void* map(std::size_t offset, std::size_t size) override;
+    virtual void unmap() override;
+
+    /**
+     * Get buffer object, the in-flight copy of the current frame for BufferUsage::STREAM buffers.
      * @return Buffer object.
      */
     inline GLuint getHandler() const { return _buffer; }
 
+    /**
+     * Indicate a new frame, BufferUsage::STREAM buffers switch to their next in-flight copy on the first update.
+     */
+    static void beginFrame();
+
 private:
+#if AX_GL_STREAM_BUFFER
+    enum class StreamMode
+    {
+        None,            // plain buffer updated with glBufferSubData
+        Persistent,      // glBufferStorage, mapped once for the buffer lifetime
+        Unsynchronized,  // glMapBufferRange with GL_MAP_UNSYNCHRONIZED_BIT, guarded by fences
+    };
+
+    void createStreamBuffers();
+    void deleteStreamBuffers();
+    void updateStreamIndex();
+
+    StreamMode _streamMode = StreamMode::None;
+    GLuint _streamBuffers[MAX_INFLIGHT_BUFFER]{};
+    GLsync _streamFences[MAX_INFLIGHT_BUFFER]{};
+    uint8_t* _streamMappedData[MAX_INFLIGHT_BUFFER]{};
+    int _currentFrameIndex    = 0;
+    unsigned int _streamFrame = 0;
+    bool _mapped              = false;
+#endif
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     void reloadBuffer();
     void fillBuffer(const void* data, std::size_t offset, std::size_t size);
@@ -94,6 +133,7 @@ private:
 #endif
     GLuint _buffer               = 0;
     std::size_t _bufferAllocated = 0;
+    unsigned int _orphanFrame    = 0;  // the frame a plain BufferUsage::STREAM buffer was last orphaned
     char* _data                  = nullptr;
     bool _needDefaultStoredData  = true;
 };
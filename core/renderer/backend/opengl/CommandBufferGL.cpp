@@ -57,17 +57,80 @@ void applyTexture(TextureBackend* texture, int slot, int index)
         return;
     }
 }
+
+// glReadPixels returns the rows from the lower left corner, we need to flip them vertically to match our API
+void copyFlippedPixels(PixelBufferDescriptor& pbd,
+                       const uint8_t* pixels,
+                       uint32_t width,
+                       uint32_t height,
+                       uint32_t bytesPerRow)
+{
+    auto wptr = pbd._data.resize(static_cast<ssize_t>(bytesPerRow) * height);
+    if (!wptr)
+        return;
+
+    auto rptr = pixels + (height - 1) * bytesPerRow;
+    for (uint32_t row = 0; row < height; ++row)
+    {
+        memcpy(wptr, rptr, bytesPerRow);
+        wptr += bytesPerRow;
+        rptr -= bytesPerRow;
+    }
+    pbd._width  = width;
+    pbd._height = height;
+}
+
+#if AX_GL_ASYNC_READBACK
+// frames a readback may stay in flight before we block on its fence
+constexpr unsigned int MAX_READBACK_LATENCY = 3;
+// idle pixel pack buffers kept for the next readbacks
+constexpr size_t MAX_IDLE_READBACK_BUFFERS = 4;
+
+bool isAsyncReadbackSupported()
+{
+#    if defined(GLAD_GL_H_)
+    return glMapBufferRange && glUnmapBuffer && glFenceSync && glClientWaitSync && glDeleteSync;
+#    else
+    return true;
+#    endif
+}
+#endif
 }  // namespace
 
-CommandBufferGL::CommandBufferGL() {}
+CommandBufferGL::CommandBufferGL()
+{
+#if AX_GL_ASYNC_READBACK && AX_ENABLE_CACHE_TEXTURE_DATA
+    // the buffers and fences of the pending readbacks were lost with the context
+    _backToForegroundListener = EventListenerCustom::create(EVENT_RENDERER_RECREATED, [this](EventCustom*) {
+        _readbackBuffers.clear();
+        auto pendingReadbacks = std::move(_pendingReadbacks);
+        _pendingReadbacks.clear();
+        for (auto& readback : pendingReadbacks)
+            readback.callback(PixelBufferDescriptor{});
+    });
+    Director::getInstance()->getEventDispatcher()->addEventListenerWithFixedPriority(_backToForegroundListener, -1);
+#endif
+}
 
 CommandBufferGL::~CommandBufferGL()
 {
+#if AX_GL_ASYNC_READBACK
+#    if AX_ENABLE_CACHE_TEXTURE_DATA
+    Director::getInstance()->getEventDispatcher()->removeEventListener(_backToForegroundListener);
+#    endif
+    deleteReadbacks();
+#endif
     cleanResources();
 }
 
 bool CommandBufferGL::beginFrame()
 {
+    BufferGL::beginFrame();
+#if AX_GL_ASYNC_READBACK
+    ++_readbackFrame;
+    if (!_pendingReadbacks.empty())
+        processReadbacks();
+#endif
     return true;
 }
 
@@ -294,6 +357,12 @@ void CommandBufferGL::endRenderPass()
     AX_SAFE_RELEASE_NULL(_indexBuffer);
     AX_SAFE_RELEASE_NULL(_vertexBuffer);
     AX_SAFE_RELEASE_NULL(_instanceTransformBuffer);
+
+#if AX_GLES_PROFILE != 200
+    // GL code outside the command buffer, i.e. callback commands, must not modify a cached vertex array
+    if (_vertexArrayCacheEnabled)
+        __gl->bindVertexArray(static_cast<DriverGL*>(DriverBase::getInstance())->getDefaultVAO());
+#endif
 }
 
 void CommandBufferGL::endFrame() {}
@@ -303,11 +372,16 @@ void CommandBufferGL::prepareDrawing() const
     const auto& program = _renderPipeline->getProgram();
     __gl->useProgram(program->getHandler());
 
-    uint32_t usedBits{0};
+    if (_vertexArrayCacheEnabled)
+        bindVertexArray(program);
+    else
+    {
+        uint32_t usedBits{0};
 
-    bindVertexBuffer(usedBits);
-    bindInstanceBuffer(program, usedBits);
-    __gl->disableUnusedVertexAttribs(usedBits);
+        bindVertexBuffer(usedBits);
+        bindInstanceBuffer(program, usedBits);
+        __gl->disableUnusedVertexAttribs(usedBits);
+    }
 
     bindUniforms(program);
 
@@ -324,6 +398,57 @@ void CommandBufferGL::prepareDrawing() const
         __gl->disableCullFace();
 }
 
+void CommandBufferGL::bindVertexArray(ProgramGL* program) const
+{
+#if AX_GLES_PROFILE != 200
+    auto vertexLayout = _programState->getVertexLayout();
+
+    VertexArrayKey key;
+    if (vertexLayout->isValid() && _vertexBuffer)
+    {
+        key.layoutHash   = vertexLayout->getHash();
+        key.vertexBuffer = _vertexBuffer->getHandler();
+    }
+    if (_instanceTransformBuffer)
+    {
+        key.instanceLocation = program->getAttributeLocation(Attribute::INSTANCE);
+        if (key.instanceLocation != -1)
+            key.instanceBuffer = _instanceTransformBuffer->getHandler();
+    }
+
+    if (!__gl->bindVertexArray(key))
+        return;
+
+    // A new vertex array starts with all attributes disabled and divisors at 0, specify them once
+    if (key.vertexBuffer)
+    {
+        __gl->bindBuffer(BufferType::ARRAY_BUFFER, key.vertexBuffer);
+        for (const auto& attributeInfo : vertexLayout->getAttributes())
+        {
+            const auto& attribute = attributeInfo.second;
+            glEnableVertexAttribArray(attribute.index);
+            glVertexAttribPointer(attribute.index, UtilsGL::getGLAttributeSize(attribute.format),
+                                  UtilsGL::toGLAttributeType(attribute.format), attribute.needToBeNormallized,
+                                  vertexLayout->getStride(), (GLvoid*)attribute.offset);
+        }
+    }
+
+    if (key.instanceBuffer)
+    {
+        __gl->bindBuffer(BufferType::ARRAY_BUFFER, key.instanceBuffer);
+        for (auto i = 0; i < 4; ++i)
+        {
+            auto elementLoc = key.instanceLocation + i;
+            glEnableVertexAttribArray(elementLoc);
+            glVertexAttribPointer(elementLoc, 4, GL_FLOAT, GL_FALSE, sizeof(float) * 16,
+                                  (void*)(sizeof(float) * 4 * i));
+            glVertexAttribDivisor(elementLoc, 1);
+        }
+    }
+    CHECK_GL_ERROR_DEBUG();
+#endif
+}
+
 void CommandBufferGL::bindVertexBuffer(uint32_t& usedBits) const
 {
     // Bind vertex buffers and set the attributes.
@@ -333,8 +458,7 @@ void CommandBufferGL::bindVertexBuffer(uint32_t& usedBits) const
     if (!vertexLayout->isValid())
         return;
 
-    // Bind VAO, engine share 1 VAO for all vertexLayouts aka vfmts
-    // optimize proposal: create VAO per vertexLayout, just need bind VAO
+    // Without vertex array objects, every attribute is specified again for each draw, see bindVertexArray
     __gl->bindBuffer(BufferType::ARRAY_BUFFER, _vertexBuffer->getHandler());
 
     for (const auto& attributeInfo : attributes)
@@ -385,9 +509,7 @@ void CommandBufferGL::bindUniforms(ProgramGL* program) const
 
         auto& uniformInfos = program->getAllActiveUniformInfo(ShaderStage::VERTEX);
 
-        std::size_t bufferSize = 0;
-        auto buffer            = _programState->getVertexUniformBuffer(bufferSize);
-        program->bindUniformBuffers(buffer, bufferSize);
+        program->bindUniformBuffers(_programState);
 
         const auto& textureInfo = _programState->getVertexTextureInfos();
         for (const auto& iter : textureInfo)
@@ -436,24 +558,162 @@ void CommandBufferGL::setScissorRect(bool isEnabled, float x, float y, float wid
 
 void CommandBufferGL::readPixels(RenderTarget* rt, std::function<void(const PixelBufferDescriptor&)> callback)
 {
-    PixelBufferDescriptor pbd;
+    int x = 0, y = 0;
+    uint32_t width = 0, height = 0;
     if (rt->isDefaultRenderTarget())
     {  // read pixels from screen
-        readPixels(rt, _viewPort.x, _viewPort.y, _viewPort.width, _viewPort.height, _viewPort.width * 4, false, pbd);
+        x      = _viewPort.x;
+        y      = _viewPort.y;
+        width  = _viewPort.width;
+        height = _viewPort.height;
     }
     else
     {
         // we only readPixels from the COLOR0 attachment.
         auto colorAttachment = rt->_color[0].texture;
-        if (colorAttachment)
+        if (!colorAttachment)
         {
-            readPixels(rt, 0, 0, colorAttachment->getWidth(), colorAttachment->getHeight(),
-                       colorAttachment->getWidth() * 4, false, pbd);
+            callback(PixelBufferDescriptor{});
+            return;
         }
+        width  = colorAttachment->getWidth();
+        height = colorAttachment->getHeight();
     }
+
+#if AX_GL_ASYNC_READBACK
+    if (isAsyncReadbackSupported())
+    {
+        queueReadback(rt, x, y, width, height, width * 4, std::move(callback));
+        return;
+    }
+#endif
+    PixelBufferDescriptor pbd;
+    readPixels(rt, x, y, width, height, width * 4, false, pbd);
     callback(pbd);
 }
 
+#if AX_GL_ASYNC_READBACK
+void CommandBufferGL::queueReadback(RenderTarget* rt,
+                                    int x,
+                                    int y,
+                                    uint32_t width,
+                                    uint32_t height,
+                                    uint32_t bytesPerRow,
+                                    std::function<void(const PixelBufferDescriptor&)> callback)
+{
+    PendingReadback readback;
+    readback.width       = width;
+    readback.height      = height;
+    readback.bytesPerRow = bytesPerRow;
+    readback.frame       = _readbackFrame;
+    readback.callback    = std::move(callback);
+
+    // reuse the smallest idle buffer large enough
+    const auto bufferSize = bytesPerRow * height;
+    auto best             = _readbackBuffers.end();
+    for (auto it = _readbackBuffers.begin(); it != _readbackBuffers.end(); ++it)
+    {
+        if (it->second >= bufferSize && (best == _readbackBuffers.end() || it->second < best->second))
+            best = it;
+    }
+    if (best != _readbackBuffers.end())
+    {
+        readback.buffer   = best->first;
+        readback.capacity = best->second;
+        _readbackBuffers.erase(best);
+        __gl->bindBuffer(BufferType::PIXEL_PACK_BUFFER, readback.buffer);
+    }
+    else
+    {
+        glGenBuffers(1, &readback.buffer);
+        readback.capacity = bufferSize;
+        __gl->bindBuffer(BufferType::PIXEL_PACK_BUFFER, readback.buffer);
+        glBufferData(GL_PIXEL_PACK_BUFFER, bufferSize, nullptr, GL_STREAM_READ);
+    }
+
+    auto rtGL = static_cast<RenderTargetGL*>(rt);
+    rtGL->bindFrameBuffer();
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    __gl->bindBuffer(BufferType::PIXEL_PACK_BUFFER, 0);
+
+    // the copy is only queued, the buffer is mapped once the fence signaled
+    readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    CHECK_GL_ERROR_DEBUG();
+
+    if (!rtGL->isDefaultRenderTarget())
+        rtGL->unbindFrameBuffer();
+
+    _pendingReadbacks.emplace_back(std::move(readback));
+}
+
+void CommandBufferGL::processReadbacks()
+{
+    while (!_pendingReadbacks.empty())
+    {
+        auto& readback = _pendingReadbacks.front();
+
+        // fences signal in submission order, stop at the first one still in flight unless it's overdue
+        auto status = glClientWaitSync(readback.fence, 0, 0);
+        if (status == GL_TIMEOUT_EXPIRED)
+        {
+            if (_readbackFrame - readback.frame < MAX_READBACK_LATENCY)
+                break;
+            status = glClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+        }
+        glDeleteSync(readback.fence);
+
+        PixelBufferDescriptor pbd;
+        if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+        {
+            const auto bufferSize = readback.bytesPerRow * readback.height;
+            __gl->bindBuffer(BufferType::PIXEL_PACK_BUFFER, readback.buffer);
+            if (auto pixels = (const uint8_t*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bufferSize, GL_MAP_READ_BIT))
+            {
+                copyFlippedPixels(pbd, pixels, readback.width, readback.height, readback.bytesPerRow);
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            }
+            __gl->bindBuffer(BufferType::PIXEL_PACK_BUFFER, 0);
+        }
+        else
+            AXLOGW("readPixels: the readback of a {}x{} target didn't complete", readback.width, readback.height);
+
+        recycleReadbackBuffer(readback.buffer, readback.capacity);
+
+        // the callback may queue another readback
+        auto callback = std::move(readback.callback);
+        _pendingReadbacks.pop_front();
+        callback(pbd);
+    }
+}
+
+void CommandBufferGL::recycleReadbackBuffer(GLuint buffer, uint32_t capacity)
+{
+    if (_readbackBuffers.size() >= MAX_IDLE_READBACK_BUFFERS)
+    {
+        // drop the oldest one
+        __gl->deleteBuffer(BufferType::PIXEL_PACK_BUFFER, _readbackBuffers.front().first);
+        _readbackBuffers.erase(_readbackBuffers.begin());
+    }
+    _readbackBuffers.emplace_back(buffer, capacity);
+}
+
+void CommandBufferGL::deleteReadbacks()
+{
+    for (auto& readback : _pendingReadbacks)
+    {
+        glDeleteSync(readback.fence);
+        __gl->deleteBuffer(BufferType::PIXEL_PACK_BUFFER, readback.buffer);
+    }
+    _pendingReadbacks.clear();
+
+    for (auto& buffer : _readbackBuffers)
+        __gl->deleteBuffer(BufferType::PIXEL_PACK_BUFFER, buffer.first);
+    _readbackBuffers.clear();
+}
+#endif
+
 void CommandBufferGL::readPixels(RenderTarget* rt,
                                  int x,
                                  int y,
@@ -473,7 +733,7 @@ void CommandBufferGL::readPixels(RenderTarget* rt,
     GLuint pbo;
     glGenBuffers(1, &pbo);
     __gl->bindBuffer(BufferType::PIXEL_PACK_BUFFER, pbo);
-    glBufferData(GL_PIXEL_PACK_BUFFER, bufferSize, nullptr, GL_STATIC_DRAW);
+    glBufferData(GL_PIXEL_PACK_BUFFER, bufferSize, nullptr, GL_STREAM_READ);
     glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
     auto buffer_ptr = (uint8_t*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bufferSize, GL_MAP_READ_BIT);
 #else
@@ -486,22 +746,7 @@ void CommandBufferGL::readPixels(RenderTarget* rt,
     if (buffer_ptr)
     {
         if (!eglCacheHint)
-        {
-            // we need to flip the buffer vertically to match our API
-            uint8_t* wptr = nullptr;
-            if (wptr = pbd._data.resize(bufferSize))
-            {
-                auto rptr = buffer_ptr + (height - 1) * bytesPerRow;
-                for (int row = 0; row < height; ++row)
-                {
-                    memcpy(wptr, rptr, bytesPerRow);
-                    wptr += bytesPerRow;
-                    rptr -= bytesPerRow;
-                }
-                pbd._width  = width;
-                pbd._height = height;
-            }
-        }
+            copyFlippedPixels(pbd, buffer_ptr, width, height, bytesPerRow);
         else
         {
             // for cache for restore on EGL context resume, don't need flip
@@ -33,6 +33,14 @@
 #include "StdC.h"
 
 #include <vector>
+#include <deque>
+
+// Asynchronous readbacks need pixel pack buffers and fence syncs, GLES2 and WebGL read synchronously
+#if AX_GLES_PROFILE != 200 && AX_TARGET_PLATFORM != AX_PLATFORM_WASM
+#    define AX_GL_ASYNC_READBACK 1
+#else
+#    define AX_GL_ASYNC_READBACK 0
+#endif
 
 NS_AX_BACKEND_BEGIN
 
@@ -199,7 +207,8 @@ public:
     void setScissorRect(bool isEnabled, float x, float y, float width, float height) override;
 
     /**
-     * Get a screen snapshot
+     * Get a screen snapshot, the pixels are copied to a pixel pack buffer and the callback is invoked
+     * at the beginning of a later frame, once the fence issued after the copy has signaled.
      * @param callback A callback to deal with screen snapshot image.
      */
     void readPixels(RenderTarget* rt, std::function<void(const PixelBufferDescriptor&)> callback) override;
@@ -220,11 +229,43 @@ public:
 protected:
 
     void prepareDrawing() const;
+    void bindVertexArray(ProgramGL* program) const;
     void bindVertexBuffer(uint32_t& usedBits) const;
     virtual void bindInstanceBuffer(ProgramGL* program, uint32_t& usedBits) const;
     void bindUniforms(ProgramGL* program) const;
     void cleanResources();
 
+#if AX_GL_ASYNC_READBACK
+    struct PendingReadback
+    {
+        GLuint buffer        = 0;
+        uint32_t capacity    = 0;
+        GLsync fence         = nullptr;
+        uint32_t width       = 0;
+        uint32_t height      = 0;
+        uint32_t bytesPerRow = 0;
+        unsigned int frame   = 0;
+        std::function<void(const PixelBufferDescriptor&)> callback;
+    };
+
+    void queueReadback(RenderTarget* rt,
+                       int x,
+                       int y,
+                       uint32_t width,
+                       uint32_t height,
+                       uint32_t bytesPerRow,
+                       std::function<void(const PixelBufferDescriptor&)> callback);
+    // delivers the completed readbacks in issue order, blocks on the ones pending for too many frames
+    void processReadbacks();
+    void recycleReadbackBuffer(GLuint buffer, uint32_t capacity);
+    void deleteReadbacks();
+
+    std::deque<PendingReadback> _pendingReadbacks;
+    // idle pixel pack buffers and their size, reused by the next readbacks
+    std::vector<std::pair<GLuint, uint32_t>> _readbackBuffers;
+    unsigned int _readbackFrame = 0;
+#endif
+
     BufferGL* _vertexBuffer                   = nullptr;
     ProgramState* _programState               = nullptr;
     BufferGL* _indexBuffer                    = nullptr;
@@ -234,6 +275,8 @@ protected:
     DepthStencilStateGL* _depthStencilStateGL = nullptr;
     Viewport _viewPort;
     GLboolean _alphaTestEnabled               = false;
+    // cache a vertex array object per vertex layout and buffers, GLES2 devices specify attributes every draw
+    bool _vertexArrayCacheEnabled = AX_GLES_PROFILE != 200;
 
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     EventListenerCustom* _backToForegroundListener = nullptr;
@@ -33,6 +33,8 @@ NS_AX_BACKEND_BEGIN
 
 CommandBufferGLES2::CommandBufferGLES2()
 {
+    _vertexArrayCacheEnabled = false;
+
     if (glDrawElementsInstancedEXT)
         glDrawElementsInstanced = glDrawElementsInstancedEXT;
     else if (glDrawElementsInstancedANGLE)
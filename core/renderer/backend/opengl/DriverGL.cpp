@@ -186,6 +186,11 @@ GLint DriverGL::getDefaultFBO() const
     return _defaultFBO;
 }
 
+GLuint DriverGL::getDefaultVAO() const
+{
+    return _defaultVAO;
+}
+
 CommandBuffer* DriverGL::newCommandBuffer()
 {
 #if !defined(__APPLE__) && AX_TARGET_PLATFORM != AX_PLATFORM_WINRT
@@ -45,6 +45,7 @@ public:
     ~DriverGL();
 
     GLint getDefaultFBO() const;
+    GLuint getDefaultVAO() const;
 
     /**
      * New a CommandBuffer object, not auto released.
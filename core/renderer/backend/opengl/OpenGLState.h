@@ -1,6 +1,7 @@
 #pragma once
 
 #include <optional>
+#include <unordered_map>
 
 #include "base/Types.h"
 #include "platform/GL.h"
@@ -107,6 +108,32 @@ struct UniformBufferBaseBindState
     GLuint handle;
 };
 
+// Identify the attribute bindings stored in a vertex array object
+struct VertexArrayKey
+{
+    uint64_t layoutHash    = 0;  // VertexLayout::getHash()
+    GLuint vertexBuffer    = 0;
+    GLuint instanceBuffer  = 0;
+    GLint instanceLocation = -1;
+
+    bool operator==(const VertexArrayKey& rhs) const
+    {
+        return layoutHash == rhs.layoutHash && vertexBuffer == rhs.vertexBuffer &&
+               instanceBuffer == rhs.instanceBuffer && instanceLocation == rhs.instanceLocation;
+    }
+};
+
+struct VertexArrayKeyHash
+{
+    size_t operator()(const VertexArrayKey& key) const
+    {
+        uint64_t hash = key.layoutHash;
+        hash ^= (static_cast<uint64_t>(key.vertexBuffer) << 32 | key.instanceBuffer) * 0x9e3779b97f4a7c15ull;
+        hash ^= static_cast<uint64_t>(static_cast<uint32_t>(key.instanceLocation)) * 0xc2b2ae3d27d4eb4full;
+        return static_cast<size_t>(hash ^ (hash >> 32));
+    }
+};
+
 struct OpenGLState
 {
     constexpr static GLenum BufferTargets[] = {
@@ -283,6 +310,10 @@ struct OpenGLState
     }
     void deleteBuffer(BufferType type, GLuint buffer)
     {
+#if AX_GLES_PROFILE != 200
+        if (type == BufferType::ARRAY_BUFFER)
+            deleteVertexArrays(buffer);
+#endif
         glDeleteBuffers(1, &buffer);
         if (_bufferBindings[static_cast<int>(type)] == buffer)
             _bufferBindings[static_cast<int>(type)].reset();
@@ -300,7 +331,57 @@ struct OpenGLState
     {
         _bufferBindings[static_cast<int>(BufferType::ARRAY_BUFFER)].reset();
         _bufferBindings[static_cast<int>(BufferType::ELEMENT_ARRAY_BUFFER)].reset();
+        _vertexArrayBind.reset();
+    }
+
+#if AX_GLES_PROFILE != 200
+    void bindVertexArray(GLuint vao)
+    {
+        if (_vertexArrayBind == vao)
+            return;
+        _vertexArrayBind = vao;
+        glBindVertexArray(vao);
+        // GL_ELEMENT_ARRAY_BUFFER binding is part of the vertex array state
+        _bufferBindings[static_cast<int>(BufferType::ELEMENT_ARRAY_BUFFER)].reset();
+    }
+
+    /**
+     * Bind the cached vertex array of key, a new one is created when missing.
+     * @return true if the vertex array was just created, the caller must specify its attributes.
+     */
+    bool bindVertexArray(const VertexArrayKey& key)
+    {
+        auto it = _vertexArrays.find(key);
+        if (it != _vertexArrays.end())
+        {
+            bindVertexArray(it->second);
+            return false;
+        }
+
+        GLuint vao{0};
+        glGenVertexArrays(1, &vao);
+        _vertexArrays.emplace(key, vao);
+        bindVertexArray(vao);
+        return true;
+    }
+
+    // vertex arrays keep deleted buffers alive and their names may be reused, drop the ones referencing buffer
+    void deleteVertexArrays(GLuint buffer)
+    {
+        for (auto it = _vertexArrays.begin(); it != _vertexArrays.end();)
+        {
+            if (it->first.vertexBuffer == buffer || it->first.instanceBuffer == buffer)
+            {
+                if (_vertexArrayBind == it->second)
+                    _vertexArrayBind.reset();
+                glDeleteVertexArrays(1, &it->second);
+                it = _vertexArrays.erase(it);
+            }
+            else
+                ++it;
+        }
     }
+#endif
 
     void enableVertexAttribArray(GLuint index)
     {
@@ -427,6 +508,10 @@ private:
     std::optional<GLuint> _stencilMaskBack;
     std::optional<GLenum> _activeTexture;
     std::optional<UniformBufferBaseBindState> _uniformBufferState;
+
+    // vertex array objects are not shared between contexts, so they are cached per state
+    std::optional<GLuint> _vertexArrayBind;
+    std::unordered_map<VertexArrayKey, GLuint, VertexArrayKeyHash> _vertexArrays;
 };
 
 AX_DLL extern OpenGLState* __gl;
@@ -0,0 +1,211 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ProgramBinaryCacheGL.h"
+#include "renderer/backend/DriverBase.h"
+#include "platform/FileUtils.h"
+#include "base/Data.h"
+
+#include "xxhash.h"
+
+NS_AX_BACKEND_BEGIN
+
+namespace
+{
+// 'AXPB'
+constexpr uint32_t PROGRAM_BINARY_MAGIC   = 0x42505841;
+constexpr uint32_t PROGRAM_BINARY_VERSION = 1;
+
+struct ProgramBinaryHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint32_t format;
+    uint32_t length;
+};
+
+enum class BinarySupport
+{
+    Unknown,
+    Yes,
+    No,
+};
+
+bool s_enabled               = true;
+BinarySupport s_support      = BinarySupport::Unknown;
+uint64_t s_driverSeed        = 0;
+bool s_cacheDirectoryCreated = false;
+
+std::string makeBinaryPath(uint64_t key)
+{
+    return fmt::format("{}{:016x}.bin", ProgramBinaryCacheGL::getCacheDirectory(), key);
+}
+
+uint64_t hashDriver()
+{
+    auto driver = DriverBase::getInstance();
+    uint64_t seed{0};
+    for (auto str : {driver->getVendor(), driver->getRenderer(), driver->getVersion()})
+    {
+        if (str)
+            seed = XXH64(str, strlen(str), seed);
+    }
+    return seed;
+}
+}  // namespace
+
+void ProgramBinaryCacheGL::setEnabled(bool enabled)
+{
+    s_enabled = enabled;
+}
+
+bool ProgramBinaryCacheGL::isEnabled()
+{
+    return s_enabled;
+}
+
+bool ProgramBinaryCacheGL::isAvailable()
+{
+    if (!s_enabled)
+        return false;
+
+    if (s_support == BinarySupport::Unknown)
+    {
+        s_support = BinarySupport::No;
+#if AX_GLES_PROFILE != 200 && AX_TARGET_PLATFORM != AX_PLATFORM_WASM
+#    if defined(GLAD_GL_H_)
+        // GL 4.1 or GL_ARB_get_program_binary, always present on GLES 3.0+
+        if (glGetProgramBinary && glProgramBinary && glProgramParameteri)
+#    endif
+        {
+            GLint numFormats{0};
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+            if (numFormats > 0)
+            {
+                s_support    = BinarySupport::Yes;
+                s_driverSeed = hashDriver();
+            }
+        }
+#endif
+    }
+    return s_support == BinarySupport::Yes;
+}
+
+uint64_t ProgramBinaryCacheGL::computeKey(std::string_view vertexShader, std::string_view fragmentShader)
+{
+    auto key = XXH64(vertexShader.data(), vertexShader.length(), s_driverSeed);
+    return XXH64(fragmentShader.data(), fragmentShader.length(), key);
+}
+
+bool ProgramBinaryCacheGL::loadBinary(GLuint program, uint64_t key)
+{
+#if AX_GLES_PROFILE != 200 && AX_TARGET_PLATFORM != AX_PLATFORM_WASM
+    if (!isAvailable())
+        return false;
+
+    auto fileUtils = FileUtils::getInstance();
+    auto path      = makeBinaryPath(key);
+    if (!fileUtils->isFileExist(path))
+        return false;
+
+    auto data = fileUtils->getDataFromFile(path);
+
+    ProgramBinaryHeader header;
+    bool valid = data.getSize() > static_cast<ssize_t>(sizeof(header));
+    if (valid)
+    {
+        memcpy(&header, data.getBytes(), sizeof(header));
+        valid = header.magic == PROGRAM_BINARY_MAGIC && header.version == PROGRAM_BINARY_VERSION &&
+                header.key == key && header.length == data.getSize() - sizeof(header);
+    }
+
+    if (valid)
+    {
+        glProgramBinary(program, header.format, data.getBytes() + sizeof(header), header.length);
+
+        GLint status = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &status);
+        valid = status == GL_TRUE;
+    }
+
+    // the driver rejects binaries produced by a different build, drop the entry and relink from source
+    if (!valid)
+    {
+        AXLOGW("axmol: discarding stale program binary: {}", path);
+        fileUtils->removeFile(path);
+    }
+    return valid;
+#else
+    return false;
+#endif
+}
+
+void ProgramBinaryCacheGL::saveBinary(GLuint program, uint64_t key)
+{
+#if AX_GLES_PROFILE != 200 && AX_TARGET_PLATFORM != AX_PLATFORM_WASM
+    if (!isAvailable())
+        return;
+
+    GLint length{0};
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+
+    Data data;
+    auto bytes = data.resize(sizeof(ProgramBinaryHeader) + length);
+
+    GLenum format{0};
+    GLsizei written{0};
+    glGetProgramBinary(program, length, &written, &format, bytes + sizeof(ProgramBinaryHeader));
+    if (written <= 0)
+        return;
+
+    ProgramBinaryHeader header{PROGRAM_BINARY_MAGIC, PROGRAM_BINARY_VERSION, key, format,
+                               static_cast<uint32_t>(written)};
+    memcpy(bytes, &header, sizeof(header));
+    data.resize(sizeof(header) + written);
+
+    auto fileUtils = FileUtils::getInstance();
+    if (!s_cacheDirectoryCreated)
+        s_cacheDirectoryCreated = fileUtils->createDirectories(getCacheDirectory());
+
+    if (!fileUtils->writeDataToFile(data, makeBinaryPath(key)))
+        AXLOGW("axmol: failed to store program binary: {:016x}", key);
+#endif
+}
+
+void ProgramBinaryCacheGL::purge()
+{
+    FileUtils::getInstance()->removeDirectory(getCacheDirectory());
+    s_cacheDirectoryCreated = false;
+}
+
+const std::string& ProgramBinaryCacheGL::getCacheDirectory()
+{
+    static std::string cacheDir = FileUtils::getInstance()->getWritablePath() + "axslc-cache/";
+    return cacheDir;
+}
+
+NS_AX_BACKEND_END
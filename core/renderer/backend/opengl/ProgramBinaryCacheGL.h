@@ -0,0 +1,92 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "platform/GL.h"
+
+#include <string>
+#include <string_view>
+
+NS_AX_BACKEND_BEGIN
+/**
+ * @addtogroup _opengl
+ * @{
+ */
+
+/**
+ * Persistent cache of linked program binaries, stored under the writable path.
+ *
+ * Entries are keyed by the xxhash of both shader sources and the GL vendor/renderer/version strings,
+ * so a driver update or a shader change simply misses and falls back to compiling from source.
+ * All functions must be called on the GL thread.
+ */
+struct AX_DLL ProgramBinaryCacheGL
+{
+    /**
+     * Enable or disable the cache, enabled by default.
+     * Disabling does not delete the files already stored, see purge().
+     */
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    /**
+     * Whether the cache is enabled and the driver exposes at least one program binary format.
+     */
+    static bool isAvailable();
+
+    /**
+     * Compute the cache key of a program.
+     * @param vertexShader Specifies the vertex shader source.
+     * @param fragmentShader Specifies the fragment shader source.
+     */
+    static uint64_t computeKey(std::string_view vertexShader, std::string_view fragmentShader);
+
+    /**
+     * Load the cached binary of key into program.
+     * @return true if the binary was found and the program links successfully, a stale or corrupt entry
+     * is removed from disk.
+     */
+    static bool loadBinary(GLuint program, uint64_t key);
+
+    /**
+     * Store the binary of a successfully linked program.
+     */
+    static void saveBinary(GLuint program, uint64_t key);
+
+    /**
+     * Remove all cached program binaries from disk.
+     */
+    static void purge();
+
+    /**
+     * Get the directory the binaries are stored in, ends with '/'.
+     */
+    static const std::string& getCacheDirectory();
+};
+
+// end of _opengl group
+/// @}
+NS_AX_BACKEND_END
@@ -25,7 +25,9 @@
 
 #include "ProgramGL.h"
 #include "ShaderModuleGL.h"
+#include "ProgramBinaryCacheGL.h"
 #include "renderer/backend/Types.h"
+#include "renderer/backend/ProgramState.h"
 #include "renderer/backend/opengl/MacrosGL.h"
 #include "base/Director.h"
 #include "base/EventDispatcher.h"
@@ -121,12 +123,11 @@ static void setUniform(bool isArray, GLuint location, unsigned int size, GLenum
 ProgramGL::ProgramGL(std::string_view vertexShader, std::string_view fragmentShader)
     : Program(vertexShader, fragmentShader)
 {
-    _vertexShaderModule   = static_cast<ShaderModuleGL*>(ShaderCache::getInstance()->newVertexShaderModule(_vertexShader));
-    _fragmentShaderModule = static_cast<ShaderModuleGL*>(ShaderCache::getInstance()->newFragmentShaderModule(_fragmentShader));
-
-    AX_SAFE_RETAIN(_vertexShaderModule);
-    AX_SAFE_RETAIN(_fragmentShaderModule);
-    compileProgram();
+    if (!loadProgramBinary())
+    {
+        createShaderModules();
+        compileProgram();
+    }
     computeUniformInfos();
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     for (const auto& uniform : _activeUniformInfos)
@@ -165,9 +166,12 @@ void ProgramGL::reloadProgram()
     _activeUniformInfos.clear();
     _mapToCurrentActiveLocation.clear();
     _mapToOriginalLocation.clear();
-    static_cast<ShaderModuleGL*>(_vertexShaderModule)->compileShader(backend::ShaderStage::VERTEX, _vertexShader);
-    static_cast<ShaderModuleGL*>(_fragmentShaderModule)->compileShader(backend::ShaderStage::FRAGMENT, _fragmentShader);
-    compileProgram();
+    if (!loadProgramBinary())
+    {
+        // the cached modules compiled themselves again already, see ShaderModuleGL
+        createShaderModules();
+        compileProgram();
+    }
     computeUniformInfos();
 
     for (const auto& uniform : _activeUniformInfos)
@@ -179,6 +183,37 @@ void ProgramGL::reloadProgram()
 }
 #endif
 
+bool ProgramGL::loadProgramBinary()
+{
+    if (!ProgramBinaryCacheGL::isAvailable())
+        return false;
+
+    _binaryKey = ProgramBinaryCacheGL::computeKey(_vertexShader, _fragmentShader);
+
+    _program = glCreateProgram();
+    if (!_program)
+        return false;
+
+    if (ProgramBinaryCacheGL::loadBinary(_program, _binaryKey))
+        return true;
+
+    glDeleteProgram(_program);
+    _program = 0;
+    return false;
+}
+
+void ProgramGL::createShaderModules()
+{
+    if (_vertexShaderModule && _fragmentShaderModule)
+        return;
+
+    _vertexShaderModule   = static_cast<ShaderModuleGL*>(ShaderCache::getInstance()->newVertexShaderModule(_vertexShader));
+    _fragmentShaderModule = static_cast<ShaderModuleGL*>(ShaderCache::getInstance()->newFragmentShaderModule(_fragmentShader));
+
+    AX_SAFE_RETAIN(_vertexShaderModule);
+    AX_SAFE_RETAIN(_fragmentShaderModule);
+}
+
 void ProgramGL::compileProgram()
 {
     if (_vertexShaderModule == nullptr || _fragmentShaderModule == nullptr)
@@ -198,6 +233,11 @@ void ProgramGL::compileProgram()
     glAttachShader(_program, vertShader);
     glAttachShader(_program, fragShader);
 
+#if AX_GLES_PROFILE != 200 && AX_TARGET_PLATFORM != AX_PLATFORM_WASM
+    if (_binaryKey)
+        glProgramParameteri(_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+
     glLinkProgram(_program);
 
     GLint status = 0;
@@ -217,6 +257,8 @@ void ProgramGL::compileProgram()
         glDeleteProgram(_program);
         _program = 0;
     }
+    else if (_binaryKey)
+        ProgramBinaryCacheGL::saveBinary(_program, _binaryKey);
 }
 
 void ProgramGL::setBuiltinLocations()
@@ -411,15 +453,39 @@ void ProgramGL::computeUniformInfos()
 
         _maxLocation = _maxLocation <= uniform.location ? (uniform.location + 1) : _maxLocation;
     }
+
+    // new uniform storage, the next draw uploads everything
+    _uniformShadow.resize(_totalBufferSize);
+    _uniformShadowValid = false;
 }
 
-void ProgramGL::bindUniformBuffers(const char* buffer, size_t bufferSize)
+void ProgramGL::bindUniformBuffers(ProgramState* programState)
 {
+    std::size_t bufferSize = 0;
+    auto buffer            = programState->getVertexUniformBuffer(bufferSize);
+    assert(bufferSize <= _uniformShadow.size());
+
+    // Drawing the same program state again only needs its dirty range, another state is compared with the shadow
+    std::size_t dirtyBegin = 0, dirtyEnd = bufferSize;
+    const bool sameState = _uniformShadowValid && _uniformStateId == programState->getUniformStateId();
+    if (sameState && !programState->getUniformDirtyRange(dirtyBegin, dirtyEnd))
+        dirtyBegin = dirtyEnd = 0;
+
+    auto needsUpload = [&](std::size_t offset, std::size_t size) {
+        if (sameState)
+            return offset < dirtyEnd && dirtyBegin < offset + size;
+        return !_uniformShadowValid || memcmp(_uniformShadow.data() + offset, buffer + offset, size) != 0;
+    };
+
 #if AX_GLES_PROFILE != 200
     for (GLuint blockIdx = 0; blockIdx < static_cast<GLuint>(_uniformBuffers.size()); ++blockIdx)
     {
         auto& desc = _uniformBuffers[blockIdx];
-        desc._ubo->updateData(buffer + desc._location, desc._size);
+        if (needsUpload(desc._location, desc._size))
+        {
+            desc._ubo->updateData(buffer + desc._location, desc._size);
+            memcpy(_uniformShadow.data() + desc._location, buffer + desc._location, desc._size);
+        }
         __gl->bindUniformBufferBase(blockIdx, desc._ubo->getHandler());
     }
 #else
@@ -430,11 +496,20 @@ void ProgramGL::bindUniformBuffers(const char* buffer, size_t bufferSize)
             continue;
 
         int elementCount = uniformInfo.count;
+        auto dataSize    = static_cast<std::size_t>(uniformInfo.size) * elementCount;
+        if (!needsUpload(uniformInfo.bufferOffset, dataSize))
+            continue;
+
         setUniform(uniformInfo.count > 1, uniformInfo.location, elementCount, uniformInfo.type,
                    (void*)(buffer + uniformInfo.bufferOffset));
+        memcpy(_uniformShadow.data() + uniformInfo.bufferOffset, buffer + uniformInfo.bufferOffset, dataSize);
     }
 #endif
 
+    _uniformStateId     = programState->getUniformStateId();
+    _uniformShadowValid = true;
+    programState->clearUniformDirtyRange();
+
     CHECK_GL_ERROR_DEBUG();
 }
 
@@ -43,6 +43,7 @@
 NS_AX_BACKEND_BEGIN
 
 class ShaderModuleGL;
+class ProgramState;
 
 /**
  * Store attribute information.
@@ -161,9 +162,14 @@ public:
      */
     virtual const hlookup::string_map<UniformInfo>& getAllActiveUniformInfo(ShaderStage stage) const override;
 
-    void bindUniformBuffers(const char* buffer, size_t bufferSize);
+    /**
+     * Upload the uniforms of programState which differ from the last upload to this program.
+     */
+    void bindUniformBuffers(ProgramState* programState);
 
 private:
+    bool loadProgramBinary();
+    void createShaderModules();
     void compileProgram();
     void computeUniformInfos();
     void setBuiltinLocations();
@@ -182,10 +188,16 @@ private:
 
     GLuint _program                       = 0;
     ShaderModuleGL* _vertexShaderModule   = nullptr;
-    ShaderModuleGL* _fragmentShaderModule = nullptr;
+    ShaderModuleGL* _fragmentShaderModule = nullptr;  ///< created on demand, null when linked from a cached binary
+    uint64_t _binaryKey                   = 0;        ///< the ProgramBinaryCacheGL key, 0: cache not available
 
     axstd::pod_vector<UniformBlockDescriptor> _uniformBuffers;
 
+    // copy of the last uploaded uniforms, the program keeps them between draws
+    axstd::pod_vector<char> _uniformShadow;
+    uint64_t _uniformStateId  = 0;  ///< ProgramState::getUniformStateId of the last upload
+    bool _uniformShadowValid = false;
+
     std::vector<AttributeInfo> _attributeInfos;
     hlookup::string_map<UniformInfo> _activeUniformInfos;
     mutable hlookup::string_map<AttributeBindInfo> _activeAttribs;
@@ -28,17 +28,36 @@
 #include "platform/PlatformMacros.h"
 #include "base/Macros.h"
 #include "base/axstd.h"
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+#    include "base/Director.h"
+#    include "base/EventDispatcher.h"
+#    include "base/EventType.h"
+#endif
 
 NS_AX_BACKEND_BEGIN
 
 ShaderModuleGL::ShaderModuleGL(ShaderStage stage, std::string_view source) : ShaderModule(stage)
 {
     compileShader(stage, source);
+
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    // before the programs, see ProgramGL::reloadProgram
+    _source                    = source;
+    _rendererRecreatedListener = EventListenerCustom::create(EVENT_RENDERER_RECREATED, [this](EventCustom*) {
+        _shader = 0;
+        compileShader(_stage, _source);
+    });
+    Director::getInstance()->getEventDispatcher()->addEventListenerWithFixedPriority(_rendererRecreatedListener, -2);
+#endif
 }
 
 ShaderModuleGL::~ShaderModuleGL()
 {
     deleteShader();
+
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    Director::getInstance()->getEventDispatcher()->removeEventListener(_rendererRecreatedListener);
+#endif
 }
 
 void ShaderModuleGL::compileShader(ShaderStage stage, std::string_view source)
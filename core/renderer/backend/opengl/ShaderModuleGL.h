@@ -27,6 +27,9 @@
 #include "../ShaderModule.h"
 
 #include "platform/GL.h"
+#include "base/EventListenerCustom.h"
+
+#include <string>
 
 NS_AX_BACKEND_BEGIN
 /**
@@ -58,6 +61,11 @@ private:
     void deleteShader();
 
     GLuint _shader = 0;
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    // the modules are shared by programs, each one is compiled again once before the programs are linked again
+    std::string _source;
+    EventListenerCustom* _rendererRecreatedListener = nullptr;
+#endif
     friend class ProgramGL;
 };
 // end of _opengl group
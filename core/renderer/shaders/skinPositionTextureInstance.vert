@@ -0,0 +1,96 @@
+#version 310 es
+
+#include "base.glsl"
+
+layout(location = POSITION) in vec3 a_position;
+
+layout(location = BLENDWEIGHT) in vec4 a_blendWeight;
+layout(location = BLENDINDICES) in vec4 a_blendIndex;
+
+layout(location = TEXCOORD0) in vec2 a_texCoord;
+#if !defined(METAL)
+layout(location = TEXCOORD1) in mat4 a_instance;
+#endif
+
+// Varyings
+layout(location = TEXCOORD0) out vec2 v_texCoord;
+
+layout(std140, binding = 0) uniform vs_ub {
+    mat4 u_MVPMatrix;
+    float u_matrixPaletteWidth;
+};
+
+#if defined(METAL)
+layout(std140, binding = 1) buffer vs_inst {
+    mat4 u_instance[];
+};
+#endif
+
+// The matrix palette is a 1 pixel high RGBA32F texture, 3 texels per joint in the
+// same row layout as u_matrixPalette, so the joint count is not limited by the uniform block size
+layout(binding = 2) uniform sampler2D u_matrixPaletteTex;
+
+vec4 getPaletteRow(int index)
+{
+    return texture(u_matrixPaletteTex, vec2((float(index) + 0.5) / u_matrixPaletteWidth, 0.5));
+}
+
+vec4 getPosition()
+{
+    float blendWeight = a_blendWeight[0];
+
+    int matrixIndex = int (a_blendIndex[0]) * 3;
+    vec4 matrixPalette1 = getPaletteRow(matrixIndex) * blendWeight;
+    vec4 matrixPalette2 = getPaletteRow(matrixIndex + 1) * blendWeight;
+    vec4 matrixPalette3 = getPaletteRow(matrixIndex + 2) * blendWeight;
+
+
+    blendWeight = a_blendWeight[1];
+    if (blendWeight > 0.0)
+    {
+        matrixIndex = int(a_blendIndex[1]) * 3;
+        matrixPalette1 += getPaletteRow(matrixIndex) * blendWeight;
+        matrixPalette2 += getPaletteRow(matrixIndex + 1) * blendWeight;
+        matrixPalette3 += getPaletteRow(matrixIndex + 2) * blendWeight;
+
+        blendWeight = a_blendWeight[2];
+        if (blendWeight > 0.0)
+        {
+            matrixIndex = int(a_blendIndex[2]) * 3;
+            matrixPalette1 += getPaletteRow(matrixIndex) * blendWeight;
+            matrixPalette2 += getPaletteRow(matrixIndex + 1) * blendWeight;
+            matrixPalette3 += getPaletteRow(matrixIndex + 2) * blendWeight;
+
+            blendWeight = a_blendWeight[3];
+            if (blendWeight > 0.0)
+            {
+                matrixIndex = int(a_blendIndex[3]) * 3;
+                matrixPalette1 += getPaletteRow(matrixIndex) * blendWeight;
+                matrixPalette2 += getPaletteRow(matrixIndex + 1) * blendWeight;
+                matrixPalette3 += getPaletteRow(matrixIndex + 2) * blendWeight;
+            }
+        }
+    }
+
+    vec4 _skinnedPosition;
+    vec4 position = vec4(a_position, 1.0);
+    _skinnedPosition.x = dot(position, matrixPalette1);
+    _skinnedPosition.y = dot(position, matrixPalette2);
+    _skinnedPosition.z = dot(position, matrixPalette3);
+    _skinnedPosition.w = position.w;
+
+    return _skinnedPosition;
+}
+
+void main()
+{
+    vec4 position = getPosition();
+#if defined(METAL)
+    gl_Position = u_MVPMatrix * u_instance[gl_InstanceIndex] * position;
+#else
+    gl_Position = u_MVPMatrix * a_instance * position;
+#endif
+
+    v_texCoord = a_texCoord;
+    v_texCoord.y = 1.0 - v_texCoord.y;
+}
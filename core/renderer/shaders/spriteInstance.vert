@@ -0,0 +1,35 @@
+#version 310 es
+
+// unit quad corner, (0,0) bottom-left .. (1,1) top-right
+layout(location = POSITION) in vec2 a_position;
+#if !defined(METAL)
+layout(location = TEXCOORD1) in mat4 a_instance;
+#endif
+
+layout(location = COLOR0) out vec4 v_color;
+layout(location = TEXCOORD0) out vec2 v_texCoord;
+
+layout(std140, binding = 0) uniform vs_ub {
+    mat4 u_MVPMatrix;
+};
+
+#if defined(METAL)
+layout(std140, binding = 1) buffer vs_inst {
+    mat4 u_instance[];
+};
+#endif
+
+void main()
+{
+#if defined(METAL)
+    mat4 inst = u_instance[gl_InstanceIndex];
+#else
+    mat4 inst = a_instance;
+#endif
+    // inst[0]: 2x2 linear part (x axis, y axis), inst[1].xyz: translation, inst[2]: uv rect (left, top, right, bottom)
+    // inst[3]: color
+    vec2 pos     = inst[0].xy * a_position.x + inst[0].zw * a_position.y + inst[1].xy;
+    gl_Position  = u_MVPMatrix * vec4(pos, inst[1].z, 1.0);
+    v_texCoord   = mix(inst[2].xy, inst[2].zw, vec2(a_position.x, 1.0 - a_position.y));
+    v_color      = inst[3];
+}
@@ -1,7 +1,41 @@
 #include <doctest.h>
 #include "base/Types.h"
+#include "platform/FileUtils.h"
+#include "platform/GLViewImpl.h"
 #include "TestUtils.h"
 
+
+bool ensureGLView() {
+    auto director = ax::Director::getInstance();
+    if (director->getGLView())
+        return true;
+
+    auto glView = ax::GLViewImpl::create("Unit Tests");
+    if (!glView)
+        return false;
+
+    director->setGLView(glView);
+    return true;
+}
+
+std::string findTestFont() {
+    static const char* candidates[] = {
+        "fonts/arial.ttf",
+        "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
+        "/usr/share/fonts/TTF/DejaVuSans.ttf",
+        "/Library/Fonts/Arial.ttf",
+        "C:/Windows/Fonts/arial.ttf",
+    };
+    auto fileUtils = ax::FileUtils::getInstance();
+    for (auto candidate : candidates)
+    {
+        if (fileUtils->isFileExist(candidate))
+            return fileUtils->fullPathForFilename(candidate);
+    }
+    return {};
+}
+
+
 namespace ax
 {
 
@@ -41,6 +41,15 @@ public:
 };
 
 
+/// Creates the window and its GL context the renderer tests draw with, the unit tests run without one.
+/// Returns false when the platform has no display, the caller should skip its test then.
+bool ensureGLView();
+
+/// Returns the path of a ttf font for the font and label tests, the test content or a system font.
+/// Returns an empty string when none is found, the caller should skip its test then.
+std::string findTestFont();
+
+
 namespace ax {
     doctest::String toString(const Color4B& value);
     doctest::String toString(const Vec2& value);
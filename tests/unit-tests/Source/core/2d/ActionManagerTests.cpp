@@ -0,0 +1,197 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include "2d/ActionManager.h"
+#include "2d/Node.h"
+
+using namespace ax;
+
+// a node driven by the given action manager instead of the director's one
+static Node* newTweenedNode(ActionManager* manager)
+{
+    auto node = new Node();
+    node->setActionManager(manager);
+    return node;
+}
+
+
+TEST_SUITE("2d/ActionManager") {
+    TEST_CASE("addTween") {
+        auto manager = new ActionManager();
+        auto node    = newTweenedNode(manager);
+
+        manager->addTween(node, TweenProperty::POSITION, Vec2(100.0f, -50.0f), 1.0f);
+        manager->addTween(node, TweenProperty::SCALE, Vec2(3.0f, 2.0f), 2.0f);
+        manager->addTween(node, TweenProperty::ROTATION, 90.0f, 1.0f);
+        CHECK(manager->getNumberOfRunningTweens() == 3);
+
+        SUBCASE("paused target") {
+            // a target which isn't running starts paused
+            manager->update(0.5f);
+            manager->update(0.5f);
+            CHECK_EQ(0.0f, node->getPositionX());
+            CHECK(manager->getNumberOfRunningTweens() == 3);
+        }
+
+
+        SUBCASE("running target") {
+            manager->resumeTarget(node);
+
+            // the first update only starts the tweens, same as actions
+            manager->update(0.5f);
+            CHECK_EQ(0.0f, node->getPositionX());
+
+            manager->update(0.5f);
+            CHECK_EQ(50.0f, node->getPositionX());
+            CHECK_EQ(-25.0f, node->getPositionY());
+            CHECK_EQ(1.5f, node->getScaleX());
+            CHECK_EQ(1.25f, node->getScaleY());
+            CHECK_EQ(45.0f, node->getRotation());
+
+            manager->pauseTarget(node);
+            manager->update(0.5f);
+            CHECK_EQ(50.0f, node->getPositionX());
+
+            manager->resumeTarget(node);
+            manager->update(0.5f);
+            CHECK_EQ(100.0f, node->getPositionX());
+            CHECK_EQ(-50.0f, node->getPositionY());
+            CHECK_EQ(90.0f, node->getRotation());
+            CHECK(manager->getNumberOfRunningTweens() == 1);
+
+            manager->update(1.0f);
+            CHECK_EQ(3.0f, node->getScaleX());
+            CHECK_EQ(2.0f, node->getScaleY());
+            CHECK(manager->getNumberOfRunningTweens() == 0);
+        }
+
+        node->release();
+        manager->release();
+    }
+
+
+    TEST_CASE("color components") {
+        auto manager = new ActionManager();
+        auto node    = newTweenedNode(manager);
+        manager->resumeTarget(node);
+
+        SUBCASE("rounded") {
+            node->setOpacity(0);
+            manager->addTween(node, TweenProperty::OPACITY, 255.0f, 1.0f);
+            manager->update(0.0f);
+            manager->update(0.5f);
+            CHECK(node->getOpacity() == 128);
+        }
+
+
+        SUBCASE("overshoot clamped") {
+            // back easing overshoots by about 6% at 0.75
+            node->setOpacity(0);
+            node->setColor(Color3B(255, 0, 128));
+            manager->addTween(node, TweenProperty::OPACITY, 255.0f, 1.0f, tweenfunc::Back_EaseOut);
+            manager->addTween(node, TweenProperty::COLOR, Vec3(0.0f, 255.0f, 128.0f), 1.0f, tweenfunc::Back_EaseOut);
+            manager->update(0.0f);
+            manager->update(0.75f);
+            CHECK(node->getOpacity() == 255);
+            CHECK(node->getColor().r == 0);
+            CHECK(node->getColor().g == 255);
+            CHECK(node->getColor().b == 128);
+
+            manager->update(0.25f);
+            CHECK(node->getOpacity() == 255);
+            CHECK(node->getColor() == Color3B(0, 255, 128));
+        }
+
+        node->release();
+        manager->release();
+    }
+
+
+    TEST_CASE("removeTweensByTag") {
+        auto manager = new ActionManager();
+        auto node    = newTweenedNode(manager);
+        manager->resumeTarget(node);
+
+        manager->addTween(node, TweenProperty::POSITION, Vec2(100.0f, 0.0f), 1.0f, tweenfunc::Linear, 1);
+        manager->addTween(node, TweenProperty::ROTATION, 90.0f, 1.0f, tweenfunc::Linear, 2);
+        manager->update(0.0f);
+        manager->update(0.5f);
+
+        manager->removeTweensByTag(1, node);
+        manager->removeTweensByTag(3, node);
+        manager->update(0.25f);
+        CHECK_EQ(50.0f, node->getPositionX());
+        CHECK_EQ(67.5f, node->getRotation());
+        CHECK(manager->getNumberOfRunningTweens() == 1);
+
+        manager->removeTweensByTag(2, node);
+        manager->update(0.25f);
+        CHECK_EQ(67.5f, node->getRotation());
+        CHECK(manager->getNumberOfRunningTweens() == 0);
+
+        node->release();
+        manager->release();
+    }
+
+
+    TEST_CASE("target released in flight") {
+        auto manager = new ActionManager();
+        auto released = newTweenedNode(manager);
+        auto kept     = newTweenedNode(manager);
+        manager->resumeTarget(released);
+        manager->resumeTarget(kept);
+
+        manager->addTween(released, TweenProperty::POSITION, Vec2(100.0f, 0.0f), 1.0f);
+        manager->addTween(kept, TweenProperty::POSITION, Vec2(0.0f, 100.0f), 1.0f);
+        manager->addTween(released, TweenProperty::ROTATION, 90.0f, 1.0f);
+        manager->update(0.0f);
+        manager->update(0.25f);
+
+        // the tweens of the released node are dropped, the node isn't accessed anymore
+        released->release();
+        manager->update(0.25f);
+        CHECK_EQ(50.0f, kept->getPositionY());
+        CHECK(manager->getNumberOfRunningTweens() == 1);
+
+        // a new target may reuse the slot of the released one
+        auto added = newTweenedNode(manager);
+        manager->resumeTarget(added);
+        manager->addTween(added, TweenProperty::POSITION, Vec2(-100.0f, 0.0f), 0.5f);
+        manager->update(0.0f);
+        manager->update(0.25f);
+        CHECK_EQ(-50.0f, added->getPositionX());
+        CHECK_EQ(75.0f, kept->getPositionY());
+
+        manager->update(0.25f);
+        CHECK_EQ(-100.0f, added->getPositionX());
+        CHECK_EQ(100.0f, kept->getPositionY());
+        CHECK(manager->getNumberOfRunningTweens() == 0);
+
+        added->release();
+        kept->release();
+        manager->release();
+    }
+}
@@ -0,0 +1,112 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include <chrono>
+#include <thread>
+#include "2d/FontAtlas.h"
+#include "2d/FontAtlasCache.h"
+#include "2d/Label.h"
+#include "base/Director.h"
+#include "TestUtils.h"
+
+using namespace ax;
+
+static bool hasLetter(FontAtlas* atlas, char32_t charCode)
+{
+    FontLetterDefinition letterDef;
+    return atlas->getLetterDefinitionForChar(charCode, letterDef);
+}
+
+TEST_SUITE("2d/FontAtlas")
+{
+    TEST_CASE("async rasterization")
+    {
+        const auto fontPath = findTestFont();
+        if (!ensureGLView() || fontPath.empty())
+        {
+            MESSAGE("no display or font, skipped");
+            return;
+        }
+
+        // a size no other test uses, so the atlas starts empty
+        TTFConfig config(fontPath, 29, GlyphCollection::DYNAMIC);
+        auto atlas = FontAtlasCache::getFontAtlasTTF(&config);
+        REQUIRE(atlas);
+
+        SUBCASE("synchronous")
+        {
+            CHECK_FALSE(FontAtlas::isAsyncRasterizationEnabled());
+            atlas->prefetchCharacters("xyz"sv);
+            CHECK(hasLetter(atlas, U'x'));
+            CHECK(hasLetter(atlas, U'z'));
+            CHECK_FALSE(atlas->hasPendingGlyphs());
+        }
+
+        SUBCASE("queue and upload order")
+        {
+            FontAtlas::setAsyncRasterizationEnabled(true);
+            FontAtlas::setGlyphUploadBudget(1);
+
+            const std::u32string first = U"ab", second = U"cd";
+            atlas->prepareLetterDefinitions(first);
+            atlas->prefetchCharacters(second);
+            CHECK(atlas->hasPendingGlyphs(first));
+            CHECK(atlas->isGlyphPending(U'c'));
+            CHECK_FALSE(atlas->hasPendingGlyphs(U"xyz"));
+            CHECK_FALSE(hasLetter(atlas, U'a'));
+            const auto generation = atlas->getGlyphGeneration();
+
+            // one glyph lands per frame, the characters queued first land first
+            auto scheduler = Director::getInstance()->getScheduler();
+            std::u32string landed;
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (landed.size() < 4 && std::chrono::steady_clock::now() < deadline)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                scheduler->update(0);
+
+                std::u32string frame;
+                for (auto charCode : first + second)
+                {
+                    if (landed.find(charCode) == std::u32string::npos && hasLetter(atlas, charCode))
+                        frame += charCode;
+                }
+                CHECK(frame.size() <= 1);
+                landed += frame;
+            }
+            FontAtlas::setAsyncRasterizationEnabled(false);
+            FontAtlas::setGlyphUploadBudget(32);
+
+            REQUIRE_EQ(landed.size(), 4);
+            CHECK(first.find(landed[0]) != std::u32string::npos);
+            CHECK(first.find(landed[1]) != std::u32string::npos);
+            CHECK_EQ(atlas->getGlyphGeneration(), generation + 4);
+            CHECK_FALSE(atlas->hasPendingGlyphs());
+        }
+
+        FontAtlasCache::releaseFontAtlas(atlas);
+    }
+}
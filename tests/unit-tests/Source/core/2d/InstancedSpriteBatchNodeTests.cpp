@@ -0,0 +1,152 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include "2d/InstancedSpriteBatchNode.h"
+#include "renderer/Texture2D.h"
+#include "TestUtils.h"
+
+using namespace ax;
+
+namespace
+{
+class TestBatchNode : public InstancedSpriteBatchNode
+{
+public:
+    using InstancedSpriteBatchNode::_dirtyBegin;
+    using InstancedSpriteBatchNode::_dirtyEnd;
+    using InstancedSpriteBatchNode::_instanceCapacity;
+    using InstancedSpriteBatchNode::_instanceData;
+    using InstancedSpriteBatchNode::updateInstanceBuffer;
+
+    static TestBatchNode* create(Texture2D* texture, int capacity)
+    {
+        auto node = new TestBatchNode();
+        if (!node->initWithTexture(texture, capacity))
+        {
+            delete node;
+            return nullptr;
+        }
+        node->autorelease();
+        return node;
+    }
+};
+}  // namespace
+
+TEST_SUITE("2d/InstancedSpriteBatchNode")
+{
+    TEST_CASE("instances")
+    {
+        if (!ensureGLView())
+        {
+            MESSAGE("no display, skipped");
+            return;
+        }
+
+        std::vector<uint8_t> pixels(32 * 32 * 4, 0xff);
+        auto texture = new Texture2D();
+        REQUIRE(texture->initWithData(pixels.data(), pixels.size(), backend::PixelFormat::RGBA8, 32, 32));
+        texture->autorelease();
+
+        auto node = TestBatchNode::create(texture, 2);
+        REQUIRE(node);
+        CHECK_EQ(node->getInstanceCount(), 0);
+
+        SUBCASE("packing")
+        {
+            node->addInstance(Rect(8, 0, 16, 8), Vec2(100, 50), 0.0f, Vec2::ONE, Color4B(255, 0, 0, 128));
+            const auto& data = node->_instanceData[0];
+
+            // the anchor (0.5, 0.5) lands on the position
+            CHECK_EQ(data.axes[0], doctest::Approx(16.0f));
+            CHECK_EQ(data.axes[1], doctest::Approx(0.0f));
+            CHECK_EQ(data.axes[2], doctest::Approx(0.0f));
+            CHECK_EQ(data.axes[3], doctest::Approx(8.0f));
+            CHECK_EQ(data.translation[0], doctest::Approx(92.0f));
+            CHECK_EQ(data.translation[1], doctest::Approx(46.0f));
+
+            const float scale = AX_CONTENT_SCALE_FACTOR() / 32.0f;
+            CHECK_EQ(data.uv[0], doctest::Approx(8.0f * scale));
+            CHECK_EQ(data.uv[1], doctest::Approx(0.0f));
+            CHECK_EQ(data.uv[2], doctest::Approx(24.0f * scale));
+            CHECK_EQ(data.uv[3], doctest::Approx(8.0f * scale));
+
+            // not premultiplied, the color is used as-is
+            CHECK_EQ(data.color[0], doctest::Approx(1.0f));
+            CHECK_EQ(data.color[1], doctest::Approx(0.0f));
+            CHECK_EQ(data.color[3], doctest::Approx(128 / 255.0f));
+
+            // clockwise like Node::setRotation, scaled
+            node->setInstanceTransform(0, Vec2(100, 50), 90.0f, Vec2(2.0f, 1.0f));
+            CHECK_EQ(data.axes[0], doctest::Approx(0.0f).epsilon(1e-5));
+            CHECK_EQ(data.axes[1], doctest::Approx(-32.0f));
+            CHECK_EQ(data.axes[2], doctest::Approx(8.0f));
+            CHECK_EQ(data.axes[3], doctest::Approx(0.0f).epsilon(1e-5));
+            CHECK_EQ(data.translation[0], doctest::Approx(96.0f));
+            CHECK_EQ(data.translation[1], doctest::Approx(66.0f));
+
+            // bottom-left anchor
+            node->setInstanceAnchorPoint(Vec2::ZERO);
+            CHECK_EQ(data.translation[0], doctest::Approx(100.0f));
+            CHECK_EQ(data.translation[1], doctest::Approx(50.0f));
+        }
+
+        SUBCASE("dirty range")
+        {
+            for (int i = 0; i < 3; ++i)
+                CHECK_EQ(node->addInstance(Rect(0, 0, 4, 4), Vec2(i * 10.0f, 0)), i);
+            CHECK_EQ(node->_dirtyBegin, 0);
+            CHECK_EQ(node->_dirtyEnd, 3);
+
+            // grown by a third past the initial capacity, all uploaded at once
+            node->updateInstanceBuffer();
+            CHECK_EQ(node->_instanceCapacity, 4);
+            CHECK_EQ(node->_instanceData.size(), 3u);
+            CHECK_EQ(node->_dirtyBegin, node->_dirtyEnd);
+
+            node->setInstanceColor(1, Color4B::BLUE);
+            CHECK_EQ(node->_dirtyBegin, 1);
+            CHECK_EQ(node->_dirtyEnd, 2);
+            node->updateInstanceBuffer();
+            CHECK_EQ(node->_dirtyBegin, node->_dirtyEnd);
+
+            // the last instance moves into the removed one
+            node->removeInstance(0);
+            CHECK_EQ(node->getInstanceCount(), 2);
+            CHECK_EQ(node->getInstancePosition(0), Vec2(20.0f, 0));
+            CHECK_EQ(node->_dirtyBegin, 0);
+            CHECK_EQ(node->_dirtyEnd, 1);
+            node->updateInstanceBuffer();
+
+            // nothing to upload when the last one is removed
+            node->removeInstance(1);
+            CHECK_EQ(node->_dirtyBegin, node->_dirtyEnd);
+
+            node->removeAllInstances();
+            CHECK_EQ(node->getInstanceCount(), 0);
+            CHECK_EQ(node->_instanceCapacity, 4);
+        }
+    }
+}
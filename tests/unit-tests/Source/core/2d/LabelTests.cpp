@@ -0,0 +1,192 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include <string.h>
+#include <algorithm>
+#include "2d/Label.h"
+#include "2d/SpriteBatchNode.h"
+#include "base/Director.h"
+#include "renderer/Renderer.h"
+#include "renderer/TextureAtlas.h"
+#include "TestUtils.h"
+
+using namespace ax;
+
+namespace
+{
+class TestLabel : public Label
+{
+public:
+    using Label::_batchNodes;
+    using Label::_lettersInfo;
+
+    static TestLabel* create(const TTFConfig& config)
+    {
+        auto label = new TestLabel();
+        if (!label->setTTFConfig(config))
+        {
+            delete label;
+            return nullptr;
+        }
+        label->autorelease();
+        return label;
+    }
+
+    // the quads of all the pages, sorted as their order in the atlases differs after an incremental layout
+    std::vector<V3F_C4B_T2F_Quad> getSortedQuads()
+    {
+        std::vector<V3F_C4B_T2F_Quad> quads;
+        for (auto batchNode : _batchNodes)
+        {
+            auto textureAtlas = batchNode->getTextureAtlas();
+            quads.insert(quads.end(), textureAtlas->getQuads(),
+                         textureAtlas->getQuads() + textureAtlas->getTotalQuads());
+        }
+        std::sort(quads.begin(), quads.end(), [](const V3F_C4B_T2F_Quad& a, const V3F_C4B_T2F_Quad& b) {
+            return memcmp(&a, &b, sizeof(a)) < 0;
+        });
+        return quads;
+    }
+};
+
+void checkSameLayout(TestLabel* full, TestLabel* incremental)
+{
+    CHECK_EQ(full->getStringNumLines(), incremental->getStringNumLines());
+    CHECK_EQ(full->getContentSize(), incremental->getContentSize());
+
+    const int length = full->getStringLength();
+    REQUIRE_EQ(length, incremental->getStringLength());
+    for (int i = 0; i < length; ++i)
+    {
+        CAPTURE(i);
+        const auto& a = full->_lettersInfo[i];
+        const auto& b = incremental->_lettersInfo[i];
+        CHECK_EQ(a.utf32Char, b.utf32Char);
+        CHECK_EQ(a.valid, b.valid);
+        CHECK_EQ(a.lineIndex, b.lineIndex);
+        CHECK_EQ(a.positionX, b.positionX);
+        CHECK_EQ(a.positionY, b.positionY);
+    }
+
+    const auto fullQuads        = full->getSortedQuads();
+    const auto incrementalQuads = incremental->getSortedQuads();
+    REQUIRE_EQ(fullQuads.size(), incrementalQuads.size());
+    CHECK(memcmp(fullQuads.data(), incrementalQuads.data(), fullQuads.size() * sizeof(V3F_C4B_T2F_Quad)) == 0);
+}
+}  // namespace
+
+TEST_SUITE("2d/Label")
+{
+    TEST_CASE("incremental layout")
+    {
+        const auto fontPath = findTestFont();
+        if (!ensureGLView() || fontPath.empty())
+        {
+            MESSAGE("no display or font, skipped");
+            return;
+        }
+
+        TTFConfig config(fontPath, 20);
+        auto full        = TestLabel::create(config);
+        auto incremental = TestLabel::create(config);
+        REQUIRE(full);
+        REQUIRE(incremental);
+        incremental->setIncrementalLayoutEnabled(true);
+
+        SUBCASE("left") {}
+        SUBCASE("center")
+        {
+            full->setAlignment(TextHAlignment::CENTER, TextVAlignment::CENTER);
+            incremental->setAlignment(TextHAlignment::CENTER, TextVAlignment::CENTER);
+        }
+        full->setMaxLineWidth(150);
+        incremental->setMaxLineWidth(150);
+
+        const char* texts[] = {
+            "The quick brown fox jumps over the lazy dog",
+            "The quick brown fox jumps over the lazy dog and keeps running",  // appended
+            "The quick brown cat jumps over the lazy dog and keeps running",  // changed in the first line
+            "The quick brown cat jumps over the lazy dog and keeps running\nthen stops",
+            "The quick brown cat jumps over the lazy dog and keeps running\nthen stops",  // unchanged
+            "The quick",                                                                  // shortened
+            "The quick\n\nbrown fox 12345",
+            "The quick\n\nbrown fox 12346",
+        };
+        for (auto text : texts)
+        {
+            CAPTURE(text);
+            full->setString(text);
+            incremental->setString(text);
+            full->updateContent();
+            incremental->updateContent();
+            checkSameLayout(full, incremental);
+        }
+    }
+
+    TEST_CASE("batched rendering")
+    {
+        const auto fontPath = findTestFont();
+        if (!ensureGLView() || fontPath.empty())
+        {
+            MESSAGE("no display or font, skipped");
+            return;
+        }
+
+        TTFConfig config(fontPath, 20);
+        auto renderer = Director::getInstance()->getRenderer();
+        auto drawBatches = [&](const Color4B& secondColor) {
+            Label* labels[] = {Label::createWithTTF(config, "first label"), Label::createWithTTF(config, "second")};
+            labels[1]->setPosition(0.0f, 50.0f);
+            labels[1]->setTextColor(secondColor);
+
+            const auto drawnBatches = renderer->getDrawnBatches();
+            for (auto label : labels)
+                label->visit(renderer, Mat4::IDENTITY, Node::FLAGS_TRANSFORM_DIRTY);
+            renderer->render();
+            return renderer->getDrawnBatches() - drawnBatches;
+        };
+
+        SUBCASE("disabled")
+        {
+            CHECK_FALSE(Label::isBatchedRenderingEnabled());
+            CHECK_EQ(drawBatches(Color4B::WHITE), 2);
+        }
+
+        SUBCASE("same page and colors are merged")
+        {
+            Label::setBatchedRenderingEnabled(true);
+            CHECK_EQ(drawBatches(Color4B::WHITE), 1);
+            Label::setBatchedRenderingEnabled(false);
+        }
+
+        SUBCASE("different colors aren't")
+        {
+            Label::setBatchedRenderingEnabled(true);
+            CHECK_EQ(drawBatches(Color4B::RED), 2);
+            Label::setBatchedRenderingEnabled(false);
+        }
+    }
+}
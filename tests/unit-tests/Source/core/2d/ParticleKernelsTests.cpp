@@ -0,0 +1,247 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include <random>
+#include "2d/ParticleSystem.h"
+#include "TestUtils.h"
+
+#if defined(AX_SSE_INTRINSICS) && defined(__AVX2__)
+#    include <immintrin.h>
+#endif
+
+#if defined(AX_SSE_INTRINSICS) || (defined(AX_NEON_INTRINSICS) && (AX_64BITS || AX_NEON_INTRINSICS > 1))
+#    define SKIP_SIMD_TEST doctest::skip(false)
+#else
+#    define SKIP_SIMD_TEST doctest::skip(true)
+#endif
+
+using namespace ax;
+
+namespace UnitTest
+{
+
+#include "2d/ParticleKernels.inl"
+#if defined(AX_SSE_INTRINSICS)
+#    include "2d/ParticleKernelsSSE.inl"
+using ParticleKernelsSIMD = ParticleKernelsSSE;
+#elif defined(AX_NEON_INTRINSICS) && (AX_64BITS || AX_NEON_INTRINSICS > 1)
+#    include "2d/ParticleKernelsNeon.inl"
+using ParticleKernelsSIMD = ParticleKernelsNeon;
+#else
+using ParticleKernelsSIMD = ParticleKernelsC;
+#endif
+
+}  // namespace UnitTest
+
+// not multiples of the vector widths included, the tails go through the scalar kernels
+static const int PARTICLE_COUNTS[] = {1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, 100};
+
+static std::vector<float> randomValues(int count, float min, float max, unsigned int seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(min, max);
+    std::vector<float> values(count);
+    for (auto& value : values)
+        value = dist(rng);
+    return values;
+}
+
+static void checkValuesAreEqual(const float* expected, const float* actual, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        const float tolerance = 0.0001f * (std::max)(1.0f, std::abs(expected[i]));
+        CHECK_MESSAGE(std::abs(expected[i] - actual[i]) <= tolerance, "index ", i, " expected ", expected[i],
+                      " actual ", actual[i]);
+    }
+}
+
+TEST_SUITE("2d/ParticleKernels" * SKIP_SIMD_TEST)
+{
+    using namespace UnitTest;
+
+    TEST_CASE("updateLife")
+    {
+        for (auto count : PARTICLE_COUNTS)
+        {
+            CAPTURE(count);
+            auto values = randomValues(count, 0.1f, 2.0f, count);
+
+            SUBCASE("all alive")
+            {
+                auto expected = values;
+                auto actual   = values;
+                CHECK_EQ(ParticleKernelsC::updateLife(expected.data(), count, 0.05f), count);
+                CHECK_EQ(ParticleKernelsSIMD::updateLife(actual.data(), count, 0.05f), count);
+                checkValuesAreEqual(expected.data(), actual.data(), count);
+            }
+
+            SUBCASE("first dead")
+            {
+                // one dead particle at every position, the last one lands in the scalar tail
+                for (int dead = 0; dead < count; ++dead)
+                {
+                    auto expected  = values;
+                    expected[dead] = 0.01f;
+                    auto actual    = expected;
+                    CHECK_EQ(ParticleKernelsC::updateLife(expected.data(), count, 0.05f), dead);
+                    CHECK_EQ(ParticleKernelsSIMD::updateLife(actual.data(), count, 0.05f), dead);
+                    checkValuesAreEqual(expected.data(), actual.data(), count);
+                }
+            }
+        }
+    }
+
+    TEST_CASE("nextDead")
+    {
+        for (auto count : PARTICLE_COUNTS)
+        {
+            CAPTURE(count);
+            auto values = randomValues(count, 0.1f, 2.0f, count);
+            CHECK_EQ(ParticleKernelsSIMD::nextDead(values.data(), 0, count), count);
+
+            // two dead particles, the scan starts before, at and past the first one
+            for (int dead = 0; dead < count; ++dead)
+            {
+                auto timeToLive       = values;
+                timeToLive[dead]      = 0.0f;
+                timeToLive[count - 1] = -0.5f;
+                for (int begin : {0, dead, dead + 1})
+                {
+                    CAPTURE(begin);
+                    CHECK_EQ(ParticleKernelsSIMD::nextDead(timeToLive.data(), begin, count),
+                             ParticleKernelsC::nextDead(timeToLive.data(), begin, count));
+                }
+            }
+        }
+    }
+
+    TEST_CASE("integrate")
+    {
+        for (auto count : PARTICLE_COUNTS)
+        {
+            CAPTURE(count);
+            auto values = randomValues(count, -10.0f, 10.0f, count);
+            auto deltas = randomValues(count, -50.0f, 50.0f, count + 1);
+            auto limits = randomValues(count, -10.0f, 10.0f, count + 2);
+
+            auto expected = values;
+            auto actual   = values;
+            ParticleKernelsC::integrate(expected.data(), deltas.data(), count, 0.016f);
+            ParticleKernelsSIMD::integrate(actual.data(), deltas.data(), count, 0.016f);
+            checkValuesAreEqual(expected.data(), actual.data(), count);
+
+            // clamps to 0 for about half of the values
+            expected = values;
+            actual   = values;
+            ParticleKernelsC::integrateNonNegative(expected.data(), deltas.data(), count, 0.5f);
+            ParticleKernelsSIMD::integrateNonNegative(actual.data(), deltas.data(), count, 0.5f);
+            checkValuesAreEqual(expected.data(), actual.data(), count);
+
+            expected = values;
+            actual   = values;
+            ParticleKernelsC::advanceClamped(expected.data(), limits.data(), count, 0.5f);
+            ParticleKernelsSIMD::advanceClamped(actual.data(), limits.data(), count, 0.5f);
+            checkValuesAreEqual(expected.data(), actual.data(), count);
+        }
+    }
+
+    TEST_CASE("updateGravity")
+    {
+        const Vec2 gravity(3.0f, -98.0f);
+        for (auto count : PARTICLE_COUNTS)
+        {
+            CAPTURE(count);
+            ParticleData expected, actual;
+            REQUIRE(expected.init(count));
+            REQUIRE(actual.init(count));
+
+            auto posx            = randomValues(count, -100.0f, 100.0f, count);
+            auto posy            = randomValues(count, -100.0f, 100.0f, count + 1);
+            auto dirX            = randomValues(count, -20.0f, 20.0f, count + 2);
+            auto dirY            = randomValues(count, -20.0f, 20.0f, count + 3);
+            auto radialAccel     = randomValues(count, -30.0f, 30.0f, count + 4);
+            auto tangentialAccel = randomValues(count, -30.0f, 30.0f, count + 5);
+            // a particle at the emitter has no radial direction
+            posx[0] = posy[0] = 0.0f;
+            for (auto p : {&expected, &actual})
+            {
+                std::copy_n(posx.data(), count, p->posx);
+                std::copy_n(posy.data(), count, p->posy);
+                std::copy_n(dirX.data(), count, p->modeA.dirX);
+                std::copy_n(dirY.data(), count, p->modeA.dirY);
+                std::copy_n(radialAccel.data(), count, p->modeA.radialAccel);
+                std::copy_n(tangentialAccel.data(), count, p->modeA.tangentialAccel);
+            }
+
+            // the subranges start on a lane which isn't the first one of a vector
+            const int begin = count > 2 ? 1 : 0;
+            ParticleKernelsC::updateGravity(expected, begin, count, gravity, 0.016f, -1.0f);
+            ParticleKernelsSIMD::updateGravity(actual, begin, count, gravity, 0.016f, -1.0f);
+            checkValuesAreEqual(expected.posx, actual.posx, count);
+            checkValuesAreEqual(expected.posy, actual.posy, count);
+            checkValuesAreEqual(expected.modeA.dirX, actual.modeA.dirX, count);
+            checkValuesAreEqual(expected.modeA.dirY, actual.modeA.dirY, count);
+
+            expected.release();
+            actual.release();
+        }
+    }
+
+    TEST_CASE("updateRadius")
+    {
+        for (auto count : PARTICLE_COUNTS)
+        {
+            CAPTURE(count);
+            ParticleData expected, actual;
+            REQUIRE(expected.init(count));
+            REQUIRE(actual.init(count));
+
+            // every octant in both directions, and a few turns around
+            auto angle  = randomValues(count, -40.0f, 40.0f, count);
+            auto radius = randomValues(count, 0.0f, 300.0f, count + 1);
+            angle[0]    = 0.0f;
+            if (count > 4)
+                angle[4] = 10000.0f;  // past the polynomial range, the vector is done with cosf/sinf
+            for (auto p : {&expected, &actual})
+            {
+                std::copy_n(angle.data(), count, p->modeB.angle);
+                std::copy_n(radius.data(), count, p->modeB.radius);
+            }
+
+            const int begin = count > 2 ? 1 : 0;
+            for (float yFlip : {1.0f, -1.0f})
+            {
+                ParticleKernelsC::updateRadius(expected, begin, count, yFlip);
+                ParticleKernelsSIMD::updateRadius(actual, begin, count, yFlip);
+                checkValuesAreEqual(expected.posx + begin, actual.posx + begin, count - begin);
+                checkValuesAreEqual(expected.posy + begin, actual.posy + begin, count - begin);
+            }
+
+            expected.release();
+            actual.release();
+        }
+    }
+}
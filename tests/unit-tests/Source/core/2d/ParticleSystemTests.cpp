@@ -0,0 +1,128 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include <string.h>
+#include "2d/ParticleSystemQuad.h"
+#include "base/Director.h"
+#include "TestUtils.h"
+
+using namespace ax;
+
+namespace
+{
+class TestParticleSystem : public ParticleSystemQuad
+{
+public:
+    using ParticleSystem::_particleData;
+
+    static TestParticleSystem* create(uint64_t seed)
+    {
+        auto system = new TestParticleSystem();
+        if (!system->initWithTotalParticles(256))
+            return nullptr;
+        system->autorelease();
+        system->_rng.seed(seed);
+
+        system->setDuration(DURATION_INFINITY);
+        system->setLife(0.5f);
+        system->setLifeVar(0.25f);
+        system->setEmissionRate(300.0f);
+        system->setGravity(Vec2(0.0f, -50.0f));
+        system->setSpeed(100.0f);
+        system->setSpeedVar(30.0f);
+        system->setAngleVar(180.0f);
+        system->setPosVar(Vec2(10.0f, 10.0f));
+        system->setStartSize(4.0f);
+        system->setEndSize(1.0f);
+        return system;
+    }
+};
+
+bool isSameSimulation(TestParticleSystem* a, TestParticleSystem* b)
+{
+    const auto count = a->getParticleCount();
+    if (count != b->getParticleCount())
+        return false;
+    const auto& pa = a->_particleData;
+    const auto& pb = b->_particleData;
+    return memcmp(pa.posx, pb.posx, count * sizeof(float)) == 0 &&
+           memcmp(pa.posy, pb.posy, count * sizeof(float)) == 0 &&
+           memcmp(pa.timeToLive, pb.timeToLive, count * sizeof(float)) == 0 &&
+           memcmp(pa.size, pb.size, count * sizeof(float)) == 0;
+}
+}  // namespace
+
+TEST_SUITE("2d/ParticleSystem")
+{
+    TEST_CASE("parallel update")
+    {
+        if (!ensureGLView())
+        {
+            MESSAGE("no display, skipped");
+            return;
+        }
+
+        // FREE systems under a moved parent, so workers read the transforms settled before dispatch
+        const int count = 8;
+        auto serialParent   = Node::create();
+        auto parallelParent = Node::create();
+        serialParent->setPosition(100.0f, 50.0f);
+        parallelParent->setPosition(100.0f, 50.0f);
+
+        Vector<TestParticleSystem*> serial, parallel;
+        for (int i = 0; i < count; ++i)
+        {
+            serial.pushBack(TestParticleSystem::create(i + 1));
+            parallel.pushBack(TestParticleSystem::create(i + 1));
+            serialParent->addChild(serial.back());
+            parallelParent->addChild(parallel.back());
+        }
+
+        auto scheduler = Director::getInstance()->getScheduler();
+        const float dt = 1.0f / 60.0f;
+        for (int frame = 0; frame < 30; ++frame)
+        {
+            for (auto system : serial)
+                system->update(dt);
+
+            ParticleSystem::setParallelUpdateEnabled(true);
+            for (auto system : parallel)
+                system->update(dt);
+            ParticleSystem::setParallelUpdateEnabled(false);
+
+            // update() only recorded the systems, they're simulated at the end of the scheduler update
+            CAPTURE(frame);
+            if (frame == 0)
+                CHECK_EQ(parallel.front()->getParticleCount(), 0);
+            scheduler->update(0);
+
+            for (int i = 0; i < count; ++i)
+                CHECK(isSameSimulation(serial.at(i), parallel.at(i)));
+        }
+        CHECK(parallel.front()->getParticleCount() > 0);
+        CHECK_FALSE(ParticleSystem::isParallelUpdateEnabled());
+    }
+}
@@ -0,0 +1,273 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include <algorithm>
+#include <random>
+#include "base/Config.h"
+
+#if defined(AX_ENABLE_3D)
+
+#    include "2d/Camera.h"
+#    include "3d/AABBTree.h"
+
+using namespace ax;
+
+// at the origin, looking down -z
+static Frustum createFrustum(bool clipZ = true)
+{
+    Frustum frustum;
+    frustum.setClipZ(clipZ);
+    frustum.initFrustum(Camera::createPerspective(60.0f, 1.0f, 1.0f, 100.0f));
+    return frustum;
+}
+
+// boxes around the frustum, about half of them in it
+static std::vector<AABB> randomAABBs(int count, unsigned int seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-80.0f, 80.0f);
+    std::uniform_real_distribution<float> depth(-130.0f, 20.0f);
+    std::uniform_real_distribution<float> size(0.5f, 10.0f);
+
+    std::vector<AABB> aabbs;
+    aabbs.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        const Vec3 min(position(rng), position(rng), depth(rng));
+        aabbs.emplace_back(min, min + Vec3(size(rng), size(rng), size(rng)));
+    }
+    return aabbs;
+}
+
+static std::vector<int> queryTree(const AABBTree& tree, const Frustum& frustum)
+{
+    std::vector<int> visible;
+    tree.query(frustum, [&](void* userData) { visible.push_back(static_cast<int>(reinterpret_cast<intptr_t>(userData))); });
+    std::sort(visible.begin(), visible.end());
+    return visible;
+}
+
+// the leaves are culled by their fat aabb
+static std::vector<int> queryBruteForce(const AABBTree& tree,
+                                        const std::vector<int>& proxies,
+                                        const Frustum& frustum)
+{
+    std::vector<int> visible;
+    for (int i = 0; i < static_cast<int>(proxies.size()); ++i)
+    {
+        if (proxies[i] != AABBTree::NULL_NODE && !frustum.isOutOfFrustum(tree.getFatAABB(proxies[i])))
+            visible.push_back(i);
+    }
+    return visible;
+}
+
+static void* toUserData(int index)
+{
+    return reinterpret_cast<void*>(static_cast<intptr_t>(index));
+}
+
+
+TEST_SUITE("3d/Frustum") {
+    TEST_CASE("intersectAABB") {
+        for (bool clipZ : {true, false})
+        {
+            CAPTURE(clipZ);
+            const auto frustum = createFrustum(clipZ);
+            const uint32_t allPlanes = clipZ ? 0x3Fu : 0x0Fu;
+            REQUIRE(frustum.getPlaneMask() == allPlanes);
+
+            SUBCASE("same as isOutOfFrustum") {
+                for (auto& aabb : randomAABBs(1000, 1))
+                {
+                    auto mask = frustum.getPlaneMask();
+                    CHECK(frustum.intersectAABB(aabb, mask) == !frustum.isOutOfFrustum(aabb));
+                }
+            }
+
+
+            SUBCASE("plane mask") {
+                // fully inside, no plane left to test
+                auto mask = frustum.getPlaneMask();
+                CHECK(frustum.intersectAABB(AABB(Vec3(-1.0f, -1.0f, -51.0f), Vec3(1.0f, 1.0f, -49.0f)), mask));
+                CHECK(mask == 0);
+
+                // across the left plane only, about x = -28.87 at this depth
+                mask = frustum.getPlaneMask();
+                CHECK(frustum.intersectAABB(AABB(Vec3(-30.0f, -1.0f, -51.0f), Vec3(-28.0f, 1.0f, -49.0f)), mask));
+                CHECK(mask == 1u);
+
+                // behind the camera
+                if (clipZ)
+                {
+                    mask = frustum.getPlaneMask();
+                    CHECK(not frustum.intersectAABB(AABB(Vec3(-1.0f, -1.0f, 1.0f), Vec3(1.0f, 1.0f, 2.0f)), mask));
+                }
+            }
+
+
+            SUBCASE("children tested with the parent mask") {
+                // what a bounding volume hierarchy does, a box inside a parent gets the same answer with the
+                // planes left over by the parent as with all of them
+                std::mt19937 rng(2);
+                std::uniform_real_distribution<float> alpha(0.0f, 1.0f);
+                for (auto& parent : randomAABBs(500, 3))
+                {
+                    auto parentMask = frustum.getPlaneMask();
+                    if (!frustum.intersectAABB(parent, parentMask))
+                        continue;
+
+                    for (int i = 0; i < 4; ++i)
+                    {
+                        const Vec3 a = parent._min.lerp(parent._max, alpha(rng));
+                        const Vec3 b = parent._min.lerp(parent._max, alpha(rng));
+                        const AABB child(Vec3((std::min)(a.x, b.x), (std::min)(a.y, b.y), (std::min)(a.z, b.z)),
+                                         Vec3((std::max)(a.x, b.x), (std::max)(a.y, b.y), (std::max)(a.z, b.z)));
+
+                        auto childMask = parentMask;
+                        auto fullMask  = frustum.getPlaneMask();
+                        CHECK(frustum.intersectAABB(child, childMask) == frustum.intersectAABB(child, fullMask));
+                        CHECK((childMask & ~parentMask) == 0);
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+TEST_SUITE("3d/AABBTree") {
+    TEST_CASE("insert,query") {
+        AABBTree tree;
+        CHECK(tree.empty());
+
+        const auto frustum = createFrustum();
+        const auto aabbs   = randomAABBs(300, 4);
+        std::vector<int> proxies;
+        for (int i = 0; i < static_cast<int>(aabbs.size()); ++i)
+        {
+            proxies.push_back(tree.createProxy(aabbs[i], toUserData(i)));
+            CHECK(tree.getUserData(proxies.back()) == toUserData(i));
+        }
+
+        CHECK(not tree.empty());
+        // balanced, 300 leaves fit in a height of 9
+        CHECK(tree.getHeight() < 20);
+
+        auto visible = queryTree(tree, frustum);
+        CHECK(not visible.empty());
+        CHECK(visible.size() < aabbs.size());
+        CHECK(visible == queryBruteForce(tree, proxies, frustum));
+
+        // the fat aabbs contain the original ones
+        for (int i = 0; i < static_cast<int>(aabbs.size()); ++i)
+        {
+            auto& fat = tree.getFatAABB(proxies[i]);
+            CHECK(fat.containPoint(aabbs[i]._min));
+            CHECK(fat.containPoint(aabbs[i]._max));
+        }
+
+        SUBCASE("frustum not initialized") {
+            CHECK(queryTree(tree, Frustum()).size() == aabbs.size());
+        }
+    }
+
+
+    TEST_CASE("moveProxy") {
+        AABBTree tree;
+        const auto frustum = createFrustum();
+        auto aabbs         = randomAABBs(200, 5);
+        std::vector<int> proxies;
+        for (int i = 0; i < static_cast<int>(aabbs.size()); ++i)
+            proxies.push_back(tree.createProxy(aabbs[i], toUserData(i)));
+
+        // within the fat aabb, the tree isn't touched
+        {
+            const AABB fat = tree.getFatAABB(proxies[0]);
+            AABB moved(aabbs[0]);
+            const Vec3 offset = (aabbs[0]._max - aabbs[0]._min) * 0.05f;
+            moved._min += offset;
+            moved._max += offset;
+            CHECK(not tree.moveProxy(proxies[0], moved));
+            CHECK(tree.getFatAABB(proxies[0])._min == fat._min);
+            CHECK(tree.getFatAABB(proxies[0])._max == fat._max);
+        }
+
+        // everything moves through the frustum
+        std::mt19937 rng(6);
+        std::uniform_real_distribution<float> offset(-40.0f, 40.0f);
+        for (int frame = 0; frame < 10; ++frame)
+        {
+            for (int i = 0; i < static_cast<int>(aabbs.size()); ++i)
+            {
+                const Vec3 delta(offset(rng), offset(rng), offset(rng));
+                aabbs[i]._min += delta;
+                aabbs[i]._max += delta;
+                CHECK(tree.moveProxy(proxies[i], aabbs[i]));
+                CHECK(tree.getFatAABB(proxies[i]).containPoint(aabbs[i]._min));
+                CHECK(tree.getFatAABB(proxies[i]).containPoint(aabbs[i]._max));
+                CHECK(tree.getUserData(proxies[i]) == toUserData(i));
+            }
+            CHECK(queryTree(tree, frustum) == queryBruteForce(tree, proxies, frustum));
+        }
+        CHECK(tree.getHeight() < 20);
+    }
+
+
+    TEST_CASE("destroyProxy") {
+        AABBTree tree;
+        const auto frustum = createFrustum();
+        const auto aabbs   = randomAABBs(200, 7);
+        std::vector<int> proxies;
+        for (int i = 0; i < static_cast<int>(aabbs.size()); ++i)
+            proxies.push_back(tree.createProxy(aabbs[i], toUserData(i)));
+
+        // every other one
+        for (int i = 0; i < static_cast<int>(proxies.size()); i += 2)
+        {
+            tree.destroyProxy(proxies[i]);
+            proxies[i] = AABBTree::NULL_NODE;
+        }
+        auto visible = queryTree(tree, frustum);
+        CHECK(visible == queryBruteForce(tree, proxies, frustum));
+        CHECK(std::none_of(visible.begin(), visible.end(), [](int i) { return i % 2 == 0; }));
+
+        // the nodes of the removed leaves are reused, 200 leaves took 399 nodes
+        const int reused = tree.createProxy(aabbs[0], toUserData(0));
+        CHECK(reused < static_cast<int>(aabbs.size()) * 2 - 1);
+        proxies[0] = reused;
+        CHECK(queryTree(tree, frustum) == queryBruteForce(tree, proxies, frustum));
+
+        for (auto& proxy : proxies)
+        {
+            if (proxy != AABBTree::NULL_NODE)
+                tree.destroyProxy(proxy);
+        }
+        CHECK(tree.empty());
+        CHECK(queryTree(tree, frustum).empty());
+    }
+}
+
+#endif
@@ -0,0 +1,239 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include <random>
+#include "base/Config.h"
+
+#if defined(AX_ENABLE_3D)
+
+#    include "3d/Animation3D.h"
+#    include "3d/Bundle3DData.h"
+
+using namespace ax;
+
+// uneven key spacing, so the binary search and the cursor don't trivially agree
+static std::vector<float> createKeyTimes(int count)
+{
+    std::mt19937 rng(count);
+    std::uniform_real_distribution<float> dist(0.1f, 1.0f);
+    std::vector<float> keys(count);
+    for (int i = 1; i < count; ++i)
+        keys[i] = keys[i - 1] + dist(rng);
+    for (auto& key : keys)
+        key /= keys.back();
+    return keys;
+}
+
+static bool isBracketed(const std::vector<float>& keys, int index, float time)
+{
+    return index >= 0 && index + 1 < static_cast<int>(keys.size()) && keys[index] <= time &&
+           time <= keys[index + 1];
+}
+
+static void checkCursor(const AnimationCurve<3>* curve, const std::vector<float>& keys, float time, int& cursor)
+{
+    CAPTURE(time);
+    CAPTURE(cursor);
+    const int expected = curve->determineIndex(time);
+    const int actual   = curve->determineIndex(time, cursor);
+    CHECK(isBracketed(keys, actual, time));
+    // both are valid on a key time shared by two intervals
+    if (actual != expected)
+        CHECK(time == keys[actual + (actual < expected ? 1 : 0)]);
+    cursor = actual;
+}
+
+TEST_SUITE("3d/AnimationCurve")
+{
+    TEST_CASE("determineIndex with a cursor")
+    {
+        const int count = 23;
+        auto keys       = createKeyTimes(count);
+        std::vector<float> values(count * 3);
+        auto curve = AnimationCurve<3>::create(keys.data(), values.data(), count);
+
+        SUBCASE("forward")
+        {
+            int cursor = -1;
+            for (float time = 0.0f; time < 1.0f; time += 0.0037f)
+                checkCursor(curve, keys, time, cursor);
+        }
+
+        SUBCASE("reverse")
+        {
+            int cursor = -1;
+            for (float time = 1.0f; time > 0.0f; time -= 0.0037f)
+                checkCursor(curve, keys, time, cursor);
+        }
+
+        SUBCASE("seek")
+        {
+            // random jumps land far from the cursor, which falls back to the binary search
+            std::mt19937 rng(7);
+            std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+            int cursor = -1;
+            for (int i = 0; i < 200; ++i)
+                checkCursor(curve, keys, dist(rng), cursor);
+        }
+
+        SUBCASE("key times")
+        {
+            int cursor = -1;
+            for (int i = 0; i + 1 < count; ++i)
+                checkCursor(curve, keys, keys[i], cursor);
+            for (int i = count - 1; i > 0; --i)
+                checkCursor(curve, keys, keys[i], cursor);
+        }
+
+        SUBCASE("out of range cursor")
+        {
+            for (int cursor : {-1, count - 1, count + 5})
+            {
+                int hint = cursor;
+                checkCursor(curve, keys, 0.5f, hint);
+            }
+        }
+    }
+
+    TEST_CASE("createQuantized")
+    {
+        const int count = 40;
+        auto keys       = createKeyTimes(count);
+
+        // one wide, one narrow and one constant component
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<float> wide(-500.0f, 1500.0f), narrow(0.25f, 0.75f);
+        std::vector<float> values(count * 3);
+        for (int i = 0; i < count; ++i)
+        {
+            values[i * 3]     = wide(rng);
+            values[i * 3 + 1] = narrow(rng);
+            values[i * 3 + 2] = 42.0f;
+        }
+
+        auto curve = AnimationCurve<3>::createQuantized(keys.data(), values.data(), count);
+        REQUIRE(curve);
+        CHECK_EQ(curve->getKeyCount(), count);
+
+        float tolerance[3];
+        for (int c = 0; c < 3; ++c)
+        {
+            float minValue = values[c], maxValue = values[c];
+            for (int i = 1; i < count; ++i)
+            {
+                minValue = std::min(minValue, values[i * 3 + c]);
+                maxValue = std::max(maxValue, values[i * 3 + c]);
+            }
+            // half a quantization step, plus float rounding of the decode
+            tolerance[c] = (maxValue - minValue) / 131070.0f + std::abs(maxValue) * 1e-6f;
+        }
+
+        // INT_NEAR returns the decoded key itself at a key time
+        for (int i = 0; i < count; ++i)
+        {
+            CAPTURE(i);
+            float key[3];
+            curve->evaluate(keys[i], key, EvaluateType::INT_NEAR);
+            for (int c = 0; c < 3; ++c)
+            {
+                CAPTURE(c);
+                CHECK(std::abs(key[c] - values[i * 3 + c]) <= tolerance[c]);
+            }
+            CHECK_EQ(key[2], 42.0f);
+        }
+    }
+}
+
+TEST_SUITE("3d/Animation3D")
+{
+    TEST_CASE("init")
+    {
+        const Vec3 position(1.0f, 2.0f, 3.0f);
+        Animation3DData data;
+        data._totalTime = 1.0f;
+        for (float time : {0.0f, 0.5f, 1.0f})
+        {
+            data._translationKeys["constant"].emplace_back(time, position);
+            data._translationKeys["moving"].emplace_back(time, position * (time * 100.0f));
+            data._rotationKeys["constant"].emplace_back(time, Quaternion::identity());
+        }
+
+        SUBCASE("constant channels collapse to a single key")
+        {
+            auto animation = new Animation3D();
+            REQUIRE(animation->init(data));
+
+            auto constant = animation->getBoneCurveByName("constant");
+            REQUIRE(constant);
+            REQUIRE(constant->translateCurve);
+            REQUIRE(constant->rotCurve);
+            CHECK_EQ(constant->translateCurve->getKeyCount(), 1);
+            CHECK_EQ(constant->rotCurve->getKeyCount(), 1);
+            CHECK_FALSE(constant->scaleCurve);
+
+            for (float time : {0.0f, 0.3f, 1.0f})
+            {
+                Vec3 value;
+                constant->translateCurve->evaluate(time, &value.x, EvaluateType::INT_LINEAR);
+                CHECK_EQ(value, position);
+            }
+
+            auto moving = animation->getBoneCurveByName("moving");
+            REQUIRE(moving);
+            REQUIRE(moving->translateCurve);
+            CHECK_EQ(moving->translateCurve->getKeyCount(), 3);
+            Vec3 value;
+            moving->translateCurve->evaluate(0.25f, &value.x, EvaluateType::INT_LINEAR);
+            CHECK(value.distance(position * 25.0f) < 1e-4f);
+
+            animation->release();
+        }
+
+        SUBCASE("quantized keys")
+        {
+            Animation3D::setKeyQuantizationEnabled(true);
+            auto animation = new Animation3D();
+            const bool initialized = animation->init(data);
+            Animation3D::setKeyQuantizationEnabled(false);
+            REQUIRE(initialized);
+
+            // the single key of a constant channel is never quantized
+            Vec3 value;
+            animation->getBoneCurveByName("constant")->translateCurve->evaluate(0.3f, &value.x,
+                                                                               EvaluateType::INT_LINEAR);
+            CHECK_EQ(value, position);
+
+            auto moving = animation->getBoneCurveByName("moving")->translateCurve;
+            CHECK_EQ(moving->getKeyCount(), 3);
+            moving->evaluate(0.5f, &value.x, EvaluateType::INT_LINEAR);
+            CHECK(value.distance(position * 50.0f) <= 300.0f / 131070.0f * 2.0f);
+
+            animation->release();
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,313 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include <thread>
+#include "base/Config.h"
+
+#if defined(AX_ENABLE_3D)
+
+#    include "3d/Bundle3D.h"
+#    include "3d/MeshRenderer.h"
+#    include "base/Director.h"
+#    include "platform/FileUtils.h"
+#    include "platform/Image.h"
+#    include "renderer/TextureCache.h"
+#    include "TestUtils.h"
+
+using namespace ax;
+
+namespace
+{
+// writes the little endian c3b layout read by Bundle3D::loadBinary
+class C3BWriter
+{
+public:
+    void u32(uint32_t value) { append(&value, sizeof(value)); }
+    void u16(uint16_t value) { append(&value, sizeof(value)); }
+    void f32(float value) { append(&value, sizeof(value)); }
+    void string(std::string_view value)
+    {
+        u32(static_cast<uint32_t>(value.size()));
+        append(value.data(), value.size());
+    }
+    void matrix(const Mat4& value) { append(value.m, sizeof(value.m)); }
+    void append(const void* data, size_t size)
+    {
+        auto bytes = static_cast<const uint8_t*>(data);
+        _buffer.insert(_buffer.end(), bytes, bytes + size);
+    }
+
+    std::vector<uint8_t>& buffer() { return _buffer; }
+
+private:
+    std::vector<uint8_t> _buffer;
+};
+
+// 2 quads with position and uv, 2 materials sharing a texture, 2 nodes
+std::vector<uint8_t> createSampleC3B(std::string_view texture)
+{
+    C3BWriter meshes;
+    meshes.u32(2);
+    for (int mesh = 0; mesh < 2; ++mesh)
+    {
+        meshes.u32(2);
+        meshes.u32(3);
+        meshes.string("GL_FLOAT");
+        meshes.string("VERTEX_ATTRIB_POSITION");
+        meshes.u32(2);
+        meshes.string("GL_FLOAT");
+        meshes.string("VERTEX_ATTRIB_TEX_COORD");
+
+        meshes.u32(4 * 5);
+        for (int v = 0; v < 4; ++v)
+        {
+            const float x = float(v & 1), y = float(v >> 1);
+            for (float value : {x + mesh, y, 0.0f, x, y})
+                meshes.f32(value);
+        }
+
+        meshes.u32(1);
+        meshes.string(mesh == 0 ? "part0" : "part1");
+        meshes.u32(6);
+        for (uint16_t index : {0, 1, 2, 3, 2, 1})
+            meshes.u16(index);
+        for (float value : {float(mesh), 0.0f, 0.0f, mesh + 1.0f, 1.0f, 0.0f})
+            meshes.f32(value);
+    }
+
+    C3BWriter materials;
+    materials.u32(2);
+    for (auto id : {"material0", "material1"})
+    {
+        materials.string(id);
+        for (int i = 0; i < 14; ++i)
+            materials.f32(1.0f);
+        materials.u32(1);
+        materials.string("diffuse");
+        materials.string(texture);
+        for (float value : {0.0f, 0.0f, 1.0f, 1.0f})
+            materials.f32(value);
+        materials.string("DIFFUSE");
+        materials.string("CLAMP");
+        materials.string("CLAMP");
+    }
+
+    C3BWriter nodes;
+    nodes.u32(2);
+    for (int node = 0; node < 2; ++node)
+    {
+        Mat4 transform;
+        Mat4::createTranslation(node * 10.0f, 0.0f, 0.0f, &transform);
+        nodes.string(node == 0 ? "node0" : "node1");
+        nodes.append("\0", 1);  // not a skeleton
+        nodes.matrix(transform);
+        nodes.u32(1);
+        nodes.string(node == 0 ? "part0" : "part1");
+        nodes.string(node == 0 ? "material0" : "material1");
+        nodes.u32(0);  // bones
+        nodes.u32(0);  // uv mappings
+        nodes.u32(0);  // children
+    }
+
+    // version 0.9, then the reference table pointing at the sections
+    const std::pair<const char*, uint32_t> references[] = {{"meshes", 34}, {"materials", 16}, {"nodes", 2}};
+    C3BWriter header;
+    header.append("C3B\0", 4);
+    header.append("\x00\x09", 2);
+    header.u32(3);
+    size_t headerSize = header.buffer().size();
+    for (auto& reference : references)
+        headerSize += 4 + strlen(reference.first) + 8;
+
+    uint32_t offset = static_cast<uint32_t>(headerSize);
+    C3BWriter* sections[] = {&meshes, &materials, &nodes};
+    for (int i = 0; i < 3; ++i)
+    {
+        header.string(references[i].first);
+        header.u32(references[i].second);
+        header.u32(offset);
+        offset += static_cast<uint32_t>(sections[i]->buffer().size());
+    }
+    for (auto section : sections)
+        header.append(section->buffer().data(), section->buffer().size());
+    return std::move(header.buffer());
+}
+
+std::string writeSampleFiles()
+{
+    auto fu   = FileUtils::getInstance();
+    auto path = fu->getWritablePath();
+
+    uint8_t pixels[2 * 2 * 4];
+    memset(pixels, 0xff, sizeof(pixels));
+    Image image;
+    if (!image.initWithRawData(pixels, sizeof(pixels), 2, 2, 8) || !image.saveToFile(path + "__bundle3d_test.png", false))
+        return {};
+
+    auto model = createSampleC3B("__bundle3d_test.png");
+    Data data;
+    data.copy(model.data(), model.size());
+    return fu->writeDataToFile(data, path + "__bundle3d_test.c3b") ? path + "__bundle3d_test.c3b" : std::string{};
+}
+
+void removeSampleFiles()
+{
+    auto fu   = FileUtils::getInstance();
+    auto path = fu->getWritablePath();
+    fu->removeFile(path + "__bundle3d_test.c3b");
+    fu->removeFile(path + "__bundle3d_test.png");
+}
+
+struct ModelDatas
+{
+    MeshDatas meshes;
+    MaterialDatas materials;
+    NodeDatas nodes;
+    std::vector<std::string> textures;
+};
+
+bool loadModelDatas(std::string_view path, bool parallel, ModelDatas& datas)
+{
+    const bool enabled = Bundle3D::isParallelDecodeEnabled();
+    Bundle3D::setParallelDecodeEnabled(parallel);
+    auto bundle = Bundle3D::createBundle();
+    bool result = bundle->load(path) &&
+                  bundle->loadModelDatas(datas.meshes, datas.materials, datas.nodes, [&datas](std::string_view texture) {
+        datas.textures.emplace_back(texture);
+    });
+    Bundle3D::destroyBundle(bundle);
+    Bundle3D::setParallelDecodeEnabled(enabled);
+    return result;
+}
+}  // namespace
+
+TEST_SUITE("3d/Bundle3D")
+{
+    TEST_CASE("loadModelDatas")
+    {
+        auto path = writeSampleFiles();
+        REQUIRE(!path.empty());
+
+        ModelDatas serial, parallel;
+        REQUIRE(loadModelDatas(path, false, serial));
+        REQUIRE(loadModelDatas(path, true, parallel));
+
+        REQUIRE_EQ(serial.meshes.meshDatas.size(), 2);
+        REQUIRE_EQ(parallel.meshes.meshDatas.size(), 2);
+        for (size_t i = 0; i < 2; ++i)
+        {
+            CAPTURE(i);
+            auto expected = serial.meshes.meshDatas[i];
+            auto actual   = parallel.meshes.meshDatas[i];
+            CHECK_EQ(expected->attribs.size(), 2);
+            CHECK_EQ(actual->attribs.size(), expected->attribs.size());
+            CHECK_EQ(expected->vertex.size(), 20);
+            CHECK(actual->vertex == expected->vertex);
+            CHECK(actual->subMeshIds == expected->subMeshIds);
+            REQUIRE_EQ(expected->subMeshIndices.size(), 1);
+            REQUIRE_EQ(actual->subMeshIndices.size(), 1);
+            CHECK_EQ(expected->subMeshIndices[0].size(), 6);
+            CHECK_EQ(actual->subMeshIndices[0].bsize(), expected->subMeshIndices[0].bsize());
+            CHECK(memcmp(actual->subMeshIndices[0].data(), expected->subMeshIndices[0].data(),
+                         expected->subMeshIndices[0].bsize()) == 0);
+        }
+
+        REQUIRE_EQ(serial.materials.materials.size(), 2);
+        REQUIRE_EQ(parallel.materials.materials.size(), 2);
+        for (size_t i = 0; i < 2; ++i)
+        {
+            CAPTURE(i);
+            auto& expected = serial.materials.materials[i];
+            auto& actual   = parallel.materials.materials[i];
+            CHECK_EQ(actual.id, expected.id);
+            REQUIRE_EQ(actual.textures.size(), 1);
+            CHECK_EQ(actual.textures[0].filename, expected.textures[0].filename);
+        }
+
+        REQUIRE_EQ(serial.nodes.nodes.size(), 2);
+        REQUIRE_EQ(parallel.nodes.nodes.size(), 2);
+        for (size_t i = 0; i < 2; ++i)
+        {
+            CAPTURE(i);
+            auto expected = serial.nodes.nodes[i];
+            auto actual   = parallel.nodes.nodes[i];
+            CHECK_EQ(actual->id, expected->id);
+            CHECK(memcmp(actual->transform.m, expected->transform.m, sizeof(Mat4::m)) == 0);
+            REQUIRE_EQ(actual->modelNodeDatas.size(), 1);
+            CHECK_EQ(actual->modelNodeDatas[0]->subMeshId, expected->modelNodeDatas[0]->subMeshId);
+            CHECK_EQ(actual->modelNodeDatas[0]->materialId, expected->modelNodeDatas[0]->materialId);
+        }
+
+        // the texture shared by both materials is reported once
+        REQUIRE_EQ(serial.textures.size(), 1);
+        CHECK_EQ(parallel.textures, serial.textures);
+        CHECK_EQ(serial.textures[0], serial.materials.materials[0].textures[0].filename);
+
+        removeSampleFiles();
+    }
+}
+
+TEST_SUITE("3d/MeshRenderer")
+{
+    TEST_CASE("createAsync with canceled texture callbacks")
+    {
+        if (!ensureGLView())
+        {
+            MESSAGE("no display, skipped");
+            return;
+        }
+
+        auto path = writeSampleFiles();
+        REQUIRE(!path.empty());
+
+        auto director     = Director::getInstance();
+        auto textureCache = director->getTextureCache();
+        bool loaded       = false;
+        MeshRenderer* meshRenderer = nullptr;
+        MeshRenderer::createAsync(path, [&](MeshRenderer* result, void*) {
+            loaded       = true;
+            meshRenderer = result;
+        }, nullptr);
+
+        // anyone can unbind the pending image callbacks while the model loads, which must not stall it
+        for (int i = 0; i < 5000 && !loaded; ++i)
+        {
+            director->getScheduler()->update(0);
+            textureCache->unbindAllImageAsync();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        REQUIRE(loaded);
+        REQUIRE(meshRenderer);
+        CHECK_EQ(meshRenderer->getMeshCount(), 2);
+        CHECK(textureCache->getTextureForKey(FileUtils::getInstance()->getWritablePath() + "__bundle3d_test.png"));
+
+        MeshRendererCache::getInstance()->removeMeshRenderData(path);
+        textureCache->removeUnusedTextures();
+        removeSampleFiles();
+    }
+}
+
+#endif
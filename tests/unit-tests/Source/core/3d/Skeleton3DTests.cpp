@@ -0,0 +1,221 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include <algorithm>
+#include "base/Config.h"
+
+#if defined(AX_ENABLE_3D)
+
+#    include "3d/MeshSkin.h"
+#    include "3d/Skeleton3D.h"
+
+using namespace ax;
+
+namespace
+{
+class TestSkeleton : public Skeleton3D
+{
+public:
+    using Skeleton3D::_sortedBones;
+    using Skeleton3D::_sortedBonesDirty;
+
+    void addRoot(const NodeData& data)
+    {
+        auto bone = createBone3D(data);
+        bone->resetPose();
+        _rootBones.pushBack(bone);
+    }
+};
+}  // namespace
+
+static NodeData* createNode(std::string_view id, float x, std::initializer_list<NodeData*> children = {})
+{
+    auto node = new NodeData();
+    node->id  = id;
+    Mat4::createTranslation(x, 0.0f, 0.0f, &node->transform);
+    node->children = children;
+    return node;
+}
+
+// root(1) -> a(10) -> a1(100)
+//         -> b(1000)
+static TestSkeleton* createSkeleton()
+{
+    std::unique_ptr<NodeData> root(createNode("root", 1.0f,
+        {createNode("a", 10.0f, {createNode("a1", 100.0f)}), createNode("b", 1000.0f)}));
+
+    auto skeleton = new TestSkeleton();
+    skeleton->addRoot(*root);
+    return skeleton;
+}
+
+static ptrdiff_t sortedIndex(const TestSkeleton* skeleton, const Bone3D* bone)
+{
+    auto& sorted = skeleton->_sortedBones;
+    auto it      = std::find(sorted.begin(), sorted.end(), bone);
+    return it == sorted.end() ? -1 : it - sorted.begin();
+}
+
+// each bone is evaluated once, after its parent
+static void checkSortedBones(const TestSkeleton* skeleton, size_t boneCount)
+{
+    REQUIRE(skeleton->_sortedBones.size() == boneCount);
+    for (auto bone : skeleton->_sortedBones)
+    {
+        CHECK(std::count(skeleton->_sortedBones.begin(), skeleton->_sortedBones.end(), bone) == 1);
+        if (auto parent = bone->getParentBone())
+            CHECK(sortedIndex(skeleton, parent) < sortedIndex(skeleton, bone));
+    }
+}
+
+static float worldX(Bone3D* bone)
+{
+    return bone->getWorldMat().m[12];
+}
+
+
+TEST_SUITE("3d/Skeleton3D") {
+    TEST_CASE("sortBones") {
+        auto skeleton = createSkeleton();
+        auto root     = skeleton->getBoneByName("root");
+        auto a        = skeleton->getBoneByName("a");
+        auto a1       = skeleton->getBoneByName("a1");
+        auto b        = skeleton->getBoneByName("b");
+        REQUIRE(skeleton->getBoneCount() == 4);
+        CHECK(skeleton->_sortedBonesDirty);
+
+        skeleton->updateBoneMatrix();
+        CHECK(not skeleton->_sortedBonesDirty);
+        checkSortedBones(skeleton, 4);
+        CHECK(sortedIndex(skeleton, root) == 0);
+        CHECK(worldX(root) == 1.0f);
+        CHECK(worldX(a) == 11.0f);
+        CHECK(worldX(a1) == 111.0f);
+        CHECK(worldX(b) == 1001.0f);
+
+        SUBCASE("addChildBone") {
+            auto c = Bone3D::create("c");
+            Mat4 pose;
+            Mat4::createTranslation(10000.0f, 0.0f, 0.0f, &pose);
+            c->setOriPose(pose);
+            c->resetPose();
+
+            b->addChildBone(c);
+            CHECK(c->getParentBone() == b);
+            CHECK(skeleton->_sortedBonesDirty);
+
+            skeleton->updateBoneMatrix();
+            checkSortedBones(skeleton, 5);
+            CHECK(sortedIndex(skeleton, c) > sortedIndex(skeleton, b));
+            CHECK(worldX(c) == 11001.0f);
+
+            // already a child, nothing to sort
+            b->addChildBone(c);
+            CHECK(not skeleton->_sortedBonesDirty);
+            CHECK(b->getChildBoneCount() == 1);
+        }
+
+        SUBCASE("removeChildBone") {
+            a1->retain();
+            a->removeChildBone(a1);
+            CHECK(a1->getParentBone() == nullptr);
+            CHECK(skeleton->_sortedBonesDirty);
+
+            skeleton->updateBoneMatrix();
+            checkSortedBones(skeleton, 3);
+            CHECK(sortedIndex(skeleton, a1) == -1);
+
+            // not a child anymore
+            skeleton->updateBoneMatrix();
+            a->removeChildBone(a1);
+            CHECK(not skeleton->_sortedBonesDirty);
+            a1->release();
+        }
+
+        SUBCASE("removeChildBoneByIndex") {
+            root->removeChildBoneByIndex(0);
+            CHECK(skeleton->_sortedBonesDirty);
+
+            skeleton->updateBoneMatrix();
+            checkSortedBones(skeleton, 2);
+            CHECK(sortedIndex(skeleton, b) == 1);
+        }
+
+        SUBCASE("removeAllChildBone") {
+            root->removeAllChildBone();
+            CHECK(skeleton->_sortedBonesDirty);
+
+            skeleton->updateBoneMatrix();
+            checkSortedBones(skeleton, 1);
+        }
+
+        SUBCASE("removeAllBones") {
+            skeleton->removeAllBones();
+            skeleton->updateBoneMatrix();
+            CHECK(skeleton->_sortedBones.empty());
+        }
+
+        skeleton->release();
+    }
+}
+
+
+TEST_SUITE("3d/MeshSkin") {
+    TEST_CASE("getMatrixPalette") {
+        auto skeleton = createSkeleton();
+        auto a        = skeleton->getBoneByName("a");
+        skeleton->updateBoneMatrix();
+
+        auto skin = MeshSkin::create(skeleton, {"a", "b"}, {Mat4::IDENTITY, Mat4::IDENTITY});
+        skin->retain();
+        REQUIRE(skin->getMatrixPaletteSize() == 6);
+        CHECK(skin->getMatrixPaletteSizeInBytes() == 6 * sizeof(Vec4));
+
+        // 3 rows per bone, the translation is in w
+        auto palette = skin->getMatrixPalette();
+        CHECK(palette[0] == Vec4(1.0f, 0.0f, 0.0f, 11.0f));
+        CHECK(palette[1] == Vec4(0.0f, 1.0f, 0.0f, 0.0f));
+        CHECK(palette[2] == Vec4(0.0f, 0.0f, 1.0f, 0.0f));
+        CHECK(palette[3].w == 1001.0f);
+
+        SUBCASE("cached until the skeleton is updated") {
+            Mat4 pose;
+            Mat4::createTranslation(20.0f, 0.0f, 0.0f, &pose);
+            a->setOriPose(pose);
+            a->resetPose();
+            CHECK(skin->getMatrixPalette()[0].w == 11.0f);
+
+            skeleton->updateBoneMatrix();
+            CHECK(skin->getMatrixPalette()[0].w == 21.0f);
+            CHECK(skin->getMatrixPalette()[3].w == 1001.0f);
+        }
+
+        skin->release();
+        skeleton->release();
+    }
+}
+
+#endif  // defined(AX_ENABLE_3D)
@@ -0,0 +1,217 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include <thread>
+#include "audio/AudioEngine.h"
+#include "base/Director.h"
+#include "platform/FileUtils.h"
+#include "TestUtils.h"
+
+#if defined(AX_ENABLE_AUDIO)
+
+using namespace ax;
+
+// one second of 16 bits mono silence
+static constexpr size_t PCM_BYTES = 44100 * 2;
+
+static std::string writeWav(std::string_view name, int seconds = 1)
+{
+    const auto pcmBytes = PCM_BYTES * seconds;
+    auto file = FileUtils::getInstance()->getWritablePath().append(name);
+
+    auto le = [](std::string& out, uint32_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i)
+            out += static_cast<char>((value >> (8 * i)) & 0xff);
+    };
+    std::string wav = "RIFF";
+    le(wav, static_cast<uint32_t>(36 + pcmBytes), 4);
+    wav += "WAVEfmt ";
+    le(wav, 16, 4);         // fmt chunk size
+    le(wav, 1, 2);          // PCM
+    le(wav, 1, 2);          // channels
+    le(wav, 44100, 4);      // sample rate
+    le(wav, 44100 * 2, 4);  // byte rate
+    le(wav, 2, 2);          // block align
+    le(wav, 16, 2);         // bits per sample
+    wav += "data";
+    le(wav, static_cast<uint32_t>(pcmBytes), 4);
+    wav.append(pcmBytes, '\0');
+
+    return FileUtils::getInstance()->writeStringToFile(wav, file) ? file : std::string{};
+}
+
+static bool preloadAndWait(std::string_view file)
+{
+    AsyncRunner<bool> runner;
+    AudioEngine::preload(file, [&](bool isSuccess) { runner.finish(isSuccess); });
+    return runner();
+}
+
+// runs the audio engine update, scheduled every 0.05s
+static void updateFor(std::chrono::milliseconds duration, const std::function<bool()>& done = nullptr)
+{
+    auto scheduler   = Director::getInstance()->getScheduler();
+    const auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < duration && !(done && done()))
+    {
+        scheduler->update(0.05f);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+// served without decoding again, touches the cache
+static bool isCached(std::string_view file)
+{
+    const auto misses = AudioEngine::getCacheStats().misses;
+    REQUIRE(preloadAndWait(file));
+    return AudioEngine::getCacheStats().misses == misses;
+}
+
+
+TEST_SUITE("audio/AudioEngine") {
+    TEST_CASE("cache budget") {
+        if (!AudioEngine::lazyInit())
+        {
+            MESSAGE("no audio device, skipped");
+            return;
+        }
+
+        auto fu                = FileUtils::getInstance();
+        const auto savedBudget = AudioEngine::getCacheBudget();
+        const auto a           = writeWav("__test_a.wav");
+        const auto b           = writeWav("__test_b.wav");
+        const auto c           = writeWav("__test_c.wav");
+        REQUIRE(not a.empty());
+        REQUIRE(not b.empty());
+        REQUIRE(not c.empty());
+
+        AudioEngine::uncacheAll();
+        AudioEngine::setCacheBudget(0);
+        REQUIRE(preloadAndWait(a));
+        REQUIRE(preloadAndWait(b));
+        REQUIRE(preloadAndWait(c));
+        CHECK(AudioEngine::getCacheStats().bytes == 3 * PCM_BYTES);
+
+        const auto evictions = AudioEngine::getCacheStats().evictions;
+
+        SUBCASE("least recently used first") {
+            // b, c, a
+            REQUIRE(preloadAndWait(a));
+
+            AudioEngine::setCacheBudget(2 * PCM_BYTES + PCM_BYTES / 2);
+            CHECK(AudioEngine::getCacheStats().evictions == evictions + 1);
+            CHECK(AudioEngine::getCacheStats().bytes == 2 * PCM_BYTES);
+
+            // decoding b again evicts c, a was used since
+            CHECK(not isCached(b));
+            CHECK(AudioEngine::getCacheStats().evictions == evictions + 2);
+            CHECK(isCached(a));
+            CHECK(not isCached(c));
+        }
+
+
+        SUBCASE("caches in use by a player are kept") {
+            const auto audioID = AudioEngine::play2d(b, true, 0.0f);
+            REQUIRE(audioID != AudioEngine::INVALID_AUDIO_ID);
+
+            // b, a, c, b the least recently used is playing
+            REQUIRE(preloadAndWait(a));
+            REQUIRE(preloadAndWait(c));
+
+            AudioEngine::setCacheBudget(2 * PCM_BYTES + PCM_BYTES / 2);
+            CHECK(AudioEngine::getCacheStats().evictions == evictions + 1);
+            CHECK(isCached(b));
+            CHECK(isCached(c));
+            CHECK(not isCached(a));
+
+            // nothing else to evict, over budget until b stops
+            AudioEngine::setCacheBudget(1);
+            CHECK(isCached(b));
+
+            AudioEngine::stop(audioID);
+        }
+
+        AudioEngine::uncacheAll();
+        AudioEngine::setCacheBudget(savedBudget);
+        CHECK(fu->removeFile(a));
+        CHECK(fu->removeFile(b));
+        CHECK(fu->removeFile(c));
+    }
+
+
+    TEST_CASE("streaming") {
+        if (!AudioEngine::lazyInit())
+        {
+            MESSAGE("no audio device, skipped");
+            return;
+        }
+
+        auto fu                   = FileUtils::getInstance();
+        const auto savedThreshold = AudioEngine::getStreamingThreshold();
+        const auto shortFile      = writeWav("__test_short.wav", 1);
+        const auto longFile       = writeWav("__test_long.wav", 2);
+        REQUIRE(not shortFile.empty());
+        REQUIRE(not longFile.empty());
+
+        // both are streamed
+        AudioEngine::setStreamingThreshold(PCM_BYTES / 4);
+
+        // refilled together by the shared streaming thread
+        std::vector<AUDIO_ID> loops;
+        for (int i = 0; i < 4; ++i)
+        {
+            loops.push_back(AudioEngine::play2d(longFile, true, 0.0f));
+            REQUIRE(loops.back() != AudioEngine::INVALID_AUDIO_ID);
+        }
+
+        bool finished      = false;
+        const auto oneShot = AudioEngine::play2d(shortFile, false, 0.0f);
+        REQUIRE(oneShot != AudioEngine::INVALID_AUDIO_ID);
+        AudioEngine::setFinishCallback(oneShot, [&](AUDIO_ID, std::string_view) { finished = true; });
+
+        // stopped while the streaming thread refills them
+        updateFor(std::chrono::milliseconds(200));
+        AudioEngine::stop(loops[0]);
+        AudioEngine::stop(loops[1]);
+
+        // the one shot stream plays to its end, the loops never do
+        updateFor(std::chrono::seconds(5), [&] { return finished; });
+        CHECK(finished);
+        CHECK(AudioEngine::getState(loops[2]) == AudioEngine::AudioState::PLAYING);
+        CHECK(AudioEngine::getState(loops[3]) == AudioEngine::AudioState::PLAYING);
+
+        AudioEngine::stopAll();
+        updateFor(std::chrono::milliseconds(100));
+        CHECK(AudioEngine::getPlayingAudioCount() == 0);
+
+        AudioEngine::uncacheAll();
+        AudioEngine::setStreamingThreshold(savedThreshold);
+        CHECK(fu->removeFile(shortFile));
+        CHECK(fu->removeFile(longFile));
+    }
+}
+
+#endif
@@ -0,0 +1,276 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include "base/Scheduler.h"
+
+using namespace ax;
+
+// frame deltas and intervals are powers of two, the clock sums stay exact
+static constexpr float FRAME = 0.25f;
+
+static void advance(Scheduler* scheduler, int frames)
+{
+    for (int i = 0; i < frames; ++i)
+        scheduler->update(FRAME);
+}
+
+
+TEST_SUITE("base/Scheduler") {
+    TEST_CASE("interval") {
+        auto scheduler = new Scheduler();
+        int target     = 0;
+        std::vector<float> triggers;
+
+        scheduler->schedule([&](float dt) { triggers.push_back(dt); }, &target, 1.0f, false, "interval");
+
+        // the first update only starts the timer
+        advance(scheduler, 4);
+        CHECK(triggers.empty());
+        advance(scheduler, 1);
+        CHECK(triggers.size() == 1);
+
+        advance(scheduler, 8);
+        REQUIRE(triggers.size() == 3);
+        for (auto dt : triggers)
+            CHECK(dt == 1.0f);
+
+        scheduler->release();
+    }
+
+
+    TEST_CASE("every frame") {
+        auto scheduler = new Scheduler();
+        int target     = 0;
+        std::vector<float> triggers;
+
+        scheduler->schedule([&](float dt) { triggers.push_back(dt); }, &target, 0.0f, false, "frame");
+
+        advance(scheduler, 5);
+        REQUIRE(triggers.size() == 4);
+        for (auto dt : triggers)
+            CHECK(dt == FRAME);
+
+        scheduler->release();
+    }
+
+
+    TEST_CASE("repeat") {
+        auto scheduler = new Scheduler();
+        int target     = 0;
+        int triggers   = 0;
+
+        // runs repeat + 1 times
+        scheduler->schedule([&](float) { ++triggers; }, &target, 0.5f, 2, 0.0f, false, "repeat");
+
+        advance(scheduler, 6);
+        CHECK(triggers == 2);
+        CHECK(scheduler->isScheduled("repeat", &target));
+
+        advance(scheduler, 2);
+        CHECK(triggers == 3);
+        CHECK(not scheduler->isScheduled("repeat", &target));
+
+        advance(scheduler, 8);
+        CHECK(triggers == 3);
+
+        scheduler->release();
+    }
+
+
+    TEST_CASE("delay") {
+        auto scheduler = new Scheduler();
+        int target     = 0;
+        std::vector<float> triggers;
+
+        scheduler->schedule([&](float dt) { triggers.push_back(dt); }, &target, 0.5f, 1, 1.0f, false, "delay");
+
+        advance(scheduler, 4);
+        CHECK(triggers.empty());
+
+        // the delay, then the interval
+        advance(scheduler, 1);
+        REQUIRE(triggers.size() == 1);
+        CHECK(triggers[0] == 1.0f);
+
+        advance(scheduler, 2);
+        REQUIRE(triggers.size() == 2);
+        CHECK(triggers[1] == 0.5f);
+        CHECK(not scheduler->isScheduled("delay", &target));
+
+        scheduler->release();
+    }
+
+
+    TEST_CASE("pause,resume") {
+        auto scheduler = new Scheduler();
+        int target     = 0;
+        int triggersA  = 0;
+        int triggersB  = 0;
+
+        scheduler->schedule([&](float) { ++triggersA; }, &target, 1.0f, false, "a");
+
+        SUBCASE("paused time doesn't count") {
+            advance(scheduler, 3);
+            scheduler->pauseTarget(&target);
+            CHECK(scheduler->isTargetPaused(&target));
+            advance(scheduler, 8);
+            CHECK(triggersA == 0);
+
+            // 0.5s left to run
+            scheduler->resumeTarget(&target);
+            advance(scheduler, 1);
+            CHECK(triggersA == 0);
+            advance(scheduler, 1);
+            CHECK(triggersA == 1);
+        }
+
+
+        SUBCASE("schedule while paused") {
+            scheduler->pauseTarget(&target);
+            advance(scheduler, 40);
+
+            // joins the paused target, starts counting on resume like the other timers
+            scheduler->schedule([&](float) { ++triggersB; }, &target, 1.0f, false, "b");
+            CHECK(scheduler->isTargetPaused(&target));
+            advance(scheduler, 8);
+            CHECK(triggersB == 0);
+
+            scheduler->resumeTarget(&target);
+            advance(scheduler, 4);
+            CHECK(triggersA == 0);
+            CHECK(triggersB == 0);
+            advance(scheduler, 1);
+            CHECK(triggersA == 1);
+            CHECK(triggersB == 1);
+        }
+
+
+        SUBCASE("reschedule while paused") {
+            scheduler->pauseTarget(&target);
+            advance(scheduler, 40);
+
+            scheduler->schedule([&](float) { ++triggersA; }, &target, 0.5f, false, "a");
+            scheduler->resumeTarget(&target);
+            advance(scheduler, 2);
+            CHECK(triggersA == 0);
+            advance(scheduler, 1);
+            CHECK(triggersA == 1);
+        }
+
+        scheduler->release();
+    }
+
+
+    TEST_CASE("unschedule during update") {
+        auto scheduler = new Scheduler();
+        int target     = 0;
+        int other      = 0;
+        int triggersA  = 0;
+        int triggersB  = 0;
+        int triggersC  = 0;
+
+        SUBCASE("another timer due in the same frame") {
+            scheduler->schedule(
+                [&](float) {
+                    ++triggersA;
+                    scheduler->unschedule("b", &target);
+                },
+                &target, 0.5f, false, "a");
+            scheduler->schedule([&](float) { ++triggersB; }, &target, 0.5f, false, "b");
+
+            advance(scheduler, 3);
+            CHECK(triggersA == 1);
+            CHECK(triggersB == 0);
+            CHECK(not scheduler->isScheduled("b", &target));
+
+            advance(scheduler, 2);
+            CHECK(triggersA == 2);
+            CHECK(triggersB == 0);
+        }
+
+
+        SUBCASE("itself") {
+            scheduler->schedule(
+                [&](float) {
+                    ++triggersA;
+                    scheduler->unschedule("a", &target);
+                },
+                &target, 0.0f, false, "a");
+
+            advance(scheduler, 8);
+            CHECK(triggersA == 1);
+            CHECK(not scheduler->isScheduled("a", &target));
+        }
+
+
+        SUBCASE("all of its target") {
+            scheduler->schedule(
+                [&](float) {
+                    ++triggersA;
+                    scheduler->unscheduleAllForTarget(&target);
+                },
+                &target, 0.5f, false, "a");
+            scheduler->schedule([&](float) { ++triggersB; }, &target, 0.5f, false, "b");
+            scheduler->schedule([&](float) { ++triggersC; }, &other, 0.5f, false, "c");
+
+            advance(scheduler, 3);
+            CHECK(triggersA == 1);
+            CHECK(triggersB == 0);
+            CHECK(triggersC == 1);
+
+            advance(scheduler, 8);
+            CHECK(triggersA == 1);
+            CHECK(triggersB == 0);
+            CHECK(triggersC == 5);
+        }
+
+
+        SUBCASE("then schedule again") {
+            scheduler->schedule([&](float) { ++triggersA; }, &target, 1.0f, false, "a");
+            scheduler->schedule(
+                [&](float) {
+                    ++triggersB;
+                    scheduler->unschedule("a", &target);
+                    scheduler->schedule([&](float) { ++triggersC; }, &target, 0.5f, false, "a");
+                },
+                &target, 0.5f, 0, 0.0f, false, "b");
+
+            advance(scheduler, 3);
+            CHECK(triggersB == 1);
+
+            // the new "a" starts on the next update, the old one would have been due at 1.25
+            advance(scheduler, 2);
+            CHECK(triggersA == 0);
+            CHECK(triggersC == 0);
+            advance(scheduler, 1);
+            CHECK(triggersA == 0);
+            CHECK(triggersC == 1);
+            CHECK(scheduler->isScheduled("a", &target));
+        }
+
+        scheduler->release();
+    }
+}
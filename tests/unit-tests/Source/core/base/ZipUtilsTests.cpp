@@ -0,0 +1,194 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include <atomic>
+#include <thread>
+#include "base/ZipUtils.h"
+#include "platform/FileUtils.h"
+
+using namespace ax;
+
+// built with python zipfile from
+//   stored/abc.txt      "abc", stored
+//   stored/bytes.bin    (i * 7) % 251 for i in [0, 256), stored
+//   deflated/packed.txt "packed " * 32, deflated
+static const uint8_t ZIP[] = {
+    0x50, 0x4b, 0x03, 0x04, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x50, 0xc2, 0x41,
+    0x24, 0x35, 0x03, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x73, 0x74,
+    0x6f, 0x72, 0x65, 0x64, 0x2f, 0x61, 0x62, 0x63, 0x2e, 0x74, 0x78, 0x74, 0x61, 0x62, 0x63, 0x50,
+    0x4b, 0x03, 0x04, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x50, 0x89, 0x12, 0x0d,
+    0x5a, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x73, 0x74, 0x6f,
+    0x72, 0x65, 0x64, 0x2f, 0x62, 0x79, 0x74, 0x65, 0x73, 0x2e, 0x62, 0x69, 0x6e, 0x00, 0x07, 0x0e,
+    0x15, 0x1c, 0x23, 0x2a, 0x31, 0x38, 0x3f, 0x46, 0x4d, 0x54, 0x5b, 0x62, 0x69, 0x70, 0x77, 0x7e,
+    0x85, 0x8c, 0x93, 0x9a, 0xa1, 0xa8, 0xaf, 0xb6, 0xbd, 0xc4, 0xcb, 0xd2, 0xd9, 0xe0, 0xe7, 0xee,
+    0xf5, 0x01, 0x08, 0x0f, 0x16, 0x1d, 0x24, 0x2b, 0x32, 0x39, 0x40, 0x47, 0x4e, 0x55, 0x5c, 0x63,
+    0x6a, 0x71, 0x78, 0x7f, 0x86, 0x8d, 0x94, 0x9b, 0xa2, 0xa9, 0xb0, 0xb7, 0xbe, 0xc5, 0xcc, 0xd3,
+    0xda, 0xe1, 0xe8, 0xef, 0xf6, 0x02, 0x09, 0x10, 0x17, 0x1e, 0x25, 0x2c, 0x33, 0x3a, 0x41, 0x48,
+    0x4f, 0x56, 0x5d, 0x64, 0x6b, 0x72, 0x79, 0x80, 0x87, 0x8e, 0x95, 0x9c, 0xa3, 0xaa, 0xb1, 0xb8,
+    0xbf, 0xc6, 0xcd, 0xd4, 0xdb, 0xe2, 0xe9, 0xf0, 0xf7, 0x03, 0x0a, 0x11, 0x18, 0x1f, 0x26, 0x2d,
+    0x34, 0x3b, 0x42, 0x49, 0x50, 0x57, 0x5e, 0x65, 0x6c, 0x73, 0x7a, 0x81, 0x88, 0x8f, 0x96, 0x9d,
+    0xa4, 0xab, 0xb2, 0xb9, 0xc0, 0xc7, 0xce, 0xd5, 0xdc, 0xe3, 0xea, 0xf1, 0xf8, 0x04, 0x0b, 0x12,
+    0x19, 0x20, 0x27, 0x2e, 0x35, 0x3c, 0x43, 0x4a, 0x51, 0x58, 0x5f, 0x66, 0x6d, 0x74, 0x7b, 0x82,
+    0x89, 0x90, 0x97, 0x9e, 0xa5, 0xac, 0xb3, 0xba, 0xc1, 0xc8, 0xcf, 0xd6, 0xdd, 0xe4, 0xeb, 0xf2,
+    0xf9, 0x05, 0x0c, 0x13, 0x1a, 0x21, 0x28, 0x2f, 0x36, 0x3d, 0x44, 0x4b, 0x52, 0x59, 0x60, 0x67,
+    0x6e, 0x75, 0x7c, 0x83, 0x8a, 0x91, 0x98, 0x9f, 0xa6, 0xad, 0xb4, 0xbb, 0xc2, 0xc9, 0xd0, 0xd7,
+    0xde, 0xe5, 0xec, 0xf3, 0xfa, 0x06, 0x0d, 0x14, 0x1b, 0x22, 0x29, 0x30, 0x37, 0x3e, 0x45, 0x4c,
+    0x53, 0x5a, 0x61, 0x68, 0x6f, 0x76, 0x7d, 0x84, 0x8b, 0x92, 0x99, 0xa0, 0xa7, 0xae, 0xb5, 0xbc,
+    0xc3, 0xca, 0xd1, 0xd8, 0xdf, 0xe6, 0xed, 0xf4, 0x00, 0x07, 0x0e, 0x15, 0x1c, 0x50, 0x4b, 0x03,
+    0x04, 0x14, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x21, 0x50, 0x8b, 0x47, 0x1e, 0x52, 0x0c,
+    0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x13, 0x00, 0x00, 0x00, 0x64, 0x65, 0x66, 0x6c, 0x61,
+    0x74, 0x65, 0x64, 0x2f, 0x70, 0x61, 0x63, 0x6b, 0x65, 0x64, 0x2e, 0x74, 0x78, 0x74, 0x2b, 0x48,
+    0x4c, 0xce, 0x4e, 0x4d, 0x51, 0x28, 0x18, 0xae, 0x14, 0x00, 0x50, 0x4b, 0x01, 0x02, 0x14, 0x03,
+    0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x50, 0xc2, 0x41, 0x24, 0x35, 0x03, 0x00,
+    0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00, 0x73, 0x74, 0x6f, 0x72, 0x65, 0x64, 0x2f, 0x61,
+    0x62, 0x63, 0x2e, 0x74, 0x78, 0x74, 0x50, 0x4b, 0x01, 0x02, 0x14, 0x03, 0x14, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x21, 0x50, 0x89, 0x12, 0x0d, 0x5a, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01,
+    0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x01,
+    0x2f, 0x00, 0x00, 0x00, 0x73, 0x74, 0x6f, 0x72, 0x65, 0x64, 0x2f, 0x62, 0x79, 0x74, 0x65, 0x73,
+    0x2e, 0x62, 0x69, 0x6e, 0x50, 0x4b, 0x01, 0x02, 0x14, 0x03, 0x14, 0x00, 0x00, 0x00, 0x08, 0x00,
+    0x00, 0x00, 0x21, 0x50, 0x8b, 0x47, 0x1e, 0x52, 0x0c, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00,
+    0x13, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0x5d, 0x01,
+    0x00, 0x00, 0x64, 0x65, 0x66, 0x6c, 0x61, 0x74, 0x65, 0x64, 0x2f, 0x70, 0x61, 0x63, 0x6b, 0x65,
+    0x64, 0x2e, 0x74, 0x78, 0x74, 0x50, 0x4b, 0x05, 0x06, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x03,
+    0x00, 0xbb, 0x00, 0x00, 0x00, 0x9a, 0x01, 0x00, 0x00, 0x00, 0x00,
+};
+
+static std::string writeZip(std::string_view name, std::string_view prefix)
+{
+    auto file = FileUtils::getInstance()->getWritablePath().append(name);
+    std::string bytes{prefix};
+    bytes.append(reinterpret_cast<const char*>(ZIP), sizeof(ZIP));
+    return FileUtils::getInstance()->writeStringToFile(bytes, file) ? file : std::string{};
+}
+
+static std::string expectedBytes()
+{
+    std::string bytes;
+    for (int i = 0; i < 256; ++i)
+        bytes += static_cast<char>((i * 7) % 251);
+    return bytes;
+}
+
+static std::string expectedPacked()
+{
+    std::string packed;
+    for (int i = 0; i < 32; ++i)
+        packed += "packed ";
+    return packed;
+}
+
+static std::string getFileData(ZipFile* zip, std::string_view name)
+{
+    std::string data;
+    ResizableBufferAdapter<std::string> buffer(&data);
+    return zip->getFileData(name, &buffer) ? data : std::string{"<failed>"};
+}
+
+
+TEST_SUITE("base/ZipUtils") {
+    TEST_CASE("ZipFile") {
+        auto fu = FileUtils::getInstance();
+
+        // the offsets of the central directory don't account for data prepended to the archive,
+        // as in self extracting archives
+        for (std::string_view prefix : {""sv, "prepended data, i.e. an executable stub"sv})
+        {
+            CAPTURE(prefix);
+            auto file = writeZip("__test.zip", prefix);
+            REQUIRE(not file.empty());
+
+            auto zip = ZipFile::createFromFile(file);
+            REQUIRE(zip);
+            CHECK(zip->fileExists("stored/abc.txt"));
+            CHECK(not zip->fileExists("stored/doesnt_exist.txt"));
+
+            SUBCASE("getFileData") {
+                CHECK(getFileData(zip, "stored/abc.txt") == "abc");
+                CHECK(getFileData(zip, "stored/bytes.bin") == expectedBytes());
+                CHECK(getFileData(zip, "deflated/packed.txt") == expectedPacked());
+            }
+
+
+            SUBCASE("vread") {
+                for (auto name : {"stored/bytes.bin"sv, "deflated/packed.txt"sv})
+                {
+                    const auto expected = name == "stored/bytes.bin"sv ? expectedBytes() : expectedPacked();
+                    auto entry          = zip->vopen(name);
+                    REQUIRE(entry);
+                    CHECK(zip->vsize(entry) == static_cast<int64_t>(expected.size()));
+
+                    // in chunks, then after a seek
+                    std::string data;
+                    char chunk[100];
+                    int n;
+                    while ((n = zip->vread(entry, chunk, sizeof(chunk))) > 0)
+                        data.append(chunk, n);
+                    CHECK(data == expected);
+
+                    CHECK(zip->vseek(entry, 10, SEEK_SET) == 10);
+                    REQUIRE(zip->vread(entry, chunk, 5) == 5);
+                    CHECK(std::string_view(chunk, 5) == std::string_view(expected).substr(10, 5));
+                    zip->vclose(entry);
+                }
+            }
+
+
+            SUBCASE("concurrent reads") {
+                // each thread borrows its own reader from the pool, more threads than readers wait for one
+                const auto threadCount = (std::max)(4u, std::thread::hardware_concurrency() * 2);
+                std::vector<std::thread> threads;
+                std::atomic<int> failures{0};
+                for (unsigned int t = 0; t < threadCount; ++t)
+                {
+                    threads.emplace_back([&, t]() {
+                        for (int i = 0; i < 50; ++i)
+                        {
+                            switch ((t + i) % 3)
+                            {
+                            case 0:
+                                failures += getFileData(zip, "stored/abc.txt") != "abc";
+                                break;
+                            case 1:
+                                failures += getFileData(zip, "stored/bytes.bin") != expectedBytes();
+                                break;
+                            default:
+                                failures += getFileData(zip, "deflated/packed.txt") != expectedPacked();
+                                break;
+                            }
+                        }
+                    });
+                }
+                for (auto& thread : threads)
+                    thread.join();
+                CHECK(failures == 0);
+            }
+
+            delete zip;
+            CHECK(fu->removeFile(file));
+        }
+    }
+}
@@ -24,11 +24,87 @@
  ****************************************************************************/
 
 #include <doctest.h>
+#include <atomic>
+#include <thread>
 #include "TestUtils.h"
 #include "platform/FileUtils.h"
 
 using namespace ax;
 
+// built by tools/axpack/axpack.py from
+//   a/text/123.txt    "abc"
+//   a/text/packed.txt "packed " * 32
+// with: axpack.py build a -o a.axpk --compress --align 4
+static const uint8_t PACK_A[] = {
+    0x41, 0x58, 0x50, 0x4b, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x1b, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x61, 0x62, 0x63, 0x00, 0x78, 0xda, 0x2b, 0x48,
+    0x4c, 0xce, 0x4e, 0x4d, 0x51, 0x28, 0x18, 0xae, 0x14, 0x00, 0xb8, 0x6d, 0x51, 0x01, 0x00, 0x00,
+    0x64, 0x31, 0x91, 0xcf, 0x3c, 0x1f, 0x12, 0x93, 0x28, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xd6, 0x27, 0xb6, 0x54, 0x11, 0x00, 0x25, 0x9a, 0x2c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x12, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x0f, 0x00, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x74, 0x65, 0x78, 0x74, 0x2f, 0x31, 0x32, 0x33, 0x2e, 0x74, 0x78, 0x74, 0x74, 0x65, 0x78, 0x74,
+    0x2f, 0x70, 0x61, 0x63, 0x6b, 0x65, 0x64, 0x2e, 0x74, 0x78, 0x74,
+};
+
+// built from b/text/123.txt "xyz" with: axpack.py build b -o b.axpk --align 4
+static const uint8_t PACK_B[] = {
+    0x41, 0x58, 0x50, 0x4b, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x0c, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x78, 0x79, 0x7a, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x64, 0x31, 0x91, 0xcf, 0x3c, 0x1f, 0x12, 0x93, 0x28, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x74, 0x65, 0x78, 0x74, 0x2f, 0x31, 0x32, 0x33, 0x2e, 0x74, 0x78, 0x74,
+};
+
+static std::string writePack(std::string_view name, const uint8_t* bytes, size_t size)
+{
+    auto file = FileUtils::getInstance()->getWritablePath().append(name);
+    Data data;
+    data.copy(bytes, size);
+    return FileUtils::getInstance()->writeDataToFile(data, file) ? file : std::string{};
+}
+
+
+// a delegate storing its files xored, like an app decrypting its assets in getContents
+class XorFileUtils : public FileUtils
+{
+public:
+    explicit XorFileUtils(bool canMap = false) : _canMap(canMap) {}
+
+    Status getContents(std::string_view filename, ResizableBuffer* buffer) const override
+    {
+        auto status = FileUtils::getContents(filename, buffer);
+        auto bytes  = static_cast<uint8_t*>(buffer->buffer());
+        for (size_t i = 0; i < buffer->size(); ++i)
+            bytes[i] ^= 0x5a;
+        return status;
+    }
+
+    bool canMapFile(std::string_view /*fullPath*/) const override { return _canMap; }
+
+    std::string getWritablePath() const override { return FileUtils::getInstance()->getWritablePath(); }
+    std::string getNativeWritableAbsolutePath() const override
+    {
+        return FileUtils::getInstance()->getNativeWritableAbsolutePath();
+    }
+
+protected:
+    bool isFileExistInternal(std::string_view filename) const override
+    {
+        return FileUtils::getInstance()->isFileExist(filename);
+    }
+
+    bool _canMap;
+};
+
 
 TEST_SUITE("platform/FileUtils") {
     // !!!Don't invoke FileUtils::getInstacne at here, it's dangerous due to
@@ -272,6 +348,191 @@ TEST_SUITE("platform/FileUtils") {
     }
 
 
+    TEST_CASE("mapFile") {
+        SUBCASE("existing") {
+            auto mapping = fu->mapFile("text/hello.txt");
+            REQUIRE(mapping);
+            REQUIRE(mapping->size() == 12);
+            CHECK(std::string_view((const char*)mapping->data(), mapping->size()) == "Hello world!");
+
+            // a mapped view has no buffer to hand over, android assets are read into one instead
+            ssize_t size = 0;
+            auto buffer  = mapping->takeBuffer(&size);
+            CHECK((buffer == nullptr) == mapping->isMapped());
+            free(buffer);
+        }
+
+
+        SUBCASE("missing") {
+            CHECK(fu->mapFile("text/doesnt_exist.txt") == nullptr);
+            CHECK(fu->mapFile("") == nullptr);
+        }
+
+
+        SUBCASE("overridden getContents") {
+            auto file = fu->getWritablePath() + "__test_xored.txt";
+            std::string xored = "secret";
+            for (auto& c : xored)
+                c ^= 0x5a;
+            REQUIRE(fu->writeStringToFile(xored, file));
+
+            // the contents go through the delegate getContents
+            XorFileUtils delegate;
+            auto mapping = delegate.mapFile(file);
+            REQUIRE(mapping);
+            CHECK(not mapping->isMapped());
+            CHECK(std::string_view((const char*)mapping->data(), mapping->size()) == "secret");
+
+            // unless it opts in to mapping, then they are read as-is
+            XorFileUtils mappingDelegate(true);
+            mapping = mappingDelegate.mapFile(file);
+            REQUIRE(mapping);
+            CHECK(std::string_view((const char*)mapping->data(), mapping->size()) == xored);
+
+            mapping.reset();
+            CHECK(fu->removeFile(file));
+        }
+
+
+        SUBCASE("empty") {
+            auto file = fu->getWritablePath() + "__test_empty.txt";
+            REQUIRE(fu->writeStringToFile("", file));
+
+            // nothing to map, falls back to an empty buffer
+            auto mapping = fu->mapFile(file);
+            REQUIRE(mapping);
+            CHECK(mapping->empty());
+            CHECK(not mapping->isMapped());
+
+            mapping.reset();
+            CHECK(fu->removeFile(file));
+        }
+    }
+
+
+    TEST_CASE("mountPack") {
+        auto packA = writePack("__test_a.axpk", PACK_A, sizeof(PACK_A));
+        auto packB = writePack("__test_b.axpk", PACK_B, sizeof(PACK_B));
+        REQUIRE(not packA.empty());
+        REQUIRE(not packB.empty());
+
+        const auto searchPathFile = fu->fullPathForFilename("text/123.txt");
+        REQUIRE(not searchPathFile.empty());
+
+        CHECK(not fu->mountPack("__test_doesnt_exist.axpk"));
+        REQUIRE(fu->mountPack(packA));
+
+        SUBCASE("lookup") {
+            CHECK(fu->fullPathForFilename("text/123.txt") == packA + "/text/123.txt");
+            CHECK(fu->isFileExist("text/packed.txt"));
+            CHECK(not fu->isFileExist("text/doesnt_exist.txt"));
+
+            // files not in the archive still come from the search paths
+            CHECK(fu->fullPathForFilename("text/hello.txt") != "");
+            CHECK(fu->getStringFromFile("text/hello.txt") == "Hello world!");
+        }
+
+
+        SUBCASE("read") {
+            CHECK(fu->getStringFromFile("text/123.txt") == "abc");
+
+            std::string expected;
+            for (int i = 0; i < 32; ++i)
+                expected += "packed ";
+            CHECK(fu->getStringFromFile("text/packed.txt") == expected);
+
+            auto mapping = fu->mapFile("text/packed.txt");
+            REQUIRE(mapping);
+            CHECK(std::string_view((const char*)mapping->data(), mapping->size()) == expected);
+
+            mapping = fu->mapFile("text/123.txt");
+            REQUIRE(mapping);
+            CHECK(std::string_view((const char*)mapping->data(), mapping->size()) == "abc");
+
+            // the inflated size
+            CHECK(fu->getFileSize("text/123.txt") == 3);
+            CHECK(fu->getFileSize("text/packed.txt") == static_cast<int64_t>(expected.size()));
+        }
+
+
+        SUBCASE("precedence") {
+            // the most recently mounted archive first
+            REQUIRE(fu->mountPack(packB));
+            CHECK(fu->fullPathForFilename("text/123.txt") == packB + "/text/123.txt");
+            CHECK(fu->getStringFromFile("text/123.txt") == "xyz");
+            CHECK(fu->getStringFromFile("text/packed.txt") != "");
+
+            // mounting again moves it to the front
+            REQUIRE(fu->mountPack(packA));
+            CHECK(fu->getStringFromFile("text/123.txt") == "abc");
+
+            fu->unmountPack(packA);
+            CHECK(fu->getStringFromFile("text/123.txt") == "xyz");
+            CHECK(not fu->isFileExist("text/packed.txt"));
+
+            fu->unmountPack(packB);
+        }
+
+
+        SUBCASE("unmount") {
+            auto mapping = fu->mapFile("text/123.txt");
+            REQUIRE(mapping);
+
+            fu->unmountPack(packA);
+            CHECK(fu->fullPathForFilename("text/123.txt") == searchPathFile);
+            CHECK(fu->getStringFromFile("text/123.txt") == "123");
+            CHECK(not fu->isFileExist("text/packed.txt"));
+
+            // views outlive the archive
+            CHECK(std::string_view((const char*)mapping->data(), mapping->size()) == "abc");
+        }
+
+        SUBCASE("concurrent unmount") {
+            // sizes and lookups of archive entries while another thread unmounts the archive
+            const auto packedFile = packB + "/text/123.txt";
+            std::atomic<bool> done{false};
+            std::thread reader([&] {
+                while (!done.load())
+                {
+                    auto size = fu->getFileSize(packedFile);
+                    CHECK((size == 3 || size == -1));
+                    fu->isFileExist(packedFile);
+                }
+            });
+            for (int i = 0; i < 200; ++i)
+            {
+                REQUIRE(fu->mountPack(packB));
+                fu->unmountPack(packB);
+            }
+            done = true;
+            reader.join();
+        }
+
+        SUBCASE("malformed") {
+            // a stored entry whose original size doesn't match its payload size
+            for (uint8_t originalSize : {0x02, 0x40})
+            {
+                CAPTURE(originalSize);
+                std::vector<uint8_t> bytes(PACK_B, PACK_B + sizeof(PACK_B));
+                bytes[0x44] = originalSize;
+                auto packC  = writePack("__test_c.axpk", bytes.data(), bytes.size());
+                REQUIRE(fu->mountPack(packC));
+
+                CHECK(fu->getStringFromFile("text/123.txt") == "");
+                CHECK(fu->mapFile("text/123.txt") == nullptr);
+
+                fu->unmountPack(packC);
+                CHECK(fu->removeFile(packC));
+            }
+        }
+
+        fu->unmountPack(packA);
+        CHECK(fu->fullPathForFilename("text/123.txt") == searchPathFile);
+        CHECK(fu->removeFile(packA));
+        CHECK(fu->removeFile(packB));
+    }
+
+
     TEST_CASE("write_data") {
         auto file = fu->getWritablePath() + "__test.txt";
 
@@ -0,0 +1,154 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include "base/Config.h"
+
+#if defined(AX_USE_GL)
+
+#    include "base/Director.h"
+#    include "platform/GL.h"
+#    include "renderer/CustomCommand.h"
+#    include "renderer/Renderer.h"
+#    include "renderer/Texture2D.h"
+#    include "renderer/backend/DriverBase.h"
+#    include "renderer/backend/ProgramState.h"
+#    include "renderer/backend/RenderTarget.h"
+#    include "renderer/backend/opengl/CommandBufferGL.h"
+#    include "TestUtils.h"
+
+using namespace ax;
+
+static GLint getBoundVertexArray()
+{
+    GLint vao = 0;
+#    if AX_GLES_PROFILE != 200
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &vao);
+#    endif
+    return vao;
+}
+
+
+TEST_SUITE("renderer/CommandBufferGL") {
+    TEST_CASE("vertex array cache") {
+        if (!ensureGLView())
+        {
+            MESSAGE("no display, skipped");
+            return;
+        }
+
+        auto renderer         = Director::getInstance()->getRenderer();
+        const auto defaultVAO = getBoundVertexArray();
+
+        const V3F_C4B_T2F vertices[] = {
+            {Vec3(0.0f, 0.0f, 0.0f), Color4B::WHITE, Tex2F(0.0f, 0.0f)},
+            {Vec3(1.0f, 0.0f, 0.0f), Color4B::WHITE, Tex2F(1.0f, 0.0f)},
+            {Vec3(0.0f, 1.0f, 0.0f), Color4B::WHITE, Tex2F(0.0f, 1.0f)},
+        };
+        auto programState =
+            new backend::ProgramState(backend::Program::getBuiltinProgram(backend::ProgramType::POSITION_TEXTURE_COLOR));
+
+        CustomCommand command;
+        command.init(0.0f);
+        command.setDrawType(CustomCommand::DrawType::ARRAY);
+        command.setPrimitiveType(CustomCommand::PrimitiveType::TRIANGLE);
+        command.createVertexBuffer(sizeof(V3F_C4B_T2F), 3, CustomCommand::BufferUsage::STATIC);
+        command.updateVertexBuffer(vertices, sizeof(vertices));
+        command.setVertexDrawInfo(0, 3);
+        command.getPipelineDescriptor().programState = programState;
+
+        // the callback stands for any GL code run by the application between two draws
+        GLint callbackVAO = -1;
+
+        // twice, the second frame draws with the cached vertex array
+        for (int frame = 0; frame < 2; ++frame)
+        {
+            CAPTURE(frame);
+            renderer->addCommand(&command);
+            if (frame == 1)
+                renderer->addCallbackCommand([&] { callbackVAO = getBoundVertexArray(); }, 1.0f);
+            renderer->render();
+
+            CHECK(getBoundVertexArray() == defaultVAO);
+        }
+        CHECK(callbackVAO == defaultVAO);
+
+        programState->release();
+    }
+
+    TEST_CASE("async readback") {
+        if (!ensureGLView())
+        {
+            MESSAGE("no display, skipped");
+            return;
+        }
+
+        auto renderer = Director::getInstance()->getRenderer();
+
+        // 2x2 targets, the bottom row in the color of the target and the top row blue
+        auto createRenderTarget = [](const Color4B& color, Texture2D*& texture) {
+            const Color4B pixels[4] = {color, color, Color4B::BLUE, Color4B::BLUE};
+            texture                 = new Texture2D();
+            texture->initWithData(pixels, sizeof(pixels), backend::PixelFormat::RGBA8, 2, 2);
+            return backend::DriverBase::getInstance()->newRenderTarget(texture->getBackendTexture());
+        };
+        Texture2D *redTexture = nullptr, *greenTexture = nullptr;
+        auto redTarget   = createRenderTarget(Color4B::RED, redTexture);
+        auto greenTarget = createRenderTarget(Color4B::GREEN, greenTexture);
+
+        std::vector<Color4B> order;
+        auto readback = [&order](const backend::PixelBufferDescriptor& pbd) {
+            // invoked by the renderer, a REQUIRE would throw through it
+            CHECK(pbd);
+            if (!pbd || pbd._width != 2 || pbd._height != 2)
+            {
+                order.emplace_back(Color4B::BLACK);
+                return;
+            }
+            // top row first
+            auto pixels = reinterpret_cast<const Color4B*>(pbd._data.getBytes());
+            CHECK_EQ(pixels[0], Color4B::BLUE);
+            order.emplace_back(pixels[3]);
+        };
+        renderer->readPixels(redTarget, readback);
+        renderer->readPixels(greenTarget, readback);
+#    if AX_GL_ASYNC_READBACK
+        // delivered at the beginning of a later frame
+        CHECK(order.empty());
+#    endif
+
+        // in issue order, at the latest after a few frames
+        for (int frame = 0; frame < 4 && order.size() < 2; ++frame)
+            Director::getInstance()->drawScene();
+        CHECK_EQ(order, std::vector<Color4B>{Color4B::RED, Color4B::GREEN});
+
+        redTarget->release();
+        greenTarget->release();
+        redTexture->release();
+        greenTexture->release();
+    }
+}
+
+#endif  // defined(AX_USE_GL)
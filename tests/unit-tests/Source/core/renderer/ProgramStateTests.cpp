@@ -0,0 +1,168 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include <string.h>
+#include "base/Config.h"
+#include "math/Mat4.h"
+#include "renderer/backend/Program.h"
+#include "renderer/backend/ProgramState.h"
+#include "TestUtils.h"
+
+#if defined(AX_USE_GL)
+#    include "platform/GL.h"
+#    include "renderer/backend/opengl/ProgramGL.h"
+#endif
+
+using namespace ax;
+
+static backend::ProgramState* createProgramState()
+{
+    return new backend::ProgramState(backend::Program::getBuiltinProgram(backend::ProgramType::POSITION_TEXTURE_COLOR));
+}
+
+#if defined(AX_USE_GL) && !AX_GLES_PROFILE
+// reads back the uniform block bound at index 0, glGetBufferSubData is desktop GL only
+static std::vector<char> readUniformBlock(std::size_t size)
+{
+    GLint previous = 0, ubo = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_BINDING, &previous);
+    glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, 0, &ubo);
+    std::vector<char> data(size);
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glGetBufferSubData(GL_UNIFORM_BUFFER, 0, size, data.data());
+    glBindBuffer(GL_UNIFORM_BUFFER, previous);
+    return data;
+}
+#endif
+
+TEST_SUITE("renderer/ProgramState")
+{
+    TEST_CASE("uniform dirty range")
+    {
+        if (!ensureGLView())
+        {
+            MESSAGE("no display, skipped");
+            return;
+        }
+
+        auto programState = createProgramState();
+        auto location     = programState->getUniformLocation("u_MVPMatrix");
+        std::size_t bufferSize = 0;
+        programState->getVertexUniformBuffer(bufferSize);
+
+        // a new state was never uploaded, all of it is dirty
+        std::size_t begin = 0, end = 0;
+        CHECK(programState->getUniformDirtyRange(begin, end));
+        CHECK_EQ(begin, 0);
+        CHECK_EQ(end, bufferSize);
+        programState->clearUniformDirtyRange();
+        CHECK_FALSE(programState->getUniformDirtyRange(begin, end));
+
+        SUBCASE("same value")
+        {
+            Mat4 zero;
+            zero.setZero();
+            programState->setUniform(location, zero.m, sizeof(zero.m));
+            CHECK_FALSE(programState->getUniformDirtyRange(begin, end));
+        }
+
+        SUBCASE("changed value")
+        {
+            programState->setUniform(location, Mat4::IDENTITY.m, sizeof(Mat4::IDENTITY.m));
+            REQUIRE(programState->getUniformDirtyRange(begin, end));
+            CHECK_EQ(end - begin, sizeof(Mat4::IDENTITY.m));
+            CHECK(end <= bufferSize);
+
+            // setting it again doesn't widen the range
+            programState->setUniform(location, Mat4::IDENTITY.m, sizeof(Mat4::IDENTITY.m));
+            std::size_t begin2 = 0, end2 = 0;
+            CHECK(programState->getUniformDirtyRange(begin2, end2));
+            CHECK_EQ(begin2, begin);
+            CHECK_EQ(end2, end);
+        }
+
+        SUBCASE("clone")
+        {
+            auto clone = programState->clone();
+            CHECK_NE(clone->getUniformStateId(), programState->getUniformStateId());
+            CHECK(clone->getUniformDirtyRange(begin, end));
+            CHECK_EQ(begin, 0);
+            CHECK_EQ(end, bufferSize);
+            clone->release();
+        }
+
+        programState->release();
+    }
+
+#if defined(AX_USE_GL) && !AX_GLES_PROFILE
+    TEST_CASE("uniform shadow")
+    {
+        if (!ensureGLView())
+        {
+            MESSAGE("no display, skipped");
+            return;
+        }
+
+        auto a        = createProgramState();
+        auto b        = createProgramState();
+        auto program  = static_cast<backend::ProgramGL*>(a->getProgram());
+        auto location = a->getUniformLocation("u_MVPMatrix");
+
+        Mat4 translation, scale;
+        Mat4::createTranslation(1.0f, 2.0f, 3.0f, &translation);
+        Mat4::createScale(2.0f, 2.0f, 2.0f, &scale);
+        a->setUniform(location, translation.m, sizeof(translation.m));
+        b->setUniform(location, scale.m, sizeof(scale.m));
+
+        std::size_t size = 0;
+        auto isUploaded  = [&size](backend::ProgramState* programState) {
+            auto buffer = programState->getVertexUniformBuffer(size);
+            auto data   = readUniformBlock(size);
+            return memcmp(data.data(), buffer, size) == 0;
+        };
+
+        program->bindUniformBuffers(a);
+        CHECK(isUploaded(a));
+        std::size_t begin = 0, end = 0;
+        CHECK_FALSE(a->getUniformDirtyRange(begin, end));
+
+        program->bindUniformBuffers(b);
+        CHECK(isUploaded(b));
+
+        // a isn't dirty, but differs from what b uploaded
+        program->bindUniformBuffers(a);
+        CHECK(isUploaded(a));
+
+        // the same state again, only its dirty range is uploaded
+        a->setUniform(location, scale.m, sizeof(scale.m));
+        program->bindUniformBuffers(a);
+        CHECK(isUploaded(a));
+
+        a->release();
+        b->release();
+    }
+#endif
+}
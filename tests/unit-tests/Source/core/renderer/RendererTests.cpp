@@ -0,0 +1,234 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include "base/Config.h"
+#include "2d/Camera.h"
+#include "2d/Node.h"
+#include "base/Director.h"
+#include "renderer/CustomCommand.h"
+#include "renderer/Renderer.h"
+
+#if defined(AX_USE_GL)
+#    include "renderer/Texture2D.h"
+#    include "renderer/TrianglesCommand.h"
+#    include "renderer/backend/ProgramState.h"
+#    include "TestUtils.h"
+#endif
+
+using namespace ax;
+
+namespace
+{
+class TestRenderer : public Renderer
+{
+public:
+    using Renderer::_parallelVisits;
+    using Renderer::_renderGroups;
+};
+
+class TestCamera : public Camera
+{
+public:
+    static void setVisitingCamera(Camera* camera) { _visitingCamera = camera; }
+};
+
+// queues one command, in the negative, zero or positive global z queue depending on its index
+class CommandNode : public Node
+{
+public:
+    explicit CommandNode(int index)
+    {
+        setGlobalZOrder(static_cast<float>(index % 3 - 1));
+        setPosition(static_cast<float>(index), 0.0f);
+    }
+
+    void draw(Renderer* renderer, const Mat4& transform, uint32_t flags) override
+    {
+        _command.init(_globalZOrder, transform, flags);
+        renderer->addCommand(&_command);
+    }
+
+    CustomCommand _command;
+};
+
+std::vector<RenderCommand*> getQueuedCommands(TestRenderer& renderer)
+{
+    std::vector<RenderCommand*> commands;
+    auto& queue = renderer._renderGroups[0];
+    for (int i = 0; i < RenderQueue::QUEUE_COUNT; ++i)
+    {
+        auto& subQueue = queue.getSubQueue(static_cast<RenderQueue::QUEUE_GROUP>(i));
+        commands.insert(commands.end(), subQueue.begin(), subQueue.end());
+    }
+    return commands;
+}
+}  // namespace
+
+TEST_SUITE("renderer/Renderer")
+{
+    TEST_CASE("parallel visit")
+    {
+        // root -> 8 children, every other one a parallel root with 6 children of its own,
+        // some of them with a negative local z to be visited before their parent
+        int index = 0;
+        auto root = new CommandNode(index++);
+        for (int i = 0; i < 8; ++i)
+        {
+            auto child = new CommandNode(index++);
+            child->setParallelVisitRoot(i % 2 == 1);
+            for (int j = 0; j < 6; ++j)
+            {
+                auto grandChild = new CommandNode(index++);
+                child->addChild(grandChild, j % 3 - 1);
+                grandChild->release();
+            }
+            root->addChild(child);
+            child->release();
+        }
+
+        auto camera = Camera::create();
+        TestCamera::setVisitingCamera(camera);
+
+        TestRenderer renderer;
+        root->visit(&renderer, Mat4::IDENTITY, Node::FLAGS_TRANSFORM_DIRTY);
+        CHECK(renderer._parallelVisits.empty());
+        const auto expected = getQueuedCommands(renderer);
+        CHECK_EQ(expected.size(), index);
+        std::vector<Mat4> expectedTransforms;
+        for (auto command : expected)
+            expectedTransforms.emplace_back(command->getMV());
+        renderer.clean();
+
+        renderer.setParallelVisitEnabled(true);
+        root->visit(&renderer, Mat4::IDENTITY, Node::FLAGS_TRANSFORM_DIRTY);
+        CHECK_EQ(renderer._parallelVisits.size(), 4);
+        renderer.processParallelVisits();
+        CHECK(renderer._parallelVisits.empty());
+
+        // the same commands in the same order as the serial visit, with the same transforms
+        const auto actual = getQueuedCommands(renderer);
+        CHECK(actual == expected);
+        for (size_t i = 0; i < actual.size(); ++i)
+        {
+            CAPTURE(i);
+            CHECK(memcmp(actual[i]->getMV().m, expectedTransforms[i].m, sizeof(Mat4::m)) == 0);
+        }
+        renderer.clean();
+
+        TestCamera::setVisitingCamera(nullptr);
+        root->release();
+    }
+}
+
+#if defined(AX_USE_GL)
+
+static Texture2D* createTexture()
+{
+    const uint8_t pixels[4 * 4] = {};
+    auto texture                = new Texture2D();
+    texture->initWithData(pixels, sizeof(pixels), backend::PixelFormat::RGBA8, 2, 2);
+    return texture;
+}
+
+// a 10x10 quad with its own material per texture, placed at x
+struct TestQuad
+{
+    V3F_C4B_T2F vertices[4] = {
+        {Vec3(0.0f, 0.0f, 0.0f), Color4B::WHITE, Tex2F(0.0f, 0.0f)},
+        {Vec3(10.0f, 0.0f, 0.0f), Color4B::WHITE, Tex2F(1.0f, 0.0f)},
+        {Vec3(0.0f, 10.0f, 0.0f), Color4B::WHITE, Tex2F(0.0f, 1.0f)},
+        {Vec3(10.0f, 10.0f, 0.0f), Color4B::WHITE, Tex2F(1.0f, 1.0f)},
+    };
+    unsigned short indices[6] = {0, 1, 2, 3, 2, 1};
+    TrianglesCommand command;
+
+    void init(backend::ProgramState* programState, Texture2D* texture, float x)
+    {
+        Mat4 transform;
+        Mat4::createTranslation(x, 0.0f, 0.0f, &transform);
+        command.getPipelineDescriptor().programState = programState;
+        command.init(0.0f, texture, BlendFunc::ALPHA_PREMULTIPLIED, TrianglesCommand::Triangles(vertices, indices, 4, 6),
+                     transform, 0);
+    }
+};
+
+TEST_SUITE("renderer/Renderer")
+{
+    TEST_CASE("triangles reorder")
+    {
+        if (!ensureGLView())
+        {
+            MESSAGE("no display, skipped");
+            return;
+        }
+
+        auto renderer     = Director::getInstance()->getRenderer();
+        auto programState = new backend::ProgramState(
+            backend::Program::getBuiltinProgram(backend::ProgramType::POSITION_TEXTURE_COLOR));
+        auto textureA = createTexture();
+        auto textureB = createTexture();
+
+        // A, B, A: the second A can only join the first one if it doesn't overlap B
+        auto drawBatches = [&](float bx, float secondAx, bool reorder) {
+            TestQuad quads[3];
+            quads[0].init(programState, textureA, 0.0f);
+            quads[1].init(programState, textureB, bx);
+            quads[2].init(programState, textureA, secondAx);
+            REQUIRE(quads[0].command.getMaterialID() == quads[2].command.getMaterialID());
+            REQUIRE(quads[0].command.getMaterialID() != quads[1].command.getMaterialID());
+
+            renderer->setTrianglesReorderEnabled(reorder);
+            for (auto& quad : quads)
+                renderer->addCommand(&quad.command);
+            const auto drawnBatches = renderer->getDrawnBatches();
+            renderer->render();
+            renderer->setTrianglesReorderEnabled(false);
+            return renderer->getDrawnBatches() - drawnBatches;
+        };
+
+        SUBCASE("disabled keeps the queue order")
+        {
+            CHECK_EQ(drawBatches(20.0f, 40.0f, false), 3);
+        }
+
+        SUBCASE("disjoint commands are merged")
+        {
+            CHECK_EQ(drawBatches(20.0f, 40.0f, true), 2);
+        }
+
+        SUBCASE("overlapping commands keep their order")
+        {
+            CHECK_EQ(drawBatches(20.0f, 15.0f, true), 3);
+            CHECK_EQ(drawBatches(20.0f, 25.0f, true), 3);
+        }
+
+        textureA->release();
+        textureB->release();
+        programState->release();
+    }
+}
+
+#endif  // defined(AX_USE_GL)
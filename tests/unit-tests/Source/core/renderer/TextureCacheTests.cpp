@@ -0,0 +1,194 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include <chrono>
+#include <thread>
+#include "base/Director.h"
+#include "platform/FileUtils.h"
+#include "platform/Image.h"
+#include "renderer/TextureCache.h"
+#include "TestUtils.h"
+
+using namespace ax;
+
+static const int IMAGE_COUNT = 6;
+
+namespace
+{
+class TestTextureCache : public TextureCache
+{
+public:
+    using TextureCache::_requestMutex;
+    using TextureCache::_requestQueue;
+
+    // whether a worker picked all the requests
+    bool isRequestQueueEmpty()
+    {
+        std::lock_guard<std::mutex> lck(_requestMutex);
+        return _requestQueue.empty();
+    }
+};
+}  // namespace
+
+static std::string getImagePath(int index)
+{
+    return FileUtils::getInstance()->getWritablePath() + fmt::format("__texture_cache_test{}.png", index);
+}
+
+// the first image is the largest, it keeps a worker busy while other requests queue up
+static bool writeImages()
+{
+    for (int i = 0; i < IMAGE_COUNT; ++i)
+    {
+        const int size = i == 0 ? 1024 : 4;
+        std::vector<uint8_t> pixels(size * size * 4, static_cast<uint8_t>(i * 40));
+        Image image;
+        if (!image.initWithRawData(pixels.data(), pixels.size(), size, size, 8) ||
+            !image.saveToFile(getImagePath(i), false))
+            return false;
+    }
+    return true;
+}
+
+static void removeImages()
+{
+    for (int i = 0; i < IMAGE_COUNT; ++i)
+        FileUtils::getInstance()->removeFile(getImagePath(i));
+}
+
+// runs frames until done returns true, or gives up after a few seconds
+template <typename F>
+static bool runFrames(F&& done)
+{
+    auto scheduler      = Director::getInstance()->getScheduler();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!done())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        scheduler->update(0);
+    }
+    return true;
+}
+
+TEST_SUITE("renderer/TextureCache")
+{
+    TEST_CASE("addImageAsync")
+    {
+        if (!ensureGLView())
+        {
+            MESSAGE("no display, skipped");
+            return;
+        }
+        REQUIRE(writeImages());
+
+        auto textureCache = new TestTextureCache();
+        CHECK(textureCache->getAsyncDecodeWorkers() >= 1);
+        CHECK_EQ(textureCache->getAsyncUploadBudget(), 0.0f);
+
+        SUBCASE("decode workers")
+        {
+            textureCache->setAsyncDecodeWorkers(3);
+            CHECK_EQ(textureCache->getAsyncDecodeWorkers(), 3);
+
+            int loaded = 0;
+            for (int i = 0; i < IMAGE_COUNT; ++i)
+            {
+                textureCache->addImageAsync(getImagePath(i), [&loaded, i](Texture2D* texture) {
+                    CAPTURE(i);
+                    CHECK(texture);
+                    ++loaded;
+                });
+            }
+            REQUIRE(runFrames([&] { return loaded == IMAGE_COUNT; }));
+            for (int i = 0; i < IMAGE_COUNT; ++i)
+                CHECK(textureCache->getTextureForKey(getImagePath(i)));
+        }
+
+        SUBCASE("priority order")
+        {
+            // a single worker decodes, and so calls back, in priority order, FIFO for the same priority
+            textureCache->setAsyncDecodeWorkers(1);
+            const int priorities[IMAGE_COUNT] = {0, 1, 5, 1, 5, 3};
+            std::vector<int> order;
+            auto request = [&](int i) {
+                textureCache->addImageAsync(
+                    getImagePath(i), [&order, i](Texture2D*) { order.emplace_back(i); }, getImagePath(i),
+                    priorities[i]);
+            };
+
+            request(0);
+            REQUIRE(runFrames([&] { return textureCache->isRequestQueueEmpty(); }));
+            for (int i = 1; i < IMAGE_COUNT; ++i)
+                request(i);
+            REQUIRE(runFrames([&] { return order.size() == IMAGE_COUNT; }));
+            CHECK_EQ(order, std::vector<int>{0, 2, 4, 5, 1, 3});
+        }
+
+        SUBCASE("upload budget")
+        {
+            // at least one texture is created per frame, a budget this small allows no more
+            textureCache->setAsyncUploadBudget(1e-9f);
+            auto scheduler = Director::getInstance()->getScheduler();
+            int loaded = 0, maxPerFrame = 0;
+            for (int i = 0; i < IMAGE_COUNT; ++i)
+                textureCache->addImageAsync(getImagePath(i), [&loaded](Texture2D*) { ++loaded; });
+
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (loaded < IMAGE_COUNT && std::chrono::steady_clock::now() < deadline)
+            {
+                // give the workers time to decode several images per frame
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                const int before = loaded;
+                scheduler->update(0);
+                maxPerFrame = (std::max)(maxPerFrame, loaded - before);
+            }
+            CHECK_EQ(loaded, IMAGE_COUNT);
+            CHECK_EQ(maxPerFrame, 1);
+        }
+
+        SUBCASE("unbind cancels")
+        {
+            textureCache->setAsyncDecodeWorkers(1);
+            int called = 0;
+            for (int i = 0; i < IMAGE_COUNT; ++i)
+                textureCache->addImageAsync(getImagePath(i), [&called](Texture2D*) { ++called; }, "canceled");
+            textureCache->unbindImageAsync("canceled");
+
+            // the request being decoded completes without its callback, the queued ones are dropped
+            bool loaded = false;
+            textureCache->addImageAsync(getImagePath(1), [&loaded](Texture2D* texture) { loaded = texture != nullptr; });
+            REQUIRE(runFrames([&] { return loaded; }));
+            CHECK_EQ(called, 0);
+            CHECK_FALSE(textureCache->getTextureForKey(getImagePath(IMAGE_COUNT - 1)));
+        }
+
+        textureCache->waitForQuit();
+        textureCache->release();
+        removeImages();
+    }
+}
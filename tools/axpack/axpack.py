@@ -0,0 +1,225 @@
+#!/usr/bin/env python3
+# axpack.py
+# builds and inspects packed archives (.axpk) mounted by ax::FileUtils::mountPack,
+# see core/platform/PackFile.h for the layout.
+#
+# Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md)
+
+import argparse
+import fnmatch
+import os
+import struct
+import sys
+import zlib
+
+MAGIC = b'AXPK'
+VERSION = 1
+HEADER_FORMAT = '<4sIIIQQII'  # magic, version, entryCount, slotCount, tocOffset, namesOffset, namesSize, alignment
+ENTRY_FORMAT = '<QQIIIHH'  # hash, offset, size, originalSize, nameOffset, nameLength, flags
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+ENTRY_SIZE = struct.calcsize(ENTRY_FORMAT)
+ENTRY_DEFLATE = 1
+
+# xxh64, must match XXH64(name, len, 0) used by PackFile::find
+_P1 = 11400714785074694791
+_P2 = 14029467366897019727
+_P3 = 1609587929392839161
+_P4 = 9650029242287828579
+_P5 = 2870177450012600261
+_M64 = (1 << 64) - 1
+
+
+def _rotl(x, r):
+    return ((x << r) | (x >> (64 - r))) & _M64
+
+
+def _round(acc, lane):
+    acc = (acc + lane * _P2) & _M64
+    return (_rotl(acc, 31) * _P1) & _M64
+
+
+def _merge(acc, val):
+    acc ^= _round(0, val)
+    return (acc * _P1 + _P4) & _M64
+
+
+def xxh64(data, seed=0):
+    n = len(data)
+    i = 0
+    if n >= 32:
+        v1 = (seed + _P1 + _P2) & _M64
+        v2 = (seed + _P2) & _M64
+        v3 = seed
+        v4 = (seed - _P1) & _M64
+        while i + 32 <= n:
+            l1, l2, l3, l4 = struct.unpack_from('<4Q', data, i)
+            v1, v2, v3, v4 = _round(v1, l1), _round(v2, l2), _round(v3, l3), _round(v4, l4)
+            i += 32
+        h = (_rotl(v1, 1) + _rotl(v2, 7) + _rotl(v3, 12) + _rotl(v4, 18)) & _M64
+        for v in (v1, v2, v3, v4):
+            h = _merge(h, v)
+    else:
+        h = (seed + _P5) & _M64
+    h = (h + n) & _M64
+    while i + 8 <= n:
+        h ^= _round(0, struct.unpack_from('<Q', data, i)[0])
+        h = (_rotl(h, 27) * _P1 + _P4) & _M64
+        i += 8
+    if i + 4 <= n:
+        h ^= (struct.unpack_from('<I', data, i)[0] * _P1) & _M64
+        h = (_rotl(h, 23) * _P2 + _P3) & _M64
+        i += 4
+    while i < n:
+        h ^= (data[i] * _P5) & _M64
+        h = (_rotl(h, 11) * _P1) & _M64
+        i += 1
+    h ^= h >> 33
+    h = (h * _P2) & _M64
+    h ^= h >> 29
+    h = (h * _P3) & _M64
+    h ^= h >> 32
+    return h
+
+
+def _align(value, alignment):
+    return (value + alignment - 1) // alignment * alignment
+
+
+def collect_files(root, excludes):
+    files = []
+    for dirpath, dirnames, filenames in os.walk(root):
+        dirnames.sort()
+        for filename in sorted(filenames):
+            path = os.path.join(dirpath, filename)
+            name = os.path.relpath(path, root).replace(os.sep, '/')
+            if any(fnmatch.fnmatch(name, pattern) for pattern in excludes):
+                continue
+            files.append((name, path))
+    return files
+
+
+def build(args):
+    alignment = args.align
+    if alignment <= 0 or alignment & (alignment - 1):
+        sys.exit('alignment must be a power of two')
+
+    files = collect_files(args.input, args.exclude)
+    if not files:
+        sys.exit('no files found in %s' % args.input)
+
+    slot_count = 1
+    while slot_count < len(files) * 2:  # load factor <= 0.5 keeps probe sequences short
+        slot_count <<= 1
+
+    slots = [None] * slot_count
+    names = bytearray()
+    stored_bytes = packed_bytes = 0
+    with open(args.output, 'wb') as out:
+        out.write(b'\0' * HEADER_SIZE)
+        for name, path in files:
+            with open(path, 'rb') as f:
+                data = f.read()
+            flags = 0
+            payload = data
+            if args.compress and not any(fnmatch.fnmatch(name, pattern) for pattern in args.store):
+                compressed = zlib.compress(data, 9)
+                if len(compressed) < len(data) * args.min_ratio:
+                    payload = compressed
+                    flags |= ENTRY_DEFLATE
+
+            offset = _align(out.tell(), alignment)
+            out.write(b'\0' * (offset - out.tell()))
+            out.write(payload)
+
+            encoded = name.encode('utf-8')
+            if len(encoded) > 0xFFFF:
+                sys.exit('name too long: %s' % name)
+            h = xxh64(encoded)
+            index = h & (slot_count - 1)
+            while slots[index] is not None:
+                index = (index + 1) & (slot_count - 1)
+            slots[index] = (h, offset, len(payload), len(data), len(names), len(encoded), flags)
+            names += encoded
+            stored_bytes += len(data)
+            packed_bytes += len(payload)
+
+        toc_offset = _align(out.tell(), 8)
+        out.write(b'\0' * (toc_offset - out.tell()))
+        for slot in slots:
+            out.write(struct.pack(ENTRY_FORMAT, *(slot or (0, 0, 0, 0, 0, 0, 0))))
+        names_offset = out.tell()
+        out.write(names)
+
+        out.seek(0)
+        out.write(struct.pack(HEADER_FORMAT, MAGIC, VERSION, len(files), slot_count, toc_offset, names_offset,
+                              len(names), alignment))
+
+    print('%s: %d files, %d bytes -> %d bytes' % (args.output, len(files), stored_bytes, packed_bytes))
+
+
+def read_pack(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+    magic, version, entry_count, slot_count, toc_offset, names_offset, names_size, alignment = struct.unpack_from(
+        HEADER_FORMAT, data, 0)
+    if magic != MAGIC or version != VERSION:
+        sys.exit('%s is not a version %d axpk archive' % (path, VERSION))
+    names = data[names_offset:names_offset + names_size]
+    entries = []
+    for i in range(slot_count):
+        entry = struct.unpack_from(ENTRY_FORMAT, data, toc_offset + i * ENTRY_SIZE)
+        if entry[5]:
+            entries.append((names[entry[4]:entry[4] + entry[5]].decode('utf-8'),) + entry)
+    entries.sort()
+    return data, entries
+
+
+def list_pack(args):
+    _, entries = read_pack(args.pack)
+    for name, _, offset, size, original_size, _, _, flags in entries:
+        print('%10d %10d %s %s' % (original_size, size, 'D' if flags & ENTRY_DEFLATE else 'S', name))
+    print('%d files' % len(entries))
+
+
+def extract_pack(args):
+    data, entries = read_pack(args.pack)
+    for name, _, offset, size, original_size, _, _, flags in entries:
+        payload = data[offset:offset + size]
+        if flags & ENTRY_DEFLATE:
+            payload = zlib.decompress(payload)
+        path = os.path.join(args.output, *name.split('/'))
+        os.makedirs(os.path.dirname(path), exist_ok=True)
+        with open(path, 'wb') as f:
+            f.write(payload)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Build and inspect axmol packed archives (.axpk)')
+    commands = parser.add_subparsers(dest='command', required=True)
+
+    p = commands.add_parser('build', help='pack a resource directory')
+    p.add_argument('input', help='resource root, entry names are relative to it')
+    p.add_argument('-o', '--output', required=True, help='archive to write')
+    p.add_argument('-c', '--compress', action='store_true', help='deflate entries which shrink enough')
+    p.add_argument('--min-ratio', type=float, default=0.9, help='keep a deflated entry below this size ratio')
+    p.add_argument('--store', action='append', default=['*.png', '*.jpg', '*.webp', '*.mp3', '*.ogg', '*.ktx*'],
+                   help='pattern of already compressed entries which are always stored, can repeat')
+    p.add_argument('--align', type=int, default=16, help='payload alignment, 4096 for page aligned entries')
+    p.add_argument('--exclude', action='append', default=[], help='pattern of entries to skip, can repeat')
+    p.set_defaults(func=build)
+
+    p = commands.add_parser('list', help='list the entries of an archive')
+    p.add_argument('pack')
+    p.set_defaults(func=list_pack)
+
+    p = commands.add_parser('extract', help='extract an archive')
+    p.add_argument('pack')
+    p.add_argument('-o', '--output', required=True, help='directory to extract to')
+    p.set_defaults(func=extract_pack)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == '__main__':
+    main()